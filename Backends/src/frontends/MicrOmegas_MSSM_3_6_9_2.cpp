@@ -18,6 +18,7 @@
 #include "gambit/Elements/mssm_slhahelp.hpp"
 #include "gambit/Utils/mpiwrapper.hpp"
 #include "gambit/Utils/threadsafe_rng.hpp"
+#include "gambit/Utils/memory_file.hpp"
 #include <unistd.h>
 
 // Convenience functions (definitions)
@@ -68,27 +69,27 @@ BE_INI_FUNCTION
 
     if (ModelInUse("MSSM63atQ"))
     {
-        // Write out an SLHA1 file, as required by Micromegas
-        filename = "DarkBit_to_MicrOmegas_" + std::to_string(rank) + ".slha";
+        // Pass an SLHA1 file, as required by Micromegas.  This lives in memory
+        // where possible, so no filesystem is involved.
+        std::stringstream ss;
         const Spectrum& mySpec = *Dep::MSSM_spectrum;
         SLHAstruct mySLHA = mySpec.getSLHAea(1);
-        std::ofstream ofs(filename);
-        ofs << mySLHA;
+        ss << mySLHA;
 
         // Also write out decay block, if internal_decays option is set to false
         if(!(runOptions->getValueOrDef<bool>(false,"internal_decays")))
         {
-            ofs << endl;
+            ss << endl;
             const DecayTable& myDecays = *Dep::decay_rates;
             SLHAstruct decayBlock = myDecays.getSLHAea(1,true,*Dep::SLHA_pseudonyms);
-            ofs << decayBlock;
+            ss << decayBlock;
         }
-        ofs.close();
+        Utils::MemoryFile slha("DarkBit_to_MicrOmegas_" + std::to_string(rank) + ".slha", ss.str());
+        filename = slha.get_filename();
 
         // Convert filename string to char* type
-        char* filename_c = new char[filename.size() + 1];
-        std::copy(filename.begin(), filename.end(), filename_c);
-        filename_c[filename.size()] = '\0';
+        std::vector<char> filename_c(filename.begin(), filename.end());
+        filename_c.push_back('\0');
 
         // Initialize micromegas mass spectrum from SLHA
         char cdmName[10];
@@ -96,10 +97,10 @@ BE_INI_FUNCTION
 
         unsigned int usec = 100000;  // 100 ms delay
 
-        // Try 100 times before giving up
+        // Try 100 times before giving up, waiting only after a failed attempt
         for (int counter = 0; counter < 100; counter++)
         {
-            usleep(usec);
+            if (counter > 0) usleep(usec);
             error = lesHinput(&filename_c[0]);
             if (error != 0)
                 backend_warning().raise(LOCAL_INFO,
@@ -117,12 +118,6 @@ BE_INI_FUNCTION
         error = sortOddParticles(&cdmName[0]);
         if (error != 0) backend_error().raise(LOCAL_INFO, "MicrOmegas function "
                 "sortOddParticles ("+filename+") returned error code: " + std::to_string(error));
-
-        if (remove(filename_c) != 0)
-            backend_warning().raise(LOCAL_INFO, "Unable to delete SLHA file "+filename);
-
-        // Delete the heap filename
-        delete [] filename_c;
     }
 
     // Initialize yield tables for use in cascade decays
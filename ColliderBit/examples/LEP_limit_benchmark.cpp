@@ -0,0 +1,56 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Benchmark of the LEP limit interpolation.
+///  Times limitAverage, which uses the spatial
+///  indices of the limit contours, against
+///  limitAverageExact, which tests every contour
+///  segment, on a grid over the same mass planes
+///  that ColliderBit dumps for limit debugging,
+///  and reports the largest difference between
+///  the two.
+///
+///  Usage: LEP_limit_benchmark [grid points per axis]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author The GAMBIT Collaboration
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <iostream>
+
+#include "gambit/ColliderBit/limits/ALEPHSleptonLimits.hpp"
+#include "gambit/ColliderBit/limits/L3SleptonLimits.hpp"
+#include "gambit/ColliderBit/limits/L3GauginoLimits.hpp"
+#include "gambit/ColliderBit/limits/OPALGauginoLimits.hpp"
+
+using namespace Gambit::ColliderBit;
+
+/// Run the benchmark for one limit container, over the given mass plane
+void benchmark(const char* name, const BaseLimitContainer& limitContainer,
+               double xlow, double xhigh, double ylow, double yhigh, int ngrid)
+{
+  const double mZ = 91.1876;
+  std::cout << name << std::endl;
+  limitContainer.benchmarkLimitAverage(xlow, xhigh, ylow, yhigh, mZ, std::cout, ngrid);
+}
+
+int main(int argc, char* argv[])
+{
+  const int ngrid = (argc > 1 ? std::stoi(argv[1]) : 100);
+
+  benchmark("ALEPHSelectronLimitAt208GeV", ALEPHSelectronLimitAt208GeV(), 45., 115., 0., 100., ngrid);
+  benchmark("ALEPHStauLimitAt208GeV", ALEPHStauLimitAt208GeV(), 45., 115., 0., 100., ngrid);
+  benchmark("L3SelectronLimitAt205GeV", L3SelectronLimitAt205GeV(), 45., 104., 0., 100., ngrid);
+  benchmark("L3NeutralinoAllChannelsLimitAt188pt6GeV", L3NeutralinoAllChannelsLimitAt188pt6GeV(), 0., 200., 0., 100., ngrid);
+  benchmark("L3CharginoAllChannelsLimitAt188pt6GeV", L3CharginoAllChannelsLimitAt188pt6GeV(), 45., 100., 0., 100., ngrid);
+  benchmark("OPALCharginoAllChannelsLimitAt208GeV", OPALCharginoAllChannelsLimitAt208GeV(), 75., 105., 0., 105., ngrid);
+  benchmark("OPALNeutralinoHadronicLimitAt208GeV", OPALNeutralinoHadronicLimitAt208GeV(), 0., 200., 0., 100., ngrid);
+
+  return 0;
+}
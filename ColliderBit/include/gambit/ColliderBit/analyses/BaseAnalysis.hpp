@@ -121,6 +121,16 @@ namespace Gambit {
           if (_results.empty()) collect_results();
           return _results;
         }
+
+        /// Get the SignalRegionData for the events seen so far, without caching them.
+        /// @note For monitoring while events are still being analyzed; get_results() must be used for the final numbers.
+        std::vector<SignalRegionData> peek_results() {
+          std::vector<SignalRegionData> current;
+          _results.swap(current);
+          collect_results();
+          _results.swap(current);
+          return current;
+        }
       //@}
 
       /// @name Protected collection functions:
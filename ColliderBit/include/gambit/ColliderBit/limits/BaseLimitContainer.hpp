@@ -27,12 +27,14 @@
 #include <iostream>
 #include <limits>
 #include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "gambit/Elements/shared_types.hpp"
 #include "gambit/ColliderBit/limits/PointsAndLines.hpp"
+#include "gambit/ColliderBit/limits/SegmentGrid.hpp"
 
 namespace Gambit
 {
@@ -66,6 +68,19 @@ namespace Gambit
         // Some point external to all limit contours
         P2 _externalPoint;
 
+      private:
+        // Spatial indices of the limit contours (same order as _limitValuesSorted),
+        // built on the first call to limitAverage, after the derived class has filled the contours
+        mutable std::vector<SegmentGrid> _contourGrids;
+        mutable std::once_flag _contourGridsBuilt;
+
+        /// @brief Build the spatial indices of the limit contours
+        void buildContourGrids() const;
+
+        /// @brief Implementation of limitAverage, with or without the spatial indices,
+        /// for a point already known to be within the exclusion region
+        double computeLimitAverage(double x, double y, bool useGrids) const;
+
       //@}
 
       /// @name Construction and Destruction
@@ -96,6 +111,10 @@ namespace Gambit
         /// @brief Two-pi averaging interpolator to find limits between limit curves
         double limitAverage(double x, double y, double mZ) const;
 
+        /// @brief Same as limitAverage, but testing every contour segment rather than using
+        /// the spatial index (slow; for validation)
+        double limitAverageExact(double x, double y, double mZ) const;
+
         /// @brief Dump limit average data into a file for average debugging
         void dumpPlotData(double xlow, double xhigh, double ylow, double yhigh,
                           double mZ, std::string filename, int ngrid=100) const;
@@ -103,6 +122,11 @@ namespace Gambit
         /// @brief Dump input limit contour data into a file for limit debugging
         void dumpLightPlotData(std::string filename, int nperLine=20) const;
 
+        /// @brief Time limitAverage against limitAverageExact on a grid of points, and
+        /// write the timings and the largest difference between the two to a stream
+        void benchmarkLimitAverage(double xlow, double xhigh, double ylow, double yhigh,
+                                   double mZ, std::ostream& out, int ngrid=100) const;
+
       //@}
     };
 
@@ -0,0 +1,64 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Uniform grid index over a set of line
+///  segments, for fast intersection queries
+///  against the LEP limit contours.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *************************************
+
+#pragma once
+
+#include <vector>
+
+#include "gambit/ColliderBit/limits/PointsAndLines.hpp"
+
+namespace Gambit
+{
+  namespace ColliderBit
+  {
+
+    /// @brief Spatial index of a fixed set of line segments on a uniform grid.
+    ///
+    /// Each segment is filed under every grid cell that its bounding box touches,
+    /// so a query only has to test the segments in the cells that the query line
+    /// passes through. The tests themselves use LineSegment::intersectsAt, so the
+    /// answers are identical to looping over every segment.
+    class SegmentGrid
+    {
+      public:
+
+        SegmentGrid() : _segments(NULL), _nx(0), _ny(0) {}
+
+        /// @brief Build the index for the given segments (which must outlive the grid)
+        explicit SegmentGrid(const std::vector<LineSegment>& segments);
+
+        /// @brief Count the segments that the given line intersects
+        unsigned countIntersections(const LineSegment& line) const;
+
+        /// @brief Distance from point to the closest intersection of ray with any segment
+        /// (infinity if there is none). The ray must start at point.
+        double closestIntersection(const P2& point, const LineSegment& ray) const;
+
+      private:
+
+        /// @brief Range of cell indices [lo, hi] covering [a, b] along one axis; false if empty
+        bool cellRange(double a, double b, double min, double width, int n, int& lo, int& hi) const;
+
+        /// @brief Range of cell rows covering the part of line with x in [xa, xb]; false if empty
+        bool rowRange(const LineSegment& line, double xa, double xb, int& lo, int& hi) const;
+
+        const std::vector<LineSegment>* _segments;
+        int _nx, _ny;
+        double _xmin, _ymin, _dx, _dy, _eps;
+        /// Segment indices in each cell, stored by column (cell (i,j) is entry i*_ny+j)
+        std::vector<std::vector<unsigned> > _cells;
+    };
+
+  }
+}
@@ -31,6 +31,8 @@
 ///  *********************************************
 
 #include <cmath>
+#include <map>
+#include <algorithm>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -130,7 +132,8 @@ namespace Gambit
                              START_SUBPROCESS = -3,
                              END_SUBPROCESS = -4,
                              COLLIDER_FINALIZE = -5,
-                             BASE_FINALIZE = -6};
+                             BASE_FINALIZE = -6,
+                             CHECK_CONVERGENCE = -7};
 
     /// Pythia stuff
     std::vector<str> pythiaNames;
@@ -163,6 +166,72 @@ namespace Gambit
     bool haveUsedDelphesDetector;
 #endif
 
+    /// Adaptive event generation stuff
+    /// Signal region counts of one analysis, summed over threads at the last convergence check
+    struct ConvergenceData
+    {
+      std::vector<SignalRegionData> srData;
+      double luminosity = 0; ///< Integrated luminosity of the analysis (fb^-1)
+      double nEvents = 0;    ///< Number of events analysed
+      double xsecEvents = 0; ///< Cross-section (fb) times number of events, for averaging the threads' xsec estimates
+    };
+    std::map<str, ConvergenceData> convergenceData;
+
+    /// Add the current signal region counts from one thread's analyses to the convergence check
+    void addToConvergenceCheck(const str& detector, const HEPUtilsAnalysisContainer& container, double xs_fb)
+    {
+      for (size_t i = 0; i < container.analyses.size(); ++i)
+      {
+        HEPUtilsAnalysis* ana = container.analyses[i];
+        const std::vector<SignalRegionData> srData = ana->peek_results();
+        if (srData.empty()) continue;
+        #pragma omp critical (access_convergenceData)
+        {
+          ConvergenceData& data = convergenceData[detector + "_" + std::to_string(i)];
+          if (data.srData.empty()) data.srData = srData;
+          else for (size_t SR = 0; SR < srData.size(); ++SR) data.srData[SR].n_signal += srData[SR].n_signal;
+          data.luminosity = ana->luminosity();
+          data.nEvents += ana->num_events();
+          data.xsecEvents += xs_fb * ana->num_events();
+        }
+      }
+    }
+
+    /// Decide from the signal region counts collected at the last convergence check whether
+    /// more events could still change the LHC likelihood. A signal region is converged when either
+    /// the Monte Carlo relative uncertainty on its signal is below relErrorTarget, or the
+    /// resulting uncertainty on its (Gaussian-approximated) delta log-likelihood is below dllErrorTarget.
+    bool signalConverged(double relErrorTarget, double dllErrorTarget)
+    {
+      for (auto it = convergenceData.begin(); it != convergenceData.end(); ++it)
+      {
+        const ConvergenceData& data = it->second;
+        if (data.nEvents <= 0) return false;
+        // Number of signal events expected at the experiment per simulated event
+        const double factor = data.luminosity * (data.xsecEvents / data.nEvents) / data.nEvents;
+        for (auto SR = data.srData.begin(); SR != data.srData.end(); ++SR)
+        {
+          // With no events in the SR yet, be conservative and use the 95% CL upper limit of 3 events
+          const double n_signal = (SR->n_signal > 0 ? SR->n_signal : 3.0);
+          const double rel_err = 1.0 / sqrt(n_signal);
+          if (rel_err <= relErrorTarget) continue;
+          // dll ~ s^2/2V, so the uncertainty on the dll from the uncertainty on s is ~ (s^2/V)*(ds/s)
+          const double s = n_signal * factor;
+          const double variance = SR->n_background + s + SR->background_sys*SR->background_sys;
+          const double dll_err = (variance > 0 ? s*s/variance * rel_err : 0);
+          if (dll_err > dllErrorTarget)
+          {
+            #ifdef COLLIDERBIT_DEBUG
+              std::cerr << debug_prefix() << "Not converged: " << SR->analysis_name << ", SR: " << SR->sr_label << ", n_signal = "
+                        << SR->n_signal << ", s at lumi = " << s << ", dll error = " << dll_err << endl;
+            #endif
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+
 
 
 
@@ -236,6 +305,18 @@ namespace Gambit
       bool silenceLoop = runOptions->getValueOrDef<bool>(true, "silenceLoop");
       if (silenceLoop) std::cout.rdbuf(0);
 
+      // Should we generate events in batches, and stop once the signal is known well enough?
+      // In this case nEvents is the maximum number of events for each collider.
+      bool adaptiveEvents = runOptions->getValueOrDef<bool>(false, "adaptiveEvents");
+      int nEventsBatch = runOptions->getValueOrDef<int>(1000, "nEventsBatch");
+      int nEventsMin = runOptions->getValueOrDef<int>(nEventsBatch, "nEventsMin");
+      double signalRelErrorTarget = runOptions->getValueOrDef<double>(0.1, "signalRelErrorTarget");
+      double dllErrorTarget = runOptions->getValueOrDef<double>(0.05, "dllErrorTarget");
+      if (adaptiveEvents and nEventsBatch <= 0)
+      {
+        ColliderBit_error().raise(LOCAL_INFO, "The option 'nEventsBatch' for the function 'operateLHCLoop' must be positive.");
+      }
+
 
 
       // Do the base-level initialisation
@@ -267,7 +348,6 @@ namespace Gambit
         //
         // OMP parallelized loop begins here
         //
-        int currentEvent = 0;
         #pragma omp parallel
         {
           Loop::executeIteration(START_SUBPROCESS);
@@ -276,27 +356,65 @@ namespace Gambit
         piped_warnings.check(ColliderBit_warning());
         piped_errors.check(ColliderBit_error());
 
-        // Main event loop
-        #pragma omp parallel
+        // Main event loop, run in batches if generating adaptively.
+        // Each thread claims the next event number from the shared counter.
+        const int maxEvents = nEvents[indexPythiaNames];
+        int currentEvent = 0;
+        int targetEvents = (adaptiveEvents ? std::min(std::max(nEventsMin, 1), maxEvents) : maxEvents);
+        while (true)
         {
-          while(currentEvent<nEvents[indexPythiaNames] and not *Loop::done and not piped_errors.inquire())
+          #pragma omp parallel
           {
-            if (!eventsGenerated)
-              eventsGenerated = true;
-            try
+            while (not *Loop::done and not piped_errors.inquire())
             {
-              Loop::executeIteration(currentEvent);
-              currentEvent++;
-            }
-            catch (std::domain_error& e)
-            {
-              std::cerr<<"\n   Continuing to the next event...\n\n";
+              int myEvent;
+              #pragma omp atomic capture
+              myEvent = currentEvent++;
+              if (myEvent >= targetEvents) break;
+
+              if (!eventsGenerated)
+                eventsGenerated = true;
+              // Failed events are repeated, so that they do not count towards the total
+              bool eventDone = false;
+              while (not eventDone and not *Loop::done and not piped_errors.inquire())
+              {
+                try
+                {
+                  Loop::executeIteration(myEvent);
+                  eventDone = true;
+                }
+                catch (std::domain_error& e)
+                {
+                  std::cerr<<"\n   Continuing to the next event...\n\n";
+                }
+              }
             }
           }
+          // Any problems during the main event loop?
+          piped_warnings.check(ColliderBit_warning());
+          piped_errors.check(ColliderBit_error());
+
+          // Every thread overshoots the counter by one when it stops
+          currentEvent = std::min(currentEvent, targetEvents);
+          if (not adaptiveEvents or currentEvent >= maxEvents or *Loop::done or tooManyFailedEvents) break;
+
+          // Collect the signal region counts from all threads, and stop if they are good enough
+          convergenceData.clear();
+          #pragma omp parallel
+          {
+            Loop::executeIteration(CHECK_CONVERGENCE);
+          }
+          piped_warnings.check(ColliderBit_warning());
+          piped_errors.check(ColliderBit_error());
+          if (signalConverged(signalRelErrorTarget, dllErrorTarget)) break;
+          targetEvents = std::min(targetEvents + nEventsBatch, maxEvents);
+        }
+
+        if (adaptiveEvents)
+        {
+          logger() << LogTags::debug << "operateLHCLoop: generated " << currentEvent << " of at most " << maxEvents
+                   << " events for " << *iterPythiaNames << "." << EOM;
         }
-        // Any problems during the main event loop?
-        piped_warnings.check(ColliderBit_warning());
-        piped_errors.check(ColliderBit_error());
 
         #pragma omp parallel
         {
@@ -335,7 +453,6 @@ namespace Gambit
       static bool pythia_doc_path_needs_setting = true;
       static std::vector<str> pythiaCommonOptions;
       static SLHAstruct slha;
-      static SLHAstruct spectrum;
       static std::vector<double> xsec_vetos;
 
       if (*Loop::iteration == BASE_INIT)
@@ -354,19 +471,12 @@ namespace Gambit
 
         // SLHAea object constructed from dependencies on the spectrum and decays.
         slha.clear();
-        spectrum.clear();
         slha = Dep::decay_rates->getSLHAea(2);
         if (ModelInUse("MSSM63atQ") or ModelInUse("MSSM63atMGUT"))
         {
-          // MSSM-specific.  SLHAea in SLHA2 format, please.
-          spectrum = Dep::MSSM_spectrum->getSLHAea(2);
-          SLHAea::Block block("MODSEL");
-          block.push_back("BLOCK MODSEL              # Model selection");
-          SLHAea::Line line;
-          line << 1 << 0 << "# General MSSM";
-          block.push_back(line);
+          // MSSM-specific.  SLHA2 spectrum, shared with other modules and already including MODSEL.
+          const SLHAstruct& spectrum = Dep::MSSM_SLHA2_blocks->slhaea();
           slha.insert(slha.begin(), spectrum.begin(), spectrum.end());
-          slha.push_front(block);
         }
         else
         {
@@ -901,6 +1011,13 @@ namespace Gambit
 
       if (!useDelphesDetector) return;
 
+      if (*Loop::iteration == CHECK_CONVERGENCE)
+      {
+        // Report this thread's signal region counts for deciding whether to generate more events
+        addToConvergenceCheck("Det", result, Dep::HardScatteringSim->xsec_pb() * 1000.);
+        return;
+      }
+
       if (*Loop::iteration == START_SUBPROCESS)
       {
         // Each thread gets its own Analysis container.
@@ -980,6 +1097,13 @@ namespace Gambit
 
       if (!useBuckFastATLASDetector) return;
 
+      if (*Loop::iteration == CHECK_CONVERGENCE)
+      {
+        // Report this thread's signal region counts for deciding whether to generate more events
+        addToConvergenceCheck("ATLAS", result, Dep::HardScatteringSim->xsec_pb() * 1000.);
+        return;
+      }
+
       if (*Loop::iteration == START_SUBPROCESS)
       {
         // Each thread gets its own Analysis container.
@@ -1058,6 +1182,13 @@ namespace Gambit
 
       if (!useBuckFastCMSDetector) return;
 
+      if (*Loop::iteration == CHECK_CONVERGENCE)
+      {
+        // Report this thread's signal region counts for deciding whether to generate more events
+        addToConvergenceCheck("CMS", result, Dep::HardScatteringSim->xsec_pb() * 1000.);
+        return;
+      }
+
       if (*Loop::iteration == START_SUBPROCESS)
       {
         // Each thread gets its own Analysis container.
@@ -1136,6 +1267,13 @@ namespace Gambit
 
       if (!useBuckFastIdentityDetector) return;
 
+      if (*Loop::iteration == CHECK_CONVERGENCE)
+      {
+        // Report this thread's signal region counts for deciding whether to generate more events
+        addToConvergenceCheck("Identity", result, Dep::HardScatteringSim->xsec_pb() * 1000.);
+        return;
+      }
+
       if (*Loop::iteration == START_SUBPROCESS)
       {
         // Each thread gets its own Analysis container.
@@ -18,6 +18,8 @@
 ///
 ///  *************************************
 
+#include <chrono>
+
 #include "gambit/ColliderBit/limits/BaseLimitContainer.hpp"
 
 namespace Gambit
@@ -39,9 +41,28 @@ namespace Gambit
       return std::numeric_limits<double>::infinity();
     }
   
+    void BaseLimitContainer::buildContourGrids() const
+    {
+      _contourGrids.clear();
+      for (unsigned index=0; index<_limitValuesSorted.size(); index++)
+        _contourGrids.push_back(SegmentGrid(*_limitContours.at(index)));
+    }
+
     double BaseLimitContainer::limitAverage(double x, double y, double mZ) const
     {
       if (!isWithinExclusionRegion(x, y, mZ)) return specialLimit(x, y);
+      std::call_once(_contourGridsBuilt, &BaseLimitContainer::buildContourGrids, this);
+      return computeLimitAverage(x, y, true);
+    }
+
+    double BaseLimitContainer::limitAverageExact(double x, double y, double mZ) const
+    {
+      if (!isWithinExclusionRegion(x, y, mZ)) return specialLimit(x, y);
+      return computeLimitAverage(x, y, false);
+    }
+
+    double BaseLimitContainer::computeLimitAverage(double x, double y, bool useGrids) const
+    {
       const P2& point = P2(x, y);
       const LineSegment& externalLine = LineSegment(point, _externalPoint);
       P2 rayMaker;
@@ -54,10 +75,13 @@ namespace Gambit
       for (index=0; index<_limitValuesSorted.size(); index++) {
         intersectCounter = 0; 
         thisLimit = _limitValuesSorted[index];
-        for (auto segmentIter = _limitContours.at(index)->begin();
-                  segmentIter != _limitContours.at(index)->end(); ++segmentIter)
-          if (externalLine.intersectsAt(*segmentIter).r() < std::numeric_limits<double>::infinity())
-            intersectCounter++;
+        if (useGrids)
+          intersectCounter = _contourGrids[index].countIntersections(externalLine);
+        else
+          for (auto segmentIter = _limitContours.at(index)->begin();
+                    segmentIter != _limitContours.at(index)->end(); ++segmentIter)
+            if (externalLine.intersectsAt(*segmentIter).r() < std::numeric_limits<double>::infinity())
+              intersectCounter++;
         if (intersectCounter % 2) break;
         thisLimit = -1.;
       }
@@ -82,12 +106,15 @@ namespace Gambit
   
         // For each ray, look for intersections with the next best limit.
         rmin = std::numeric_limits<double>::infinity();
-        for (auto segmentIter = _limitContours.at(index-1)->begin();
-                  segmentIter != _limitContours.at(index-1)->end(); ++segmentIter) {
-          intersectLine.init(point, ray.intersectsAt(*segmentIter));
-          r = intersectLine.r();
-          if (r <= rmin) rmin = r;
-        }
+        if (useGrids)
+          rmin = _contourGrids[index-1].closestIntersection(point, ray);
+        else
+          for (auto segmentIter = _limitContours.at(index-1)->begin();
+                    segmentIter != _limitContours.at(index-1)->end(); ++segmentIter) {
+            intersectLine.init(point, ray.intersectsAt(*segmentIter));
+            r = intersectLine.r();
+            if (r <= rmin) rmin = r;
+          }
         if (rmin == 0.) {
           totalWeight = -1.;
           average = nextBestLimit;
@@ -99,12 +126,15 @@ namespace Gambit
   
         // For each ray, also look for intersections with the current limit.
         rmin = std::numeric_limits<double>::infinity();
-        for (auto segmentIter = _limitContours.at(index)->begin();
-                  segmentIter != _limitContours.at(index)->end(); ++segmentIter) {
-          intersectLine.init(point, ray.intersectsAt(*segmentIter));
-          r = intersectLine.r();
-          if (r <= rmin) rmin = r;
-        }
+        if (useGrids)
+          rmin = _contourGrids[index].closestIntersection(point, ray);
+        else
+          for (auto segmentIter = _limitContours.at(index)->begin();
+                    segmentIter != _limitContours.at(index)->end(); ++segmentIter) {
+            intersectLine.init(point, ray.intersectsAt(*segmentIter));
+            r = intersectLine.r();
+            if (r <= rmin) rmin = r;
+          }
         if (rmin == 0.) {
           totalWeight = -1.;
           average = thisLimit;
@@ -156,6 +186,49 @@ namespace Gambit
       outFile.close();
     }
 
+    /// @brief Time limitAverage against limitAverageExact on a grid of points
+    void BaseLimitContainer::benchmarkLimitAverage(double xlow, double xhigh, double ylow,
+                                                   double yhigh, double mZ,
+                                                   std::ostream& out, int ngrid) const
+    {
+      std::vector<double> fast, exact;
+      double x, y;
+      // Build the indices up front, so that they are not included in the timing
+      std::call_once(_contourGridsBuilt, &BaseLimitContainer::buildContourGrids, this);
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      for (int xi=0; xi<=ngrid; xi++) {
+        x = xlow + (xhigh - xlow) * xi / ngrid;
+        for (int yi=0; yi<=ngrid; yi++) {
+          y = ylow + (yhigh - ylow) * yi / ngrid;
+          fast.push_back(limitAverage(x,y,mZ));
+        }
+      }
+      std::chrono::steady_clock::time_point middle = std::chrono::steady_clock::now();
+      for (int xi=0; xi<=ngrid; xi++) {
+        x = xlow + (xhigh - xlow) * xi / ngrid;
+        for (int yi=0; yi<=ngrid; yi++) {
+          y = ylow + (yhigh - ylow) * yi / ngrid;
+          exact.push_back(limitAverageExact(x,y,mZ));
+        }
+      }
+      std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+      double maxdiff = 0.;
+      unsigned nmismatch = 0;
+      for (unsigned i=0; i<fast.size(); i++) {
+        if (fast[i] == exact[i]) continue;
+        double diff = std::fabs(fast[i] - exact[i]) / std::max(std::fabs(exact[i]), std::numeric_limits<double>::min());
+        if (!(diff <= maxdiff)) maxdiff = diff;
+        nmismatch++;
+      }
+
+      out << "limitAverage benchmark on " << fast.size() << " points:" << std::endl
+          << "  indexed: " << std::chrono::duration<double>(middle - start).count() << " s" << std::endl
+          << "  exact:   " << std::chrono::duration<double>(end - middle).count() << " s" << std::endl
+          << "  points differing: " << nmismatch << ", largest relative difference: " << maxdiff << std::endl;
+    }
+
 
   }
 }
@@ -0,0 +1,171 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Uniform grid index over a set of line
+///  segments, for fast intersection queries
+///  against the LEP limit contours.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *************************************
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "gambit/ColliderBit/limits/SegmentGrid.hpp"
+
+namespace Gambit
+{
+  namespace ColliderBit
+  {
+
+    SegmentGrid::SegmentGrid(const std::vector<LineSegment>& segments)
+      : _segments(&segments), _nx(0), _ny(0)
+    {
+      if (segments.empty()) return;
+
+      // Bounding box of all the segments
+      double xmax, ymax;
+      _xmin = xmax = segments.front().getp1().getx();
+      _ymin = ymax = segments.front().getp1().gety();
+      for (auto it = segments.begin(); it != segments.end(); ++it)
+      {
+        // p1 always has the smaller x
+        _xmin = std::min(_xmin, it->getp1().getx());
+        xmax = std::max(xmax, it->getp2().getx());
+        _ymin = std::min(_ymin, std::min(it->getp1().gety(), it->getp2().gety()));
+        ymax = std::max(ymax, std::max(it->getp1().gety(), it->getp2().gety()));
+      }
+
+      // Pad everything a little, so that intersections lying within rounding
+      // error of a cell boundary are still found.
+      _eps = 1e-9 * std::max(1., std::max(xmax - _xmin, ymax - _ymin));
+      _xmin -= 2*_eps;
+      _ymin -= 2*_eps;
+      xmax += 2*_eps;
+      ymax += 2*_eps;
+
+      // About one segment per cell
+      _nx = _ny = std::max(1, (int)std::sqrt((double)segments.size()));
+      _dx = (xmax - _xmin) / _nx;
+      _dy = (ymax - _ymin) / _ny;
+      _cells.resize(_nx * _ny);
+
+      for (unsigned k = 0; k < segments.size(); ++k)
+      {
+        const LineSegment& seg = segments[k];
+        int ilo, ihi, jlo, jhi;
+        cellRange(seg.getp1().getx() - _eps, seg.getp2().getx() + _eps, _xmin, _dx, _nx, ilo, ihi);
+        cellRange(std::min(seg.getp1().gety(), seg.getp2().gety()) - _eps,
+                  std::max(seg.getp1().gety(), seg.getp2().gety()) + _eps, _ymin, _dy, _ny, jlo, jhi);
+        for (int i = ilo; i <= ihi; ++i)
+          for (int j = jlo; j <= jhi; ++j)
+            _cells[i*_ny + j].push_back(k);
+      }
+    }
+
+    bool SegmentGrid::cellRange(double a, double b, double min, double width, int n, int& lo, int& hi) const
+    {
+      if (not (b >= min and a <= min + n*width)) return false;
+      // Clamp in floating point first, as a or b may be far outside the grid
+      lo = (int)std::max(0., std::floor((a - min) / width));
+      hi = (int)std::min(n - 1., std::floor((b - min) / width));
+      lo = std::min(lo, n - 1);
+      hi = std::max(hi, 0);
+      return true;
+    }
+
+    bool SegmentGrid::rowRange(const LineSegment& line, double xa, double xb, int& lo, int& hi) const
+    {
+      const P2 p1 = line.getp1(), p2 = line.getp2();
+      double ya, yb;
+      if (p1.getx() == p2.getx())
+      {
+        ya = p1.gety();
+        yb = p2.gety();
+      }
+      else
+      {
+        const double slope = (p2.gety() - p1.gety()) / (p2.getx() - p1.getx());
+        ya = p1.gety() + (xa - p1.getx()) * slope;
+        yb = p1.gety() + (xb - p1.getx()) * slope;
+      }
+      return cellRange(std::min(ya, yb) - _eps, std::max(ya, yb) + _eps, _ymin, _dy, _ny, lo, hi);
+    }
+
+    unsigned SegmentGrid::countIntersections(const LineSegment& line) const
+    {
+      int ilo, ihi, jlo, jhi;
+      if (_cells.empty() or not cellRange(line.getp1().getx() - _eps, line.getp2().getx() + _eps, _xmin, _dx, _nx, ilo, ihi))
+        return 0;
+
+      // Gather the segments in all cells along the line. Long segments appear in more
+      // than one cell, so remove the duplicates before counting.
+      std::vector<unsigned> candidates;
+      const double x1 = line.getp1().getx(), x2 = line.getp2().getx();
+      for (int i = ilo; i <= ihi; ++i)
+      {
+        const double xa = std::min(std::max(_xmin + i*_dx, x1), x2);
+        const double xb = std::min(std::max(_xmin + (i+1)*_dx, x1), x2);
+        if (not rowRange(line, xa, xb, jlo, jhi)) continue;
+        for (int j = jlo; j <= jhi; ++j)
+        {
+          const std::vector<unsigned>& cell = _cells[i*_ny + j];
+          candidates.insert(candidates.end(), cell.begin(), cell.end());
+        }
+      }
+      std::sort(candidates.begin(), candidates.end());
+      candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+      unsigned intersectCounter = 0;
+      for (auto it = candidates.begin(); it != candidates.end(); ++it)
+        if (line.intersectsAt((*_segments)[*it]).r() < std::numeric_limits<double>::infinity())
+          intersectCounter++;
+      return intersectCounter;
+    }
+
+    double SegmentGrid::closestIntersection(const P2& point, const LineSegment& ray) const
+    {
+      double rmin = std::numeric_limits<double>::infinity();
+      int ilo, ihi, jlo, jhi;
+      if (_cells.empty() or not cellRange(ray.getp1().getx() - _eps, ray.getp2().getx() + _eps, _xmin, _dx, _nx, ilo, ihi))
+        return rmin;
+
+      // Walk the columns outwards from the start of the ray. Once the closest intersection
+      // found is nearer than the next column boundary, no later column can beat it.
+      const double x1 = ray.getp1().getx(), x2 = ray.getp2().getx();
+      const bool ascending = (x2 > point.getx());
+      const bool vertical = (x2 == x1);
+      const double distPerDx = (vertical ? 0. : ray.r() / (x2 - x1));
+      LineSegment intersectLine;
+      for (int n = 0; n <= ihi - ilo; ++n)
+      {
+        const int i = (ascending ? ilo + n : ihi - n);
+        const double xa = std::min(std::max(_xmin + i*_dx, x1), x2);
+        const double xb = std::min(std::max(_xmin + (i+1)*_dx, x1), x2);
+        if (rowRange(ray, xa, xb, jlo, jhi))
+        {
+          for (int j = jlo; j <= jhi; ++j)
+          {
+            const std::vector<unsigned>& cell = _cells[i*_ny + j];
+            for (auto it = cell.begin(); it != cell.end(); ++it)
+            {
+              intersectLine.init(point, ray.intersectsAt((*_segments)[*it]));
+              const double r = intersectLine.r();
+              if (r <= rmin) rmin = r;
+            }
+          }
+        }
+        if (vertical) continue;
+        const double boundary = _xmin + (ascending ? i+1 : i)*_dx;
+        if (rmin <= (std::fabs(boundary - point.getx()) - _eps) * distPerDx) break;
+      }
+      return rmin;
+    }
+
+  }
+}
@@ -0,0 +1,129 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Benchmark of the per-point calculation of
+///  ObsLike entries by the dependency resolver.
+///  Sets up the dependency graph for a yaml file
+///  exactly as GAMBIT does, fixes every model
+///  parameter to its fixed value or the centre
+///  of its scan range, then times
+///  DependencyResolver::calcObsLike over all
+///  ObsLike entries, point after point, with the
+///  results going to the printer of the yaml file.
+///  For a yaml file with cheap module functions
+///  (e.g. spartan.yaml), the time per point is
+///  mostly the bookkeeping overhead of
+///  calcObsLike.
+///
+///  Usage: ObsLike_plan_benchmark [yaml file] [points]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author The GAMBIT Collaboration
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <chrono>
+#include <iostream>
+
+#include "gambit/Core/gambit.hpp"
+
+using namespace Gambit;
+
+/// Value used for a model parameter: its fixed value, or the centre of its scan range (zero otherwise)
+double benchmark_value(const YAML::Node& node)
+{
+  if (node.IsScalar()) return node.as<double>();
+  if (node.IsMap() and node["fixed_value"])
+  {
+    const YAML::Node& value = node["fixed_value"];
+    return value.IsSequence() ? value[0].as<double>() : value.as<double>();
+  }
+  if (node.IsMap() and node["range"]) return 0.5*(node["range"][0].as<double>() + node["range"][1].as<double>());
+  return 0.;
+}
+
+/// Time a function over a number of points; returns the time per point in microseconds
+template <typename F>
+double time_per_point(int npoints, F f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int n = 0; n < npoints; ++n) f(n);
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(stop - start).count() / npoints;
+}
+
+int main(int argc, char* argv[])
+{
+  const str filename = (argc > 1 ? argv[1] : "yaml_files/spartan.yaml");
+  const int npoints = (argc > 2 ? std::stoi(argv[2]) : 10000);
+
+  #ifdef WITH_MPI
+    GMPI::Init();
+  #endif
+
+  {
+    // Read the yaml file, which also initialises the logger, and set up the dependency resolver as GAMBIT does
+    IniParser::IniFile iniFile;
+    iniFile.readFile(filename);
+    Random::create_rng_engine(iniFile.getValueOrDef<str>("default", "rng"));
+    Core().registerActiveModelFunctors(Models::ModelDB().getPrimaryModelFunctorsToActivate(iniFile.getModelNames(), Core().getPrimaryModelFunctors()));
+    Core().accountForMissingClasses();
+    Printers::PrinterManager printerManager(iniFile.getPrinterNode(), false);
+    DRes::DependencyResolver dependencyResolver(Core(), Models::ModelDB(), iniFile, Utils::typeEquivalencies(), *(printerManager.printerptr));
+    dependencyResolver.doResolution();
+
+    // Fix the model parameters
+    const YAML::Node parameters = iniFile.getParametersNode();
+    const std::map<str, primary_model_functor*> models = Core().getActiveModelFunctors();
+    for (auto it = models.begin(); it != models.end(); ++it)
+    {
+      ModelParameters* contents = it->second->getcontentsPtr();
+      const std::vector<str> keys = contents->getKeys();
+      const YAML::Node model = parameters[it->first];
+      for (auto jt = keys.begin(); jt != keys.end(); ++jt)
+      {
+        contents->setValue(*jt, (model and model[*jt]) ? benchmark_value(model[*jt]) : 0.);
+      }
+    }
+
+    const std::vector<DRes::VertexID> obslikes = dependencyResolver.getObsLikeOrder();
+    std::cout << filename << ": " << obslikes.size() << " ObsLikes, " << npoints << " points" << std::endl;
+
+    // Calculate every ObsLike entry at each point, stopping at the first that invalidates the point, as the
+    // likelihood container does.
+    int ninvalid = 0;
+    const double reset_only = time_per_point(npoints, [&](int)
+    {
+      dependencyResolver.resetAll();
+    });
+    const double calc = time_per_point(npoints, [&](int n)
+    {
+      try
+      {
+        for (auto it = obslikes.begin(); it != obslikes.end(); ++it) dependencyResolver.calcObsLike(*it, n);
+      }
+      catch (invalid_point_exception&)
+      {
+        logger().leaving_module();
+        ++ninvalid;
+      }
+      dependencyResolver.resetAll();
+    });
+    printerManager.printerptr->finalise();
+
+    std::cout << "  resetting functors only: " << reset_only << " us per point" << std::endl;
+    std::cout << "  calcObsLike:             " << calc << " us per point ("
+              << (calc-reset_only)/obslikes.size() << " us per ObsLike)" << std::endl;
+    if (ninvalid > 0) std::cout << "  (" << ninvalid << " points were invalidated)" << std::endl;
+  }
+
+  #ifdef WITH_MPI
+    GMPI::Finalize();
+  #endif
+  return 0;
+}
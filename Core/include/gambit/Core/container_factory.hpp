@@ -27,6 +27,7 @@
 #define __container_factory_hpp__
 
 #include <vector>
+#include <memory>
 #include <unordered_map>
 #include <map>
 #include <unordered_set>
@@ -47,12 +48,16 @@
 namespace Gambit
 {
 
+  #ifdef WITH_MPI
+    class Functor_Stats_Exchange;
+  #endif
+
   registry
   {
     typedef void* factory_type(const std::map<str, primary_model_functor *> &, 
      DRes::DependencyResolver &b, IniParser::IniFile &c, const str &purpose, Printers::BaseBasePrinter& p
      #ifdef WITH_MPI
-     , GMPI::Comm& comm
+     , GMPI::Comm& comm, Functor_Stats_Exchange* stats_exchange
      #endif
      );
     reg_elem <factory_type> __scanner_factories__;
@@ -67,6 +72,8 @@ namespace Gambit
       Printers::BaseBasePrinter &printer;
       #ifdef WITH_MPI
       GMPI::Comm& myComm;
+      /// Exchange of functor statistics shared by all containers (NULL if the statistics are not shared)
+      std::shared_ptr<Functor_Stats_Exchange> stats_exchange;
       #endif
 
     public:
@@ -78,6 +85,8 @@ namespace Gambit
        );
       ~Likelihood_Container_Factory(){}
       void * operator() (const str &purpose) const;
+      /// Finish all communication between the containers of different processes.  Call after the scan, before MPI_Finalize.
+      void finalise();
   };
 
 }
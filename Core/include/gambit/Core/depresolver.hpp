@@ -99,6 +99,31 @@ namespace Gambit
       bool printme;
     };
 
+    /// One precompiled step in the calculation of an ObsLike entry
+    struct ObsLikeStep
+    {
+      /// Functor to calculate
+      functor* f;
+      /// Whether the result should be passed on to the printer (i.e. is not void)
+      bool print;
+    };
+
+    /// One wave of a parallel execution plan.  Every vertex in a wave has all its parents in earlier waves.
+    struct ParallelWave
+    {
+      /// Groups of vertices that may be calculated concurrently with each other.  The vertices within
+      /// a group share a backend, so they are calculated one after the other by the same thread.
+      std::vector<std::vector<VertexID> > groups;
+      /// Loop managers in the wave.  These set global OpenMP signal-handling state while they run their
+      /// nested functors, so they are calculated one at a time, after the concurrent groups.
+      std::vector<VertexID> loop_managers;
+      /// All vertices in the wave, including nested functors that are run by their loop managers.
+      std::vector<VertexID> members;
+    };
+
+    /// Execution plan for concurrently calculating the functors required by a set of target vertices.
+    typedef std::vector<ParallelWave> ParallelPlan;
+
     /// Check whether s1 (wildcard + regex allowed) matches s2
     bool stringComp(const str &s1, const str &s2, bool with_regex = true);
 
@@ -127,9 +152,21 @@ namespace Gambit
         /// Retrieve the order in which target vertices are to be evaluated.
         std::vector<VertexID> getObsLikeOrder();
 
+        /// Retrieve the order in which target vertices are to be evaluated, given runtime and invalidation rate estimates indexed by VertexID.
+        std::vector<VertexID> getObsLikeOrder(const std::vector<double>&, const std::vector<double>&);
+
+        /// Collect the current runtime and invalidation rate estimates of all functors, indexed by VertexID.
+        void getFunctorStatistics(std::vector<double>&, std::vector<double>&);
+
         /// Calculate a single target vertex.
         void calcObsLike(VertexID, const int);
 
+        /// Build a plan for concurrently calculating all functors needed by a list of target vertices.
+        ParallelPlan getParallelPlan(const std::vector<VertexID>&);
+
+        /// Calculate the functors in a parallel plan, using up to the given number of threads.
+        void calcParallelPlan(const ParallelPlan&, int, bool);
+
         /// Getter for print_timing flag (used by LikelihoodContainer)
         bool printTiming();
 
@@ -251,6 +288,16 @@ namespace Gambit
         /// Saved calling order for functions required to compute single ObsLike entries
         std::map<VertexID, std::vector<VertexID>> SortedParentVertices;
 
+        /// Precompiled execution plans for single ObsLike entries (flat lists of functors in calling order)
+        std::map<VertexID, std::vector<ObsLikeStep>> ObsLikePlans;
+
+        /// Log the runtime of each functor after calculating it?
+        bool log_runtime = false;
+
+        /// Backends used by each vertex, as identified by their initialisation functions (BACKEND_VERSION_init),
+        /// recorded as the backend requirements are resolved
+        std::map<VertexID, std::set<str>> resolvedBackends;
+
         /// Temporary map for loop manager -> list of nested functions
         std::map<VertexID, std::set<VertexID>> loopManagerMap;
 
@@ -34,6 +34,55 @@
 namespace Gambit
 {
 
+  #ifdef WITH_MPI
+    /// Exchange of functor statistics between MPI processes, used by likelihood containers to re-optimise their
+    /// evaluation order.  Owned by the Likelihood_Container_Factory rather than by the containers, so that the
+    /// sends still in flight at the end of a scan can be completed by finalise() before MPI_Finalize.
+    class Functor_Stats_Exchange
+    {
+
+      private:
+
+        /// Communicator used for the exchange
+        GMPI::Comm& comm;
+
+        /// MPI tags for statistics messages, and for the final count of them sent to each process
+        static const int STATS_TAG = 2;
+        static const int COUNT_TAG = 3;
+
+        /// Buffer and pending requests for the statistics last sent to the other processes
+        /// (the buffer must be kept until the requests have completed)
+        std::vector<double> sent_stats;
+        std::vector<MPI_Request> requests;
+
+        /// Number of statistics messages sent to each other process, and received from each of them
+        std::vector<int> n_sent;
+        std::vector<int> n_received;
+
+        /// Free any requests that have not completed, keeping their buffers until the program exits
+        void abandon();
+
+      public:
+
+        /// Constructor
+        Functor_Stats_Exchange(GMPI::Comm&);
+
+        /// Destructor; never blocks, abandoning any exchange that has not been finalised
+        ~Functor_Stats_Exchange();
+
+        /// Send statistics to all other processes, unless the previous send has not completed yet
+        void send(const std::vector<double>&);
+
+        /// Receive the statistics that have arrived so far, keeping the latest from each process
+        void receive(std::vector<std::vector<double> >&);
+
+        /// Receive all statistics sent to this process and complete all sends, so that none are left pending at
+        /// MPI_Finalize.  Must be called by all processes; gives up after a timeout, and never throws.
+        void finalise();
+
+    };
+  #endif
+
   /// Class for collecting pointers to all the likelihood components, then running and combining them.
   class Likelihood_Container : public Scanner::Function_Base<double (std::unordered_map<std::string, double> &)>
   {
@@ -58,11 +107,38 @@ namespace Gambit
       /// Map of scanned model names to primary model functors
       std::map<str, primary_model_functor *> functorMap;
 
+      /// Pre-bound destination of one entry of the dense physical parameter vector
+      struct bound_parameter
+      {
+        str name;
+        unsigned int index;
+        double* slot;
+      };
+
+      /// Dense parameter layout, grouped by scanned model (resolved once by compileParameterLayout)
+      std::vector<std::pair<str, std::vector<bound_parameter> > > dense_layout;
+
+      /// Flag indicating that the parameters of the current point were already set via the dense path
+      bool parameters_preset;
+
       /// MPI communicator group for errors
       #ifdef WITH_MPI
         GMPI::Comm& errorComm;
       #endif
 
+      /// Number of points between re-optimisations of the evaluation order of the target vertices (0 = never)
+      int reorder_interval;
+
+      /// Number of points evaluated since the evaluation order was last optimised
+      int points_since_reorder;
+
+      #ifdef WITH_MPI
+        /// Exchange of functor statistics with other MPI processes (NULL if they are not shared)
+        Functor_Stats_Exchange* stats_exchange;
+        /// Latest functor statistics received from each MPI process (runtimes followed by invalidation rates)
+        std::vector<std::vector<double> > remote_stats;
+      #endif
+
       /// Primary value of the log likelihood at which a point is considered so unlikely that it can be ruled out (invalid).
       double min_valid_lnlike;
 
@@ -72,6 +148,13 @@ namespace Gambit
       /// Active value for the minimum log likelihood (one of the above two values, whichever is currently in-use)
       double active_min_valid_lnlike;
 
+      /// Number of threads used to calculate independent functors concurrently (1 = serial evaluation)
+      int obslike_threads;
+
+      /// Parallel execution plans for the target and auxiliary vertices (only used if obslike_threads > 1)
+      DRes::ParallelPlan target_plan;
+      DRes::ParallelPlan aux_plan;
+
       /// Map of return types of target functors
       std::map<DRes::VertexID,str> return_types;
 
@@ -93,6 +176,12 @@ namespace Gambit
       /// Run in likelihood debug mode?
       bool debug;
 
+      /// Pass the parameter values of the current point on to exceptions and debug output
+      void announceParameters (const str &);
+
+      /// Re-optimise the evaluation order of the target and auxiliary vertices using the latest functor statistics
+      void reorderVertices();
+
     public:
 
       /// Constructor
@@ -100,13 +189,19 @@ namespace Gambit
        DRes::DependencyResolver &dependencyResolver, IniParser::IniFile &iniFile,
        const str &purpose, Printers::BaseBasePrinter& printer
        #ifdef WITH_MPI
-       , GMPI::Comm& comm
+       , GMPI::Comm& comm, Functor_Stats_Exchange* stats_exchange
        #endif
       );
 
       /// Do the prior transformation and populate the parameter map
       void setParameters (const std::unordered_map<std::string, double> &);
 
+      /// Bind each entry of the dense physical parameter vector to its ModelParameters slot
+      bool compileParameterLayout (const std::vector<str> &);
+
+      /// Set the parameters of the next point directly from the dense physical parameter vector
+      void setParameters (const std::vector<double> &);
+
       /// Evaluate total likelihood function
       double main (std::unordered_map<std::string, double> &in);
 
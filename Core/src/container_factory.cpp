@@ -42,6 +42,13 @@ namespace Gambit
     , myComm(comm)
     #endif
   {
+    #ifdef WITH_MPI
+      if (iniFile.getValueOrDef<bool>(false, "likelihood", "reorder_share_stats") and comm.Get_size() > 1)
+      {
+        stats_exchange = std::make_shared<Functor_Stats_Exchange>(comm);
+      }
+    #endif
+
     functorMap = core.getActiveModelFunctors();
     std::set<std::string> modelSet = iniFile.getModelNames();
     
@@ -87,8 +94,15 @@ namespace Gambit
   {
     return __scanner_factories__["GAMBIT_Scanner_Target_Function"](functorMap, dependencyResolver, iniFile, purpose, printer
       #ifdef WITH_MPI
-       , myComm
+       , myComm, stats_exchange.get()
       #endif
       );
   }
+
+  void Likelihood_Container_Factory::finalise()
+  {
+    #ifdef WITH_MPI
+      if (stats_exchange) stats_exchange->finalise();
+    #endif
+  }
 }
@@ -41,6 +41,8 @@
 #include <sstream>
 #include <fstream>
 #include <iomanip>
+#include <exception>
+#include <omp.h>
 #ifdef HAVE_REGEX_H
   #include <regex>
 #endif
@@ -236,12 +238,12 @@ namespace Gambit
     bool use_regex;
 
     // Return runtime estimate for a set of nodes
-    double getTimeEstimate(const std::set<VertexID> & vertexList, const DRes::MasterGraphType &graph)
+    double getTimeEstimate(const std::set<VertexID> & vertexList, const std::vector<double> &runtimes)
     {
       double result = 0;
       for (std::set<VertexID>::iterator it = vertexList.begin(); it != vertexList.end(); ++it)
       {
-        result += graph[*it]->getRuntimeAverage();
+        result += runtimes[*it];
       }
       return result;
     }
@@ -404,6 +406,27 @@ namespace Gambit
         SortedParentVertices[*it] = getSortedParentVertices(*it, masterGraph, function_order);
       }
 
+      // Compile these lists into flat execution plans, so that nothing needs to be looked up per point.
+      log_runtime = boundIniFile->getValueOrDef<bool>(false, "dependency_resolution", "log_runtime");
+      for (auto it = SortedParentVertices.begin(); it != SortedParentVertices.end(); ++it)
+      {
+        std::vector<ObsLikeStep>& plan = ObsLikePlans[it->first];
+        plan.reserve(it->second.size());
+        for (auto jt = it->second.begin(); jt != it->second.end(); ++jt)
+        {
+          ObsLikeStep step = {masterGraph[*jt], not typeComp(masterGraph[*jt]->type(), "void", *boundTEs, false)};
+          plan.push_back(step);
+        }
+      }
+
+      // The options of the active functors are now final, so freeze them; module functions
+      // can then look them up at every point without re-reading the YAML.
+      graph_traits<DRes::MasterGraphType>::vertex_iterator vi, vi_end;
+      for (boost::tie(vi, vi_end) = vertices(masterGraph); vi != vi_end; ++vi)
+      {
+        if (masterGraph[*vi]->status() == 2) masterGraph[*vi]->freezeOptions();
+      }
+
       // Done
     }
 
@@ -574,6 +597,27 @@ namespace Gambit
 
     // Returns list of ObsLike vertices in order of runtime
     std::vector<VertexID> DependencyResolver::getObsLikeOrder()
+    {
+      std::vector<double> runtimes, invalidation_rates;
+      getFunctorStatistics(runtimes, invalidation_rates);
+      return getObsLikeOrder(runtimes, invalidation_rates);
+    }
+
+    /// Collect the current runtime and invalidation rate estimates of all functors, indexed by VertexID.
+    void DependencyResolver::getFunctorStatistics(std::vector<double>& runtimes, std::vector<double>& invalidation_rates)
+    {
+      runtimes.assign(num_vertices(masterGraph), 0.0);
+      invalidation_rates.assign(num_vertices(masterGraph), 0.0);
+      graph_traits<DRes::MasterGraphType>::vertex_iterator vi, vi_end;
+      for (boost::tie(vi, vi_end) = vertices(masterGraph); vi != vi_end; ++vi)
+      {
+        runtimes[*vi] = masterGraph[*vi]->getRuntimeAverage();
+        invalidation_rates[*vi] = masterGraph[*vi]->getInvalidationRate();
+      }
+    }
+
+    /// Order the target vertices using supplied runtime and invalidation rate estimates (indexed by VertexID).
+    std::vector<VertexID> DependencyResolver::getObsLikeOrder(const std::vector<double>& runtimes, const std::vector<double>& invalidation_rates)
     {
       std::vector<VertexID> unsorted;
       std::vector<VertexID> sorted;
@@ -601,8 +645,9 @@ namespace Gambit
           {
             parents.erase(*cit);
           }
-          t2p_now = (double) getTimeEstimate(parents, masterGraph);
-          t2p_now /= masterGraph[*it]->getInvalidationRate();
+          t2p_now = (double) getTimeEstimate(parents, runtimes);
+          // Floor the invalidation rate, so that a rate of zero doesn't give an infinite ratio
+          t2p_now /= std::max(invalidation_rates[*it], FUNCTORS_BASE_INVALIDATION_RATE);
           if (t2p_min < 0 or t2p_now < t2p_min)
           {
             t2p_min = t2p_now;
@@ -612,7 +657,7 @@ namespace Gambit
         }
         // Extent list of calculated vertices
         colleages.insert(colleages_min.begin(), colleages_min.end());
-        double prop = masterGraph[*it_min]->getInvalidationRate();
+        double prop = std::max(invalidation_rates[*it_min], FUNCTORS_BASE_INVALIDATION_RATE);
         logger() << LogTags::dependency_resolver << "Estimated T [s]: " << t2p_min*prop << EOM;
         logger() << LogTags::dependency_resolver << "Estimated p: " << prop << EOM;
         sorted.push_back(*it_min);
@@ -627,26 +672,28 @@ namespace Gambit
       // pointID is supplied by the scanner, and is used to tell the printer which model
       // point the results should be associated with.
 
-      if (SortedParentVertices.find(vertex) == SortedParentVertices.end())
+      auto plan = ObsLikePlans.find(vertex);
+      if (plan == ObsLikePlans.end())
         core_error().raise(LOCAL_INFO, "Tried to calculate a function not in or not at top of dependency graph.");
-      std::vector<VertexID> order = SortedParentVertices.at(vertex);
 
-      for (std::vector<VertexID>::iterator it = order.begin(); it != order.end(); ++it)
+      for (auto it = plan->second.begin(), end = plan->second.end(); it != end; ++it)
       {
-        std::ostringstream ss;
-        ss << "Calling " << masterGraph[*it]->name() << " from " << masterGraph[*it]->origin() << "...";
-        logger() << LogTags::dependency_resolver << LogTags::info << LogTags::debug << ss.str() << EOM;
-        masterGraph[*it]->calculate();
-        if (boundIniFile->getValueOrDef<bool>(
-              false, "dependency_resolution", "log_runtime") )
+        functor* f = it->f;
+        if (logger().logging_debug_messages())
+        {
+          logger() << LogTags::dependency_resolver << LogTags::info << LogTags::debug
+                   << "Calling " << f->name() << " from " << f->origin() << "..." << EOM;
+        }
+        f->calculate();
+        if (log_runtime)
         {
-          double T = masterGraph[*it]->getRuntimeAverage();
+          double T = f->getRuntimeAverage();
           logger() << LogTags::dependency_resolver << LogTags::info <<
             "Runtime, averaged over multiple calls [s]: " << T << EOM;
         }
-        invalid_point_exception* e = masterGraph[*it]->retrieve_invalid_point_exception();
+        invalid_point_exception* e = f->retrieve_invalid_point_exception();
         if (e != NULL) throw(*e);
-        if (not typeComp(masterGraph[*it]->type(),  "void", *boundTEs, false))
+        if (it->print)
         {
           // Note that this prints from thread index 0 only, i.e. results created by
           // threads other than the main one need to be accessed with
@@ -655,13 +702,186 @@ namespace Gambit
           // At the moment GAMBIT only prints results of thread 0, under the expectation
           // that nested module functions are all designed to gather their results into
           // thread 0.
-          masterGraph[*it]->print(boundPrinter,pointID);
+          f->print(boundPrinter,pointID);
         }
       }
       // Reset the cout output precision, in case any backends have messed with it during the ObsLike evaluation.
       cout << std::setprecision(boundCore->get_outprec());
     }
 
+    /// Build a plan for concurrently calculating all functors needed by a list of target vertices.
+    ParallelPlan DependencyResolver::getParallelPlan(const std::vector<VertexID>& targets)
+    {
+      // Collect the functors needed by all targets, in serial evaluation order.
+      std::vector<VertexID> needed;
+      std::set<VertexID> seen;
+      for (auto it = targets.begin(); it != targets.end(); ++it)
+      {
+        if (SortedParentVertices.find(*it) == SortedParentVertices.end())
+          core_error().raise(LOCAL_INFO, "Tried to plan a function not in or not at top of dependency graph.");
+        const std::vector<VertexID>& order = SortedParentVertices.at(*it);
+        for (auto jt = order.begin(); jt != order.end(); ++jt)
+        {
+          if (seen.insert(*jt).second) needed.push_back(*jt);
+        }
+      }
+
+      // Assign each functor to the wave after the latest of its parents.  The serial order is
+      // topological, so parents are always assigned before their children.
+      std::map<VertexID, unsigned int> wave_of;
+      unsigned int nwaves = 0;
+      for (auto it = needed.begin(); it != needed.end(); ++it)
+      {
+        unsigned int wave = 0;
+        graph_traits<DRes::MasterGraphType>::in_edge_iterator jt, jend;
+        for (boost::tie(jt, jend) = in_edges(*it, masterGraph); jt != jend; ++jt)
+        {
+          auto parent = wave_of.find(source(*jt, masterGraph));
+          if (parent != wave_of.end()) wave = std::max(wave, parent->second + 1);
+        }
+        wave_of[*it] = wave;
+        nwaves = std::max(nwaves, wave + 1);
+      }
+
+      // Fill the waves.  Functors using the same backend (whether or not that backend has an
+      // initialisation function) are put in the same group, so that they never run concurrently.
+      // Loop managers are kept apart, to be run one at a time.
+      ParallelPlan plan(nwaves);
+      std::vector<std::vector<VertexID> > tasks(nwaves);
+      std::vector<std::vector<std::set<str> > > backends(nwaves);
+      for (auto it = needed.begin(); it != needed.end(); ++it)
+      {
+        unsigned int wave = wave_of.at(*it);
+        plan[wave].members.push_back(*it);
+        // Nested functors are calculated by their loop managers.
+        if (masterGraph[*it]->loopManagerCapability() != "none") continue;
+        if (masterGraph[*it]->canBeLoopManager())
+        {
+          plan[wave].loop_managers.push_back(*it);
+          continue;
+        }
+        std::set<str> be;
+        if (masterGraph[*it]->origin() == "BackendIniBit") be.insert(masterGraph[*it]->name());
+        auto used = resolvedBackends.find(*it);
+        if (used != resolvedBackends.end()) be.insert(used->second.begin(), used->second.end());
+        tasks[wave].push_back(*it);
+        backends[wave].push_back(be);
+      }
+
+      for (unsigned int wave = 0; wave < nwaves; ++wave)
+      {
+        // Union-find over the tasks of this wave, joining tasks that share a backend.
+        std::vector<unsigned int> root(tasks[wave].size());
+        for (unsigned int i = 0; i < root.size(); ++i) root[i] = i;
+        std::map<str, unsigned int> first_user;
+        for (unsigned int i = 0; i < root.size(); ++i)
+        {
+          for (auto jt = backends[wave][i].begin(); jt != backends[wave][i].end(); ++jt)
+          {
+            auto user = first_user.find(*jt);
+            if (user == first_user.end()) { first_user[*jt] = i; continue; }
+            unsigned int a = i, b = user->second;
+            while (root[a] != a) a = root[a];
+            while (root[b] != b) b = root[b];
+            root[std::max(a,b)] = std::min(a,b);
+          }
+        }
+        // Emit the groups, each in serial evaluation order.
+        std::map<unsigned int, unsigned int> group_of_root;
+        for (unsigned int i = 0; i < root.size(); ++i)
+        {
+          unsigned int r = i;
+          while (root[r] != r) r = root[r];
+          if (group_of_root.find(r) == group_of_root.end())
+          {
+            group_of_root[r] = plan[wave].groups.size();
+            plan[wave].groups.push_back(std::vector<VertexID>());
+          }
+          plan[wave].groups[group_of_root.at(r)].push_back(tasks[wave][i]);
+        }
+      }
+
+      logger() << LogTags::dependency_resolver << LogTags::info << "Parallel plan for " << targets.size()
+               << " target(s): " << needed.size() << " functors in " << plan.size() << " waves." << EOM;
+      return plan;
+    }
+
+    /// Calculate the functors in a parallel plan using up to the given number of threads.
+    /// Results are not printed here; the subsequent calls to calcObsLike do that, and rethrow any
+    /// invalid point exceptions in the usual serial order.  If stop_on_invalid is set, no further
+    /// waves are started once a functor has invalidated the point; otherwise only the functors that
+    /// depend on an invalidated one are skipped.
+    void DependencyResolver::calcParallelPlan(const ParallelPlan& plan, int nthreads, bool stop_on_invalid)
+    {
+      std::vector<char> failed(num_vertices(masterGraph), false);
+      std::exception_ptr error;
+
+      for (auto wave = plan.begin(); wave != plan.end(); ++wave)
+      {
+        const int ngroups = wave->groups.size();
+        std::vector<char> skipped(num_vertices(masterGraph), false);
+
+        // Calculate one vertex, unless one of its parents has failed.
+        auto calc_vertex = [&](VertexID v)
+        {
+          graph_traits<DRes::MasterGraphType>::in_edge_iterator jt, jend;
+          for (boost::tie(jt, jend) = in_edges(v, masterGraph); jt != jend; ++jt)
+          {
+            if (failed[source(*jt, masterGraph)])
+            {
+              skipped[v] = true;
+              return;
+            }
+          }
+          try
+          {
+            masterGraph[v]->calculate();
+          }
+          catch (invalid_point_exception&)
+          {
+            // Already recorded by the functor; picked up after the wave.
+            logger().leaving_module();
+          }
+          catch (...)
+          {
+            #pragma omp critical (DependencyResolver_calcParallelPlan)
+            {
+              if (not error) error = std::current_exception();
+            }
+          }
+        };
+
+        // Module code must see the functor-level threads as running serially.
+        Utils::set_omp_module_base_level(1);
+        #pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+        for (int i = 0; i < ngroups; ++i)
+        {
+          const std::vector<VertexID>& group = wave->groups[i];
+          for (auto it = group.begin(); it != group.end(); ++it) calc_vertex(*it);
+        }
+        Utils::set_omp_module_base_level(0);
+
+        // Loop managers run on this thread only, so that they can open their own parallel regions.
+        for (auto it = wave->loop_managers.begin(); it != wave->loop_managers.end() and not error; ++it) calc_vertex(*it);
+
+        if (error) std::rethrow_exception(error);
+
+        bool any_failed = false;
+        for (auto it = wave->members.begin(); it != wave->members.end(); ++it)
+        {
+          if (skipped[*it] or masterGraph[*it]->retrieve_invalid_point_exception() != NULL)
+          {
+            failed[*it] = true;
+            any_failed = true;
+          }
+        }
+        if (any_failed and stop_on_invalid) break;
+      }
+
+      // Reset the cout output precision, in case any backends have messed with it.
+      cout << std::setprecision(boundCore->get_outprec());
+    }
+
     /// Getter for print_timing flag (used by LikelihoodContainer)
     bool DependencyResolver::printTiming() { return print_timing; }
 
@@ -2042,6 +2262,7 @@ namespace Gambit
     void DependencyResolver::resolveRequirement(functor* func, VertexID vertex)
     {
       (*masterGraph[vertex]).resolveBackendReq(func);
+      resolvedBackends[vertex].insert(func->origin() + "_" + func->safe_version() + "_init");
       logger() << LogTags::dependency_resolver;
       logger() << "Resolved by: [" << func->name() << ", ";
       logger() << func->origin() << " (" << func->version() << ")]";
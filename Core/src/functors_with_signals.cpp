@@ -78,7 +78,7 @@ namespace Gambit
          if(functor.iCanManageLoops and not signaldata().inside_multithreaded_region())
          {
             /* Debugging */
-            if(omp_get_level()!=0)
+            if(Utils::omp_module_level()!=0)
             {
               std::cerr << "rank " << signaldata().myrank() <<": Tried to set signaldata().inside_omp_block=1 (in "<<functor.myName<<"), but we are already in a parellel region! Please file a bug report." << std::endl;
               exit(EXIT_FAILURE);
@@ -94,7 +94,7 @@ namespace Gambit
          if(functor.iCanManageLoops and not functor.signal_mode_locked)
          {
             /* Debugging */
-            if(omp_get_level()!=0)
+            if(Utils::omp_module_level()!=0)
             {
               std::cerr << "rank " << signaldata().myrank() <<": Tried to set signaldata().inside_omp_block=0 (in "<<functor.myName<<"), but we are still inside a parellel region! Please file a bug report." << std::endl;
               exit(EXIT_FAILURE);
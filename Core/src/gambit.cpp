@@ -191,6 +191,8 @@ int main(int argc, char* argv[])
         if (rank == 0) std::cerr << "Starting scan." << std::endl;
         scan.Run(); // Note: the likelihood container will unblock signals when it is safe to receive them.
         logger().enable(); // Turn logs back on (in case they were disabled for speed)
+        // Complete any communication between the likelihood containers of different processes before MPI is shut down.
+        factory.finalise();
         // Check why we have exited the scanner; scan may have been terminated early by a signal.
         // We assume here that because the scanner has exited that it has already down whatever
         // cleanup it requires, including finalising the printers, i.e. the 'do_cleanup()' function will NOT run.
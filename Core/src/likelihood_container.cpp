@@ -24,6 +24,9 @@
 ///
 ///  *********************************************
 
+#include <chrono>
+#include <thread>
+
 #include "gambit/Core/likelihood_container.hpp"
 #include "gambit/Utils/mpiwrapper.hpp"
 #include "gambit/Utils/signal_helpers.hpp"
@@ -41,18 +44,25 @@ namespace Gambit
    DRes::DependencyResolver &dependencyResolver, IniParser::IniFile &iniFile,
    const str &purpose, Printers::BaseBasePrinter& printer
   #ifdef WITH_MPI
-    , GMPI::Comm& comm
+    , GMPI::Comm& comm, Functor_Stats_Exchange* stats_exchange
   #endif
   )
   : dependencyResolver (dependencyResolver),
     printer            (printer),
     functorMap         (functorMap),
+    parameters_preset  (false),
     #ifdef WITH_MPI
       errorComm        (comm),
     #endif
+    reorder_interval   (iniFile.getValueOrDef<int>(0, "likelihood", "reorder_interval")),
+    points_since_reorder (0),
+    #ifdef WITH_MPI
+      stats_exchange   (stats_exchange),
+    #endif
     min_valid_lnlike        (iniFile.getValue<double>("likelihood", "model_invalid_for_lnlike_below")),
     alt_min_valid_lnlike    (iniFile.getValueOrDef<double>(0.5*min_valid_lnlike, "likelihood", "model_invalid_for_lnlike_below_alt")),
     active_min_valid_lnlike (min_valid_lnlike), // can be switched to the alternate value by the scanner
+    obslike_threads         (iniFile.getValueOrDef<int>(1, "likelihood", "obslike_threads")),
     intralooptime_label     ("Runtime(ms) intraloop"),
     interlooptime_label     ("Runtime(ms) interloop"),
     totallooptime_label     ("Runtime(ms) totalloop"),
@@ -84,6 +94,203 @@ namespace Gambit
         aux_vertices.push_back(std::move(*it));
       }
     }
+    // Plan the concurrent evaluation of independent branches of the dependency graph, if requested.
+    // Functors sharing a backend are never run at the same time.  Note that nested OpenMP parallelism
+    // is usually disabled, so module functions that use OpenMP internally run single-threaded here.
+    if (obslike_threads > 1)
+    {
+      target_plan = dependencyResolver.getParallelPlan(target_vertices);
+      aux_plan = dependencyResolver.getParallelPlan(aux_vertices);
+      logger() << LogTags::core << "Calculating independent functors on up to " << obslike_threads << " threads." << EOM;
+    }
+  }
+
+  #ifdef WITH_MPI
+
+    // Methods for Functor_Stats_Exchange class.
+
+    /// Constructor
+    Functor_Stats_Exchange::Functor_Stats_Exchange(GMPI::Comm& comm)
+    : comm       (comm),
+      n_sent     (comm.Get_size(), 0),
+      n_received (comm.Get_size(), 0)
+    {}
+
+    /// Destructor
+    Functor_Stats_Exchange::~Functor_Stats_Exchange()
+    {
+      if (not GMPI::Is_finalized()) abandon();
+    }
+
+    /// Free any requests that have not completed, keeping their buffers until the program exits
+    void Functor_Stats_Exchange::abandon()
+    {
+      bool pending = false;
+      for (auto it = requests.begin(); it != requests.end(); ++it)
+      {
+        if (*it == MPI_REQUEST_NULL) continue;
+        MPI_Request_free(&(*it));
+        pending = true;
+      }
+      // MPI may read from the send buffers of freed requests until MPI_Finalize, so they are moved into storage
+      // that is only destroyed when the program exits.
+      if (pending)
+      {
+        static std::vector<std::vector<double> > abandoned_stats;
+        static std::vector<std::vector<int> > abandoned_counts;
+        abandoned_stats.push_back(std::move(sent_stats));
+        abandoned_counts.push_back(std::move(n_sent));
+      }
+      requests.clear();
+    }
+
+    /// Send statistics to all other processes, unless the previous send has not completed yet
+    void Functor_Stats_Exchange::send(const std::vector<double>& stats)
+    {
+      int done = 1;
+      if (not requests.empty()) MPI_Testall(requests.size(), &requests[0], &done, MPI_STATUSES_IGNORE);
+      if (not done) return;
+      sent_stats = stats;
+      requests.assign(comm.Get_size(), MPI_REQUEST_NULL);
+      for (int i = 0; i < comm.Get_size(); ++i)
+      {
+        if (i == comm.Get_rank()) continue;
+        comm.Isend(&sent_stats[0], sent_stats.size(), i, STATS_TAG, &requests[i]);
+        ++n_sent[i];
+      }
+    }
+
+    /// Receive the statistics that have arrived so far, keeping the latest from each process
+    void Functor_Stats_Exchange::receive(std::vector<std::vector<double> >& latest)
+    {
+      latest.resize(comm.Get_size());
+      MPI_Status status;
+      while (comm.Iprobe(MPI_ANY_SOURCE, STATS_TAG, &status))
+      {
+        std::vector<double>& buffer = latest[status.MPI_SOURCE];
+        buffer.resize(GMPI::Get_count<double>(&status));
+        comm.Recv(&buffer[0], buffer.size(), status.MPI_SOURCE, STATS_TAG);
+        ++n_received[status.MPI_SOURCE];
+      }
+    }
+
+    /// Receive all statistics sent to this process and complete all sends, so that none are left pending at MPI_Finalize.
+    /// Sends can't reliably be cancelled, so each process tells the others how many statistics messages it sent them,
+    /// then keeps receiving until it has all the messages it was told about and its own sends have completed.
+    void Functor_Stats_Exchange::finalise()
+    {
+      try
+      {
+        const int size = comm.Get_size();
+        const int rank = comm.Get_rank();
+        std::vector<int> n_expected(size, -1);
+        n_expected[rank] = 0;
+        requests.resize(2*size, MPI_REQUEST_NULL);
+        for (int i = 0; i < size; ++i)
+        {
+          if (i != rank) comm.Isend(&n_sent[i], 1, i, COUNT_TAG, &requests[size+i]);
+        }
+
+        // Other processes may still be busy with their last point, so give them a while to get here
+        const std::chrono::seconds timeout(60);
+        const auto start = std::chrono::steady_clock::now();
+        MPI_Status status;
+        std::vector<double> buffer;
+        while (true)
+        {
+          while (comm.Iprobe(MPI_ANY_SOURCE, STATS_TAG, &status))
+          {
+            buffer.resize(GMPI::Get_count<double>(&status));
+            comm.Recv(buffer.data(), buffer.size(), status.MPI_SOURCE, STATS_TAG);
+            ++n_received[status.MPI_SOURCE];
+          }
+          while (comm.Iprobe(MPI_ANY_SOURCE, COUNT_TAG, &status))
+          {
+            comm.Recv(&n_expected[status.MPI_SOURCE], 1, status.MPI_SOURCE, COUNT_TAG);
+          }
+          int sent;
+          MPI_Testall(requests.size(), &requests[0], &sent, MPI_STATUSES_IGNORE);
+          if (sent and n_received == n_expected)
+          {
+            requests.clear();
+            return;
+          }
+          if (std::chrono::steady_clock::now() - start > timeout) break;
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        logger() << LogTags::core << LogTags::warn << "rank " << rank << ": timed out waiting for other processes to finish "
+                 << "exchanging functor statistics; abandoning the outstanding messages." << EOM;
+      }
+      catch (const std::exception& e)
+      {
+        logger() << LogTags::core << LogTags::warn << "Failed to finish exchanging functor statistics; abandoning the "
+                 << "outstanding messages.  Error: " << e.what() << EOM;
+      }
+      abandon();
+    }
+
+  #endif
+
+  /// Re-optimise the evaluation order of the target and auxiliary vertices using the latest functor statistics
+  void Likelihood_Container::reorderVertices()
+  {
+    std::vector<double> runtimes, invalidation_rates;
+    dependencyResolver.getFunctorStatistics(runtimes, invalidation_rates);
+
+    #ifdef WITH_MPI
+      // Exchange statistics with the other processes without ever blocking: send ours if the previous send
+      // has completed, and average in the latest statistics that have arrived from the others so far.
+      if (stats_exchange != NULL)
+      {
+        const int n = runtimes.size();
+        std::vector<double> stats(runtimes);
+        stats.insert(stats.end(), invalidation_rates.begin(), invalidation_rates.end());
+        stats_exchange->send(stats);
+        stats_exchange->receive(remote_stats);
+
+        int nsources = 1;
+        for (auto it = remote_stats.begin(); it != remote_stats.end(); ++it)
+        {
+          // Skip processes that have sent nothing yet, or statistics for a different dependency graph
+          if (it->size() != std::size_t(2*n)) continue;
+          for (int i = 0; i < n; ++i)
+          {
+            runtimes[i] += (*it)[i];
+            invalidation_rates[i] += (*it)[n+i];
+          }
+          ++nsources;
+        }
+        for (int i = 0; i < n; ++i)
+        {
+          runtimes[i] /= nsources;
+          invalidation_rates[i] /= nsources;
+        }
+      }
+    #endif
+
+    std::vector<DRes::VertexID> new_targets, new_aux;
+    auto all_vertices = dependencyResolver.getObsLikeOrder(runtimes, invalidation_rates);
+    for (auto it = all_vertices.begin(); it != all_vertices.end(); ++it)
+    {
+      if (return_types.find(*it) != return_types.end()) new_targets.push_back(*it);
+      else new_aux.push_back(*it);
+    }
+
+    if (new_targets != target_vertices or new_aux != aux_vertices)
+    {
+      std::ostringstream ss;
+      ss << "Re-optimised evaluation order of likelihood components:" << endl;
+      for (auto it = new_targets.begin(); it != new_targets.end(); ++it)
+      {
+        functor* f = dependencyResolver.get_functor(*it);
+        ss << "  " << f->origin() << "::" << f->name() << " (runtime " << runtimes[*it]
+           << " s, invalidation rate " << invalidation_rates[*it] << ")" << endl;
+      }
+      logger() << LogTags::core << ss.str() << EOM;
+      if (debug) cout << ss.str();
+      target_vertices = new_targets;
+      aux_vertices = new_aux;
+    }
   }
 
   /// Do the prior transformation and populate the parameter map
@@ -122,8 +329,67 @@ namespace Gambit
       }
     }
 
+    announceParameters(parstream.str());
+  }
+
+  /// Bind each entry of the dense physical parameter vector to its ModelParameters slot
+  bool Likelihood_Container::compileParameterLayout(const std::vector<str> &layout)
+  {
+    std::unordered_map<str, unsigned int> index;
+    for (unsigned int i = 0; i < layout.size(); ++i) index[layout[i]] = i;
+
+    dense_layout.clear();
+    for (auto act_it = functorMap.begin(), act_end = functorMap.end(); act_it != act_end; act_it++)
+    {
+      ModelParameters* contents = act_it->second->getcontentsPtr();
+      std::vector<bound_parameter> bound;
+      auto paramkeys = contents->getKeys();
+      for (auto par_it = paramkeys.begin(), par_end = paramkeys.end(); par_it != par_end; par_it++)
+      {
+        auto idx_it = index.find(act_it->first + "::" + *par_it);
+        // Fall back to the string-keyed path, which reports missing parameters properly.
+        if (idx_it == index.end())
+        {
+          dense_layout.clear();
+          logger() << LogTags::core << "Parameter " << act_it->first << "::" << *par_it << " not provided by the prior; "
+                   << "using string-keyed parameter setting." << EOM;
+          return false;
+        }
+        bound_parameter par = {*par_it, idx_it->second, contents->getValuePtr(*par_it)};
+        bound.push_back(par);
+      }
+      dense_layout.push_back(std::make_pair(act_it->first, bound));
+    }
+
+    logger() << LogTags::core << "Compiled dense parameter layout with " << layout.size() << " entries." << EOM;
+    return true;
+  }
+
+  /// Set the parameters of the next point directly from the dense physical parameter vector
+  void Likelihood_Container::setParameters (const std::vector<double> &phys)
+  {
+    // Set up a stream containing the parameter values, for diagnostic output
+    std::ostringstream parstream;
+
+    for (auto mod_it = dense_layout.begin(), mod_end = dense_layout.end(); mod_it != mod_end; ++mod_it)
+    {
+      parstream << "  " << mod_it->first << ":" << endl;
+      for (auto par_it = mod_it->second.begin(), par_end = mod_it->second.end(); par_it != par_end; ++par_it)
+      {
+        *(par_it->slot) = phys[par_it->index];
+        parstream << "    " << par_it->name << ": " << *(par_it->slot) << endl;
+      }
+    }
+
+    announceParameters(parstream.str());
+    parameters_preset = true;
+  }
+
+  /// Pass the parameter values of the current point on to exceptions and debug output
+  void Likelihood_Container::announceParameters (const str &parstring)
+  {
     // Notify all exceptions of the values of the parameters for this point.
-    exception::set_parameters("\n\nYAML-ready parameter values at failed point:\n"+parstream.str());
+    exception::set_parameters("\n\nYAML-ready parameter values at failed point:\n"+parstring);
 
     // Print out the MPI rank and values of the parameters for this point if in debug mode.
     if (debug)
@@ -132,8 +398,8 @@ namespace Gambit
         GMPI::Comm COMM_WORLD;
         std::cout << "MPI process rank: "<< COMM_WORLD.Get_rank() << std::endl;
       #endif
-      cout << parstream.str();
-      logger() << LogTags::core << "\nBeginning computations for parameter point:\n" << parstream.str() << EOM;
+      cout << parstring;
+      logger() << LogTags::core << "\nBeginning computations for parameter point:\n" << parstring << EOM;
     }
   }
 
@@ -181,7 +447,9 @@ namespace Gambit
       bool compute_aux = true;
 
       // Set the values of the parameter point in the PrimaryParameters functor, and log them to cout and/or the logs if desired.
-      setParameters(in);
+      // Skipped if the scanner already set them through the dense parameter path.
+      if (parameters_preset) parameters_preset = false;
+      else setParameters(in);
 
       // Logger debug output; things labelled 'LogTags::debug' only get logged if the logger::debug or master debug flags are true, not if only 'likelihood::debug' is true.
       logger() << LogTags::core << LogTags::debug << "Number of target vertices to calculate:    " << target_vertices.size() << endl
@@ -193,6 +461,10 @@ namespace Gambit
       // Compute time since the previous likelihood evaluation ended
       std::chrono::duration<double> interloop_time = startL - previous_endL;
 
+      // If running multithreaded, first calculate the functors needed by all targets concurrently.  The
+      // serial loop below then only collects the results, prints them, and raises any invalidations.
+      if (obslike_threads > 1) dependencyResolver.calcParallelPlan(target_plan, obslike_threads, true);
+
       // First work through the target functors, i.e. the ones contributing to the likelihood.
       for (auto it = target_vertices.begin(), end = target_vertices.end(); it != end; ++it)
       {
@@ -278,6 +550,8 @@ namespace Gambit
       {
         if (debug) logger() << LogTags::core <<  "Completed likelihoods.  Calculating additional observables." << EOM;
 
+        if (obslike_threads > 1) dependencyResolver.calcParallelPlan(aux_plan, obslike_threads, false);
+
         for (auto it = aux_vertices.begin(), end = aux_vertices.end(); it != end; ++it)
         {
           // Log the observables being tried.
@@ -330,6 +604,14 @@ namespace Gambit
     if (debug) cout << "Total log-likelihood: " << lnlike << endl << endl;
     logger() << "Total lnL: " << lnlike << EOM;
     dependencyResolver.resetAll();
+    parameters_preset = false;
+
+    // Periodically re-optimise the evaluation order, now that better functor statistics are available.
+    if (reorder_interval > 0 and ++points_since_reorder >= reorder_interval)
+    {
+      reorderVertices();
+      points_since_reorder = 0;
+    }
 
     if(point_invalidated) printer.disable(); // Disable the printer so that it doesn't try to output the min_valid_lnlike as a valid likelihood value. ScannerBit will re-enable it when needed again.
 
@@ -455,6 +455,7 @@ int main(int argc, char* argv[])
     // Generate histogram for cascade MC
     cascadeMC_Histograms.resolveDependency(&cascadeMC_InitialState);
     cascadeMC_Histograms.resolveDependency(&cascadeMC_GenerateChain);
+    cascadeMC_Histograms.resolveDependency(&cascadeMC_DecayTable);
     cascadeMC_Histograms.resolveDependency(&TH_ProcessCatalog_MSSM);
     cascadeMC_Histograms.resolveDependency(&SimYieldTable_DarkSUSY);
     cascadeMC_Histograms.resolveDependency(&cascadeMC_FinalStates);
@@ -376,6 +376,7 @@ int main()
     // Generate histogram for cascade MC
     cascadeMC_Histograms.resolveDependency(&cascadeMC_InitialState);
     cascadeMC_Histograms.resolveDependency(&cascadeMC_GenerateChain);
+    cascadeMC_Histograms.resolveDependency(&cascadeMC_DecayTable);
     cascadeMC_Histograms.resolveDependency(&TH_ProcessCatalog_SingletDM);
     cascadeMC_Histograms.resolveDependency(&SimYieldTable_DarkSUSY);
     cascadeMC_Histograms.resolveDependency(&cascadeMC_FinalStates);
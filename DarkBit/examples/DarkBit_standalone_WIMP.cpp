@@ -375,6 +375,7 @@ int main(int argc, char* argv[])
     // Generate histogram for cascade MC
     cascadeMC_Histograms.resolveDependency(&cascadeMC_InitialState);
     cascadeMC_Histograms.resolveDependency(&cascadeMC_GenerateChain);
+    cascadeMC_Histograms.resolveDependency(&cascadeMC_DecayTable);
     cascadeMC_Histograms.resolveDependency(&TH_ProcessCatalog_WIMP);
     cascadeMC_Histograms.resolveDependency(SimYieldTablePointer);
     cascadeMC_Histograms.resolveDependency(&cascadeMC_FinalStates);
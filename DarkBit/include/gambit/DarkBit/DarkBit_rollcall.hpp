@@ -279,6 +279,7 @@ START_MODULE
       START_FUNCTION(DarkBit::simpleHistContainter)
       DEPENDENCY(cascadeMC_InitialState, std::string)
       DEPENDENCY(cascadeMC_ChainEvent, DarkBit::DecayChain::ChainContainer)
+      DEPENDENCY(cascadeMC_DecayTable, DarkBit::DecayChain::DecayTable)
       DEPENDENCY(TH_ProcessCatalog, DarkBit::TH_ProcessCatalog)
       DEPENDENCY(SimYieldTable, DarkBit::SimYieldTable)
       DEPENDENCY(cascadeMC_FinalStates,std::vector<std::string>)
@@ -60,6 +60,14 @@ namespace Gambit
         /// Important: Input histogram MUST have identical binning for this to give correct results.
         void addHistAsWeights_sameBin(SimpleHist &in);
 
+        /// Add bin contents and squared weights of input histogram, as if all
+        /// its events had been added to this one.
+        /// Important: Input histogram MUST have identical binning for this to give correct results.
+        void addHist_sameBin(const SimpleHist &in);
+
+        /// Set all bin contents and squared weights to zero
+        void clear();
+
         /// Get error for a specified bin
         double getError(int bin) const;
 
@@ -22,6 +22,7 @@
 #include <unordered_map>
 #include <string>
 #include <set>
+#include <type_traits>
 #include <boost/shared_ptr.hpp>
 #include "gambit/Utils/threadsafe_rng.hpp"
 
@@ -159,6 +160,8 @@ namespace Gambit
                     bool stable;
                     // Flags indicating whether or not the various decay states are endpoints
                     unordered_map<const TH_Channel*, bool> endpointFlags;
+                    // DecayTable indices of the two final state particles of each 2-body decay
+                    unordered_map<const TH_Channel*, std::pair<int,int> > finalStateIndices;
                     // Constructor
                     DecayTableEntry(string pID, double m, bool stable) :
                         m(m), stable(stable), enabledWidth(0),
@@ -214,27 +217,46 @@ namespace Gambit
 
             //  *********************************************
             //  Table of all particles and their decay channels.
-            //  Uses particle PID as array index
+            //  Uses particle PID as array index.
+            //  Every particle is also given an integer index (in order of
+            //  registration), for fast lookup in Monte Carlo loops.
             //  *********************************************
             class DecayTable
             {
                 public:
                     DecayTable(const TH_ProcessCatalog &cat, const SimYieldTable &tab, set<string> disabledList);
                     DecayTable(){};
+                    DecayTable(const DecayTable &other);
+                    DecayTable& operator=(const DecayTable &other);
                     bool hasEntry(string) const;
                     // Add particle to decay table, specifying particle ID, mass and whether or not it should be decayed in decay chains
                     void addEntry(string pID, double m, bool stable);
                     void addEntry(string pID, DecayTableEntry entry);
                     bool randomDecay(string pID, const TH_Channel* &decay) const;
                     const DecayTableEntry& operator[](string i) const;
+                    // Integer index of a particle (-1 if not in the table)
+                    int getIndex(const string &pID) const;
+                    // Number of particles in the table
+                    int size() const {return names.size();}
+                    // Access by integer index (no range checking)
+                    const DecayTableEntry& operator[](int i) const {return *entries[i];}
+                    const string& getName(int i) const {return names[i];}
                     // Retrieve width of decay channel
                     static double getWidth(const TH_Channel *ch);
                     // Print the decay table (to cout)
                     void printTable() const;
                 private:
                     unordered_map<string,DecayTableEntry> table;
+                    // Integer index of each particle, and the reverse lookups
+                    unordered_map<string,int> indices;
+                    vector<string> names;
+                    vector<const DecayTableEntry*> entries;
+                    // Fill in DecayTableEntry::finalStateIndices for all entries
+                    void resolveFinalStates();
             };
 
+            class ChainArena;
+
 
             //  *********************************************
             //  The main decay chain class.
@@ -248,6 +270,8 @@ namespace Gambit
                     const double m;
                     // Constructor for the base node (top particle in the decay chain).
                     ChainParticle(vec3 ipLab, const DecayTable *dc, string pID);
+                    // As above, with the particle given by its DecayTable index.
+                    ChainParticle(vec3 ipLab, const DecayTable *dc, int pIdx);
                     // Iteratively add random links to the decay chain by Monte Carlo to a maximum length of maxSteps or minimum energy of Emin.
                     // Use negative numbers to turn off limits
                     void generateDecayChainMC(int maxSteps, double Emin);
@@ -273,7 +297,9 @@ namespace Gambit
                     // Get energy in parent frame
                     double E_parentFrame() const;
                     // Get particle ID
-                    string getpID() const {return pID;}
+                    const string& getpID() const {return decayTable->getName(pIdx);}
+                    // Get DecayTable index of particle
+                    int getpIdx() const {return pIdx;}
                     // Print the decay chain (to cout)
                     void printChain() const;
                     // Get weight factor (see description of the weight variable)
@@ -285,6 +311,7 @@ namespace Gambit
                     // Destructor
                     ~ChainParticle();
                 private:
+                    friend class ChainArena;
                     // Helper function for printChain()
                     bool printChain(int generation, vector<int> ancestry) const;
                     // How much the decay chain (to this point) should be weighted down due to
@@ -297,8 +324,8 @@ namespace Gambit
                     mat4 boostToLabFrame;
                     // 4-momentum in parent's rest frame
                     vec4 p_parent;
-                    // Particle identifier
-                    string pID;
+                    // Particle identifier (index in decayTable)
+                    int pIdx;
                     // How many ancestors do I have?
                     int chainGeneration;
                     // Has this particle been kept from decaying by an energy or chain length cut?
@@ -309,24 +336,59 @@ namespace Gambit
                     bool isEndpoint;
                     // Number of child particles
                     int nChildren;
-                    // Pointers to parent and child particles
+                    // Pointers to parent and child particles (only 2-body decays are supported)
                     ChainParticle *parent;
-                    vector<ChainParticle*> children;
+                    ChainParticle *children[2];
+                    // Arena that this particle and its children live in (NULL if on the heap)
+                    ChainArena *arena;
                     // Function for updating the Lorentz boost matrices according to a new 4-momentum.
                     void update(vec4 &ip_parent);
+                    // Helper function for collectEndpointStates()
+                    void collectEndpointStates(vector<const ChainParticle*> &endpointStates, bool includeAborted, int ipIdx) const;
                     // Constructor used by member functions during chain generation.
-                    ChainParticle(const vec4 &pp, double m, double weight, const DecayTable *dc, ChainParticle *parent, int chainGeneration, string pID);
+                    ChainParticle(const vec4 &pp, double m, double weight, const DecayTable *dc, ChainParticle *parent, int chainGeneration, int pIdx);
                     // Disable copy constructor and assignment operator. These would cause mayhem.
                     ChainParticle(const ChainParticle&);
                     ChainParticle & operator=(const ChainParticle&);
             };
             typedef std::vector<const Gambit::DarkBit::DecayChain::ChainParticle*> ChainParticleVector;
 
+            //  *********************************************
+            //  Memory pool for the particles of decay chains.
+            //  Particles are constructed in large blocks that are kept
+            //  between events; reset() destroys all particles at once
+            //  but keeps the memory for the next chain.
+            //  Not thread safe: use one arena per thread.
+            //  *********************************************
+            class ChainArena
+            {
+                public:
+                    ChainArena() : used(0) {}
+                    ~ChainArena();
+                    // Construct the base node of a new decay chain in the arena
+                    ChainParticle* newChain(vec3 ipLab, const DecayTable *dc, int pIdx);
+                    // Destroy all particles in the arena
+                    void reset();
+                private:
+                    friend class ChainParticle;
+                    // Get memory for one more particle
+                    void* allocate();
+                    static const size_t blockSize = 64;
+                    typedef std::aligned_storage<sizeof(ChainParticle), alignof(ChainParticle)>::type Slot;
+                    vector<Slot*> blocks;
+                    // Number of particles constructed since the last reset
+                    size_t used;
+                    // Disable copy constructor and assignment operator.
+                    ChainArena(const ChainArena&);
+                    ChainArena & operator=(const ChainArena&);
+            };
+
             // Container for passing around ChainParticle objects.
             struct ChainContainer
             {
                 ChainContainer(){}
                 ChainContainer(shared_ptr<ChainParticle> ch) : chain(ch) {}
+                ChainContainer(shared_ptr<const ChainParticle> ch) : chain(ch) {}
                 shared_ptr<const ChainParticle> chain;
             };
 
@@ -21,6 +21,9 @@
 #include "gambit/Elements/gambit_module_headers.hpp"
 #include "gambit/DarkBit/DarkBit_rollcall.hpp"
 
+#include <limits>
+#include <omp.h>
+
 //#define DARKBIT_DEBUG
 
 namespace Gambit
@@ -202,6 +205,10 @@ namespace Gambit
       using namespace Pipes::cascadeMC_GenerateChain;
       static int    cMC_maxChainLength;
       static double cMC_Emin;
+      // Decay table index of the current initial state
+      static int    initialIdx;
+      // One arena per thread, holding the particles of that thread's current chain
+      static std::vector<shared_ptr<ChainArena> > arenas;
       switch(*Loop::iteration)
       {
         case MC_INIT:
@@ -209,17 +216,33 @@ namespace Gambit
           cMC_maxChainLength = runOptions->getValueOrDef<int>    (-1, "cMC_maxChainLength");
           /// Option cMC_Emin<double>: Cutoff energy for cascade particles (default 0)
           cMC_Emin = runOptions->getValueOrDef<double> (-1, "cMC_Emin");
+          while(int(arenas.size()) < omp_get_max_threads())
+            arenas.push_back(shared_ptr<ChainArena>(new ChainArena()));
           return;
         case MC_NEXT_STATE:
+          initialIdx = Dep::cascadeMC_DecayTable->getIndex(
+              *Dep::cascadeMC_InitialState);
+          return;
         case MC_FINALIZE:
           return;
       }
-      shared_ptr<ChainParticle> chn;
+      // The chain of the previous event on this thread is done with, so its
+      // memory can be reused.
+      const shared_ptr<ChainArena> &arena = arenas[omp_get_thread_num()];
+      arena->reset();
+      shared_ptr<const ChainParticle> chn;
       try
       {
-        chn.reset(new ChainParticle( vec3(0), &(*Dep::cascadeMC_DecayTable),
-                                     *Dep::cascadeMC_InitialState) );
-        chn->generateDecayChainMC(cMC_maxChainLength,cMC_Emin);
+        if(initialIdx < 0)
+        {
+          throw(Piped_exceptions::description(LOCAL_INFO,
+                "No partcile "+*Dep::cascadeMC_InitialState+" in decay table."));
+        }
+        ChainParticle* root = arena->newChain(vec3(0),
+            &(*Dep::cascadeMC_DecayTable), initialIdx);
+        // The chain is owned by the arena; share ownership of that instead
+        chn = shared_ptr<const ChainParticle>(arena, root);
+        root->generateDecayChainMC(cMC_maxChainLength,cMC_Emin);
       }
       catch(Piped_exceptions::description err)
       {
@@ -229,30 +252,61 @@ namespace Gambit
       chain=ChainContainer(chn);
     }
 
+    /// Histograms and lookup tables private to one thread of cascadeMC_Histograms
+    struct cascadeMC_ThreadData
+    {
+      /// Histograms for the current initial state, one per final state
+      std::vector<SimpleHist> hists;
+      /// Scratch histogram for sampling tabulated spectra
+      SimpleHist spectrum;
+      /// Tabulated yields for (particle, particle or none, final state), as
+      /// indexed by cascadeMC_yieldChannel; filled in on first use.
+      std::vector<const SimYieldChannel*> yields;
+      std::vector<char> yieldKnown;
+      /// Endpoints of the current chain
+      std::vector<const DecayChain::ChainParticle*> endpoints;
+      /// Events histogrammed since the last merge into the shared histograms
+      int nEvents;
+    };
+
+    /// Tabulated yield of the given endpoint particle(s) into final state f
+    /// (NULL if there is none).  Particles are given by their decay table index;
+    /// use p2 = -1 for a single particle.
+    const SimYieldChannel* cascadeMC_yieldChannel(cascadeMC_ThreadData &data,
+        const SimYieldTable &table, const DecayChain::DecayTable &decays,
+        const std::vector<std::string> &finalStates, int p1, int p2, int f)
+    {
+      const size_t nParticles = decays.size();
+      const size_t i = ((p1*(nParticles+1)) + (p2+1))*finalStates.size() + f;
+      if(!data.yieldKnown[i])
+      {
+        const std::string &name1 = decays.getName(p1);
+        const std::string name2 = (p2 < 0) ? "" : decays.getName(p2);
+        data.yields[i] = table.hasChannel(name1, name2, finalStates[f]) ?
+          &table.getChannel(name1, name2, finalStates[f]) : NULL;
+        data.yieldKnown[i] = 1;
+      }
+      return data.yields[i];
+    }
+
     /** Function for sampling SimYieldTables (tabulated spectra).
       * This is a convenience function used in cascadeMC_Histograms, and does
       * not have an associated capability.  */
-    void cascadeMC_sampleSimYield( const SimYieldTable &table,
+    void cascadeMC_sampleSimYield(const SimYieldChannel &chn,
         const DarkBit::DecayChain::ChainParticle* endpoint,
-        std::string finalState,
-        const TH_ProcessCatalog &catalog,
-        std::map<std::string, std::map<std::string, SimpleHist> > &histList,
-        std::string initialState,
+        double m, SimpleHist &hist, SimpleHist &spectrum,
         double weight, int cMC_numSpecSamples
         )
     {
 #ifdef DARKBIT_DEBUG
       std::cout << "SampleSimYield" << std::endl;
 #endif
-      std::string p1,p2;
       double gamma,beta;
       double M;
       switch(endpoint->getnChildren())
       {
         case 0:
         {
-          p1 = endpoint->getpID();
-          p2 = "";
           const DarkBit::DecayChain::ChainParticle* parent = endpoint->getParent();
           if(parent == NULL)
           {
@@ -268,8 +322,6 @@ namespace Gambit
         }
         case 2:
         {
-          p1=(*endpoint)[0]->getpID();
-          p2=(*endpoint)[1]->getpID();
           endpoint->getBoost(gamma,beta);
           M = endpoint->m;
           break;
@@ -279,16 +331,14 @@ namespace Gambit
               "cascadeMC_sampleSimYield called with invalid endpoint state.");
           return;
       }
-      const SimYieldChannel &chn = table.getChannel(p1 , p2, finalState);
       // Get Lorentz boost information
 
       const double gammaBeta = gamma*beta;
       // Mass of final state squared
-      const double m = catalog.getParticleProperty(finalState).mass;
       const double msq = m*m;
       // Get histogram edges
       double histEmin, histEmax;
-      histList[initialState][finalState].getEdges(histEmin, histEmax);
+      hist.getEdges(histEmin, histEmax);
 
       // Calculate energies to sample between.  A particle decaying
       // isotropically in its rest frame will give a box spectrum.  This is
@@ -315,9 +365,8 @@ namespace Gambit
         std::cout << "p_lab = " << endpoint->p_Lab() << std::endl;
         std::cout << "Lorentz factors gamma, beta: " << gamma << ", "
           << beta << std::endl;
-        std::cout << "Initial state: " << initialState << std::endl;
-        std::cout << "Channel: " << p1 << " " << p2 << std::endl;
-        std::cout << "Final particles: " << finalState << std::endl;
+        std::cout << "Channel: " << chn.p1 << " " << chn.p2 << std::endl;
+        std::cout << "Final particles: " << chn.finalState << std::endl;
         std::cout << "Event weight: "    << weight << std::endl;
         std::cout << "histEmin/histEmax: " << histEmin << " " << histEmax
           << std::endl;
@@ -329,7 +378,7 @@ namespace Gambit
 
       double specSum=0;
       int Nsampl=0;
-      SimpleHist spectrum(histList[initialState][finalState].binLower);
+      spectrum.clear();
       while(Nsampl<cMC_numSpecSamples)
       {
         // Draw an energy in the CoM frame of the endpoint. Logarithmic
@@ -354,8 +403,7 @@ namespace Gambit
         spectrum.multiply(1.0/Nsampl);
         // Add bin contents of spectrum histogram to main histogram as weighted
         // events
-        #pragma omp critical (cascadeMC_histList)
-          histList[initialState][finalState].addHistAsWeights_sameBin(spectrum);
+        hist.addHistAsWeights_sameBin(spectrum);
       }
     }
 
@@ -376,10 +424,22 @@ namespace Gambit
       static double cMC_binHigh;
       // Histogram list shared between all threads
       static std::map<std::string, std::map<std::string, SimpleHist> > histList;
+      // Shared histograms for the current initial state, one per final state
+      static std::vector<SimpleHist*> currentHists;
+      // Histograms filled by each thread, merged into histList every
+      // cMC_endCheckFrequency events of that thread, and at the end
+      static std::vector<cascadeMC_ThreadData> threadData;
+      // Decay table indices and masses of the final states
+      static std::vector<int>    finalIdx;
+      static std::vector<double> finalMass;
+
+      const std::vector<std::string> &finalStates = *Dep::cascadeMC_FinalStates;
+      const int nFinal = finalStates.size();
 
       switch(*Loop::iteration)
       {
         case MC_INIT:
+        {
           // Initialization
           /// Option cMC_numSpecSamples<int>: number of samples to draw from tabulated
           /// spectra (default 10)
@@ -405,43 +465,94 @@ namespace Gambit
           /// Option cMC_binHigh<double>: Histogram max energy in GeV (default 10000)
           cMC_binHigh = runOptions->getValueOrDef<double>(10000.0,"cMC_binHigh");
           histList.clear();
+          currentHists.clear();
+
+          // Resolve the final states once, rather than by name for every endpoint
+          const DecayTable &decays = *Dep::cascadeMC_DecayTable;
+          finalIdx.resize(nFinal);
+          finalMass.resize(nFinal);
+          for(int f=0; f<nFinal; f++)
+          {
+            finalIdx[f] = decays.getIndex(finalStates[f]);
+            finalMass[f] = Dep::TH_ProcessCatalog->hasParticleProperty(finalStates[f]) ?
+              Dep::TH_ProcessCatalog->getParticleProperty(finalStates[f]).mass :
+              std::numeric_limits<double>::quiet_NaN();
+          }
+
+          // The decay table and yield table change from point to point, so
+          // the lookup tables have to be reset.
+          const SimpleHist empty(cMC_NhistBins,cMC_binLow,cMC_binHigh,true);
+          const size_t nParticles = decays.size();
+          threadData.resize(omp_get_max_threads());
+          for(auto it = threadData.begin(); it != threadData.end(); ++it)
+          {
+            it->hists.assign(nFinal, empty);
+            it->spectrum = empty;
+            it->yields.assign(nParticles*(nParticles+1)*nFinal, NULL);
+            it->yieldKnown.assign(nParticles*(nParticles+1)*nFinal, 0);
+            it->nEvents = 0;
+          }
           return;
+        }
         case MC_NEXT_STATE:
+        case MC_FINALIZE:
+          // Merge what the threads have histogrammed for the previous initial state
+          if(!currentHists.empty())
+          {
+            for(auto it = threadData.begin(); it != threadData.end(); ++it)
+            {
+              for(int f=0; f<nFinal; f++)
+              {
+                currentHists[f]->addHist_sameBin(it->hists[f]);
+                it->hists[f].clear();
+              }
+              it->nEvents = 0;
+            }
+            currentHists.clear();
+          }
+          if(*Loop::iteration == MC_FINALIZE)
+          {
+            // For performance, only return the actual result once finished
+            result = histList;
+            return;
+          }
           // Initialize histograms
-          for(std::vector<std::string>::const_iterator it =
-              Dep::cascadeMC_FinalStates->begin();
-              it!=Dep::cascadeMC_FinalStates->end(); ++it)
+          for(int f=0; f<nFinal; f++)
           {
 #ifdef DARKBIT_DEBUG
             std::cout << "Defining new histList entry!!!" << std::endl;
             std::cout << "for: " << *Dep::cascadeMC_InitialState
-              << " " << *it << std::endl;
+              << " " << finalStates[f] << std::endl;
 #endif
-            histList[*Dep::cascadeMC_InitialState][*it]=
-              SimpleHist(cMC_NhistBins,cMC_binLow,cMC_binHigh,true);
+            SimpleHist &hist = histList[*Dep::cascadeMC_InitialState][finalStates[f]];
+            hist = SimpleHist(cMC_NhistBins,cMC_binLow,cMC_binHigh,true);
+            currentHists.push_back(&hist);
           }
           return;
-        case MC_FINALIZE:
-          // For performance, only return the actual result once finished
-          result = histList;
-          return;
       }
 
+      cascadeMC_ThreadData &data = threadData[omp_get_thread_num()];
+      const DecayTable &decays = *Dep::cascadeMC_DecayTable;
+      const SimYieldTable &yieldTable = *Dep::SimYieldTable;
+
       // Get list of endpoint states for this chain
-      vector<const ChainParticle*> endpoints;
+      std::vector<const ChainParticle*> &endpoints = data.endpoints;
+      endpoints.clear();
       (*Dep::cascadeMC_ChainEvent).chain->
         collectEndpointStates(endpoints, false);
       // Iterate over final states of interest
-      for(std::vector<std::string>::const_iterator pit =
-          Dep::cascadeMC_FinalStates->begin();
-          pit!=Dep::cascadeMC_FinalStates->end(); ++pit)
+      for(int f=0; f<nFinal; f++)
       {
+        SimpleHist &hist = data.hists[f];
+        // Mass of the final state, needed when sampling tabulated spectra
+        double m = finalMass[f];
+        if(m != m) m = Dep::TH_ProcessCatalog->getParticleProperty(finalStates[f]).mass;
         // Iterate over all endpoint states of the decay chain. These can
         // either be final state particles themselves or parents of final state
         // particles.  The reason for not using only final state particles is
         // that certain endpoints (e.g. quark-antiquark pairs) cannot be
         // handled as separate particles.
-        for(vector<const ChainParticle*>::const_iterator it =endpoints.begin();
+        for(std::vector<const ChainParticle*>::const_iterator it =endpoints.begin();
             it != endpoints.end(); it++)
         {
 #ifdef DARKBIT_DEBUG
@@ -457,23 +568,20 @@ namespace Gambit
           if((*it)->getnChildren() ==0)
           {
             weight = (*it)->getWeight();
+            const SimYieldChannel *chn;
             // Check if the final state itself is the particle we are looking
             // for.
-            if((*it)->getpID()==*pit)
+            if((*it)->getpIdx()==finalIdx[f])
             {
-              double E = (*it)->E_Lab();
-#pragma omp critical (cascadeMC_histList)
-              histList[*Dep::cascadeMC_InitialState][*pit].addEvent(E,weight);
+              hist.addEvent((*it)->E_Lab(),weight);
               ignored = false;
             }
             // Check if tabulated spectra exist for this final state
-            else if((*Dep::SimYieldTable).hasChannel( (*it)->getpID(), *pit ))
+            else if((chn = cascadeMC_yieldChannel(data, yieldTable, decays,
+                    finalStates, (*it)->getpIdx(), -1, f)))
             {
-              cascadeMC_sampleSimYield(
-                  *Dep::SimYieldTable, *it, *pit, *Dep::TH_ProcessCatalog,
-                  histList, *Dep::cascadeMC_InitialState, weight,
-                  cMC_numSpecSamples
-                  );
+              cascadeMC_sampleSimYield(*chn, *it, m, hist, data.spectrum,
+                  weight, cMC_numSpecSamples);
               // Check if an error was raised
               ignored = false;
               if(piped_errors.inquire())
@@ -497,15 +605,14 @@ namespace Gambit
                 std::endl;
 #endif
               // Check if tabulated spectra exist for this final state
-              if((*Dep::SimYieldTable).hasChannel(
-                    (*(*it))[0]->getpID() , (*(*it))[1]->getpID(), *pit ))
+              const SimYieldChannel *chn = cascadeMC_yieldChannel(data,
+                  yieldTable, decays, finalStates, (*(*it))[0]->getpIdx(),
+                  (*(*it))[1]->getpIdx(), f);
+              if(chn)
               {
                 hasTabulated = true;
-                cascadeMC_sampleSimYield(*Dep::SimYieldTable, *it, *pit,
-                    *Dep::TH_ProcessCatalog, histList,
-                    *Dep::cascadeMC_InitialState, weight,
-                    cMC_numSpecSamples
-                    );
+                cascadeMC_sampleSimYield(*chn, *it, m, hist, data.spectrum,
+                    weight, cMC_numSpecSamples);
                 // Check if an error was raised
                 ignored = false;
                 if(piped_errors.inquire())
@@ -520,25 +627,20 @@ namespace Gambit
               for(int i=0; i<((*it)->getnChildren()); i++)
               {
                 const ChainParticle* child = (*(*it))[i];
+                const SimYieldChannel *chn;
                 // Check if the child particle is the particle we are looking
                 // for.
-                if(child->getpID()==*pit)
+                if(child->getpIdx()==finalIdx[f])
                 {
-                  double E = child->E_Lab();
-#pragma omp critical (cascadeMC_histList)
-                  histList[
-                    *Dep::cascadeMC_InitialState][*pit].addEvent(E,weight);
+                  hist.addEvent(child->E_Lab(),weight);
                   ignored = false;
                 }
                 // Check if tabulated spectra exist for this final state
-                else if((*Dep::SimYieldTable).hasChannel( child->getpID(),
-                      *pit))
+                else if((chn = cascadeMC_yieldChannel(data, yieldTable, decays,
+                        finalStates, child->getpIdx(), -1, f)))
                 {
-                  cascadeMC_sampleSimYield(*Dep::SimYieldTable, child, *pit,
-                      *Dep::TH_ProcessCatalog, histList,
-                      *Dep::cascadeMC_InitialState, weight,
-                      cMC_numSpecSamples
-                      );
+                  cascadeMC_sampleSimYield(*chn, child, m, hist, data.spectrum,
+                      weight, cMC_numSpecSamples);
                   // Check if an error was raised
                   ignored = false;
                   if(piped_errors.inquire())
@@ -558,21 +660,37 @@ namespace Gambit
           }
         }
       }
+
+      // Merge this thread's histograms into the shared ones every
+      // cMC_endCheckFrequency events (of this thread), and before checking
+      // convergence, so that the check sees (nearly) all events so far.
+      const bool checkEnd = ((*Loop::iteration % cMC_endCheckFrequency) == 0);
+      if(++data.nEvents >= cMC_endCheckFrequency or checkEnd)
+      {
+#pragma omp critical (cascadeMC_histList)
+        {
+          for(int f=0; f<nFinal; f++)
+          {
+            currentHists[f]->addHist_sameBin(data.hists[f]);
+          }
+        }
+        for(int f=0; f<nFinal; f++) data.hists[f].clear();
+        data.nEvents = 0;
+      }
+
       // Check if finished every cMC_endCheckFrequency events
-      if((*Loop::iteration % cMC_endCheckFrequency) == 0)
+      if(checkEnd)
       {
         enum status{untouched,unfinished,finished};
         status cond = untouched;
-        for(std::vector<std::string>::const_iterator it =
-            Dep::cascadeMC_FinalStates->begin();
-            it != Dep::cascadeMC_FinalStates->end(); ++it)
+        for(int f=0; f<nFinal; f++)
         {
           // End conditions currently only implemented for gamma final state
-          if(*it=="gamma")
+          if(finalStates[f]=="gamma")
           {
             SimpleHist hist;
 #pragma omp critical (cascadeMC_histList)
-            hist = histList[*Dep::cascadeMC_InitialState][*it];
+            hist = *currentHists[f];
 #ifdef DARKBIT_DEBUG
             std::cout << "Checking whether convergence is reached" << std::endl;
             for ( int i = 0; i < hist.nBins; i++ )
@@ -141,8 +141,11 @@ namespace Gambit {
      *    gamma: Lorentz boost factor
      *    dNdE: Spectrum
      *    mass: mass of particle
+     *    reuse_partition: start each integration from the subdivision of the
+     *      range found for the previous one (faster, but the result then depends
+     *      slightly on the order in which the spectrum is evaluated)
      */
-    daFunk::Funk boost_dNdE(daFunk::Funk dNdE, double gamma, double mass)
+    daFunk::Funk boost_dNdE(daFunk::Funk dNdE, double gamma, double mass, bool reuse_partition = false)
     {
       if ( gamma < 1.0 + .02 )  // Ignore less than 2% boosts
       {
@@ -159,7 +162,10 @@ namespace Gambit {
       daFunk::Funk halfBox_bound = betaGamma*sqrt(Ep*Ep-mass*mass);
       daFunk::Funk integrand = dNdE/(2*halfBox_int);
       return integrand->gsl_integration("E", Ep*gamma-halfBox_bound, Ep*gamma+halfBox_bound)
-        ->set_epsabs(0)->set_limit(100)->set_epsrel(1e-3)->set_use_log_fallback(true)->set("Ep", daFunk::var("E"));
+        ->set_epsabs(0)->set_limit(100)->set_epsrel(1e-3)->set_use_log_fallback(true)
+        // The spectrum is evaluated on a grid of Ep, and the integrands at
+        // neighbouring points need much the same subdivision of the range.
+        ->set_reuse_partition(reuse_partition)->set("Ep", daFunk::var("E"));
       //
       // Note: integration over lnE causes problems in the WIMP example (3) as the singularity is dropped.
       // return (integrand*E)->set("E", exp(lnE))->gsl_integration("lnE", log(Ep*gamma-halfBox_bound), log(Ep*gamma+halfBox_bound))
@@ -192,6 +198,11 @@ namespace Gambit {
       /// Option line_width<double>: Set relative line width used in gamma-ray spectra (default 0.03)
       double line_width = runOptions->getValueOrDef<double>(0.03,  "line_width");
 
+      /// Option reuse_integration_partitions<bool>: Reuse the subdivision of the integration range
+      /// between neighbouring energies when boosting cascade spectra; faster, but changes the
+      /// yields slightly, depending on evaluation order (default false)
+      bool reuse_partition = runOptions->getValueOrDef<bool>(false, "reuse_integration_partitions");
+
       // Get annihilation process from process catalog
       TH_Process annProc = (*Dep::TH_ProcessCatalog).getProcess(DMid, DMid);
 
@@ -259,7 +270,7 @@ namespace Gambit {
           {
             double gamma0 = E0/m0;
             //std::cout << it->finalStateIDs[0] << " " << gamma0 << std::endl;
-            spec0 = boost_dNdE(Dep::cascadeMC_gammaSpectra->at(it->finalStateIDs[0]), gamma0, 0.0);
+            spec0 = boost_dNdE(Dep::cascadeMC_gammaSpectra->at(it->finalStateIDs[0]), gamma0, 0.0, reuse_partition);
           }
           else added = false;
 
@@ -277,7 +288,7 @@ namespace Gambit {
           {
             double gamma1 = E1/m1;
             //std::cout << it->finalStateIDs[1] << " " << gamma1 << std::endl;
-            spec1 = boost_dNdE(Dep::cascadeMC_gammaSpectra->at(it->finalStateIDs[1]), gamma1, 0.0);
+            spec1 = boost_dNdE(Dep::cascadeMC_gammaSpectra->at(it->finalStateIDs[1]), gamma1, 0.0, reuse_partition);
           }
           else added = false;
 
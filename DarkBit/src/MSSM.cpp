@@ -29,6 +29,7 @@
 #include "gambit/DarkBit/DarkBit_utils.hpp"
 
 #include "gambit/Utils/mpiwrapper.hpp"
+#include "gambit/Utils/memory_file.hpp"
 
 namespace Gambit
 {
@@ -161,14 +162,11 @@ namespace Gambit
               mySLHA.push_back(modsel_block);
           }
 
-          // Set filename
-          std::string fstr = "DarkBit_temp_";
-          fstr += std::to_string(rank) + ".slha";
-
-          // Dump SLHA onto disk
-          std::ofstream ofs(fstr);
-          ofs << mySLHA;
-          ofs.close();
+          // Hand the SLHA over as a file, in memory where possible
+          std::stringstream ss;
+          ss << mySLHA;
+          Utils::MemoryFile slha("DarkBit_temp_" + std::to_string(rank) + ".slha", ss.str());
+          std::string fstr = slha.get_filename();
 
           // Initialize SUSY spectrum from SLHA
           int len = fstr.size();
@@ -160,6 +160,29 @@ namespace Gambit {
       }
     }
 
+    void SimpleHist::addHist_sameBin(const SimpleHist &in)
+    {
+      // Check that the number of bins is equal to avoid segfaults.
+      // It is up to the user to make sure the actual binning is identical.
+      if(in.nBins != nBins)
+      {
+        DarkBit_error().raise(LOCAL_INFO,
+            "SimpleHist::addHist_sameBin requires identically binned\n"
+            "histograms.");
+      }
+      for(int i=0; i<nBins;i++)
+      {
+        binVals[i]+=in.binVals[i];
+        wtSq[i]+=in.wtSq[i];
+      }
+    }
+
+    void SimpleHist::clear()
+    {
+      std::fill(binVals.begin(), binVals.end(), 0.0);
+      std::fill(wtSq.begin(), wtSq.end(), 0.0);
+    }
+
     double SimpleHist::getError(int bin) const
     {
       return sqrt(wtSq[bin]);
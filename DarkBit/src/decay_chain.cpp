@@ -596,22 +596,76 @@ namespace Gambit
             addEntry(*it,m,true);
           }
         }
+        resolveFinalStates();
 #ifdef DARKBIT_DEBUG
         std::cout << "...done" << std::endl;
 #endif
       }
+      DecayTable::DecayTable(const DecayTable &other) :
+        table(other.table), indices(other.indices), names(other.names)
+      {
+        for(vector<string>::const_iterator it = names.begin();
+            it != names.end(); ++it)
+        {
+          entries.push_back(&table.at(*it));
+        }
+      }
+      DecayTable& DecayTable::operator=(const DecayTable &other)
+      {
+        if(this != &other)
+        {
+          table = other.table;
+          indices = other.indices;
+          names = other.names;
+          entries.clear();
+          for(vector<string>::const_iterator it = names.begin();
+              it != names.end(); ++it)
+          {
+            entries.push_back(&table.at(*it));
+          }
+        }
+        return *this;
+      }
+      void DecayTable::resolveFinalStates()
+      {
+        for(unordered_map<string,DecayTableEntry>::iterator it = table.begin();
+            it != table.end(); ++it)
+        {
+          it->second.finalStateIndices.clear();
+          for(vector<const TH_Channel*>::const_iterator
+              it2 = (it->second.enabledDecays).begin();
+              it2 != (it->second.enabledDecays).end(); ++it2)
+          {
+            if((*it2)->nFinalStates != 2) continue;
+            it->second.finalStateIndices[*it2] = std::make_pair(
+                getIndex((*it2)->finalStateIDs[0]),
+                getIndex((*it2)->finalStateIDs[1]));
+          }
+        }
+      }
+      int DecayTable::getIndex(const string &pID) const
+      {
+        unordered_map<string,int>::const_iterator it = indices.find(pID);
+        return (it == indices.end()) ? -1 : it->second;
+      }
       bool DecayTable::hasEntry(string index) const
       {
         return table.find(index) != table.end();
       }
       void DecayTable::addEntry(string pID, double m, bool stable)
       {
-        table.insert (
-            pair<string,DecayTableEntry>(pID,DecayTableEntry(pID,m,stable)) );
+        addEntry(pID,DecayTableEntry(pID,m,stable));
       }
       void DecayTable::addEntry(string pID, DecayTableEntry entry)
       {
-        table.insert ( pair<string,DecayTableEntry>(pID,entry) );
+        pair<unordered_map<string,DecayTableEntry>::iterator,bool> ins =
+          table.insert ( pair<string,DecayTableEntry>(pID,entry) );
+        if(ins.second)
+        {
+          indices[pID] = names.size();
+          names.push_back(pID);
+          entries.push_back(&(ins.first->second));
+        }
       }
       bool DecayTable::randomDecay(string pID, const TH_Channel* &decay) const
       {
@@ -623,7 +677,7 @@ namespace Gambit
         catch (std::out_of_range& e)
         {
           throw(Piped_exceptions::description(LOCAL_INFO,
-                "No partcile "+pID+" in decay table."));
+                "No particle "+pID+" in decay table."));
         }
         return ans;
       }
@@ -637,7 +691,7 @@ namespace Gambit
         catch (std::out_of_range& e)
         {
           throw(Piped_exceptions::description(LOCAL_INFO,
-                "No partcile "+i+" in decay table."));
+                "No particle "+i+" in decay table."));
         }
         return *ent;
       }
@@ -702,9 +756,19 @@ namespace Gambit
 
       ChainParticle::ChainParticle(
           vec3 ipLab, const DecayTable *dc, string pID) :
-        m((*dc)[pID].m), weight(1), decayTable(dc), pID(pID),
+        m((*dc)[pID].m), weight(1), decayTable(dc), pIdx(dc->getIndex(pID)),
         chainGeneration(0), abortedDecay(false), isEndpoint(false),
-        nChildren(0), parent(NULL)
+        nChildren(0), parent(NULL), arena(NULL)
+      {
+        p_parent=Ep4vec(ipLab,m);
+        boostMatrixParentFrame(boostToParentFrame,p_parent,m);
+        boostToLabFrame = boostToParentFrame;
+      }
+      ChainParticle::ChainParticle(
+          vec3 ipLab, const DecayTable *dc, int pIdx) :
+        m((*dc)[pIdx].m), weight(1), decayTable(dc), pIdx(pIdx),
+        chainGeneration(0), abortedDecay(false), isEndpoint(false),
+        nChildren(0), parent(NULL), arena(NULL)
       {
         p_parent=Ep4vec(ipLab,m);
         boostMatrixParentFrame(boostToParentFrame,p_parent,m);
@@ -718,8 +782,9 @@ namespace Gambit
             "Overwriting existing decay in decay chain.");
           cutChain();
         }
+        const DecayTableEntry &entry = (*decayTable)[pIdx];
         // Stable particles flagged as endpoints
-        if((*decayTable)[pID].stable)
+        if(entry.stable)
         {
           isEndpoint = true;
         }
@@ -728,11 +793,11 @@ namespace Gambit
             and ((Emin < 0) or (E_Lab()> Emin)) )
         {
           const TH_Channel *chn;
-          bool canDecay = decayTable->randomDecay(pID, chn);
+          bool canDecay = entry.randomDecay(chn);
           if(!canDecay)
           {
             piped_warnings.request(LOCAL_INFO,
-              "Unable to pick allowed decay for "+ pID+". Keeping particle stable.");
+              "Unable to pick allowed decay for "+ getpID()+". Keeping particle stable.");
             abortedDecay = true;
             return;
           }
@@ -745,16 +810,36 @@ namespace Gambit
             throw(Piped_exceptions::description(LOCAL_INFO,err));
             return;
           }
-          nChildren = 2; // chn->nFinalStates;
+          // Indices of the decay products (resolved when the DecayTable was
+          // set up, or looked up here for hand-made tables)
+          int idx1, idx2;
+          unordered_map<const TH_Channel*, std::pair<int,int> >::const_iterator
+            fs = entry.finalStateIndices.find(chn);
+          if(fs != entry.finalStateIndices.end())
+          {
+            idx1 = fs->second.first;
+            idx2 = fs->second.second;
+          }
+          else
+          {
+            idx1 = decayTable->getIndex((chn->finalStateIDs)[0]);
+            idx2 = decayTable->getIndex((chn->finalStateIDs)[1]);
+          }
+          if(idx1 < 0 or idx2 < 0)
+          {
+            throw(Piped_exceptions::description(LOCAL_INFO,
+                  "No particle "+((idx1 < 0) ? (chn->finalStateIDs)[0] :
+                    (chn->finalStateIDs)[1])+" in decay table."));
+          }
           // Kinematics for 2-body decays
-          double m1 = (*decayTable)[(chn->finalStateIDs)[0]].m;
-          double m2 = (*decayTable)[(chn->finalStateIDs)[1]].m;
+          double m1 = (*decayTable)[idx1].m;
+          double m2 = (*decayTable)[idx2].m;
           if(m1+m2>m)
           {
             ostringstream err;
             err <<
               "Kinematically impossible decay in decay chain:\n" <<
-              pID << "-> " <<
+              getpID() << "-> " <<
               ((chn->finalStateIDs)[0]) << ", " << ((chn->finalStateIDs)[1]) << "\n" <<
               "Please check your process catalog." << endl;
             err << "Relevant particle masses: " << m << " -> " << m1 << " + " << m2;
@@ -769,13 +854,24 @@ namespace Gambit
           vec4 p1(E1, abs_p*dir);
           vec4 p2(E2,-abs_p*dir);
           // Weight from not including all possible decay channels
-          double wt = weight*(*decayTable)[pID].getEnabledBranching();
-          children.push_back(new ChainParticle(p1, m1, wt, decayTable, this,
-                chainGeneration+1, chn->finalStateIDs[0]));
-          children.push_back(new ChainParticle(p2, m2, wt, decayTable, this,
-                chainGeneration+1, chn->finalStateIDs[1]));
+          double wt = weight*entry.getEnabledBranching();
+          if(arena)
+          {
+            children[0] = new (arena->allocate()) ChainParticle(p1, m1, wt,
+                decayTable, this, chainGeneration+1, idx1);
+            children[1] = new (arena->allocate()) ChainParticle(p2, m2, wt,
+                decayTable, this, chainGeneration+1, idx2);
+          }
+          else
+          {
+            children[0] = new ChainParticle(p1, m1, wt, decayTable, this,
+                  chainGeneration+1, idx1);
+            children[1] = new ChainParticle(p2, m2, wt, decayTable, this,
+                  chainGeneration+1, idx2);
+          }
+          nChildren = 2; // chn->nFinalStates;
           // Reached chain endpoint. Don't attempt further decays
-          if((*decayTable)[pID].endpointFlags.at(chn))
+          if(entry.endpointFlags.at(chn))
           {
             isEndpoint = true;
           }
@@ -812,8 +908,8 @@ namespace Gambit
       }
       void ChainParticle::cutChain()
       {
-        for(int i=0;i<nChildren; i++) delete children[i];
-        children.clear();
+        // Particles in an arena are only destroyed when the arena is reset
+        if(!arena) for(int i=0;i<nChildren; i++) delete children[i];
         nChildren = 0;
       }
       vec4 ChainParticle::p_to_Lab(const vec4 &p) const
@@ -837,23 +933,28 @@ namespace Gambit
       }
       void ChainParticle::collectEndpointStates(vector<const ChainParticle*>
           &endpointStates, bool includeAborted, string ipID) const
+      {
+        collectEndpointStates(endpointStates, includeAborted,
+            (ipID=="") ? -1 : decayTable->getIndex(ipID));
+      }
+      void ChainParticle::collectEndpointStates(vector<const ChainParticle*>
+          &endpointStates, bool includeAborted, int ipIdx) const
       {
         if(abortedDecay)
         {
-          if(includeAborted && ((ipID=="") || (ipID==pID)))
+          if(includeAborted && ((ipIdx==-1) || (ipIdx==pIdx)))
             endpointStates.push_back(this);
         }
         else
         {
           if(nChildren!=0 and !isEndpoint)
           {
-            for(vector<ChainParticle*>::const_iterator it=children.begin();
-                it!=children.end(); ++it)
+            for(int i=0;i<nChildren;i++)
             {
-              (*it)->collectEndpointStates(endpointStates,includeAborted,pID);
+              children[i]->collectEndpointStates(endpointStates,includeAborted,pIdx);
             }
           }
-          else if((ipID=="") or (ipID==pID) or isEndpoint)
+          else if((ipIdx==-1) or (ipIdx==pIdx) or isEndpoint)
           {
             endpointStates.push_back(this);
           }
@@ -884,7 +985,7 @@ namespace Gambit
         std::cout << "Decay chain printout:" << endl;
         std::cout << "---------------------" << endl;
         std::cout << "Generation " << chainGeneration << ":" << endl;
-        std::cout << "0  " << pID << ", p = " << p_Lab() <<
+        std::cout << "0  " << getpID() << ", p = " << p_Lab() <<
           ", Weight: " << weight  << endl;
         std::cout << "---------------------" << endl;
         if(nChildren>0)
@@ -928,7 +1029,7 @@ namespace Gambit
         {
           std::cout << *it << "  ";
         }
-        std::cout << pID  << ", p = " << p_Lab() << ", Weight: " << weight  << endl;
+        std::cout << getpID()  << ", p = " << p_Lab() << ", Weight: " << weight  << endl;
         if(nChildren>0) return true;
         return false;
       }
@@ -941,7 +1042,8 @@ namespace Gambit
       }
       ChainParticle::~ChainParticle()
       {
-        for(int i=0;i<nChildren; i++) delete children[i];
+        // Particles in an arena are destroyed by the arena
+        if(!arena) for(int i=0;i<nChildren; i++) delete children[i];
       }
       void ChainParticle::update(vec4 &ip_parent)
       {
@@ -951,15 +1053,50 @@ namespace Gambit
       }
       ChainParticle::ChainParticle(const vec4 &pp, double m, double weight,
           const DecayTable *dc, ChainParticle *parent, int chainGeneration,
-          string pID) :
-        m(m), weight(weight), decayTable(dc), p_parent(pp), pID(pID),
+          int pIdx) :
+        m(m), weight(weight), decayTable(dc), p_parent(pp), pIdx(pIdx),
         chainGeneration(chainGeneration), abortedDecay(false),
-        isEndpoint(false), nChildren(0), parent(parent)
+        isEndpoint(false), nChildren(0), parent(parent), arena(parent->arena)
       {
         boostMatrixParentFrame(boostToParentFrame,p_parent,m);
         boostToLabFrame = parent->boostToLabFrame*boostToParentFrame;
       }
 
+
+      //  *********************************************
+      //  ChainArena functions
+      //  *********************************************
+
+      ChainArena::~ChainArena()
+      {
+        reset();
+        for(vector<Slot*>::iterator it = blocks.begin(); it != blocks.end(); ++it)
+        {
+          delete [] *it;
+        }
+      }
+      ChainParticle* ChainArena::newChain(vec3 ipLab, const DecayTable *dc, int pIdx)
+      {
+        ChainParticle* chn = new (allocate()) ChainParticle(ipLab, dc, pIdx);
+        chn->arena = this;
+        return chn;
+      }
+      void ChainArena::reset()
+      {
+        while(used > 0)
+        {
+          --used;
+          reinterpret_cast<ChainParticle*>(&blocks[used/blockSize][used%blockSize])->~ChainParticle();
+        }
+      }
+      void* ChainArena::allocate()
+      {
+        if(used/blockSize == blocks.size()) blocks.push_back(new Slot[blockSize]);
+        void* slot = &blocks[used/blockSize][used%blockSize];
+        ++used;
+        return slot;
+      }
+
     } // namespace DecayChain
   } // namespace DarkBit
 } // namespace Gambit
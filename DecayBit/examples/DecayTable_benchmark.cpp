@@ -0,0 +1,109 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Benchmark of filling and reading DecayTables.
+///  Reads the DECAY blocks of an SLHA file (by
+///  default a full MSSM decay table), then times
+///   - building the DecayTable from SLHAea,
+///   - refilling it by particle name, channel by
+///     channel, as DecayBit does,
+///   - looking up every branching fraction by
+///     particle name, and
+///   - writing it back out as SLHAea.
+///
+///  Usage: DecayTable_benchmark [slha file] [repeats]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#include <chrono>
+#include <iostream>
+
+#include "gambit/Elements/decay_table.hpp"
+#include "gambit/Elements/slhaea_helpers.hpp"
+
+using namespace Gambit;
+
+/// One decay channel, with the particles given by name
+struct named_channel
+{
+  str mother;
+  std::vector<str> daughters;
+  double BF;
+};
+
+/// Time a function over a number of repeats; returns the time per repeat in microseconds
+template <typename F>
+double time_per_repeat(int repeats, F f)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int n = 0; n < repeats; ++n) f();
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(stop - start).count() / repeats;
+}
+
+/// Fill a decay table entry by name, using the variadic interface for two- and three-body decays
+void set_by_name(DecayTable& table, const named_channel& c)
+{
+  DecayTable::Entry& entry = table(c.mother);
+  if (c.daughters.size() == 2) entry.set_BF(c.BF, 0.0, c.daughters[0], c.daughters[1]);
+  else if (c.daughters.size() == 3) entry.set_BF(c.BF, 0.0, c.daughters[0], c.daughters[1], c.daughters[2]);
+  else entry.set_BF(c.BF, 0.0, c.daughters);
+}
+
+/// Look up a branching fraction by name
+double get_by_name(const DecayTable& table, const named_channel& c)
+{
+  const DecayTable::Entry& entry = table(c.mother);
+  if (c.daughters.size() == 2) return entry.BF(c.daughters[0], c.daughters[1]);
+  if (c.daughters.size() == 3) return entry.BF(c.daughters[0], c.daughters[1], c.daughters[2]);
+  return entry.BF(c.daughters);
+}
+
+int main(int argc, char* argv[])
+{
+  const str filename = (argc > 1 ? argv[1] : "DarkBit/data/benchmarks/stop_coannihilation_gaugino.slha2");
+  const int repeats = (argc > 2 ? std::stoi(argv[2]) : 1000);
+
+  const SLHAstruct slha = read_SLHA(filename);
+  const DecayTable reference(slha);
+
+  // List all channels by name
+  std::vector<named_channel> channels;
+  for (auto particle = reference.particles.begin(); particle != reference.particles.end(); ++particle)
+  {
+    const str mother = Models::ParticleDB().long_name(particle->first);
+    for (auto channel = particle->second.channels.begin(); channel != particle->second.channels.end(); ++channel)
+    {
+      named_channel c = {mother, std::vector<str>(), channel->second.first};
+      for (auto p = channel->first.begin(); p != channel->first.end(); ++p) c.daughters.push_back(Models::ParticleDB().long_name(*p));
+      channels.push_back(c);
+    }
+  }
+  std::cout << filename << ": " << reference.particles.size() << " particles, " << channels.size() << " channels" << std::endl;
+
+  double sum = 0;
+  const double from_slha = time_per_repeat(repeats, [&]{ DecayTable t(slha); sum += t.particles.size(); });
+  const double by_name = time_per_repeat(repeats, [&]
+  {
+    DecayTable t;
+    for (auto c = channels.begin(); c != channels.end(); ++c) set_by_name(t, *c);
+    sum += t.particles.size();
+  });
+  const double lookup = time_per_repeat(repeats, [&]
+  {
+    for (auto c = channels.begin(); c != channels.end(); ++c) sum += get_by_name(reference, *c);
+  });
+  const double to_slha = time_per_repeat(repeats, [&]{ sum += reference.getSLHAea(2).size(); });
+
+  std::cout << "  fill from SLHAea:     " << from_slha << " us per table" << std::endl;
+  std::cout << "  fill by name:         " << by_name << " us per table" << std::endl;
+  std::cout << "  look up all by name:  " << lookup << " us per table" << std::endl;
+  std::cout << "  write to SLHAea:      " << to_slha << " us per table" << std::endl;
+  std::cout << "  (checksum " << sum << ")" << std::endl;
+  return 0;
+}
@@ -86,18 +86,19 @@ namespace Gambit
       }
       result.calculator = "GAMBIT::DecayBit";
       result.calculator_version = gambit_version();
-      result.width_in_GeV = virtual_SMHiggs_widths("Gamma",mh);
-      result.set_BF(virtual_SMHiggs_widths("bb",mh), 0.0, "b", "bbar");
-      result.set_BF(virtual_SMHiggs_widths("tautau",mh), 0.0, "tau+", "tau-");
-      result.set_BF(virtual_SMHiggs_widths("mumu",mh), 0.0, "mu+", "mu-");
-      result.set_BF(virtual_SMHiggs_widths("ss",mh), 0.0, "s", "sbar");
-      result.set_BF(virtual_SMHiggs_widths("cc",mh), 0.0, "c", "cbar");
-      result.set_BF(virtual_SMHiggs_widths("tt",mh), 0.0, "t", "tbar");
-      result.set_BF(virtual_SMHiggs_widths("gg",mh), 0.0, "g", "g");
-      result.set_BF(virtual_SMHiggs_widths("gammagamma",mh), 0.0, "gamma", "gamma");
-      result.set_BF(virtual_SMHiggs_widths("Zgamma",mh), 0.0, "Z0", "gamma");
-      result.set_BF(virtual_SMHiggs_widths("WW",mh), 0.0, "W+", "W-");
-      result.set_BF(virtual_SMHiggs_widths("ZZ",mh), 0.0, "Z0", "Z0");
+      const virtual_SMHiggs_width_table::channel_array w = virtual_SMHiggs_width_table::get().widths(mh);
+      result.width_in_GeV = w[SMHiggsChannel::Gamma];
+      result.set_BF(w[SMHiggsChannel::bb], 0.0, "b", "bbar");
+      result.set_BF(w[SMHiggsChannel::tautau], 0.0, "tau+", "tau-");
+      result.set_BF(w[SMHiggsChannel::mumu], 0.0, "mu+", "mu-");
+      result.set_BF(w[SMHiggsChannel::ss], 0.0, "s", "sbar");
+      result.set_BF(w[SMHiggsChannel::cc], 0.0, "c", "cbar");
+      result.set_BF(w[SMHiggsChannel::tt], 0.0, "t", "tbar");
+      result.set_BF(w[SMHiggsChannel::gg], 0.0, "g", "g");
+      result.set_BF(w[SMHiggsChannel::gammagamma], 0.0, "gamma", "gamma");
+      result.set_BF(w[SMHiggsChannel::Zgamma], 0.0, "Z0", "gamma");
+      result.set_BF(w[SMHiggsChannel::WW], 0.0, "W+", "W-");
+      result.set_BF(w[SMHiggsChannel::ZZ], 0.0, "Z0", "Z0");
     }
 
     /// Set neutral h decays computed by FeynHiggs
@@ -69,6 +69,7 @@
 #include <omp.h>
 #include "gambit/Utils/standalone_error_handlers.hpp"
 #include "gambit/Utils/util_macros.hpp"
+#include "gambit/Utils/util_functions.hpp"
 #endif
 
 #include "boost/shared_ptr.hpp"
@@ -109,12 +110,14 @@ namespace daFunk
 
     class FunkBase;
     class FunkBound;
+    class FunkTape;
     class FunkIntegrate_gsl1d;
 
     typedef shared_ptr<FunkBase> Funk;
     typedef shared_ptr<FunkBound> BoundFunk;
     typedef std::vector<std::string> ArgsType;
     typedef std::map<std::string, std::vector<std::pair<Funk, Funk>>> Singularities;
+    typedef std::map<size_t, size_t> SlotMap;
 
     //template <typename... Args>
     //using PlainPtr = double(*)(Args&...);
@@ -328,6 +331,22 @@ namespace daFunk
             // parallel with the same Funk objects.
             virtual void resolve(std::map<std::string, size_t> datamap, size_t & datalen, size_t bindID, std::map<std::string,size_t> &argmap);
 
+            // Append the evaluation of this function to an instruction tape
+            // (see FunkTape) after resolve(), and return the workspace slot
+            // that holds the result.  subst redirects data entries that were
+            // replaced by enclosing set() calls.  The default instruction just
+            // calls value().
+            virtual size_t compile(FunkTape & tape, size_t bindID, const SlotMap & subst);
+
+            // Can several threads evaluate this function at the same time?  Only
+            // external functions not declared thread-safe (see func and
+            // func_fromThreadsafe), and anything depending on them, can't.
+            virtual bool isThreadsafe()
+            {
+                for ( auto it = functions.begin(); it != functions.end(); ++it )
+                    if ( not (*it)->isThreadsafe() ) return false;
+                return true;
+            }
 
             // Singularities handling
             Singularities getSingl() { return singularities; }
@@ -388,18 +407,263 @@ namespace daFunk
             }
     };
 
+    // Scratch array taken from a per-thread pool, so that repeated evaluations
+    // do not allocate.  Evaluations nested inside each other (e.g. integrands)
+    // simply take further arrays from the pool.
+    class FunkWorkspace
+    {
+        public:
+            FunkWorkspace(size_t n)
+            {
+                std::vector<std::vector<double>> & p = pool();
+                if ( not p.empty() )
+                {
+                    data.swap(p.back());
+                    p.pop_back();
+                }
+                data.resize(n);
+            }
+            ~FunkWorkspace()
+            {
+                pool().push_back(std::vector<double>());
+                pool().back().swap(data);
+            }
+            std::vector<double> data;
+
+        private:
+            static std::vector<std::vector<double>> & pool()
+            {
+                static thread_local std::vector<std::vector<double>> p;
+                return p;
+            }
+    };
+
+    //
+    // Compiled evaluation
+    //
+    // bind() flattens the function tree into a linear list of instructions,
+    // which operate on one workspace array: first the data entries as seen by
+    // value() (bound arguments and internal variables), then one slot for
+    // each intermediate result.  Evaluating the tape involves no virtual
+    // calls, no recursion and no copies of the data array.
+    //
+
+    class FunkTape
+    {
+        public:
+            enum Opcode { CONST, NEG, ADD, SUB, MUL, DIV, UNARY, BINARY, CALL, NODE, JUMP, JUMP_UNLESS_NONNEG, COPY };
+
+            struct Instruction
+            {
+                Opcode op;
+                size_t out, a, b;  // Workspace slots; b is the destination of jumps
+                double c;
+                double (*unary)(double);
+                double (*binary)(double, double);
+                double (*call)(void*, double);
+                void * ptr;  // Context for call, or the FunkBase object for NODE
+                size_t bindID;
+                std::vector<std::pair<size_t, size_t>> subst;  // Substitutions applied before NODE
+            };
+
+            FunkTape(size_t datalen = 0) : datalen(datalen), nslots(datalen), result(0), batchable(true) {}
+
+            // Slot currently holding data entry i
+            static size_t slot(const SlotMap & subst, size_t i)
+            {
+                auto it = subst.find(i);
+                return it == subst.end() ? i : it->second;
+            }
+
+            // Instruction generators; all return the slot of the result
+            size_t constant(double c)
+            {
+                Instruction in = instruction(CONST);
+                in.c = c;
+                return push(in);
+            }
+            size_t op(Opcode op, size_t a, size_t b = 0)
+            {
+                Instruction in = instruction(op);
+                in.a = a;
+                in.b = b;
+                return push(in);
+            }
+            size_t apply(double (*f)(double), size_t a)
+            {
+                Instruction in = instruction(UNARY);
+                in.unary = f;
+                in.a = a;
+                return push(in);
+            }
+            size_t apply(double (*f)(double, double), size_t a, size_t b)
+            {
+                Instruction in = instruction(BINARY);
+                in.binary = f;
+                in.a = a;
+                in.b = b;
+                return push(in);
+            }
+            size_t apply(double (*f)(void*, double), void * ctx, size_t a)
+            {
+                Instruction in = instruction(CALL);
+                in.call = f;
+                in.ptr = ctx;
+                in.a = a;
+                return push(in);
+            }
+            size_t node(FunkBase * f, size_t bindID, const SlotMap & subst)
+            {
+                Instruction in = instruction(NODE);
+                in.ptr = f;
+                in.bindID = bindID;
+                in.subst.assign(subst.begin(), subst.end());
+                batchable = false;
+                return push(in);
+            }
+
+            // Branching; jumps return their position, to be passed to land()
+            // once the destination has been generated
+            size_t newSlot() { return nslots++; }
+            void copy(size_t out, size_t a)
+            {
+                Instruction in = instruction(COPY);
+                in.a = a;
+                in.out = out;
+                code.push_back(in);
+            }
+            size_t jump(size_t a = 0, Opcode op = JUMP)
+            {
+                Instruction in = instruction(op);
+                in.a = a;
+                code.push_back(in);
+                batchable = false;
+                return code.size() - 1;
+            }
+            size_t jumpUnlessNonNeg(size_t a) { return jump(a, JUMP_UNLESS_NONNEG); }
+            void land(size_t jumpIndex) { code[jumpIndex].b = code.size(); }
+
+            void setResult(size_t r) { result = r; }
+            size_t getResult() const { return result; }
+            size_t getDatalen() const { return datalen; }
+            size_t size() const { return nslots; }
+            // True if there are no branches or calls to value(), so that
+            // many points can be run through each instruction in turn
+            bool isBatchable() const { return batchable; }
+
+            // Run on a workspace of at least size() entries, with the data entries filled
+            inline double run(std::vector<double> & ws) const;
+            // Run n points at once; ws[s*n+i] holds slot s for point i
+            inline void run(std::vector<double> & ws, size_t n) const;
+
+        private:
+            Instruction instruction(Opcode op)
+            {
+                Instruction in;
+                in.op = op;
+                in.out = in.a = in.b = 0;
+                in.c = 0;
+                in.unary = NULL;
+                in.binary = NULL;
+                in.call = NULL;
+                in.ptr = NULL;
+                in.bindID = 0;
+                return in;
+            }
+            size_t push(Instruction & in)
+            {
+                in.out = nslots++;
+                code.push_back(in);
+                return in.out;
+            }
+            inline double node_value(const Instruction & in, const std::vector<double> & ws) const;
+
+            std::vector<Instruction> code;
+            size_t datalen;  // Number of data entries at the start of the workspace
+            size_t nslots;   // Total size of the workspace
+            size_t result;
+            bool batchable;
+    };
+
+    inline double FunkTape::node_value(const Instruction & in, const std::vector<double> & ws) const
+    {
+        FunkBase * f = static_cast<FunkBase*>(in.ptr);
+        if ( in.subst.empty() ) return f->value(ws, in.bindID);
+        // Present the node with the data array that value() would have seen
+        FunkWorkspace data(ws.size());
+        std::copy(ws.begin(), ws.end(), data.data.begin());
+        for ( auto it = in.subst.begin(); it != in.subst.end(); ++it )
+            data.data[it->first] = ws[it->second];
+        return f->value(data.data, in.bindID);
+    }
+
+    inline double FunkTape::run(std::vector<double> & ws) const
+    {
+        double * w = &ws[0];
+        for ( size_t pc = 0; pc < code.size(); ++pc )
+        {
+            const Instruction & in = code[pc];
+            switch ( in.op )
+            {
+                case CONST: w[in.out] = in.c; break;
+                case NEG: w[in.out] = -w[in.a]; break;
+                case ADD: w[in.out] = w[in.a] + w[in.b]; break;
+                case SUB: w[in.out] = w[in.a] - w[in.b]; break;
+                case MUL: w[in.out] = w[in.a] * w[in.b]; break;
+                case DIV: w[in.out] = w[in.a] / w[in.b]; break;
+                case UNARY: w[in.out] = in.unary(w[in.a]); break;
+                case BINARY: w[in.out] = in.binary(w[in.a], w[in.b]); break;
+                case CALL: w[in.out] = in.call(in.ptr, w[in.a]); break;
+                case NODE: w[in.out] = node_value(in, ws); break;
+                case JUMP: pc = in.b - 1; break;
+                case JUMP_UNLESS_NONNEG: if ( not (w[in.a] >= 0.) ) pc = in.b - 1; break;
+                case COPY: w[in.out] = w[in.a]; break;
+            }
+        }
+        return w[result];
+    }
+
+    inline void FunkTape::run(std::vector<double> & ws, size_t n) const
+    {
+        assert ( batchable );
+        double * w = &ws[0];
+        for ( auto in = code.begin(); in != code.end(); ++in )
+        {
+            double * out = w + in->out*n;
+            const double * a = w + in->a*n;
+            const double * b = w + in->b*n;
+            switch ( in->op )
+            {
+                case CONST: for ( size_t i = 0; i < n; ++i ) out[i] = in->c; break;
+                case NEG: for ( size_t i = 0; i < n; ++i ) out[i] = -a[i]; break;
+                case ADD: for ( size_t i = 0; i < n; ++i ) out[i] = a[i] + b[i]; break;
+                case SUB: for ( size_t i = 0; i < n; ++i ) out[i] = a[i] - b[i]; break;
+                case MUL: for ( size_t i = 0; i < n; ++i ) out[i] = a[i] * b[i]; break;
+                case DIV: for ( size_t i = 0; i < n; ++i ) out[i] = a[i] / b[i]; break;
+                case UNARY: for ( size_t i = 0; i < n; ++i ) out[i] = in->unary(a[i]); break;
+                case BINARY: for ( size_t i = 0; i < n; ++i ) out[i] = in->binary(a[i], b[i]); break;
+                case CALL: for ( size_t i = 0; i < n; ++i ) out[i] = in->call(in->ptr, a[i]); break;
+                case COPY: for ( size_t i = 0; i < n; ++i ) out[i] = a[i]; break;
+                default: break;  // Not batchable
+            }
+        }
+    }
+
     class FunkBound
     {
         public:
-            FunkBound(Funk f, size_t datalen, size_t bindID) : f(f), datalen(datalen), bindID(bindID) {};
+            FunkBound(Funk f, size_t datalen, size_t bindID) : f(f), datalen(datalen), bindID(bindID), tape(datalen)
+            {
+                tape.setResult(f->compile(tape, bindID, SlotMap()));
+            };
             ~FunkBound() {bindID_manager(bindID,false);};
             double value(std::vector<double> & map, size_t bindID) {(void)bindID; (void)map; return 0;};
 
             template <typename... Args> inline double eval(Args... argss)
             {
-                auto data = vec<double>(argss...);
-                data.resize(datalen);
-                return f->value(data, bindID);
+                FunkWorkspace ws(tape.size());
+                set_data(ws.data, 0, argss...);
+                return tape.run(ws.data);
             }
 
             template <typename... Args> inline std::vector<double> vect(Args... argss)
@@ -462,18 +726,31 @@ namespace daFunk
                     }
                 }
                 auto r = vec<double>();
-                auto data = vec<double>();
-                data.resize(datalen);
+                size_t nargs = std::min(coll.size(), datalen);
+                if ( tape.isBatchable() )
+                {
+                    // All points through each instruction in turn
+                    FunkWorkspace data(tape.size()*size);
+                    std::fill(data.data.begin(), data.data.begin() + datalen*size, 0.);
+                    for ( size_t j = 0; j != nargs; ++j )
+                        for ( size_t i = 0; i != size; ++i )
+                            data.data[j*size+i] = vec_flag[j] ? coll[j][i] : coll[j][0];
+                    tape.run(data.data, size);
+                    r.assign(data.data.begin() + tape.getResult()*size, data.data.begin() + (tape.getResult()+1)*size);
+                    return r;
+                }
+                FunkWorkspace data(tape.size());
+                std::fill(data.data.begin(), data.data.begin() + datalen, 0.);
                 for ( size_t i = 0; i != size; ++i )
                 {
-                    for ( size_t j = 0; j != coll.size(); ++j )
+                    for ( size_t j = 0; j != nargs; ++j )
                     {
                         if ( vec_flag[j] )
-                            data[j] = coll[j][i];
+                            data.data[j] = coll[j][i];
                         else
-                            data[j] = coll[j][0];
+                            data.data[j] = coll[j][0];
                     }
-                    r.push_back(f->value(data, bindID));
+                    r.push_back(tape.run(data.data));
                 }
                 return r;
             }
@@ -490,17 +767,32 @@ namespace daFunk
                 return this->vect2(coll, argss...);
             }
 
+            // Fill the data entries of the workspace with the arguments of
+            // eval(), and zero any remaining ones
+            template <typename... Args> inline void set_data(std::vector<double> & data, size_t i, double x, Args... argss)
+            {
+                if ( i < datalen ) data[i] = x;
+                set_data(data, i+1, argss...);
+            }
+            inline void set_data(std::vector<double> & data, size_t i)
+            {
+                for ( ; i < datalen; ++i ) data[i] = 0.;
+            }
+
             Funk f;  // bound function
 
             // datalen is the length of the double-valued data array that is
-            // needed as workspace for function evaluation, and that is created
-            // on the heap for each eval separately to ensure thread-safety.
+            // needed as workspace for function evaluation, and that is taken
+            // from a per-thread pool for each eval to ensure thread-safety.
             size_t datalen;
 
             // bindID has the purpose of allowing bound functions (instances of
             // FunkBase and daughter classes) to be bound by various binding
             // functions simultaneously.
             size_t bindID;
+
+            // Compiled form of f for this bindID
+            FunkTape tape;
     };
 
 
@@ -594,6 +886,13 @@ namespace daFunk
                 return c;
             }
 
+            size_t compile(FunkTape & tape, size_t bindID, const SlotMap & subst)
+            {
+                (void)bindID;
+                (void)subst;
+                return tape.constant(c);
+            }
+
         private:
             double c;
     };
@@ -670,6 +969,14 @@ namespace daFunk
                 return functions[0]->value(data2, bindID);
             }
 
+            // Rather than copying the data, f reads the result of g where it would read my_arg
+            size_t compile(FunkTape & tape, size_t bindID, const SlotMap & subst)
+            {
+                SlotMap subst2(subst);
+                subst2[my_index[bindID]] = functions[1]->compile(tape, bindID, subst);
+                return functions[0]->compile(tape, bindID, subst2);
+            }
+
         private:
             std::string my_arg;
 
@@ -735,6 +1042,8 @@ namespace daFunk
                 return (*ptr)(std::get<Args>(my_input)...);
             }
 
+            bool isThreadsafe() { return threadsafe and FunkBase::isThreadsafe(); }
+
         private:
             std::tuple<typename std::remove_reference<funcargs>::type...> input;
             std::vector<double*> map;
@@ -825,6 +1134,8 @@ namespace daFunk
                 return (*obj.*ptr)(std::get<Args>(my_input)...);
             }
 
+            bool isThreadsafe() { return threadsafe and FunkBase::isThreadsafe(); }
+
         private:
             std::tuple<typename std::remove_reference<funcargs>::type...> input;
             std::vector<double*> map;
@@ -894,6 +1205,17 @@ namespace daFunk
                 return exp(-pow(x-pos,2)/pow(width,2)/2)/sqrt(2*M_PI)/width;
             }
 
+            static double call(void * ptr, double x)
+            {
+                FunkDelta * f = static_cast<FunkDelta*>(ptr);
+                return exp(-pow(x-f->pos,2)/pow(f->width,2)/2)/sqrt(2*M_PI)/f->width;
+            }
+
+            size_t compile(FunkTape & tape, size_t bindID, const SlotMap & subst)
+            {
+                return tape.apply(&FunkDelta::call, this, FunkTape::slot(subst, indices[bindID][0]));
+            }
+
         private:
             double pos, width;
     };
@@ -915,6 +1237,12 @@ namespace daFunk
             {
                 return data[indices[bindID][0]];
             }
+
+            size_t compile(FunkTape & tape, size_t bindID, const SlotMap & subst)
+            {
+                (void)tape;
+                return FunkTape::slot(subst, indices[bindID][0]);
+            }
     };
     inline Funk var(std::string arg) { return Funk(new FunkVar(arg)); }
 
@@ -984,6 +1312,11 @@ namespace daFunk
 
     }
 
+    inline size_t FunkBase::compile(FunkTape & tape, size_t bindID, const SlotMap & subst)
+    {
+        return tape.node(this, bindID, subst);
+    }
+
     template <typename... Args> inline bool FunkBase::assert_args(Args... args)
     {
         std::vector<std::vector<std::string>> list = vec<std::vector<std::string>>(args...);
@@ -1147,6 +1480,10 @@ namespace daFunk
             {
                 return -(functions[0]->value(data, bindID));
             }
+            size_t compile(FunkTape & tape, size_t bindID, const SlotMap & subst)
+            {
+                return tape.op(FunkTape::NEG, functions[0]->compile(tape, bindID, subst));
+            }
     };
     inline Funk operator - (Funk f) { return Funk(new FunkMath_umin(f)); }
 
@@ -1165,6 +1502,11 @@ namespace daFunk
             {                                                                                             \
                 return OPERATION(functions[0]->value(data, bindID));                                      \
             }                                                                                             \
+            static double op(double x) { return OPERATION(x); }                                           \
+            size_t compile(FunkTape & tape, size_t bindID, const SlotMap & subst)                         \
+            {                                                                                             \
+                return tape.apply(&op, functions[0]->compile(tape, bindID, subst));                       \
+            }                                                                                             \
     };                                                                                                    \
     inline Funk OPERATION (Funk f) { return Funk(new FunkMath_##OPERATION(f)); }
     MATH_OPERATION(cos)
@@ -1187,7 +1529,7 @@ namespace daFunk
 #undef MATH_OPERATION
 
     // Standard binary operations
-#define MATH_OPERATION(OPERATION, SYMBOL)                                                                 \
+#define MATH_OPERATION(OPERATION, SYMBOL, OPCODE)                                                         \
     class FunkMath_##OPERATION: public FunkBase                                                           \
     {                                                                                                     \
         public:                                                                                           \
@@ -1215,14 +1557,20 @@ namespace daFunk
             {                                                                                             \
                 return functions[0]->value(data, bindID) SYMBOL functions[1]->value(data, bindID);        \
             }                                                                                             \
+            size_t compile(FunkTape & tape, size_t bindID, const SlotMap & subst)                         \
+            {                                                                                             \
+                size_t a = functions[0]->compile(tape, bindID, subst);                                    \
+                size_t b = functions[1]->compile(tape, bindID, subst);                                    \
+                return tape.op(FunkTape::OPCODE, a, b);                                                   \
+            }                                                                                             \
     };                                                                                                    \
     inline Funk operator SYMBOL (Funk f1, Funk f2) { return Funk(new FunkMath_##OPERATION(f1, f2)); }     \
     inline Funk operator SYMBOL (double x, Funk f) { return Funk(new FunkMath_##OPERATION(x, f)); }       \
     inline Funk operator SYMBOL (Funk f, double x) { return Funk(new FunkMath_##OPERATION(f, x)); }
-    MATH_OPERATION(Sum,+)
-    MATH_OPERATION(Mul,*)
-    MATH_OPERATION(Div,/)
-    MATH_OPERATION(Dif,-)
+    MATH_OPERATION(Sum,+,ADD)
+    MATH_OPERATION(Mul,*,MUL)
+    MATH_OPERATION(Div,/,DIV)
+    MATH_OPERATION(Dif,-,SUB)
 #undef MATH_OPERATION
 
     // More binary operations
@@ -1254,6 +1602,13 @@ namespace daFunk
             {                                                                                             \
                 return OPERATION(functions[0]->value(data, bindID), functions[1]->value(data, bindID));   \
             }                                                                                             \
+            static double op(double x, double y) { return OPERATION(x, y); }                              \
+            size_t compile(FunkTape & tape, size_t bindID, const SlotMap & subst)                         \
+            {                                                                                             \
+                size_t a = functions[0]->compile(tape, bindID, subst);                                    \
+                size_t b = functions[1]->compile(tape, bindID, subst);                                    \
+                return tape.apply(&op, a, b);                                                             \
+            }                                                                                             \
     };                                                                                                    \
     inline Funk OPERATION (Funk f1, Funk f2) { return Funk(new FunkMath_##OPERATION(f1, f2)); }           \
     inline Funk OPERATION (double x, Funk f) { return Funk(new FunkMath_##OPERATION(x, f)); }             \
@@ -1300,6 +1655,37 @@ namespace daFunk
                 return (this->*ptr)(data[indices[bindID][0]]);
             }
 
+            static double call(void * ptr, double x)
+            {
+                FunkInterp * f = static_cast<FunkInterp*>(ptr);
+                return (f->*(f->ptr))(x);
+            }
+
+            size_t compile(FunkTape & tape, size_t bindID, const SlotMap & subst)
+            {
+                functions[0]->compile(tape, bindID, subst);
+                return tape.apply(&FunkInterp::call, this, FunkTape::slot(subst, indices[bindID][0]));
+            }
+
+            // Interpolate directly at many x values (zero outside of the grid).
+            // For increasing x values the grid is walked rather than searched.
+            std::vector<double> interpolate(const std::vector<double> & x)
+            {
+                std::vector<double> y(x.size(), 0.);
+                size_t imax = Xgrid.size() - 1;
+                size_t i = 0;
+                for (size_t j = 0; j < x.size(); j++)
+                {
+                    if (x[j]<Xgrid[0] or x[j]>Xgrid[imax]) continue;
+                    if (spacing != UNSORTED and i > 0 and Xgrid[i-1] <= x[j])
+                        while (i < imax and Xgrid[i] <= x[j]) i++;
+                    else
+                        i = findBin(x[j]);
+                    y[j] = logMode ? logBin(i, x[j]) : linearBin(i, x[j]);
+                }
+                return y;
+            }
+
         private:
             void setup(Funk f, std::vector<double> & Xgrid, std::vector<double> & Ygrid, std::string mode)
             {
@@ -1309,40 +1695,116 @@ namespace daFunk
                 arguments = f->getArgs();
                 this->Xgrid = Xgrid;
                 this->Ygrid = Ygrid;
+                this->mode = mode;
+                logMode = ( mode == "log" );
                 if ( mode == "lin" ) this->ptr = &FunkInterp::linearInterp;
                 else if ( mode == "log" ) this->ptr = &FunkInterp::logInterp;
+
+                // Differences (or log ratios) between neighbouring grid points, computed
+                // exactly as in the interpolation formulae so that results do not change
+                size_t n = Xgrid.size();
+                Xdiff.resize(n > 0 ? n-1 : 0);
+                Ydiff.resize(n > 0 ? n-1 : 0);
+                for (size_t i = 0; i+1 < n; i++)
+                {
+                    Xdiff[i] = logMode ? std::log(Xgrid[i+1]/Xgrid[i]) : Xgrid[i+1]-Xgrid[i];
+                    Ydiff[i] = logMode ? std::log(Ygrid[i+1]/Ygrid[i]) : Ygrid[i+1]-Ygrid[i];
+                }
+
+                // Detect (log-)uniform grids, where the bin can be computed directly
+                spacing = UNSORTED;
+                if ( n < 2 or not std::is_sorted(Xgrid.begin(), Xgrid.end()) ) return;
+                spacing = IRREGULAR;
+                if ( n < 3 ) return;
+                if ( isUniform(Xgrid, false) ) spacing = UNIFORM;
+                else if ( Xgrid[0] > 0 and isUniform(Xgrid, true) ) spacing = LOGUNIFORM;
+            }
+
+            // Check for equal steps in x (or log x), to well within a step
+            bool isUniform(const std::vector<double> & X, bool inLog)
+            {
+                size_t n = X.size();
+                double x0 = inLog ? std::log(X[0]) : X[0];
+                double step = ((inLog ? std::log(X[n-1]) : X[n-1]) - x0) / (n-1);
+                if ( not (step > 0) ) return false;
+                for (size_t i = 1; i < n; i++)
+                    if ( std::abs((inLog ? std::log(X[i]) : X[i]) - x0 - i*step) > 1e-3*step ) return false;
+                gridStart = x0;
+                gridInvStep = 1./step;
+                return true;
             }
 
-            double logInterp(double x)
+            // Index of the first grid point above x (or the last grid point),
+            // for Xgrid[0] <= x <= Xgrid.back()
+            size_t findBin(double x)
+            {
+                size_t imax = Xgrid.size() - 1;
+                switch (spacing)
+                {
+                    case UNIFORM:
+                    case LOGUNIFORM:
+                    {
+                        // Estimate from the spacing, then correct for rounding
+                        double guess = ((spacing == UNIFORM ? x : std::log(x)) - gridStart) * gridInvStep + 1;
+                        // A NaN guess can't be cast to an index; search for it like on an irregular grid
+                        if ( std::isnan(guess) )
+                            return std::upper_bound(Xgrid.begin(), Xgrid.begin() + imax, x) - Xgrid.begin();
+                        size_t i = guess < 1 ? 1 : guess > imax ? imax : (size_t)guess;
+                        while (i < imax and Xgrid[i] <= x) i++;
+                        while (i > 1 and Xgrid[i-1] > x) i--;
+                        return i;
+                    }
+                    case IRREGULAR:
+                        return std::upper_bound(Xgrid.begin(), Xgrid.begin() + imax, x) - Xgrid.begin();
+                    default:
+                    {
+                        size_t i = 0;
+                        for (; i < imax; i++) {if (Xgrid[i] > x) break;};
+                        return i;
+                    }
+                }
+            }
+
+            double logBin(size_t i, double x)
             {
                 // Linear interpolation in log-log space
-                int i = 0; int imax = Xgrid.size() - 1;
-                if (x<Xgrid[0] or x>Xgrid[imax]) return 0;
-                for (; i < imax; i++) {if (Xgrid[i] > x) break;};
                 double x0 = Xgrid[i-1];
-                double x1 = Xgrid[i];
                 double y0 = Ygrid[i-1];
-                double y1 = Ygrid[i];
-                return y0 * std::exp(std::log(y1/y0) * std::log(x/x0) / std::log(x1/x0));
+                return y0 * std::exp(Ydiff[i-1] * std::log(x/x0) / Xdiff[i-1]);
             }
 
-            double linearInterp(double x)
+            double linearBin(size_t i, double x)
             {
                 // Linear interpolation in lin-lin space
-                int i = 0; int imax = Xgrid.size() - 1;
-                if (x<Xgrid[0] or x>Xgrid[imax]) return 0;
-                for (; i < imax; i++) {if (Xgrid[i] > x) break;};
                 double x0 = Xgrid[i-1];
-                double x1 = Xgrid[i];
                 double y0 = Ygrid[i-1];
-                double y1 = Ygrid[i];
-                return y0 + (x-x0)/(x1-x0)*(y1-y0);
+                return y0 + (x-x0)/Xdiff[i-1]*Ydiff[i-1];
+            }
+
+            double logInterp(double x)
+            {
+                if (x<Xgrid[0] or x>Xgrid[Xgrid.size()-1]) return 0;
+                return logBin(findBin(x), x);
             }
 
+            double linearInterp(double x)
+            {
+                if (x<Xgrid[0] or x>Xgrid[Xgrid.size()-1]) return 0;
+                return linearBin(findBin(x), x);
+            }
+
+            enum Spacing { UNSORTED, IRREGULAR, UNIFORM, LOGUNIFORM };
+
             double(FunkInterp::*ptr)(double);
             std::vector<double> Xgrid;
             std::vector<double> Ygrid;
+            std::vector<double> Xdiff;
+            std::vector<double> Ydiff;
             std::string mode;
+            bool logMode;
+            Spacing spacing;
+            double gridStart;
+            double gridInvStep;
     };
     template <typename T> inline shared_ptr<FunkInterp> interp(T f, std::vector<double> x, std::vector<double> y) { return shared_ptr<FunkInterp>(new FunkInterp(f, x, y)); }
 
@@ -1367,6 +1829,17 @@ namespace daFunk
               else
                 return functions[2]->value(data,bindID);
             }
+            size_t compile(FunkTape & tape, size_t bindID, const SlotMap & subst)
+            {
+              size_t out = tape.newSlot();
+              size_t toElse = tape.jumpUnlessNonNeg(functions[0]->compile(tape, bindID, subst));
+              tape.copy(out, functions[1]->compile(tape, bindID, subst));
+              size_t toEnd = tape.jump();
+              tape.land(toElse);
+              tape.copy(out, functions[2]->compile(tape, bindID, subst));
+              tape.land(toEnd);
+              return out;
+            }
     };
     inline Funk ifelse(Funk f, Funk g, Funk h) { return Funk(new FunkIfElse(f, g, h)); }
     inline Funk ifelse(Funk f, double g, Funk h) { return Funk(new FunkIfElse(f, cnst(g), h)); }
@@ -1389,7 +1862,7 @@ namespace daFunk
               (void)bindID;
               (void)data;
 #ifdef GAMBIT_DIR
-              if ( omp_get_level() == 0 )  // Outside of OMP blocks
+              if ( Gambit::Utils::omp_module_level() == 0 )  // Outside of OMP blocks
               {
                   Gambit::utils_error().raise(LOCAL_INFO, "daFunk::ThrowError says: " + msg);
               }
@@ -1419,7 +1892,7 @@ namespace daFunk
             {
               (void)bindID;
               (void)data;
-              if ( omp_get_level() == 0 )  // Outside of OMP blocks
+              if ( Gambit::Utils::omp_module_level() == 0 )  // Outside of OMP blocks
               {
                   Gambit::utils_warning().raise(LOCAL_INFO, "daFunk::RaiseInvalidPoint says: " + msg);
                   Gambit::invalid_point().raise("daFunk::RaiseInvalidPoint says: " + msg);
@@ -1470,7 +1943,57 @@ namespace daFunk
     // GSL integration
     //
 
-    class FunkIntegrate_gsl1d: public FunkBase, public gsl_function
+    // Per-thread pool of GSL integration workspaces.  Integrals are often
+    // rebuilt for every parameter point, so instead of each integral owning a
+    // workspace, value() borrows the smallest pooled one that can hold the
+    // requested number of subintervals, and hands it back afterwards.
+    class FunkGslWorkspace
+    {
+        public:
+            FunkGslWorkspace(size_t limit)
+            {
+                std::vector<gsl_integration_workspace*> & p = pool().free;
+                auto best = p.end();
+                for ( auto it = p.begin(); it != p.end(); ++it )
+                {
+                    if ( (*it)->limit >= limit and ( best == p.end() or (*it)->limit < (*best)->limit ) )
+                        best = it;
+                }
+                if ( best != p.end() )
+                {
+                    ws = *best;
+                    p.erase(best);
+                }
+                else
+                    ws = gsl_integration_workspace_alloc(std::max(limit, (size_t)1));
+            }
+            ~FunkGslWorkspace()
+            {
+                if ( ws ) pool().free.push_back(ws);
+            }
+            gsl_integration_workspace * ws;
+
+        private:
+            FunkGslWorkspace(const FunkGslWorkspace &);
+            FunkGslWorkspace & operator=(const FunkGslWorkspace &);
+
+            struct Pool
+            {
+                std::vector<gsl_integration_workspace*> free;
+                ~Pool()
+                {
+                    for ( auto it = free.begin(); it != free.end(); ++it )
+                        gsl_integration_workspace_free(*it);
+                }
+            };
+            static Pool & pool()
+            {
+                static thread_local Pool p;
+                return p;
+            }
+    };
+
+    class FunkIntegrate_gsl1d: public FunkBase
     {
         public:
             FunkIntegrate_gsl1d(Funk f0, std::string arg, Funk f1, Funk f2)
@@ -1553,11 +2076,19 @@ namespace daFunk
                     it->first->resolve(datamap, datalen, bindID, argmap);
                     it->second->resolve(datamap, datalen, bindID, argmap);
                 }
+                // Any integrand tape or partition from a previous use of this bindID is stale
+                if ( integrands.size() > bindID ) integrands[bindID].reset();
+                if ( partitions.size() > bindID ) partitions[bindID].clear();
             }
 
-            ~FunkIntegrate_gsl1d()
+            // The integral itself is evaluated through value(), but the integrand
+            // gets its own tape, run on the data array that value() receives.
+            size_t compile(FunkTape & tape, size_t bindID, const SlotMap & subst)
             {
-                gsl_integration_workspace_free(gsl_workspace);
+                if ( integrands.size() <= bindID ) integrands.resize(bindID+1);
+                integrands[bindID].reset(new FunkTape(tape.getDatalen()));
+                integrands[bindID]->setResult(functions[0]->compile(*integrands[bindID], bindID, SlotMap()));
+                return FunkBase::compile(tape, bindID, subst);
             }
 
             shared_ptr<FunkIntegrate_gsl1d> set_epsrel(double epsrel)
@@ -1570,72 +2101,113 @@ namespace daFunk
             { this->singl_factor = f; return static_pointer_cast<FunkIntegrate_gsl1d>(this->shared_from_this()); }
             shared_ptr<FunkIntegrate_gsl1d> set_use_log_fallback(bool flag)
             { this->use_log_fallback = flag; return static_pointer_cast<FunkIntegrate_gsl1d>(this->shared_from_this()); }
+            // Start each evaluation from the subdivision that the previous
+            // evaluation (with the same bindID) ended up with.  Only used for
+            // integrals without singularities.
+            shared_ptr<FunkIntegrate_gsl1d> set_reuse_partition(bool flag)
+            { this->reuse_partition = flag; return static_pointer_cast<FunkIntegrate_gsl1d>(this->shared_from_this()); }
+            // Evaluate only one such integral at a time.  This is the default
+            // if the integrand is not thread-safe (see FunkBase::isThreadsafe).
+            shared_ptr<FunkIntegrate_gsl1d> set_serialise(bool flag)
+            { this->serialise = flag; return static_pointer_cast<FunkIntegrate_gsl1d>(this->shared_from_this()); }
 
             double value(const std::vector<double> & data, size_t bindID)
             {
+                // Integrals nested inside a serialised one are serialised already,
+                // and must not try to enter the critical section again.
+                if ( not serialise or serialised_depth() > 0 ) return integrate(data, bindID);
                 double result;
                 #pragma omp critical(FunkIntegrate_gsl1d_integration)
                 {
-                    local_data = data;
-                    local_bindID = bindID;
-                    double error;
-                    function=&FunkIntegrate_gsl1d::invoke;
-                    params=this;
-                    double x0 = functions[1]->value(data, bindID);
-                    double x1 = functions[2]->value(data, bindID);
-                    gsl_set_error_handler_off();
-                    int status = 0;
-                    if ( my_singularities.size() == 0 )
+                    ++serialised_depth();
+                    result = integrate(data, bindID);
+                    --serialised_depth();
+                }
+                return result;
+            }
+
+        private:
+            double integrate(const std::vector<double> & data, size_t bindID)
+            {
+                // Everything belonging to this evaluation lives on the stack (or
+                // in per-thread pools), so one integral can be evaluated by
+                // several threads at once, if the integrand allows it.
+                Integrand integrand;
+                integrand.self = this;
+                integrand.bindID = bindID;
+                integrand.tape = bindID < integrands.size() ? integrands[bindID].get() : NULL;
+                FunkWorkspace local(std::max(data.size(), integrand.tape ? integrand.tape->size() : (size_t)0));
+                std::copy(data.begin(), data.end(), local.data.begin());
+                integrand.data = &local.data;
+                gsl_function F;
+                F.function = &FunkIntegrate_gsl1d::invoke;
+                F.params = &integrand;
+
+                double result, error;
+                double x0 = functions[1]->value(data, bindID);
+                double x1 = functions[2]->value(data, bindID);
+                gsl_set_error_handler_off();
+                FunkGslWorkspace workspace(limit);
+                int status = 0;
+                if ( my_singularities.size() == 0 )
+                {
+                    std::vector<double> pts;
+                    if ( reuse_partition ) pts = startingPartition(bindID, x0, x1);
+                    if ( pts.size() > 2 )
+                        status = gsl_integration_qagp(&F, &pts[0], pts.size(), epsabs, epsrel, limit, workspace.ws, &result, &error);
+                    else
+                        status = gsl_integration_qags(&F, x0, x1, epsabs, epsrel, limit, workspace.ws, &result, &error);
+                    if ( reuse_partition and not status and x0 < x1 ) storePartition(bindID, workspace.ws);
+                }
+                else
+                {
+                    double s = 0;
+                    std::vector<double> ranges;
+                    ranges.push_back(x0);
+                    ranges.push_back(x1);
+                    for ( auto it = my_singularities.begin(); it != my_singularities.end(); ++it )
                     {
-                        status = gsl_integration_qags(this, x0, x1, epsabs, epsrel, limit, gsl_workspace, &result, &error);
+                        double mean = it->first->value(data, bindID);
+                        double sigma = it->second->value(data, bindID);
+                        double z0 = mean - singl_factor*sigma;
+                        double z1 = mean + singl_factor*sigma;
+                        if ( z0 == z1 )
+                            std::cout << "daFunk::FunkBase WARNING: Singularity width is beyond machine precision." << std::endl;
+                        if ( z0 > x0 and z0 < x1 ) ranges.push_back(z0);
+                        if ( z1 > x0 and z1 < x1 ) ranges.push_back(z1);
                     }
-                    else
+                    std::sort(ranges.begin(), ranges.end());
+                    for ( auto it = ranges.begin(); it != ranges.end()-1; ++it )
                     {
-                        double s = 0;
-                        std::vector<double> ranges;
-                        ranges.push_back(x0);
-                        ranges.push_back(x1);
-                        for ( auto it = my_singularities.begin(); it != my_singularities.end(); ++it )
-                        {
-                            double mean = it->first->value(data, bindID);
-                            double sigma = it->second->value(data, bindID);
-                            double z0 = mean - singl_factor*sigma;
-                            double z1 = mean + singl_factor*sigma;
-                            if ( z0 == z1 )
-                                std::cout << "daFunk::FunkBase WARNING: Singularity width is beyond machine precision." << std::endl;
-                            if ( z0 > x0 and z0 < x1 ) ranges.push_back(z0);
-                            if ( z1 > x0 and z1 < x1 ) ranges.push_back(z1);
-                        }
-                        std::sort(ranges.begin(), ranges.end());
-                        for ( auto it = ranges.begin(); it != ranges.end()-1; ++it )
-                        {
-                            status = gsl_integration_qags(this, *it, *(it+1), epsabs, epsrel, limit, gsl_workspace, &result, &error);
-                            s += result;
-                            if (status) break;
-                        }
-                        result = s;
+                        status = gsl_integration_qags(&F, *it, *(it+1), epsabs, epsrel, limit, workspace.ws, &result, &error);
+                        s += result;
+                        if (status) break;
                     }
-                    if (status and this->use_log_fallback)
+                    result = s;
+                }
+                if (status and this->use_log_fallback)
+                {
+                    // The last resort: A cheap integration on log grid, linear interpolation
+                    const double N = 300;
+                    std::vector<double> Xgrid = 
+                        logspace(std::log10(x0), std::log10(x1), N);
+                    double sum = 0, y0, y1, dx;
+                    local.data[index[bindID]] = Xgrid[0];
+                    y0 = functions[0]->value(local.data, bindID);
+                    for (size_t i = 0; i<N-1; i++)
                     {
-                        // The last resort: A cheap integration on log grid, linear interpolation
-                        const double N = 300;
-                        std::vector<double> Xgrid = 
-                            logspace(std::log10(x0), std::log10(x1), N);
-                        double sum = 0, y0, y1, dx;
-                        local_data[index[bindID]] = Xgrid[0];
-                        y0 = functions[0]->value(local_data, bindID);
-                        for (size_t i = 0; i<N-1; i++)
-                        {
-                            local_data[index[bindID]] = Xgrid[i+1];
-                            y1 = functions[0]->value(local_data, bindID);
-                            dx = Xgrid[i+1]-Xgrid[i];
-                            sum += dx*(y0+y1)/2;
-                            y0 = y1;
-                        }
-                        result = sum;
+                        local.data[index[bindID]] = Xgrid[i+1];
+                        y1 = functions[0]->value(local.data, bindID);
+                        dx = Xgrid[i+1]-Xgrid[i];
+                        sum += dx*(y0+y1)/2;
+                        y0 = y1;
                     }
-                    // TODO: Implement flags to optionally throw an error
-                    if (status and not this->use_log_fallback)
+                    result = sum;
+                }
+                // TODO: Implement flags to optionally throw an error
+                if (status and not this->use_log_fallback)
+                {
+                    #pragma omp critical(FunkIntegrate_gsl1d_warning)
                     {
                         std::cerr << "daFunk::FunkIntegrate_gsl1d WARNING: " << gsl_strerror(status) << std::endl;
                         std::cerr << "Attempt to integrate from " << x0 << " to " << x1 << std::endl;
@@ -1646,13 +2218,19 @@ namespace daFunk
 //                        for ( double x = x0; x <= x1; x = (x0>0) ? x*1.01 : x+(x1-x0)/1000)
 //                            std::cerr << "  " << x << " " << invoke(x, this) << std::endl;
                         std::cerr << "Returning zero." << std::endl;
-                        result = 0.;
                     }
+                    result = 0.;
                 }
                 return result;
             }
 
-        private:
+            // Number of serialised integrals being evaluated by this thread
+            static int & serialised_depth()
+            {
+                static thread_local int n = 0;
+                return n;
+            }
+
             void setup(Funk f0, std::string arg, Funk f1, Funk f2)
             {
                 this->functions = vec(f0, f1, f2);
@@ -1665,38 +2243,95 @@ namespace daFunk
                 singularities = joinSingl(singularities, tmp_singl);
 
                 arguments = joinArgs(eraseArg(f0->getArgs(), arg), joinArgs(f1->getArgs(), f2->getArgs()));
-                gsl_workspace = gsl_integration_workspace_alloc (100000);
 
                 this->arg = arg;
                 limit = 100;
                 epsrel = 1e-2;
                 epsabs = 1e-2;
                 use_log_fallback = false;
+                reuse_partition = false;
                 singl_factor = 4;
+                serialise = not isThreadsafe();
+                for ( auto it = my_singularities.begin(); it != my_singularities.end(); ++it )
+                    if ( not it->first->isThreadsafe() or not it->second->isThreadsafe() ) serialise = true;
             }
 
+            // State of one evaluation of the integral, handed to invoke() by GSL
+            struct Integrand
+            {
+                FunkIntegrate_gsl1d * self;
+                std::vector<double> * data;  // Copy of the input data, with the integration variable
+                size_t bindID;
+                FunkTape * tape;  // Compiled integrand, or NULL
+            };
+
             // Static member function that invokes integrand
             static double invoke(double x, void *params) {
-                FunkIntegrate_gsl1d * ptr = static_cast<FunkIntegrate_gsl1d*>(params);
-                ptr->local_data[ptr->index[ptr->local_bindID]] = x;
-                return ptr->functions[0]->value(ptr->local_data, ptr->local_bindID);
+                Integrand * in = static_cast<Integrand*>(params);
+                std::vector<double> & data = *in->data;
+                data[in->self->index[in->bindID]] = x;
+                if ( in->tape ) return in->tape->run(data);
+                return in->self->functions[0]->value(data, in->bindID);
+            }
+
+            // Starting points for qagp: the interior points of the previous
+            // partition that lie inside (x0, x1), plus the end points.  Empty if
+            // there is nothing to reuse.
+            std::vector<double> startingPartition(size_t bindID, double x0, double x1)
+            {
+                std::vector<double> pts;
+                if ( not (x0 < x1) ) return pts;
+                #pragma omp critical(FunkIntegrate_gsl1d_partition)
+                {
+                    if ( bindID < partitions.size() ) pts = partitions[bindID];
+                }
+                pts.erase(std::remove_if(pts.begin(), pts.end(), [x0, x1](double x) { return not (x > x0 and x < x1); }), pts.end());
+                if ( pts.empty() ) return pts;
+                pts.insert(pts.begin(), x0);
+                pts.push_back(x1);
+                return pts;
+            }
+
+            // Remember where the subintervals of the last integration start.  At
+            // most limit/2 points are kept, leaving qagp room to refine further.
+            void storePartition(size_t bindID, const gsl_integration_workspace * ws)
+            {
+                std::vector<double> pts(ws->alist, ws->alist + ws->size);
+                std::sort(pts.begin(), pts.end());
+                size_t nmax = limit/2;
+                if ( pts.size() > nmax and nmax > 0 )
+                {
+                    size_t stride = (pts.size() + nmax - 1)/nmax;
+                    size_t n = 0;
+                    for ( size_t i = 0; i < pts.size(); i += stride ) pts[n++] = pts[i];
+                    pts.resize(n);
+                }
+                else if ( nmax == 0 )
+                    pts.clear();
+                #pragma omp critical(FunkIntegrate_gsl1d_partition)
+                {
+                    if ( partitions.size() <= bindID ) partitions.resize(bindID+1);
+                    partitions[bindID].swap(pts);
+                }
             }
 
-            // Required for rewiring input parameters
-            std::vector<double> local_data;
-            size_t local_bindID;
+            // Compiled integrands for each bindID (empty if not compiled)
+            std::vector<shared_ptr<FunkTape>> integrands;
+            // Partition of the last integration for each bindID (if reuse_partition)
+            std::vector<std::vector<double>> partitions;
             std::vector<std::pair<Funk, Funk>> my_singularities;
 
             // Integration range and function pointer
             std::string arg;
 
-            // GSL workspace and parameters
-            gsl_integration_workspace * gsl_workspace;
+            // GSL parameters
             size_t limit;
             std::vector<size_t> index;
             double epsrel;
             double epsabs;
             bool use_log_fallback;
+            bool reuse_partition;
+            bool serialise;
 
             double singl_factor;
     };
@@ -19,8 +19,11 @@
 
 #include <map>
 #include <set>
+#include <vector>
 #include <string>
 #include <sstream>
+#include <iterator>
+#include <stdexcept>
 
 #include "gambit/Elements/slhaea_helpers.hpp"
 #include "gambit/Elements/mssm_slhahelp.hpp"
@@ -39,6 +42,158 @@ namespace Gambit
       // Forward declaration of DecayTable entry class, for readability.  Holds the info on all decays of a given particle.
       class Entry;
 
+      /// A decay final state.  Final states are interned in a single table shared by all DecayTables,
+      /// so each one is resolved and checked against the particle database only once.
+      struct FinalState
+      {
+        /// Small integer identifying the final state (unique across all DecayTables)
+        int id;
+        /// The final state particles, as PDG-context integer pairs
+        std::multiset< std::pair<int,int> > particles;
+        /// Whether all the particles are in the GAMBIT particle database
+        bool known;
+        /// Long names of the particles, in the same order as particles (only if known)
+        std::vector<str> long_names;
+      };
+
+      /// Retrieve the interned final state with the given particles, adding it if it is new (thread-safe).
+      static const FinalState& final_state(const std::multiset< std::pair<int,int> >&);
+
+      /// Retrieve an interned final state by its id (thread-safe).
+      static const FinalState& final_state(int);
+
+      /// Branching fractions and their errors for all decay channels of a particle, keyed by final state.
+      /// Used like a std::map from sets of PDG-context pairs to (BF, error) pairs, and iterates in the same
+      /// order, but stores the channels in a flat vector and compares final states by their interned pointers.
+      class ChannelMap
+      {
+        public:
+
+          typedef std::multiset< std::pair<int,int> > key_type;
+          typedef std::pair<double, double> mapped_type;
+
+          /// What an iterator points to: the final state particles (first) and the BF and error (second)
+          template <typename T>
+          struct reference_type
+          {
+            const key_type& first;
+            T& second;
+            const FinalState& final_state;
+          };
+
+        private:
+
+          /// One decay channel
+          struct slot
+          {
+            const FinalState* state;
+            mapped_type value;
+          };
+
+          /// The channels, ordered by their final state particles
+          std::vector<slot> slots;
+
+          template <typename SLOT, typename REF>
+          class iterator_base
+          {
+            private:
+              SLOT* p;
+              template <typename, typename> friend class iterator_base;
+
+            public:
+              /// Proxy returned by operator->
+              struct arrow
+              {
+                REF ref;
+                const REF* operator->() const { return &ref; }
+              };
+
+              typedef std::forward_iterator_tag iterator_category;
+              typedef std::ptrdiff_t difference_type;
+              typedef REF value_type;
+              typedef REF reference;
+              typedef arrow pointer;
+
+              iterator_base(SLOT* p = NULL) : p(p) {}
+              template <typename S, typename R>
+              iterator_base(const iterator_base<S, R>& other) : p(other.p) {}
+
+              REF operator*() const { return REF{p->state->particles, p->value, *p->state}; }
+              arrow operator->() const { return arrow{**this}; }
+              iterator_base& operator++() { ++p; return *this; }
+              iterator_base operator++(int) { iterator_base old(*this); ++p; return old; }
+              bool operator==(const iterator_base& other) const { return p == other.p; }
+              bool operator!=(const iterator_base& other) const { return p != other.p; }
+          };
+
+        public:
+
+          typedef iterator_base<slot, reference_type<mapped_type> > iterator;
+          typedef iterator_base<const slot, reference_type<const mapped_type> > const_iterator;
+
+          /// Iteration over all channels
+          /// @{
+          iterator begin() { return iterator(slots.data()); }
+          iterator end() { return iterator(slots.data() + slots.size()); }
+          const_iterator begin() const { return const_iterator(slots.data()); }
+          const_iterator end() const { return const_iterator(slots.data() + slots.size()); }
+          /// @}
+
+          /// Number of channels
+          size_t size() const { return slots.size(); }
+          bool empty() const { return slots.empty(); }
+          void clear() { slots.clear(); }
+
+          /// Find a channel, returning end() if it is absent
+          /// @{
+          iterator find(const FinalState& fs)
+          {
+            for (auto it = slots.begin(); it != slots.end(); ++it) if (it->state == &fs) return iterator(&*it);
+            return end();
+          }
+          const_iterator find(const FinalState& fs) const
+          {
+            for (auto it = slots.begin(); it != slots.end(); ++it) if (it->state == &fs) return const_iterator(&*it);
+            return end();
+          }
+          iterator find(const key_type& key) { return find(DecayTable::final_state(key)); }
+          const_iterator find(const key_type& key) const { return find(DecayTable::final_state(key)); }
+          size_t count(const key_type& key) const { return find(key) != end() ? 1 : 0; }
+          /// @}
+
+          /// Get the BF and error of a channel, throwing std::out_of_range if it is absent
+          /// @{
+          mapped_type& at(const FinalState& fs)
+          {
+            iterator it = find(fs);
+            if (it == end()) throw std::out_of_range("DecayTable::ChannelMap::at");
+            return it->second;
+          }
+          const mapped_type& at(const FinalState& fs) const
+          {
+            const_iterator it = find(fs);
+            if (it == end()) throw std::out_of_range("DecayTable::ChannelMap::at");
+            return it->second;
+          }
+          mapped_type& at(const key_type& key) { return at(DecayTable::final_state(key)); }
+          const mapped_type& at(const key_type& key) const { return at(DecayTable::final_state(key)); }
+          /// @}
+
+          /// Get the BF and error of a channel, adding the channel if it is absent
+          /// @{
+          mapped_type& operator[](const FinalState& fs)
+          {
+            for (auto it = slots.begin(); it != slots.end(); ++it) if (it->state == &fs) return it->value;
+            auto pos = slots.begin();
+            while (pos != slots.end() and pos->state->particles < fs.particles) ++pos;
+            slot new_slot = {&fs, mapped_type(0.0, 0.0)};
+            return slots.insert(pos, new_slot)->value;
+          }
+          mapped_type& operator[](const key_type& key) { return operator[](DecayTable::final_state(key)); }
+          /// @}
+
+      };
+
       /// Constructors
       /// @{
       /// Default constructor
@@ -100,11 +255,14 @@ namespace Gambit
           /// Initialise a DecayTable Entry using an SLHAea DECAY block
           void init(const SLHAea::Block&, int, bool force_SM_fermion_gauge_eigenstates = false);
 
-          /// Make sure all particles listed in a set are actually known to the GAMBIT particle database
-          void check_particles_exist(std::multiset< std::pair<int,int> >&) const;
+          /// Make sure all particles in a final state are actually known to the GAMBIT particle database
+          void check_particles_exist(const FinalState&) const;
 
           /// Make sure no NaNs have been passed to the DecayTable by nefarious backends
-          void check_BF_validity(double, double, std::multiset< std::pair<int,int> >&) const;
+          void check_BF_validity(double, double, const FinalState&) const;
+
+          /// Retrieve the BF and error of a channel, raising an error if it is absent
+          const std::pair<double, double>& channel_at(const FinalState&) const;
 
           /// Construct a set of particles from a variadic list of full names or short names and indices
           /// @{
@@ -126,6 +284,68 @@ namespace Gambit
           }
           /// @}
 
+          /// Construct a string identifying a variadic list of full names or short names and indices
+          /// @{
+          /// Base function version
+          static void construct_name_key(str&) {}
+          /// Templated version for long names
+          template <typename... Args>
+          static void construct_name_key(str& key, const str& p1, Args... args)
+          {
+            key += p1;
+            key += '\x1f';
+            construct_name_key(key, args...);
+          }
+          /// Templated version for short names and indices
+          template <typename... Args>
+          static void construct_name_key(str& key, const str& p1, int i1, Args... args)
+          {
+            key += p1;
+            key += '\x1e';
+            key += std::to_string(i1);
+            key += '\x1f';
+            construct_name_key(key, args...);
+          }
+          /// @}
+
+          /// Look up and store final states in the cache of the calling thread, keyed by the way they were specified
+          /// @{
+          static const FinalState* cached_final_state(const str&);
+          static void cache_final_state(const str&, const FinalState&);
+          /// @}
+
+          /// Retrieve the interned final state for a list of particles.
+          /// Each thread remembers the lists it has seen, so the particle database is only consulted once per list.
+          /// @{
+          /// PDG-context integer pairs (array)
+          static const FinalState& final_state(const std::pair<int,int>*, size_t);
+          /// Full particle names (vector)
+          static const FinalState& final_state(const std::vector<str>&);
+          /// PDG-context integer pairs (arguments)
+          template <typename... Args>
+          static const FinalState& final_state(std::pair<int,int> p1, Args... args)
+          {
+            std::pair<int,int> particles[] = {p1, args...};
+            return final_state(particles, sizeof...(Args)+1);
+          }
+          /// Full particle names or short particle names + index integers (arguments)
+          template <typename... Args>
+          static const FinalState& final_state(str p1, Args... args)
+          {
+            str key;
+            construct_name_key(key, p1, args...);
+            const FinalState* fs = cached_final_state(key);
+            if (fs == NULL)
+            {
+              std::multiset< std::pair<int,int> > particles;
+              construct_key(particles, p1, args...);
+              fs = &DecayTable::final_state(particles);
+              cache_final_state(key, *fs);
+            }
+            return *fs;
+          }
+          /// @}
+
         public:
 
           /// Default constructor
@@ -153,20 +373,18 @@ namespace Gambit
           template <typename... Args>
           void set_BF(double BF, double error, std::pair<int,int> p1, Args... args)
           {
-            std::pair<int,int> particles[] = {p1, args...};
-            std::multiset< std::pair<int,int> > key(particles, particles+sizeof...(Args)+1);
-            check_particles_exist(key);
-            check_BF_validity(BF, error, key);
-            channels[key] = std::pair<double, double>(BF, error);
+            const FinalState& fs = final_state(p1, args...);
+            check_particles_exist(fs);
+            check_BF_validity(BF, error, fs);
+            channels[fs] = std::pair<double, double>(BF, error);
           }
 
           template <typename... Args>
           void set_BF(double BF, double error, str p1, Args... args)
           {
-            std::multiset< std::pair<int,int> > key;
-            construct_key(key, p1, args...);
-            check_BF_validity(BF, error, key);
-            channels[key] = std::pair<double, double>(BF, error);
+            const FinalState& fs = final_state(p1, args...);
+            check_BF_validity(BF, error, fs);
+            channels[fs] = std::pair<double, double>(BF, error);
           }
           /// @}
 
@@ -185,18 +403,15 @@ namespace Gambit
           template <typename... Args>
           bool has_channel(std::pair<int,int> p1, Args... args) const
           {
-            std::pair<int,int> particles[] = {p1, args...};
-            std::multiset< std::pair<int,int> > key(particles, particles+sizeof...(Args)+1);
-            check_particles_exist(key);
-            return channels.find(key) != channels.end();
+            const FinalState& fs = final_state(p1, args...);
+            check_particles_exist(fs);
+            return channels.find(fs) != channels.end();
           }
 
           template <typename... Args>
           bool has_channel(str p1, Args... args) const
           {
-            std::multiset< std::pair<int,int> > key;
-            construct_key(key, p1, args...);
-            return channels.find(key) != channels.end();
+            return channels.find(final_state(p1, args...)) != channels.end();
           }
           /// @}
 
@@ -215,37 +430,13 @@ namespace Gambit
           template <typename... Args>
           double BF(std::pair<int,int> p1, Args... args) const
           {
-            std::pair<int,int> particles[] = {p1, args...};
-            std::multiset< std::pair<int,int> > key(particles, particles+sizeof...(Args)+1);
-            if (channels.find(key) == channels.end())
-            {
-              std::ostringstream err;
-              err << "No branching fraction exists for the requested final states:";
-              for (auto particle = key.begin(); particle != key.end(); ++particle)
-              {
-                err << " {" << particle->first << ", " << particle->second << "}";
-              }
-              model_error().raise(LOCAL_INFO,err.str());
-            }
-            return channels.at(key).first;
+            return channel_at(final_state(p1, args...)).first;
           }
 
           template <typename... Args>
           double BF(str p1, Args... args) const
           {
-            std::multiset< std::pair<int,int> > key;
-            construct_key(key, p1, args...);
-            if (channels.find(key) == channels.end())
-            {
-              std::ostringstream err;
-              err << "No branching fraction exists for the requested final states:";
-              for (auto particle = key.begin(); particle != key.end(); ++particle)
-              {
-                err << " {" << particle->first << ", " << particle->second << "}";
-              }
-              model_error().raise(LOCAL_INFO,err.str());
-            }
-            return channels.at(key).first;
+            return channel_at(final_state(p1, args...)).first;
           }
           /// @}
 
@@ -256,37 +447,13 @@ namespace Gambit
           template <typename... Args>
           double BF_error(std::pair<int,int> p1, Args... args) const
           {
-            std::pair<int,int> particles[] = {p1, args...};
-            std::multiset< std::pair<int,int> > key(particles, particles+sizeof...(Args)+1);
-            if (channels.find(key) == channels.end())
-            {
-              std::ostringstream err;
-              err << "No branching fraction exists for the requested final states:";
-              for (auto particle = key.begin(); particle != key.end(); ++particle)
-              {
-                err << " {" << particle->first << ", " << particle->second << "}";
-              }
-              model_error().raise(LOCAL_INFO,err.str());
-            }
-            return channels.at(key).second;
+            return channel_at(final_state(p1, args...)).second;
           }
 
           template <typename... Args>
           double BF_error(str p1, Args... args) const
           {
-            std::multiset< std::pair<int,int> > key;
-            construct_key(key, p1, args...);
-            if (channels.find(key) == channels.end())
-            {
-              std::ostringstream err;
-              err << "No branching fraction exists for the requested final states:";
-              for (auto particle = key.begin(); particle != key.end(); ++particle)
-              {
-                err << " {" << particle->first << ", " << particle->second << "}";
-              }
-              model_error().raise(LOCAL_INFO,err.str());
-            }
-            return channels.at(key).second;
+            return channel_at(final_state(p1, args...)).second;
           }
           /// @}
 
@@ -297,37 +464,13 @@ namespace Gambit
           template <typename... Args>
           std::pair<double, double> BF_with_error(std::pair<int,int> p1, Args... args) const
           {
-            std::pair<int,int> particles[] = {p1, args...};
-            std::multiset< std::pair<int,int> > key(particles, particles+sizeof...(Args)+1);
-            if (channels.find(key) == channels.end())
-            {
-              std::ostringstream err;
-              err << "No branching fraction exists for the requested final states:";
-              for (auto particle = key.begin(); particle != key.end(); ++particle)
-              {
-                err << " {" << particle->first << ", " << particle->second << "}";
-              }
-              model_error().raise(LOCAL_INFO,err.str());
-            }
-            return channels.at(key);
+            return channel_at(final_state(p1, args...));
           }
 
           template <typename... Args>
           std::pair<double, double> BF_with_error(str p1, Args... args) const
           {
-            std::multiset< std::pair<int,int> > key;
-            construct_key(key, p1, args...);
-            if (channels.find(key) == channels.end())
-            {
-              std::ostringstream err;
-              err << "No branching fraction exists for the requested final states:";
-              for (auto particle = key.begin(); particle != key.end(); ++particle)
-              {
-                err << " {" << particle->first << ", " << particle->second << "}";
-              }
-              model_error().raise(LOCAL_INFO,err.str());
-            }
-            return channels.at(key);
+            return channel_at(final_state(p1, args...));
           }
           /// @}
 
@@ -361,7 +504,7 @@ namespace Gambit
 
           /// The actual underlying map of channels to their BFs.
           /// Just iterate over this directly if you need to iterate over all decays of this particle.
-          std::map< std::multiset< std::pair<int,int> >, std::pair<double, double> > channels;
+          ChannelMap channels;
 
       };
 
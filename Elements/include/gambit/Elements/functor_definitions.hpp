@@ -72,7 +72,7 @@ namespace Gambit
     template <typename TYPE>
     module_functor<TYPE>::~module_functor()
     {
-      if (myValue != NULL) delete [] myValue;
+      Utils::delete_cache_aligned(myValue, (iRunNested ? globlMaxThreads : 1));
     }
 
     /// Setter for indicating if the wrapped function's result should be printed
@@ -98,20 +98,20 @@ namespace Gambit
         backend_error().raise(LOCAL_INFO, ss.str());
       }
       boost::io::ios_flags_saver ifs(cout);        // Don't allow module functions to change the output precision of cout
-      int thread_num = omp_get_thread_num();
+      int thread_num = (iRunNested ? omp_get_thread_num() : 0); // Functors that cannot run nested only have one slot, whichever thread runs them.
       init_memory();                               // Init memory if this is the first run through.
-      if (needs_recalculating[thread_num])         // Do the actual calculation if required.
+      if (states[thread_num].needs_recalculating)         // Do the actual calculation if required.
       {
         logger().entering_module(myLogTag);
         this->startTiming(thread_num);             //Begin timing function evaluation
         try
         {
-          this->myFunction(myValue[thread_num]);   //Run and place result in the appropriate slot in myValue
+          this->myFunction(myValue[thread_num].value);   //Run and place result in the appropriate slot in myValue
         }
         catch (invalid_point_exception& e)
         {
           if (not point_exception_raised) acknowledgeInvalidation(e);
-          if (omp_get_level()==0)                  // If not in an OpenMP parallel block, throw onwards
+          if (Utils::omp_module_level()==0)                  // If not in an OpenMP parallel block, throw onwards
           {
             this->finishTiming(thread_num);        //Stop timing function evaluation
             throw(e);
@@ -132,7 +132,7 @@ namespace Gambit
         #pragma omp critical(module_functor_init_memory)
         {
           // Reserve enough space to hold as many results as there are slots (threads) allowed
-          if(myValue==NULL) myValue = new TYPE[(iRunNested ? globlMaxThreads : 1)];
+          if(myValue==NULL) myValue = Utils::new_cache_aligned<Utils::cache_padded<TYPE> >(iRunNested ? globlMaxThreads : 1);
         }
       }
     }
@@ -142,7 +142,7 @@ namespace Gambit
     const TYPE& module_functor<TYPE>::operator()(int index)
     {
       init_memory(); // Init memory if this is the first run through.
-      return (iRunNested ? myValue[index] : myValue[0]);
+      return (iRunNested ? myValue[index].value : myValue[0].value);
     }
 
     /// Alternative to operation (returns a safe pointer to value)
@@ -150,7 +150,7 @@ namespace Gambit
     safe_ptr<TYPE> module_functor<TYPE>::valuePtr()
     {
       init_memory(); // Init memory if this is the first run through.
-      return safe_ptr<TYPE>(myValue);
+      return safe_ptr<TYPE>(&myValue[0].value, sizeof(myValue[0]));
     }
 
     #ifndef NO_PRINTERS
@@ -163,26 +163,26 @@ namespace Gambit
         // attempted, because it uses the VertexID to differentiate print streams, and this is shared among threads.
         // Can fix by requiring a VertexID+thread_num pair, but I am leaving this for later.
         init_memory();                 // Init memory if this is the first run through.
-        if(myPrintFlag and not already_printed[thread_num] and type()!="void") // myPrintFlag should anyway not be true for void result types
+        if(myPrintFlag and not states[thread_num].already_printed and type()!="void") // myPrintFlag should anyway not be true for void result types
         {
           if (not iRunNested) thread_num = 0; // Force printing of thread_num=0 if this functor cannot run nested.
           int rank = printer->getRank();      // This is "first pass" printing, so use the actual rank of this process.
                                               // In the auxilliary printing system we may tell the printer to overwrite
                                               // the output of other ranks.
           logger() << LogTags::debug << "Printing "<<myLabel<<" (vID="<<myVertexID<<", rank="<<rank<<", pID="<<pointID<<")" << EOM;
-          printer->print(myValue[thread_num],myLabel,myVertexID,rank,pointID);
-          already_printed[thread_num] = true;
+          printer->print(myValue[thread_num].value,myLabel,myVertexID,rank,pointID);
+          states[thread_num].already_printed = true;
         }
 
         // Print timing info if requested (independent of whether printing actual result)
-        if(myTimingPrintFlag and not already_printed_timing[thread_num])
+        if(myTimingPrintFlag and not states[thread_num].already_printed_timing)
         {
           if (not iRunNested) thread_num = 0; // Force printing of thread_num=0 if this functor cannot run nested.
           int rank = printer->getRank();
-          std::chrono::duration<double> runtime = end[thread_num] - start[thread_num];
+          std::chrono::duration<double> runtime = states[thread_num].end - states[thread_num].start;
           logger() << LogTags::debug << "Printing "<<myTimingLabel<<" (vID="<<myTimingVertexID<<", rank="<<rank<<", pID="<<pointID<<")" << EOM;
           printer->print(runtime.count(),myTimingLabel,myTimingVertexID,rank,pointID);
-          already_printed_timing[thread_num] = true;
+          states[thread_num].already_printed_timing = true;
         }
       }
 
@@ -47,6 +47,7 @@
 
 #include "gambit/Utils/util_types.hpp"
 #include "gambit/Utils/util_functions.hpp"
+#include "gambit/Utils/cache_aligned.hpp"
 #include "gambit/Utils/yaml_options.hpp"
 #include "gambit/Utils/model_parameters.hpp"
 #include "gambit/Logs/logger.hpp"
@@ -268,6 +269,9 @@ namespace Gambit
       /// Return a safe pointer to the options that this functor is supposed to run with (e.g. from the ini file).
       safe_ptr<Options> getOptions();
 
+      /// Freeze the options of this functor, so that lookups of them are cached (see Options::freeze).
+      void freezeOptions();
+
       /// Test whether the functor is allowed to be used with all models
       bool allModelsAllowed();
 
@@ -554,8 +558,29 @@ namespace Gambit
       /// Construct the list of known models only if it doesn't yet exist
       void fill_activeModelFlags();
 
-      /// Beginning and end timing points
-      std::chrono::time_point<std::chrono::system_clock> *start, *end;
+      /// Per-thread state. Each thread running this functor updates only its own slot, which fills
+      /// whole cache lines, so neither locking nor false sharing occurs between threads. The timing
+      /// and invalidation statistics are merged across slots when the averages are requested.
+      struct alignas(GAMBIT_CACHE_LINE_SIZE) thread_state
+      {
+        /// Beginning and end timing points
+        std::chrono::time_point<std::chrono::steady_clock> start, end;
+        /// Averaged runtime (s) over the calls made by this thread
+        double runtime_average = FUNCTORS_RUNTIME_INIT;
+        /// Probability that the calls made by this thread invalidate a point
+        double pInvalidation = FUNCTORS_BASE_INVALIDATION_RATE;
+        /// Number of calls made by this thread
+        long long ncalls = 0;
+        /// Needs recalculating or not?
+        bool needs_recalculating = true;
+        /// Has result already been sent to the printer?
+        bool already_printed = false;
+        /// Has timing data already been sent to the printer?
+        bool already_printed_timing = false;
+      };
+
+      /// Per-thread state, one slot per thread allowed to run this functor
+      thread_state* states;
 
       /// A flag indicating whether or not this functor has invalidated the current point
       bool point_exception_raised;
@@ -563,24 +588,9 @@ namespace Gambit
       /// An exception raised because this functor has invalidated the current point
       invalid_point_exception raised_point_exception;
 
-      /// Averaged runtime in ns
-      double runtime_average;
-
       /// Fade rate for average runtime
       double fadeRate;
 
-      /// Probability that functors invalidates point in model parameter space
-      double pInvalidation;
-
-      /// Needs recalculating or not?
-      bool* needs_recalculating;
-
-      /// Has result already been sent to the printer?
-      bool* already_printed;
-
-      /// Has timing data already been sent to the printer?
-      bool* already_printed_timing;
-
       /// Flag indicating whether this function can manage a loop over other functions
       bool iCanManageLoops;
 
@@ -598,8 +608,8 @@ namespace Gambit
       /// Vector of functors that have been set up to run nested within this one.
       std::vector<functor*> myNestedFunctorList;
 
-      /// Pointer to counters for iterations of nested functor loop.
-      long long* myCurrentIteration;
+      /// Pointer to counters for iterations of nested functor loop (one per thread, padded to cache lines).
+      Utils::cache_padded<long long>* myCurrentIteration;
 
       /// Maximum number of OpenMP threads this MPI process is permitted to launch in total.
       const int globlMaxThreads;
@@ -734,8 +744,8 @@ namespace Gambit
       /// Internal storage of function pointer
       void (*myFunction)(TYPE &);
 
-      /// Internal pointer to storage location of function value
-      TYPE* myValue;
+      /// Internal pointer to storage location of function value (one per thread, padded to cache lines)
+      Utils::cache_padded<TYPE>* myValue;
 
       /// Flag to select whether or not the results of this functor should be sent to the printer object.
       bool myPrintFlag;
@@ -148,7 +148,7 @@ namespace Gambit
         if (not _initialized) this->dieGracefully();
         //Choose the index of the thread if the dependency and the dependent functor are running inside the same loop.  If not, just choose the first element.
         int index = use_thread_index(_functor_ptr, _dependent_functor_ptr) ? omp_get_thread_num() : 0;
-        return _sptr.operator->() + index;   //Call a const member function of the indexth element of the array pointed to by the safe pointer.
+        return &_sptr[index];   //Call a const member function of the indexth element of the array pointed to by the safe pointer.
       }
 
       /// Get the safe_ptr.
@@ -49,6 +49,7 @@
 #include "gambit/Elements/decay_table.hpp"             // Decay table class (carries particle decay info)
 #include "gambit/Elements/higgs_couplings_table.hpp"   // Higgs couplings table class (carries couplings info for entire Higgs sector)
 #include "gambit/Elements/slhaea_helpers.hpp"          // Contains SLHAea reader/writer class alias
+#include "gambit/Elements/slha_blocks.hpp"             // Numerical SLHA blocks, parsed once from an SLHAea object
 #include "gambit/Elements/halo_types.hpp"              // data types for DM halo properties
 
 #include "gambit/Backends/default_bossed_versions.hpp" // Default versions of backends to use when employing BOSSed types
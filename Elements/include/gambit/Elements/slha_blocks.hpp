@@ -0,0 +1,153 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Numeric, read-only view of an SLHAea object.
+///  Every data line of every block is converted
+///  to a double once, on construction, and can
+///  then be looked up by block name and index in
+///  constant time.  The underlying SLHAea object
+///  is kept for backends that need it, and the
+///  SLHA text is only rendered on first request.
+///  Copies share the same data.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#ifndef __slha_blocks_hpp__
+#define __slha_blocks_hpp__
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "gambit/Utils/util_types.hpp"
+#include "gambit/Elements/slhaea_helpers.hpp"
+
+
+namespace Gambit
+{
+
+  /// Numeric SLHA blocks, parsed once from an SLHAea object
+  class SLHAblocks
+  {
+
+    public:
+
+      /// The numeric contents of a single SLHA block
+      class Block
+      {
+        public:
+
+          /// Block name (upper case)
+          const str& name() const { return _name; }
+
+          /// Does the block definition give a scale (Q= ...)?
+          bool has_scale() const { return _has_scale; }
+          /// The scale given in the block definition
+          double scale() const;
+
+          /// Does the block contain a value with no indices (e.g. ALPHA)?
+          bool has() const { return _has_value; }
+          /// Does the block contain a value with one index?
+          bool has(int i) const { return _one.find(i) != _one.end(); }
+          /// Does the block contain a value with two indices?
+          bool has(int i, int j) const { return _two.find(key(i,j)) != _two.end(); }
+          /// Does the block contain a value with the given indices?
+          bool has(const std::vector<int>& indices) const;
+
+          /// Retrieve a value, raising an error if it is missing
+          /// @{
+          double get() const;
+          double get(int i) const;
+          double get(int i, int j) const;
+          double get(const std::vector<int>& indices) const;
+          /// @}
+
+          /// Retrieve a value, or a default if it is missing
+          /// @{
+          double get_or(double def, int i) const { auto it = _one.find(i); return it == _one.end() ? def : it->second; }
+          double get_or(double def, int i, int j) const { auto it = _two.find(key(i,j)); return it == _two.end() ? def : it->second; }
+          /// @}
+
+          /// Number of numeric entries in the block
+          size_t size() const { return _one.size() + _two.size() + _more.size() + (_has_value ? 1 : 0); }
+
+        private:
+
+          friend class SLHAblocks;
+
+          /// Pack two indices into a single key
+          static std::uint64_t key(int i, int j) { return (std::uint64_t(std::uint32_t(i)) << 32) | std::uint32_t(j); }
+
+          /// Raise an error for a missing entry
+          void missing(const str& indices) const;
+
+          str _name;
+          bool _has_scale = false;
+          double _scale = 0;
+          bool _has_value = false;
+          double _value = 0;
+          std::unordered_map<int, double> _one;
+          std::unordered_map<std::uint64_t, double> _two;
+          std::map<std::vector<int>, double> _more;
+      };
+
+      /// Empty set of blocks
+      SLHAblocks();
+
+      /// Parse all blocks of an SLHAea object.  Lines that are not purely numeric (e.g. SPINFO, DECAY) are
+      /// only retained in the SLHAea object.  Where a block name appears more than once, the first is used,
+      /// as with SLHAea::Coll::operator[].
+      explicit SLHAblocks(SLHAstruct slha);
+
+      /// Does a block exist?
+      bool has_block(const str& block) const { return find(block) != NULL; }
+
+      /// Retrieve a block, or NULL if it does not exist
+      const Block* find(const str& block) const;
+
+      /// Retrieve a block, raising an error if it does not exist
+      const Block& operator[](const str& block) const;
+
+      /// Does a block exist and contain a value with the given index/indices?
+      /// @{
+      bool has(const str& block, int i) const { const Block* b = find(block); return b != NULL and b->has(i); }
+      bool has(const str& block, int i, int j) const { const Block* b = find(block); return b != NULL and b->has(i,j); }
+      /// @}
+
+      /// Retrieve a value, raising an error if the block or entry is missing
+      /// @{
+      double get(const str& block, int i) const { return (*this)[block].get(i); }
+      double get(const str& block, int i, int j) const { return (*this)[block].get(i,j); }
+      /// @}
+
+      /// The SLHAea object that the blocks were read from
+      const SLHAstruct& slhaea() const { return _data->slha; }
+
+      /// The full SLHA text, rendered on first call and then kept
+      const str& text() const;
+
+    private:
+
+      /// Shared, immutable data
+      struct data
+      {
+        SLHAstruct slha;
+        std::unordered_map<str, Block> blocks;
+        std::once_flag rendered;
+        str text;
+      };
+      std::shared_ptr<data> _data;
+
+  };
+
+}
+
+#endif //defined __slha_blocks_hpp__
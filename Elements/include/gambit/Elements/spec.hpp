@@ -49,12 +49,13 @@ namespace Gambit {
       else if(check_overrides == ignore_overrides){overrides=false; override_only=false;}
       
       /* Create finder object, tell it what maps to search, and do the search */
-      const OverrideMaps         overridecoll = override_maps.at(partype);
-      const MapCollection<MTget> mapcoll      = getter_maps.at(partype);
+      const OverrideMaps&         overridecoll = override_maps.at(partype);
+      const MapCollection<MTget>& mapcoll      = getter_maps.at(partype);
       FptrFinder<Spec<DerivedSpec>,MapTag::Get> finder =                                
                        SetMaps<Spec<DerivedSpec>,MapTag::Get>(Par::toString.at(partype),this)
                               .omap0(  overridecoll.m0 ) 
                               .omap1( overridecoll.m1 )
+                              .ovalues( override_values )
                               .map0(  mapcoll.map0 )       
                               .map1(  mapcoll.map1 )
                               .map0W( mapcoll.map0W )       
@@ -80,12 +81,13 @@ namespace Gambit {
       else if(check_overrides == ignore_overrides){overrides=false; override_only=false;}
   
      /* Create finder object, tell it what maps to search, and do the search */
-      const OverrideMaps         overridecoll = override_maps.at(partype);
-      const MapCollection<MTget> mapcoll      = getter_maps.at(partype);
+      const OverrideMaps&         overridecoll = override_maps.at(partype);
+      const MapCollection<MTget>& mapcoll      = getter_maps.at(partype);
       FptrFinder<Spec<DerivedSpec>,MapTag::Get> finder =                                
                        SetMaps<Spec<DerivedSpec>,MapTag::Get>(Par::toString.at(partype),this)
                               .omap0(  overridecoll.m0 ) 
                               .omap1( overridecoll.m1 )
+                              .ovalues( override_values )
                               .map0(  mapcoll.map0 )       
                               .map1(  mapcoll.map1 )
                               .map0W( mapcoll.map0W )       
@@ -109,11 +111,12 @@ namespace Gambit {
       /* Before trying to set parameter, check if there is an override defined
          for it, so that we can warn people that the value they are trying to
          set will be masked by the override */
-      const OverrideMaps overridecoll = override_maps.at(partype);
+      const OverrideMaps& overridecoll = override_maps.at(partype);
       FptrFinder<Spec<DerivedSpec>,MapTag::Set> override_finder =                                
                        SetMaps<Spec<DerivedSpec>,MapTag::Set>(Par::toString.at(partype),this)
                               .omap0( overridecoll.m0 ) 
                               .omap1( overridecoll.m1 )
+                              .ovalues( override_values )
                               .override_only(true); // switch to permit search of only override maps
       if( override_finder.find(name,true,check_antiparticle) )
       { 
@@ -125,7 +128,7 @@ namespace Gambit {
       // else no problem
 
       /* Create finder object, tell it what maps to search, and do the search */
-      const MapCollection<MTset> mapcoll = setter_maps.at(partype);
+      const MapCollection<MTset>& mapcoll = setter_maps.at(partype);
       FptrFinder<Spec<DerivedSpec>,MapTag::Set> finder =                                
                        SetMaps<Spec<DerivedSpec>,MapTag::Set>(Par::toString.at(partype),this)
                               .map0(  mapcoll.map0 )       
@@ -153,12 +156,13 @@ namespace Gambit {
       else if(check_overrides == ignore_overrides){overrides=false; override_only=false;}
  
       /* Create finder object, tell it what maps to search, and do the search */
-      const OverrideMaps         overridecoll = override_maps.at(partype);
-      const MapCollection<MTget> mapcoll      = getter_maps.at(partype);
+      const OverrideMaps&         overridecoll = override_maps.at(partype);
+      const MapCollection<MTget>& mapcoll      = getter_maps.at(partype);
       FptrFinder<Spec<DerivedSpec>,MapTag::Get> finder =                                
                        SetMaps<Spec<DerivedSpec>,MapTag::Get>(Par::toString.at(partype),this)
                               .omap0( overridecoll.m0 ) 
                               .omap1( overridecoll.m1 )
+                              .ovalues( override_values )
                               .map0(  mapcoll.map0 )       
                               .map1(  mapcoll.map1 )
                               .map0W( mapcoll.map0W )       
@@ -184,12 +188,13 @@ namespace Gambit {
       else if(check_overrides == ignore_overrides){overrides=false; override_only=false;}
  
       /* Create finder object, tell it what maps to search, and do the search */
-      const OverrideMaps         overridecoll = override_maps.at(partype);
-      const MapCollection<MTget> mapcoll      = getter_maps.at(partype);
+      const OverrideMaps&         overridecoll = override_maps.at(partype);
+      const MapCollection<MTget>& mapcoll      = getter_maps.at(partype);
       FptrFinder<Spec<DerivedSpec>,MapTag::Get> finder =                                
                        SetMaps<Spec<DerivedSpec>,MapTag::Get>(Par::toString.at(partype),this)
                               .omap0( overridecoll.m0 ) 
                               .omap1( overridecoll.m1 )
+                              .ovalues( override_values )
                               .map0(  mapcoll.map0 )       
                               .map1(  mapcoll.map1 )
                               .map0W( mapcoll.map0W )       
@@ -213,11 +218,12 @@ namespace Gambit {
       /* Before trying to set parameter, check if there is an override defined
          for it, so that we can warn people that the value they are trying to
          set will be masked by the override */
-      const OverrideMaps overridecoll = override_maps.at(partype);
+      const OverrideMaps& overridecoll = override_maps.at(partype);
       FptrFinder<Spec<DerivedSpec>,MapTag::Set> override_finder =                                
                        SetMaps<Spec<DerivedSpec>,MapTag::Set>(Par::toString.at(partype),this)
                               .omap0( overridecoll.m0 ) 
                               .omap1( overridecoll.m1 )
+                              .ovalues( override_values )
                               .override_only(true); // switch to permit search of only override maps
       if( override_finder.find(name,i,true,check_antiparticle) )
       { 
@@ -229,7 +235,7 @@ namespace Gambit {
       // else no problem
 
       /* Create finder object, tell it what maps to search, and do the search */
-      const MapCollection<MTset> mapcoll = setter_maps.at(partype);
+      const MapCollection<MTset>& mapcoll = setter_maps.at(partype);
       FptrFinder<Spec<DerivedSpec>,MapTag::Set> finder =                                
                        SetMaps<Spec<DerivedSpec>,MapTag::Set>(Par::toString.at(partype),this)
                               .map0(  mapcoll.map0 )       
@@ -259,11 +265,12 @@ namespace Gambit {
       else if(check_overrides == ignore_overrides){overrides=false; override_only=false;}
  
       /* Create finder object, tell it what maps to search, and do the search */
-      const OverrideMaps         overridecoll = override_maps.at(partype);
-      const MapCollection<MTget> mapcoll      = getter_maps.at(partype);
+      const OverrideMaps&         overridecoll = override_maps.at(partype);
+      const MapCollection<MTget>& mapcoll      = getter_maps.at(partype);
       FptrFinder<Spec<DerivedSpec>,MapTag::Get> finder =                                
                        SetMaps<Spec<DerivedSpec>,MapTag::Get>(Par::toString.at(partype),this)
                               .omap2( overridecoll.m2 )
+                              .ovalues( override_values )
                               .map2(  mapcoll.map2 )
                               .map2W( mapcoll.map2W )
                               .map2M( mapcoll.map2_extraM )
@@ -285,11 +292,12 @@ namespace Gambit {
       else if(check_overrides == ignore_overrides){overrides=false; override_only=false;}
  
       /* Create finder object, tell it what maps to search, and do the search */
-      const OverrideMaps         overridecoll = override_maps.at(partype);
-      const MapCollection<MTget> mapcoll      = getter_maps.at(partype);
+      const OverrideMaps&         overridecoll = override_maps.at(partype);
+      const MapCollection<MTget>& mapcoll      = getter_maps.at(partype);
       FptrFinder<Spec<DerivedSpec>,MapTag::Get> finder =                                
                        SetMaps<Spec<DerivedSpec>,MapTag::Get>(Par::toString.at(partype),this)
                               .omap2( overridecoll.m2 )
+                              .ovalues( override_values )
                               .map2(  mapcoll.map2 )
                               .map2W( mapcoll.map2W )
                               .map2M( mapcoll.map2_extraM )
@@ -307,7 +315,7 @@ namespace Gambit {
       typedef typename DerivedSpec::MTset MTset;
 
       /* Create finder object, tell it what maps to search, and do the search */
-      const MapCollection<MTset> mapcoll = setter_maps.at(partype);
+      const MapCollection<MTset>& mapcoll = setter_maps.at(partype);
       FptrFinder<Spec<DerivedSpec>,MapTag::Set> finder =                                
                        SetMaps<Spec<DerivedSpec>,MapTag::Set>(Par::toString.at(partype),this)
                               .map2(  mapcoll.map2 )
@@ -320,6 +328,98 @@ namespace Gambit {
 
    /// @}
 
+   /// @{ Handles
+
+   template <class DerivedSpec>
+   SpecParHandle Spec<DerivedSpec>::get_handle(const Par::Tags partype, const str& name, const SpecOverrideOptions check_overrides, const SafeBool check_antiparticle) const
+   {
+      bool overrides=true;
+      bool override_only=false;
+      if     (check_overrides == use_overrides) {  overrides=true;  override_only=false; }
+      else if(check_overrides == overrides_only){  overrides=true;  override_only=true; }
+      else if(check_overrides == ignore_overrides){overrides=false; override_only=false;}
+
+      /* Do the search once, as in get(), and keep the result */
+      const OverrideMaps&         overridecoll = override_maps.at(partype);
+      const MapCollection<MTget>& mapcoll      = getter_maps.at(partype);
+      FptrFinder<Spec<DerivedSpec>,MapTag::Get> finder =
+                       SetMaps<Spec<DerivedSpec>,MapTag::Get>(Par::toString.at(partype),this)
+                              .omap0( overridecoll.m0 )
+                              .omap1( overridecoll.m1 )
+                              .map0(  mapcoll.map0 )
+                              .map1(  mapcoll.map1 )
+                              .map0W( mapcoll.map0W )
+                              .map1W( mapcoll.map1W )
+                              .map0M( mapcoll.map0_extraM )
+                              .map1M( mapcoll.map1_extraM )
+                              .map0I( mapcoll.map0_extraI )
+                              .map1I( mapcoll.map1_extraI )
+                              .override_only(override_only)
+                              .no_overrides(not overrides);
+      if( not finder.find(name,true,check_antiparticle) ) finder.raise_error(LOCAL_INFO);
+      return SpecParHandle(partype, name, 0, 0, 0, check_overrides, static_cast<bool>(check_antiparticle),
+                           override_layout, finder.callfcn.override_slot(), finder.callfcn.accessor());
+   }
+
+   template <class DerivedSpec>
+   SpecParHandle Spec<DerivedSpec>::get_handle(const Par::Tags partype, const str& name, const int i, const SpecOverrideOptions check_overrides, const SafeBool check_antiparticle) const
+   {
+      bool overrides=true;
+      bool override_only=false;
+      if     (check_overrides == use_overrides) {  overrides=true;  override_only=false; }
+      else if(check_overrides == overrides_only){  overrides=true;  override_only=true; }
+      else if(check_overrides == ignore_overrides){overrides=false; override_only=false;}
+
+      /* Do the search once, as in get(), and keep the result */
+      const OverrideMaps&         overridecoll = override_maps.at(partype);
+      const MapCollection<MTget>& mapcoll      = getter_maps.at(partype);
+      FptrFinder<Spec<DerivedSpec>,MapTag::Get> finder =
+                       SetMaps<Spec<DerivedSpec>,MapTag::Get>(Par::toString.at(partype),this)
+                              .omap0( overridecoll.m0 )
+                              .omap1( overridecoll.m1 )
+                              .map0(  mapcoll.map0 )
+                              .map1(  mapcoll.map1 )
+                              .map0W( mapcoll.map0W )
+                              .map1W( mapcoll.map1W )
+                              .map0M( mapcoll.map0_extraM )
+                              .map1M( mapcoll.map1_extraM )
+                              .map0I( mapcoll.map0_extraI )
+                              .map1I( mapcoll.map1_extraI )
+                              .override_only(override_only)
+                              .no_overrides(not overrides);
+      if( not finder.find(name,i,true,check_antiparticle) ) finder.raise_error(LOCAL_INFO);
+      return SpecParHandle(partype, name, 1, i, 0, check_overrides, static_cast<bool>(check_antiparticle),
+                           override_layout, finder.callfcn.override_slot(), finder.callfcn.accessor());
+   }
+
+   template <class DerivedSpec>
+   SpecParHandle Spec<DerivedSpec>::get_handle(const Par::Tags partype, const str& name, const int i, const int j, const SpecOverrideOptions check_overrides) const
+   {
+      bool overrides=true;
+      bool override_only=false;
+      if     (check_overrides == use_overrides) {  overrides=true;  override_only=false; }
+      else if(check_overrides == overrides_only){  overrides=true;  override_only=true; }
+      else if(check_overrides == ignore_overrides){overrides=false; override_only=false;}
+
+      /* Do the search once, as in get(), and keep the result */
+      const OverrideMaps&         overridecoll = override_maps.at(partype);
+      const MapCollection<MTget>& mapcoll      = getter_maps.at(partype);
+      FptrFinder<Spec<DerivedSpec>,MapTag::Get> finder =
+                       SetMaps<Spec<DerivedSpec>,MapTag::Get>(Par::toString.at(partype),this)
+                              .omap2( overridecoll.m2 )
+                              .map2(  mapcoll.map2 )
+                              .map2W( mapcoll.map2W )
+                              .map2M( mapcoll.map2_extraM )
+                              .map2I( mapcoll.map2_extraI )
+                              .override_only(override_only)
+                              .no_overrides(not overrides);
+      if( not finder.find(name,i,j) ) finder.raise_error(LOCAL_INFO);
+      return SpecParHandle(partype, name, 2, i, j, check_overrides, false,
+                           override_layout, finder.callfcn.override_slot(), finder.callfcn.accessor());
+   }
+
+   /// @}
+
    /// @}
 
 }
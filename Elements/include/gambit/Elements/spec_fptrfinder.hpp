@@ -62,6 +62,7 @@ namespace Gambit {
           , omap0_(NULL)
           , omap1_(NULL)
           , omap2_(NULL)
+          , ovalues_(NULL)
          {}
 
          /// Version to deal with const host object
@@ -86,6 +87,7 @@ namespace Gambit {
           , omap0_(NULL)
           , omap1_(NULL)
           , omap2_(NULL)
+          , ovalues_(NULL)
          {}
 
          /// Type of derived spectrum wrapper is known to HostSpec as D
@@ -105,9 +107,11 @@ namespace Gambit {
          SetMaps& map1I(const typename MapTypes<D,MTag>::fmap1_extraI& map1I){ map1I_=&map1I; return *this; }
          SetMaps& map2I(const typename MapTypes<D,MTag>::fmap2_extraI& map2I){ map2I_=&map2I; return *this; }
          /// base class override maps
-         SetMaps& omap0(const std::map<std::string,double>& om0)              { omap0_=&om0; return *this;}
-         SetMaps& omap1(const std::map<std::string,std::map<int,double>>& om1){ omap1_=&om1; return *this;}
-         SetMaps& omap2(const std::map<std::string,std::map<int,std::map<int,double>>>& om2){ omap2_=&om2; return *this;}
+         SetMaps& omap0(const std::map<std::string,int>& om0)              { omap0_=&om0; return *this;}
+         SetMaps& omap1(const std::map<std::string,std::map<int,int>>& om1){ omap1_=&om1; return *this;}
+         SetMaps& omap2(const std::map<std::string,std::map<int,std::map<int,int>>>& om2){ omap2_=&om2; return *this;}
+         /// base class override values (indexed by the entries of the override maps)
+         SetMaps& ovalues(const std::vector<double>& ov){ ovalues_=&ov; return *this;}
          /// Flag to disable searching of override maps (for retrieving original, unoverriden values)
          SetMaps& no_overrides(const bool flag) { no_overrides_=flag; return *this;}
          /// Flag to permit searching only override maps
@@ -137,9 +141,10 @@ namespace Gambit {
          const typename MapTypes<D,MTag>::fmap2_extraI* map2I_; 
           
          /// Maps from base class (override maps, only used in getter case)
-         const std::map<std::string,double>*                             omap0_;
-         const std::map<std::string,std::map<int,double>>*               omap1_;
-         const std::map<std::string,std::map<int,std::map<int,double>>>* omap2_;
+         const std::map<std::string,int>*                             omap0_;
+         const std::map<std::string,std::map<int,int>>*               omap1_;
+         const std::map<std::string,std::map<int,std::map<int,int>>>* omap2_;
+         const std::vector<double>* ovalues_;
    }; 
  
    /// Helper class for calling function pointers found by FptrFinder
@@ -176,9 +181,11 @@ namespace Gambit {
 
          /// Pointers to const maps to use for search
          /// Maps from base class (override maps, should only be used in getter case)
-         const std::map<std::string,double>*                             omap0_;
-         const std::map<std::string,std::map<int,double>>*               omap1_;
-         const std::map<std::string,std::map<int,std::map<int,double>>>* omap2_;
+         const std::map<std::string,int>*                             omap0_;
+         const std::map<std::string,std::map<int,int>>*               omap1_;
+         const std::map<std::string,std::map<int,std::map<int,int>>>* omap2_;
+         /// Override values, indexed by the entries of the override maps
+         const std::vector<double>* ovalues_;
          /// Maps filled by derived (wrapper) classes
          const typename MapTypes<D,MTag>::fmap0*        map0_;
          const typename MapTypes<D,MTag>::fmap1*        map1_; 
@@ -195,9 +202,9 @@ namespace Gambit {
 
          /// Iterators needed for storing locatation of search result
          /// ...for override values
-         std::map<std::string,double>::const_iterator                ito0; // 0
-         std::map<std::string,std::map<int,double>>::const_iterator  ito1; // 1
-         std::map<std::string,std::map<int,std::map<int,double>>>::const_iterator ito2; // 2
+         std::map<std::string,int>::const_iterator                ito0; // 0
+         std::map<std::string,std::map<int,int>>::const_iterator  ito1; // 1
+         std::map<std::string,std::map<int,std::map<int,int>>>::const_iterator ito2; // 2
          /// ...for derived class values
          typename MapTypes<D,MTag>::fmap0::const_iterator        it0;  // 3
          typename MapTypes<D,MTag>::fmap1::const_iterator        it1;  // 6
@@ -213,9 +220,9 @@ namespace Gambit {
          typename MapTypes<D,MTag>::fmap2_extraI::const_iterator it2I; // 11
 
          /// empty maps used to initialise the above iterators
-         static const std::map<std::string,double>                nullmap_ito0; // 0
-         static const std::map<std::string,std::map<int,double>>  nullmap_ito1; // 1
-         static const std::map<std::string,std::map<int,std::map<int,double>>> nullmap_ito2; // 2
+         static const std::map<std::string,int>                nullmap_ito0; // 0
+         static const std::map<std::string,std::map<int,int>>  nullmap_ito1; // 1
+         static const std::map<std::string,std::map<int,std::map<int,int>>> nullmap_ito2; // 2
          static const typename MapTypes<D,MTag>::fmap0        nullmap_it0;  // 3
          static const typename MapTypes<D,MTag>::fmap1        nullmap_it1;  // 6
          static const typename MapTypes<D,MTag>::fmap2        nullmap_it2;  // 9 //was 7
@@ -284,6 +291,7 @@ namespace Gambit {
            , omap0_(params.omap0_)   
            , omap1_(params.omap1_)   
            , omap2_(params.omap2_)   
+           , ovalues_(params.ovalues_)
            , map0_ (params.map0_)   
            , map1_ (params.map1_)
            , map2_ (params.map2_)
@@ -479,7 +487,7 @@ namespace Gambit {
             if( omap1_!=NULL and search_map(name,omap1_,ito1) )
             { 
                // Check that index (key) exists in inner map
-               std::map<int,double>::const_iterator it = ito1->second.find(i);
+               std::map<int,int>::const_iterator it = ito1->second.find(i);
                if( it != ito1->second.end() )
                { 
                   found=true; 
@@ -503,11 +511,11 @@ namespace Gambit {
             if( omap2_!=NULL and search_map(name,omap2_,ito2) )
             {  
                // Check that first index (key) exists in inner map
-               std::map<int,std::map<int,double>>::const_iterator jt = ito2->second.find(i);
+               std::map<int,std::map<int,int>>::const_iterator jt = ito2->second.find(i);
                if( jt != ito2->second.end() )
                { 
                   // Check that second index (key) exists in second-inner map
-                  std::map<int,double>::const_iterator jt2 = jt->second.find(j);
+                  std::map<int,int>::const_iterator jt2 = jt->second.find(j);
                   if( jt2 != jt->second.end() )
                   { 
                      found=true; 
@@ -751,9 +759,9 @@ namespace Gambit {
    }; // end class FptrFinder
 
    /// Initialise static members of FptrFinder
-   template<class HS, class MT> const std::map<std::string,double>                FptrFinder<HS,MT>::nullmap_ito0 = std::map<std::string,double>              (); // 0
-   template<class HS, class MT> const std::map<std::string,std::map<int,double>>  FptrFinder<HS,MT>::nullmap_ito1 = std::map<std::string,std::map<int,double>>(); // 1
-   template<class HS, class MT> const std::map<std::string,std::map<int,std::map<int,double>>> FptrFinder<HS,MT>::nullmap_ito2 = std::map<std::string,std::map<int,std::map<int,double>>>(); // 2
+   template<class HS, class MT> const std::map<std::string,int>                FptrFinder<HS,MT>::nullmap_ito0 = std::map<std::string,int>              (); // 0
+   template<class HS, class MT> const std::map<std::string,std::map<int,int>>  FptrFinder<HS,MT>::nullmap_ito1 = std::map<std::string,std::map<int,int>>(); // 1
+   template<class HS, class MT> const std::map<std::string,std::map<int,std::map<int,int>>> FptrFinder<HS,MT>::nullmap_ito2 = std::map<std::string,std::map<int,std::map<int,int>>>(); // 2
    /// ...for derived class values
    template<class HS, class MT> const typename MapTypes<typename HS::D,MT>::fmap0        FptrFinder<HS,MT>::nullmap_it0  = typename MapTypes<typename HS::D,MT>::fmap0       (); // 3
    template<class HS, class MT> const typename MapTypes<typename HS::D,MT>::fmap1        FptrFinder<HS,MT>::nullmap_it1  = typename MapTypes<typename HS::D,MT>::fmap1       (); // 6
@@ -787,6 +795,102 @@ namespace Gambit {
         : ff(host) 
       {}
 
+      /// Slot in the override values of the entry found, or -1 if the search did not find an override
+      int override_slot() const
+      {
+         switch( ff->whichiter )
+         {
+            case 0:
+              ff->check(ff->ito0_safe());
+              return ff->ito0->second;
+            case 1:
+              ff->check(ff->ito1_safe());
+              ff->check_index_initd(LOCAL_INFO,ff->index1,"index1");
+              return (ff->ito1->second).at(ff->index1);
+            case 2:
+              ff->check(ff->ito2_safe());
+              ff->check_index_initd(LOCAL_INFO,ff->index1,"index1");
+              ff->check_index_initd(LOCAL_INFO,ff->index2,"index2");
+              return (ff->ito2->second).at(ff->index1).at(ff->index2);
+         }
+         return -1;
+      }
+
+      /// Accessor that calls the wrapper function found by the search on any SubSpectrum of
+      /// type HostSpec, with the same indices (for SpecParHandle). Empty if the search failed
+      /// or found an override.
+      SpecAccessor accessor() const
+      {
+         if(ff->error_code!=0) return SpecAccessor();
+         const int i = ff->index1;
+         const int j = ff->index2;
+         switch( ff->whichiter )
+         {
+            case 3: {
+              ff->check(ff->it0_safe());
+              typename MT::FSptr f = ff->it0->second;
+              return [f](const SubSpectrum& s) -> double { return (static_cast<const HostSpec&>(s).model().*f)(); };}
+            case 4: {
+              ff->check(ff->it0M_safe());
+              typename MT::plainfptrM f = ff->it0M->second;
+              return [f](const SubSpectrum& s) -> double { return (*f)(static_cast<const HostSpec&>(s).model()); };}
+            case 5: {
+              ff->check(ff->it0I_safe());
+              typename MT::plainfptrI f = ff->it0I->second;
+              return [f](const SubSpectrum& s) -> double { return (*f)(static_cast<const HostSpec&>(s).input()); };}
+            case 6: {
+              ff->check(ff->it1_safe());
+              ff->check_index_initd(LOCAL_INFO,i,"index1");
+              typename MT::FSptr1 f = ff->it1->second.fptr;
+              return [f,i](const SubSpectrum& s) -> double { return (static_cast<const HostSpec&>(s).model().*f)(i); };}
+            case 7: {
+              ff->check(ff->it1M_safe());
+              ff->check_index_initd(LOCAL_INFO,i,"index1");
+              typename MT::plainfptrM1 f = ff->it1M->second.fptr;
+              return [f,i](const SubSpectrum& s) -> double { return (*f)(static_cast<const HostSpec&>(s).model(),i); };}
+            case 8: {
+              ff->check(ff->it1I_safe());
+              ff->check_index_initd(LOCAL_INFO,i,"index1");
+              typename MT::plainfptrI1 f = ff->it1I->second.fptr;
+              return [f,i](const SubSpectrum& s) -> double { return (*f)(static_cast<const HostSpec&>(s).input(),i); };}
+            case 9: {
+              ff->check(ff->it2_safe());
+              ff->check_index_initd(LOCAL_INFO,i,"index1");
+              ff->check_index_initd(LOCAL_INFO,j,"index2");
+              typename MT::FSptr2 f = ff->it2->second.fptr;
+              return [f,i,j](const SubSpectrum& s) -> double { return (static_cast<const HostSpec&>(s).model().*f)(i,j); };}
+            case 10: {
+              ff->check(ff->it2M_safe());
+              ff->check_index_initd(LOCAL_INFO,i,"index1");
+              ff->check_index_initd(LOCAL_INFO,j,"index2");
+              typename MT::plainfptrM2 f = ff->it2M->second.fptr;
+              return [f,i,j](const SubSpectrum& s) -> double { return (*f)(static_cast<const HostSpec&>(s).model(),i,j); };}
+            case 11: {
+              ff->check(ff->it2I_safe());
+              ff->check_index_initd(LOCAL_INFO,i,"index1");
+              ff->check_index_initd(LOCAL_INFO,j,"index2");
+              typename MT::plainfptrI2 f = ff->it2I->second.fptr;
+              return [f,i,j](const SubSpectrum& s) -> double { return (*f)(static_cast<const HostSpec&>(s).input(),i,j); };}
+            // Member functions of the wrapper itself (see operator() below)
+            case 12: {
+              ff->check(ff->it0W_safe());
+              typename MT::FSptrW f = ff->it0W->second;
+              return [f](const SubSpectrum& s) -> double { return (static_cast<const DerivedSpec&>(s).*f)(); };}
+            case 13: {
+              ff->check(ff->it1W_safe());
+              ff->check_index_initd(LOCAL_INFO,i,"index1");
+              typename MT::FSptr1W f = ff->it1W->second.fptr;
+              return [f,i](const SubSpectrum& s) -> double { return (static_cast<const DerivedSpec&>(s).*f)(i); };}
+            case 14: {
+              ff->check(ff->it2W_safe());
+              ff->check_index_initd(LOCAL_INFO,i,"index1");
+              ff->check_index_initd(LOCAL_INFO,j,"index2");
+              typename MT::FSptr2W f = ff->it2W->second.fptr;
+              return [f,i,j](const SubSpectrum& s) -> double { return (static_cast<const DerivedSpec&>(s).*f)(i,j); };}
+         }
+         return SpecAccessor();
+      }
+
       double operator()()
       {
          double result(-1); // should not be returned in this state
@@ -797,20 +901,16 @@ namespace Gambit {
             switch( ff->whichiter )
             {
                // Override retrieval cases
-               case 0: {
-                 ff->check(ff->ito0_safe());
-                 result = ff->ito0->second;
-                 break;}
-               case 1: {
-                 ff->check(ff->ito1_safe());
-                 ff->check_index_initd(LOCAL_INFO,ff->index1,"index1");
-                 result = (ff->ito1->second).at(ff->index1);
-                 break;}
+               case 0:
+               case 1:
                case 2: {
-                 ff->check(ff->ito2_safe());
-                 ff->check_index_initd(LOCAL_INFO,ff->index1,"index1");
-                 ff->check_index_initd(LOCAL_INFO,ff->index2,"index2");
-                 result = (ff->ito2->second).at(ff->index1).at(ff->index2);
+                 if(ff->ovalues_==NULL)
+                 {
+                   std::ostringstream errmsg;
+                   errmsg << "Error! FptrFinder found an override entry, but was not given the override values to retrieve it from. This is a bug in the SubSpectrum class; please report it! (this FptrFinder has label="<<ff->label<<")"<<std::endl;
+                   utils_error().forced_throw(LOCAL_INFO,errmsg.str());
+                 }
+                 result = ff->ovalues_->at(override_slot());
                  break;}
                // Wrapper class function call cases
                case 3: {
@@ -119,6 +119,12 @@ namespace Gambit
          bool   has(const Par::Tags, const str&, const int, const int, const SpecOverrideOptions=use_overrides) const;
          double get(const Par::Tags, const str&, const int, const int, const SpecOverrideOptions=use_overrides) const;
 
+         /* Handles for fast repeated retrieval of parameters (see SpecParHandle) */
+         SpecParHandle get_handle(const Par::Tags, const str&, const SpecOverrideOptions=use_overrides, const SafeBool=SafeBool(true)) const;
+         SpecParHandle get_handle(const Par::Tags, const str&, const int, const SpecOverrideOptions=use_overrides, const SafeBool=SafeBool(true)) const;
+         SpecParHandle get_handle(const Par::Tags, const str&, const int, const int, const SpecOverrideOptions=use_overrides) const;
+         using SubSpectrum::get;
+
          /* Setter declarations, for setting parameters in a derived model object,
             and for overriding model object values with values stored outside
             the model object (for when values cannot be inserted back into the
@@ -202,7 +208,14 @@ namespace Gambit
          /// This uses the "Contents" class to verify (once, not every construction)
          /// that this wrapper provides all the basic functionality that it is
          /// supposed to.
-         Spec() { static VerifyContents<Contents> runonce(*this); };
+         Spec()
+         {
+           static VerifyContents<Contents> runonce(*this);
+           // All objects of this type start with the same override layout, so
+           // handles work across them.
+           static const unsigned long initial_layout = new_override_layout();
+           override_layout = initial_layout;
+         };
        
          /// Virtual destructor
          virtual ~Spec() {};
@@ -15,6 +15,12 @@
 ///  For running parameters, one should access them via the getters of "LE" or
 ///  "HE" subspectra.
 ///
+///  Copies of a Spectrum share its SubSpectrum
+///  objects.  The first non-const access to a
+///  shared SubSpectrum wraps it in an overlay
+///  (see subspectrum_overlay.hpp), so that any
+///  overrides added are kept by the copy alone.
+///
 ///  *********************************************
 ///
 ///  Authors:
@@ -124,8 +130,8 @@ namespace Gambit
 
          /// Variables
          /// @{
-         std::unique_ptr<SubSpectrum> LE_new; // low energy model
-         std::unique_ptr<SubSpectrum> HE_new; // high energy model
+         std::shared_ptr<SubSpectrum> LE_new; // low energy model
+         std::shared_ptr<SubSpectrum> HE_new; // high energy model
          SubSpectrum* LE;
          SubSpectrum* HE;
          SMInputs SMINPUTS;
@@ -138,6 +144,9 @@ namespace Gambit
          /// Check if object has been fully initialised
          void check_init() const;
 
+         /// Prepare an owned SubSpectrum for modification, by putting it in an overlay if it is shared
+         static SubSpectrum* make_mutable(std::shared_ptr<SubSpectrum>&);
+
          ///Calculate Wolfenstein rho+i*eta from rhobar and etabar
          static std::complex<double> rhoplusieta(double, double, double, double);
 
@@ -145,7 +154,7 @@ namespace Gambit
 
          /// @{ Constructors/Destructors
          /// Need custom copy and move constructors plus copy-assignment operator
-         /// in order to manage the unique_ptrs properly.
+         /// in order to manage the shared SubSpectrum objects properly.
 
          /// Default constructor
          Spectrum();
@@ -159,7 +168,7 @@ namespace Gambit
          /// (won't make a version of this taking a pointer, since this is an "advanced" task, let people use the full contructor to do it.)
          Spectrum(const SubSpectrum& he, const SMInputs& smi, const std::map<str, safe_ptr<double> >* input_Param, const mc_info&, const mr_info&);
 
-         /// Copy constructor, clones SubSpectrum objects.
+         /// Copy constructor, shares owned SubSpectrum objects and clones wrapped ones.
          /// Make a non-const copy in order to use e.g. RunBothToScale function.
          Spectrum(const Spectrum& other);
          /// Copy-assignment
@@ -180,6 +189,8 @@ namespace Gambit
          /// @{ Standard SubSpectrum getters
          /// Return references to internal data members. Make sure original Spectrum object doesn't
          /// get destroyed before you finish using these or you will cause a segfault.
+         /// The non-const versions first make sure that the SubSpectrum is not shared with any copy,
+         /// so don't keep the references they return across copies of the Spectrum.
          SubSpectrum& get_LE();
          SubSpectrum& get_HE();
          SMInputs&    get_SMInputs();
@@ -30,6 +30,8 @@
 #include <set>
 #include <cfloat>
 #include <sstream>
+#include <memory>
+#include <functional>
 
 #include "gambit/Utils/cats.hpp"
 #include "gambit/Utils/safebool.hpp"
@@ -71,12 +73,70 @@ namespace Gambit
    };
 
    /// Definition of struct to hold various override values for a given ParamTag
+   /// The maps hold the index ("slot") of each value in SubSpectrum::override_values,
+   /// so that handles to overridden parameters can refer to them directly.
    struct OverrideMaps
    {
-      std::map<str,double>                             m0; // No indices
-      std::map<str,std::map<int,double>>               m1; // One index
-      std::map<str,std::map<int,std::map<int,double>>> m2; // Two indices
-      /* e.g. retrieve like this: contents = m2[name][i][j]; */
+      std::map<str,int>                          m0; // No indices
+      std::map<str,std::map<int,int>>            m1; // One index
+      std::map<str,std::map<int,std::map<int,int>>> m2; // Two indices
+      /* e.g. retrieve like this: contents = override_values[m2[name][i][j]]; */
+   };
+
+   /// Function retrieving one parameter directly from a SubSpectrum
+   typedef std::function<double(const SubSpectrum&)> SpecAccessor;
+
+   /// Handle to a SubSpectrum parameter, obtained from SubSpectrum::get_handle.
+   /// The string search for the parameter (through the override maps, the
+   /// antiparticle names and the particle database) is done once, when the
+   /// handle is created, so that retrieving the value with
+   /// SubSpectrum::get(handle) is just a direct function call or array lookup.
+   /// A handle can be used with any SubSpectrum of the same type as the one that
+   /// created it, with the same overrides added in the same order (e.g. the
+   /// spectra of later parameter points, or clones); with any other SubSpectrum,
+   /// or after a new override has been added, it falls back to the usual string
+   /// search.
+   class SpecParHandle
+   {
+      public:
+         /// Unresolved handle (always uses the string search)
+         SpecParHandle()
+           : tag(Par::Tags()), nindices(-1), i(0), j(0), check_overrides(use_overrides)
+           , check_antiparticle(true), layout(0), slot(-1)
+         {}
+
+         /// Constructor used by SubSpectrum::get_handle. Give either an override
+         /// slot or an accessor, as found by the search; neither if the search
+         /// result cannot be cached.
+         SpecParHandle(const Par::Tags tag_in, const str& name_in, const int nindices_in,
+                       const int i_in, const int j_in, const SpecOverrideOptions check_overrides_in,
+                       const bool check_antiparticle_in, const unsigned long layout_in,
+                       const int slot_in, const SpecAccessor& accessor_in)
+           : tag(tag_in), name(name_in), nindices(nindices_in), i(i_in), j(j_in)
+           , check_overrides(check_overrides_in), check_antiparticle(check_antiparticle_in)
+           , layout(layout_in), slot(slot_in), accessor(accessor_in)
+         {}
+
+         /// Name of the parameter
+         const str& getName() const { return name; }
+
+      private:
+         friend class SubSpectrum;
+
+         /// Original request, for the string search fallback
+         Par::Tags tag;
+         str name;
+         int nindices;
+         int i, j;
+         SpecOverrideOptions check_overrides;
+         bool check_antiparticle;
+
+         /// Override layout of the SubSpectrum that resolved the handle (0 if unresolved)
+         unsigned long layout;
+         /// Slot in override_values holding the value, or -1
+         int slot;
+         /// Direct accessor for the value, if it is not an override
+         SpecAccessor accessor;
    };
 
 
@@ -86,10 +146,12 @@ namespace Gambit
    // This is the interface class that most module-writers see
    class SubSpectrum
    {
+      /// Overlays copy the overrides of the SubSpectrum that they wrap
+      friend class SubSpectrumOverlay;
 
       public:
          /// @{ Constructors/destructors
-         SubSpectrum() : override_maps(create_override_maps()) {}
+         SubSpectrum() : override_maps(create_override_maps()), override_layout(new_override_layout()) {}
          virtual ~SubSpectrum() {}
          /// @}
 
@@ -110,6 +172,13 @@ namespace Gambit
          /// Add spectrum information to an SLHAea object (if possible)
          virtual void add_to_SLHAea(int, SLHAstruct&) const {}
 
+         /// Add spectrum information to an SLHAea object (if possible), taking the values of
+         /// the parameters from another SubSpectrum that wraps this one (e.g. a SubSpectrumOverlay).
+         /// Wrappers that write their parameters using their own getters should override this
+         /// and have add_to_SLHAea call it with *this; others can ignore the values.
+         virtual void add_to_SLHAea_from(int slha_version, SLHAstruct& slha, const SubSpectrum& /*values*/) const
+         { add_to_SLHAea(slha_version, slha); }
+
          /// There may be more than one *new* stable particle
          ///  this method will tell you how many.
          /// If more than zero you probbaly *need* to know what model
@@ -161,6 +230,16 @@ namespace Gambit
          virtual bool   has(const Par::Tags, const str&, const int, const int, const SpecOverrideOptions=use_overrides) const = 0;
          virtual double get(const Par::Tags, const str&, const int, const int, const SpecOverrideOptions=use_overrides) const = 0;
 
+         /* Handles for fast repeated retrieval of parameters. The arguments are the
+            same as for the getters above; see SpecParHandle. The base class versions
+            return handles that just redo the string search. */
+         virtual SpecParHandle get_handle(const Par::Tags, const str&, const SpecOverrideOptions=use_overrides, const SafeBool check_antiparticle = SafeBool(true)) const;
+         virtual SpecParHandle get_handle(const Par::Tags, const str&, const int, const SpecOverrideOptions=use_overrides, const SafeBool check_antiparticle = SafeBool(true)) const;
+         virtual SpecParHandle get_handle(const Par::Tags, const str&, const int, const int, const SpecOverrideOptions=use_overrides) const;
+
+         /// Retrieve the parameter referred to by a handle
+         double get(const SpecParHandle&) const;
+
          /* Setter declarations, for setting parameters in a derived model object,
             and for overriding model object values with values stored outside
             the model object (for when values cannot be inserted back into the
@@ -263,12 +342,55 @@ namespace Gambit
          /// Initialiser function for override_maps
          static std::map<Par::Tags,OverrideMaps> create_override_maps();
 
+         /// Set the override value in the slot given by slots[key], adding a new slot if needed
+         template<class Key>
+         void store_override_slot(std::map<Key,int>& slots, const Key& key, const double value, const str& description);
+
+         /// @{ Store override values, with no, one or two indices
+         void store_override(const Par::Tags, const str&, const double);
+         void store_override(const Par::Tags, const str&, const int, const double);
+         void store_override(const Par::Tags, const str&, const int, const int, const double);
+         /// @}
+
      protected:
+         /// Get a new, unique value for override_layout
+         static unsigned long new_override_layout();
+
+         /// Get the override_layout that results from adding an override to a layout
+         static unsigned long next_override_layout(const unsigned long, const str&);
+
          /// Map of override maps
          std::map<Par::Tags,OverrideMaps> override_maps;
 
+         /// Override values, indexed by the slots in override_maps
+         std::vector<double> override_values;
+
+         /// Identifies the type of the object together with the assignment of
+         /// override slots; handles resolved with the same layout are valid. Changes
+         /// whenever a new override is added.
+         unsigned long override_layout;
+
    };
 
+   /// Retrieve the parameter referred to by a handle
+   inline double SubSpectrum::get(const SpecParHandle& h) const
+   {
+      if(h.layout == override_layout)
+      {
+         if(h.slot >= 0) return override_values[h.slot];
+         if(h.accessor) return h.accessor(*this);
+      }
+      // Handle is not valid for this object (any more), so do the full search
+      switch(h.nindices)
+      {
+         case 0: return get(h.tag, h.name, h.check_overrides, SafeBool(h.check_antiparticle));
+         case 1: return get(h.tag, h.name, h.i, h.check_overrides, SafeBool(h.check_antiparticle));
+         case 2: return get(h.tag, h.name, h.i, h.j, h.check_overrides);
+      }
+      utils_error().forced_throw(LOCAL_INFO,"Tried to retrieve a SubSpectrum parameter using a handle that was never set up with get_handle!");
+      return 0;
+   }
+
 } // end namespace Gambit
 
 // Undef the various helper macros to avoid contaminating other files
@@ -0,0 +1,120 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  SubSpectrum wrapper that shares another
+///  (parent) SubSpectrum and keeps any overrides
+///  added to it to itself.  Creating or cloning
+///  an overlay only copies the override values,
+///  not the wrapped model object, so it is cheap
+///  to derive a spectrum with a few modified
+///  parameters from a shared one.  The parent is
+///  only cloned if the overlay is run to a new
+///  scale or has a parameter set in the model
+///  object while another object still shares it.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#ifndef __subspectrum_overlay_hpp__
+#define __subspectrum_overlay_hpp__
+
+#include <memory>
+
+#include "gambit/Elements/spec.hpp"
+
+namespace Gambit
+{
+
+   class SubSpectrumOverlay;
+
+   /// The contents of an overlay are those of its parent, which have already been verified
+   struct SubSpectrumOverlayContents
+   {
+      void verify_contents(const SubSpectrum&) const {}
+   };
+
+   template <>
+   struct SpecTraits<SubSpectrumOverlay> : DefaultTraits
+   {
+      static std::string name() { return "SubSpectrumOverlay"; }
+      typedef SubSpectrumOverlayContents Contents;
+   };
+
+   /// Overrides on top of a shared SubSpectrum
+   class SubSpectrumOverlay : public Spec<SubSpectrumOverlay>
+   {
+      public:
+
+         /// Construct an overlay on parent, starting with the same overrides as the parent.
+         /// The parent must not be modified through any other pointer while the overlay exists.
+         SubSpectrumOverlay(const std::shared_ptr<SubSpectrum>& parent);
+
+         /// Create an overlay on spec.  If spec is itself an overlay, the new one is a copy
+         /// of it, sharing the same parent.
+         static std::unique_ptr<SubSpectrum> create(const std::shared_ptr<SubSpectrum>& spec);
+
+         /// Is spec an overlay?
+         static bool is_overlay(const SubSpectrum& spec);
+
+         /// @{ Forwarded to the parent
+         std::string getName() const { return parent->getName(); }
+         int get_numbers_stable_particles() const { return parent->get_numbers_stable_particles(); }
+         double hard_upper() const { return parent->hard_upper(); }
+         double soft_upper() const { return parent->soft_upper(); }
+         double soft_lower() const { return parent->soft_lower(); }
+         double hard_lower() const { return parent->hard_lower(); }
+         double GetScale() const { return parent->GetScale(); }
+         const std::map<int, int>& PDG_translator() const { return parent->PDG_translator(); }
+         /// @}
+
+         /// @{ Modify the parent, cloning it first if it is shared
+         void RunToScaleOverride(double scale);
+         void SetScale(double scale);
+         void set(const Par::Tags, const double, const str&, const SafeBool=SafeBool(true));
+         void set(const Par::Tags, const double, const str&, const int, const SafeBool=SafeBool(true));
+         void set(const Par::Tags, const double, const str&, const int, const int);
+         /// @}
+
+         /// @{ Getters and checkers; overrides held by the overlay first, then the parent
+         bool   has(const Par::Tags, const str&, const SpecOverrideOptions=use_overrides, const SafeBool=SafeBool(true)) const;
+         double get(const Par::Tags, const str&, const SpecOverrideOptions=use_overrides, const SafeBool=SafeBool(true)) const;
+         bool   has(const Par::Tags, const str&, const int, const SpecOverrideOptions=use_overrides, const SafeBool=SafeBool(true)) const;
+         double get(const Par::Tags, const str&, const int, const SpecOverrideOptions=use_overrides, const SafeBool=SafeBool(true)) const;
+         bool   has(const Par::Tags, const str&, const int, const int, const SpecOverrideOptions=use_overrides) const;
+         double get(const Par::Tags, const str&, const int, const int, const SpecOverrideOptions=use_overrides) const;
+         SpecParHandle get_handle(const Par::Tags, const str&, const SpecOverrideOptions=use_overrides, const SafeBool=SafeBool(true)) const;
+         SpecParHandle get_handle(const Par::Tags, const str&, const int, const SpecOverrideOptions=use_overrides, const SafeBool=SafeBool(true)) const;
+         SpecParHandle get_handle(const Par::Tags, const str&, const int, const int, const SpecOverrideOptions=use_overrides) const;
+         using SubSpectrum::get;
+         /// @}
+
+         /// Add spectrum information to an SLHAea object, as written by the parent but with the
+         /// values (including overrides) of this object
+         void add_to_SLHAea(int, SLHAstruct&) const;
+         void add_to_SLHAea_from(int, SLHAstruct&, const SubSpectrum&) const;
+
+      private:
+
+         typedef Spec<SubSpectrumOverlay> Base;
+
+         /// The shared SubSpectrum
+         std::shared_ptr<SubSpectrum> parent;
+
+         /// Parent, cloned first if it is shared with another object
+         SubSpectrum& mutable_parent();
+
+         /// Are there any overrides of the given type?  If not, searching them can be skipped.
+         bool has_overrides(const Par::Tags) const;
+
+         /// Handle retrieving a parameter from the parent with another handle
+         SpecParHandle parent_handle(const SpecParHandle&, const Par::Tags, const str&, const int, const int, const int,
+                                     const SpecOverrideOptions, const bool) const;
+   };
+
+}
+
+#endif
@@ -21,6 +21,11 @@
 ///
 ///  *********************************************
 
+#ifndef __virtual_higgs_hpp__
+#define __virtual_higgs_hpp__
+
+#include <array>
+#include <vector>
 
 #include "gambit/cmake/cmake_variables.hpp"
 #include "gambit/Elements/daFunk.hpp"
@@ -28,8 +33,73 @@
 
 namespace Gambit
 {
-  
+
+  /// Codes for the channels of the SM Higgs width tables (Gamma is the total width)
+  namespace SMHiggsChannel
+  {
+    enum Channel { bb, tautau, mumu, ss, cc, tt, gg, gammagamma, Zgamma, WW, ZZ, Gamma, n_channels };
+  }
+
+  /// SM Higgs branching ratios and total width Gamma [GeV], tabulated as a function of mass [GeV].
+  /// The tables are read once, on first use of get(); all channels for a given mass are then
+  /// interpolated together, in a single pass over one bin.
+  class virtual_SMHiggs_width_table
+  {
+    public:
+
+      /// Branching ratios and total width for all channels, indexed by SMHiggsChannel::Channel
+      typedef std::array<double, SMHiggsChannel::n_channels> channel_array;
+
+      /// Retrieve the table (thread-safe; reads the data files on first call)
+      static const virtual_SMHiggs_width_table& get();
+
+      /// Branching ratios and total width for all channels at mass mh
+      channel_array widths(double mh) const;
+
+      /// Branching ratio or total width for a single channel at mass mh
+      double width(SMHiggsChannel::Channel channel, double mh) const;
+
+      /// Upper or lower uncertainties on all channels at mass mh (only tabulated from 80 GeV to 1 TeV)
+      channel_array uncertainties(double mh, bool upper) const;
+
+      /// Value of a column of the table by name ("bb", "bb+", "bb-", ..., "Gamma", "Gamma+", "Gamma-")
+      double value(const str& column, double mh) const;
+
+      /// Convert a channel name into its code
+      static SMHiggsChannel::Channel channel(const str& name);
+
+      /// Range of masses covered by the tables
+      /// @{
+      double min_mass() const { return low.mass.front(); }
+      double max_mass() const { return high.mass.back(); }
+      /// @}
+
+    private:
+
+      /// One of the mass ranges, with the values of all its columns stored row by row
+      struct segment
+      {
+        std::vector<double> mass;
+        std::vector<double> values;
+        int ncols;
+        /// Interpolate n columns (first, first+stride, ...) at mass mh, writing them to result
+        void interpolate(double mh, int first, int n, int stride, double* result) const;
+      };
+
+      /// Low-mass supplement, arXiv:1307.1347, and multi-TeV supplement
+      segment low, mid, high;
+
+      /// Read in the tables
+      virtual_SMHiggs_width_table();
+
+      /// Check that mh is covered by the tables
+      void check_mass(double mh) const;
+
+  };
+
   /// Higgs branching ratios and total width Gamma [GeV], as function of mass [GeV] (90 - 300 GeV)
   double virtual_SMHiggs_widths(str, double);
   
 }
+
+#endif // __virtual_higgs_hpp__
@@ -14,7 +14,11 @@
 ///
 ///  *********************************************
 
+#include <deque>
+#include <mutex>
 #include <fstream>
+#include <algorithm>
+#include <unordered_map>
 
 #include "gambit/Elements/decay_table.hpp"
 #include "gambit/Elements/mssm_slhahelp.hpp"
@@ -55,8 +59,61 @@ namespace Gambit
   }
 
 
+  namespace
+  {
+
+    /// Table of all final states known to any DecayTable
+    struct final_state_table
+    {
+      std::mutex mutex;
+      std::map< std::multiset< std::pair<int,int> >, int > ids;
+      /// Final states, indexed by id (a deque, so references to them stay valid as it grows)
+      std::deque<DecayTable::FinalState> states;
+    };
+    final_state_table& final_states()
+    {
+      static final_state_table table;
+      return table;
+    }
+
+    /// Final states that the current thread has already looked up, keyed by the way they were specified
+    std::unordered_map<str, const DecayTable::FinalState*>& local_final_states()
+    {
+      static thread_local std::unordered_map<str, const DecayTable::FinalState*> cache;
+      return cache;
+    }
+
+  }
+
+
   // DecayTable methods
 
+  /// Retrieve the interned final state with the given particles, adding it if it is new (thread-safe).
+  const DecayTable::FinalState& DecayTable::final_state(const std::multiset< std::pair<int,int> >& particles)
+  {
+    final_state_table& table = final_states();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto it = table.ids.find(particles);
+    if (it != table.ids.end()) return table.states[it->second];
+    FinalState fs;
+    fs.id = table.states.size();
+    fs.particles = particles;
+    fs.known = true;
+    for (auto p = particles.begin(); p != particles.end(); ++p) fs.known = fs.known and Models::ParticleDB().has_particle(*p);
+    if (fs.known) for (auto p = particles.begin(); p != particles.end(); ++p) fs.long_names.push_back(Models::ParticleDB().long_name(*p));
+    table.states.push_back(fs);
+    table.ids[particles] = fs.id;
+    return table.states.back();
+  }
+
+  /// Retrieve an interned final state by its id (thread-safe).
+  const DecayTable::FinalState& DecayTable::final_state(int id)
+  {
+    final_state_table& table = final_states();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.states.at(id);
+  }
+
   /// Create a DecayTable from an SLHA file
   DecayTable::DecayTable(str slha, int context, bool force_SM_fermion_gauge_eigenstates)
    : DecayTable(read_SLHA(slha), context, force_SM_fermion_gauge_eigenstates)
@@ -169,7 +226,7 @@ namespace Gambit
     // Add the decay info
     for (auto particle = particles.begin(); particle != particles.end(); ++particle)
     {
-      auto entry = particle->second;
+      const Entry& entry = particle->second;
       if (entry.calculator != "") calculator_map[entry.calculator].insert(entry.calculator_version);
       slha.push_back(entry.getSLHAea_block(SLHA_version, particle->first, include_zero_bfs, psn));
     }
@@ -284,10 +341,11 @@ namespace Gambit
     }
   }
 
-  /// Make sure all particles listed in a set are actually known to the GAMBIT particle database
-  void DecayTable::Entry::check_particles_exist(std::multiset< std::pair<int,int> >& particles) const
+  /// Make sure all particles in a final state are actually known to the GAMBIT particle database
+  void DecayTable::Entry::check_particles_exist(const FinalState& fs) const
   {
-    for (auto final_state = particles.begin(); final_state != particles.end(); ++final_state)
+    if (fs.known) return;
+    for (auto final_state = fs.particles.begin(); final_state != fs.particles.end(); ++final_state)
     {
       if (not Models::ParticleDB().has_particle(*final_state))
       {
@@ -301,14 +359,14 @@ namespace Gambit
   }
 
   /// Make sure no NaNs have been passed to the DecayTable by nefarious backends
-  void DecayTable::Entry::check_BF_validity(double BF, double error, std::multiset< std::pair<int,int> >& key) const
+  void DecayTable::Entry::check_BF_validity(double BF, double error, const FinalState& fs) const
   {
     if (Utils::isnan(BF) or Utils::isnan(error))
     {
       std::ostringstream msg;
       msg << "NaN detected in attempt to set decay table branching fraction. " << endl
           << "Final states are: " << endl;
-      for(auto it = key.begin(); it !=key.end(); ++it)
+      for(auto it = fs.particles.begin(); it != fs.particles.end(); ++it)
       {
         msg << "  " << Models::ParticleDB().long_name(*it) << endl;
       }
@@ -319,57 +377,119 @@ namespace Gambit
     }
   }
 
+  /// Retrieve the BF and error of a channel, raising an error if it is absent
+  const std::pair<double, double>& DecayTable::Entry::channel_at(const FinalState& fs) const
+  {
+    auto channel = channels.find(fs);
+    if (channel == channels.end())
+    {
+      std::ostringstream err;
+      err << "No branching fraction exists for the requested final states:";
+      for (auto particle = fs.particles.begin(); particle != fs.particles.end(); ++particle)
+      {
+        err << " {" << particle->first << ", " << particle->second << "}";
+      }
+      model_error().raise(LOCAL_INFO,err.str());
+    }
+    return channel->second;
+  }
+
+  /// Look up a final state in the cache of the calling thread
+  const DecayTable::FinalState* DecayTable::Entry::cached_final_state(const str& key)
+  {
+    auto& cache = local_final_states();
+    auto it = cache.find(key);
+    return it == cache.end() ? NULL : it->second;
+  }
+
+  /// Store a final state in the cache of the calling thread
+  void DecayTable::Entry::cache_final_state(const str& key, const FinalState& fs)
+  {
+    local_final_states()[key] = &fs;
+  }
+
+  /// Retrieve the interned final state for a list of particles. 1. PDG-context integer pairs (array)
+  const DecayTable::FinalState& DecayTable::Entry::final_state(const std::pair<int,int>* daughters, size_t n)
+  {
+    // Key on the sorted pairs, so that any ordering of the same particles shares a cache entry.
+    // Pair keys start with a character that cannot begin a particle name.
+    std::vector<std::pair<int,int> > sorted(daughters, daughters+n);
+    std::sort(sorted.begin(), sorted.end());
+    str key(1, '\x1d');
+    key.append(reinterpret_cast<const char*>(sorted.data()), n*sizeof(std::pair<int,int>));
+    const FinalState* fs = cached_final_state(key);
+    if (fs == NULL)
+    {
+      fs = &DecayTable::final_state(std::multiset< std::pair<int,int> >(daughters, daughters+n));
+      cache_final_state(key, *fs);
+    }
+    return *fs;
+  }
+
+  /// Retrieve the interned final state for a list of particles. 2. full particle names (vector)
+  const DecayTable::FinalState& DecayTable::Entry::final_state(const std::vector<str>& daughters)
+  {
+    str key;
+    for (auto p = daughters.begin(); p != daughters.end(); ++p) construct_name_key(key, *p);
+    const FinalState* fs = cached_final_state(key);
+    if (fs == NULL)
+    {
+      std::multiset< std::pair<int,int> > particles;
+      for (auto p = daughters.begin(); p != daughters.end(); ++p) particles.insert(Models::ParticleDB().pdg_pair(*p));
+      fs = &DecayTable::final_state(particles);
+      cache_final_state(key, *fs);
+    }
+    return *fs;
+  }
+
   /// Set branching fraction for decay to a given final state. 1. PDG-context integer pairs (vector)
   void DecayTable::Entry::set_BF(double BF, double error, const std::vector<std::pair<int,int> >& daughters)
   {
-    std::multiset< std::pair<int,int> > key(daughters.begin(), daughters.end());
-    check_particles_exist(key);
-    check_BF_validity(BF, error, key);
-    channels[key] = std::pair<double, double>(BF, error);
+    const FinalState& fs = final_state(daughters.data(), daughters.size());
+    check_particles_exist(fs);
+    check_BF_validity(BF, error, fs);
+    channels[fs] = std::pair<double, double>(BF, error);
   }
 
   /// Set branching fraction for decay to a given final state. 2. full particle names (vector)
   void DecayTable::Entry::set_BF(double BF, double error, const std::vector<str>& daughters)
   {
-    std::multiset< std::pair<int,int> > key;
-    for (auto p = daughters.begin(); p != daughters.end(); ++p) key.insert(Models::ParticleDB().pdg_pair(*p));
-    check_particles_exist(key);
-    check_BF_validity(BF, error, key);
-    channels[key] = std::pair<double, double>(BF, error);
+    const FinalState& fs = final_state(daughters);
+    check_particles_exist(fs);
+    check_BF_validity(BF, error, fs);
+    channels[fs] = std::pair<double, double>(BF, error);
   }
 
   /// Check if a given final state exists in this DecayTable::Entry. 1. PDG-context integer pairs (vector)
   bool DecayTable::Entry::has_channel(const std::vector<std::pair<int,int> >& daughters) const
   {
-    std::multiset< std::pair<int,int> > key(daughters.begin(), daughters.end());
-    check_particles_exist(key);
-    return channels.find(key) != channels.end();
+    const FinalState& fs = final_state(daughters.data(), daughters.size());
+    check_particles_exist(fs);
+    return channels.find(fs) != channels.end();
   }
 
   /// Check if a given final state exists in this DecayTable::Entry. 2. full particle names (vector)
   bool DecayTable::Entry::has_channel(const std::vector<str>& daughters) const
   {
-    std::multiset< std::pair<int,int> > key;
-    for (auto p = daughters.begin(); p != daughters.end(); ++p) key.insert(Models::ParticleDB().pdg_pair(*p));
-    check_particles_exist(key);
-    return channels.find(key) != channels.end();
+    const FinalState& fs = final_state(daughters);
+    check_particles_exist(fs);
+    return channels.find(fs) != channels.end();
   }
 
   /// Retrieve branching fraction for decay to a given final state. 1. PDG-context integer pairs (vector)
   double DecayTable::Entry::BF(const std::vector<std::pair<int, int> >& daughters) const
   {
-    std::multiset< std::pair<int,int> > key(daughters.begin(), daughters.end());
-    check_particles_exist(key);
-    return channels.at(key).first;
+    const FinalState& fs = final_state(daughters.data(), daughters.size());
+    check_particles_exist(fs);
+    return channels.at(fs).first;
   }
 
   /// Retrieve branching fraction for decay to a given final state. 2. full particle names (vector)
   double DecayTable::Entry::BF(const std::vector<str>& daughters) const
   {
-    std::multiset< std::pair<int,int> > key;
-    for (auto p = daughters.begin(); p != daughters.end(); ++p) key.insert(Models::ParticleDB().pdg_pair(*p));
-    check_particles_exist(key);
-    return channels.at(key).first;
+    const FinalState& fs = final_state(daughters);
+    check_particles_exist(fs);
+    return channels.at(fs).first;
   }
 
 
@@ -381,7 +501,7 @@ namespace Gambit
   { return getSLHAea_block(v, Models::ParticleDB().pdg_pair(p,i), z, psn); }
   SLHAea::Block DecayTable::Entry::getSLHAea_block(int v, std::pair<int,int> p, bool include_zero_bfs, const mass_es_pseudonyms& psn) const
   {
-    const std::map<str, int> slha1_pdgs = boost::assign::map_list_of
+    static const std::map<str, int> slha1_pdgs = boost::assign::map_list_of
      ("~t_1"     , 1000006)
      ("~t_2"	   , 2000006)
      ("~b_1"	   , 1000005)
@@ -463,16 +583,17 @@ namespace Gambit
       {
         if (BF > 0.0 or include_zero_bfs)
         {
-          auto daughters = channel->first;
+          const FinalState& daughters = channel->final_state;
           str comment = "# BF(" + long_name + " --> ";
           line.clear();
           // Get the branching fraction and number of particles in the final state
-          line << BF << daughters.size();
+          line << BF << daughters.particles.size();
           // Get the PDG code for each daughter particle
-          for (auto daughter = daughters.begin(); daughter != daughters.end(); ++daughter)
+          int i = 0;
+          for (auto daughter = daughters.particles.begin(); daughter != daughters.particles.end(); ++daughter, ++i)
           {
             int daughter_pdg = daughter->first;
-            str daughter_long_name = Models::ParticleDB().long_name(*daughter);
+            str daughter_long_name = daughters.known ? daughters.long_names[i] : Models::ParticleDB().long_name(*daughter);
             if (v == 1)
             {
               if (psn.gauge_family_eigenstates.find(daughter_long_name) != psn.gauge_family_eigenstates.end())
@@ -364,6 +364,12 @@ namespace Gambit
       return safe_ptr<Options>(&myOptions);
     }
 
+    /// Freeze the options of this functor, so that lookups of them are cached (see Options::freeze).
+    void functor::freezeOptions()
+    {
+      myOptions.freeze();
+    }
+
     /// Test whether the functor is allowed (either explicitly or implicitly) to be used with a given model
     bool functor::modelAllowed(str model)
     {
@@ -580,15 +586,9 @@ namespace Gambit
                                                  Models::ModelFunctorClaw &claw)
     : functor                  (func_name, func_capability, result_type, origin_name, claw),
       myTimingPrintFlag        (false),
-      start                    (NULL),
-      end                      (NULL),
+      states                   (NULL),
       point_exception_raised   (false),
-      runtime_average          (FUNCTORS_RUNTIME_INIT),           // default 1 micro second
       fadeRate                 (FUNCTORS_FADE_RATE),              // can be set individually for each functor
-      pInvalidation            (FUNCTORS_BASE_INVALIDATION_RATE),
-      needs_recalculating      (NULL),
-      already_printed          (NULL),
-      already_printed_timing   (NULL),
       iCanManageLoops          (false),
       iRunNested               (false),
       myLoopManagerCapability  ("none"),
@@ -606,12 +606,10 @@ namespace Gambit
     /// Destructor
     module_functor_common::~module_functor_common()
     {
-      if (start != NULL)                  delete [] start;
-      if (end != NULL)                    delete [] end;
-      if (needs_recalculating != NULL)    delete [] needs_recalculating;
-      if (already_printed != NULL)        delete [] already_printed;
-      if (already_printed_timing != NULL) delete [] already_printed_timing;
-      if (myCurrentIteration != NULL)     delete [] myCurrentIteration;
+      // iRunNested is fixed when the functor is registered, before any per-thread memory is allocated
+      int n = (iRunNested ? globlMaxThreads : 1);
+      Utils::delete_cache_aligned(states, n);
+      Utils::delete_cache_aligned(myCurrentIteration, n);
     }
 
     /// Check if an appropriate LogTag for this functor is missing from the logging system.
@@ -629,9 +627,19 @@ namespace Gambit
     }
 
     /// Getter for averaged runtime
+    /// The per-thread averages are combined, weighted by the number of calls made by each thread.
     double module_functor_common::getRuntimeAverage()
     {
-      return runtime_average;
+      if (states == NULL) return FUNCTORS_RUNTIME_INIT;
+      int n = (iRunNested ? globlMaxThreads : 1);
+      double sum = 0;
+      long long ncalls = 0;
+      for (int i = 0; i < n; ++i)
+      {
+        sum += states[i].ncalls * states[i].runtime_average;
+        ncalls += states[i].ncalls;
+      }
+      return (ncalls == 0 ? FUNCTORS_RUNTIME_INIT : sum/ncalls);
     }
 
     /// Setter for indicating if the timing data for this function's execution should be printed
@@ -651,9 +659,12 @@ namespace Gambit
     {
       init_memory();
       int n = (iRunNested ? globlMaxThreads : 1);
-      std::fill(needs_recalculating, needs_recalculating+n, true);
-      std::fill(already_printed, already_printed+n, false);
-      std::fill(already_printed_timing, already_printed_timing+n, false);
+      for (int i = 0; i < n; ++i)
+      {
+        states[i].needs_recalculating = true;
+        states[i].already_printed = false;
+        states[i].already_printed_timing = false;
+      }
       if (iCanManageLoops) resetLoop();
       point_exception_raised = false;
     }
@@ -662,9 +673,9 @@ namespace Gambit
     void module_functor_common::reset(int thread_num)
     {
       init_memory();
-      needs_recalculating[thread_num] = true;
-      already_printed[thread_num] = false;
-      already_printed_timing[thread_num] = false;
+      states[thread_num].needs_recalculating = true;
+      states[thread_num].already_printed = false;
+      states[thread_num].already_printed_timing = false;
       if (iCanManageLoops) resetLoop();
     }
 
@@ -678,6 +689,10 @@ namespace Gambit
     /// Acknowledge that this functor invalidated the current point in model space.
     void module_functor_common::acknowledgeInvalidation(invalid_point_exception& e, functor* f)
     {
+      init_memory();
+      // Loop managers are told about invalidations by nested functors on any thread (before the
+      // manager itself finishes timing), so this must stay atomic.
+      double& pInvalidation = states[iRunNested ? omp_get_thread_num() : 0].pInvalidation;
       #pragma omp atomic
       pInvalidation += fadeRate*(1-FUNCTORS_BASE_INVALIDATION_RATE);
       if (f==NULL) f = this;
@@ -687,7 +702,7 @@ namespace Gambit
         raised_point_exception = e;
         point_exception_raised = true;
       }
-      if (omp_get_level()!=0) breakLoop();
+      if (Utils::omp_module_level()!=0) breakLoop();
     }
 
     /// Retrieve the previously saved exception generated when this functor invalidated the current point in model space.
@@ -703,9 +718,20 @@ namespace Gambit
     }
 
     /// Getter for invalidation rate
+    /// The per-thread rates are combined, weighted by the number of calls made by each thread.
     double module_functor_common::getInvalidationRate()
     {
-      return pInvalidation;
+      if (states == NULL) return FUNCTORS_BASE_INVALIDATION_RATE;
+      int n = (iRunNested ? globlMaxThreads : 1);
+      double sum = 0;
+      long long ncalls = 0;
+      for (int i = 0; i < n; ++i)
+      {
+        sum += states[i].ncalls * states[i].pInvalidation;
+        ncalls += states[i].ncalls;
+      }
+      // Invalidations can be acknowledged before a thread completes its first call
+      return (ncalls == 0 ? states[0].pInvalidation : sum/ncalls);
     }
 
     /// Setter for the fade rate
@@ -752,7 +778,7 @@ namespace Gambit
           catch (invalid_point_exception& e)
           {
             acknowledgeInvalidation(e,*it);
-            if (omp_get_level()==0) throw(e); // If not in an OpenMP parallel block, inform of invalidation and throw onwards
+            if (Utils::omp_module_level()==0) throw(e); // If not in an OpenMP parallel block, inform of invalidation and throw onwards
           }
         }
       }
@@ -769,10 +795,8 @@ namespace Gambit
           {
             // Set the number of slots to the max number of threads allowed iff this functor can run in parallel
             int nslots = (iRunNested ? globlMaxThreads : 1);
-            // Reserve enough space to hold as many iteration numbers as there are slots (threads) allowed
-            myCurrentIteration = new long long[nslots];
-            // Zero them to start off
-            std::fill(myCurrentIteration, myCurrentIteration+nslots, 0);
+            // Reserve enough space to hold as many iteration numbers as there are slots (threads) allowed (zeroed to start off)
+            myCurrentIteration = Utils::new_cache_aligned<Utils::cache_padded<long long> >(nslots);
           }
         }
       }
@@ -822,14 +846,14 @@ namespace Gambit
     void module_functor_common::setIteration (long long iteration)
     {
       init_myCurrentIteration_if_NULL(); // Init memory if this is the first run through.
-      myCurrentIteration[omp_get_thread_num()] = iteration;
+      myCurrentIteration[omp_get_thread_num()].value = iteration;
     }
 
     /// Return a safe pointer to the iteration number in the loop in which this functor runs.
     omp_safe_ptr<long long> module_functor_common::iterationPtr()
     {
       init_myCurrentIteration_if_NULL();  // Init memory if this is the first run through.
-      return omp_safe_ptr<long long>(myCurrentIteration);
+      return omp_safe_ptr<long long>(&myCurrentIteration[0].value, sizeof(myCurrentIteration[0]));
     }
 
     /// Setter for specifying whether this is permitted to be a manager functor, which runs other functors nested in a loop.
@@ -1489,51 +1513,11 @@ namespace Gambit
     {
       int n = (iRunNested ? globlMaxThreads : 1);
       // Reserve enough space to hold as many timing points and recalculation flags as there are slots (threads) allowed
-      if(start==NULL)
+      if(states==NULL)
       {
-        #pragma omp critical(module_functor_common_init_memory_start)
+        #pragma omp critical(module_functor_common_init_memory_states)
         {
-          if(start==NULL) start = new std::chrono::time_point<std::chrono::system_clock>[n];
-        }
-      }
-      if(end==NULL)
-      {
-        #pragma omp critical(module_functor_common_init_memory_end)
-        {
-          if(end==NULL) end = new std::chrono::time_point<std::chrono::system_clock>[n];
-        }
-      }
-      if(needs_recalculating==NULL)
-      {
-        #pragma omp critical(module_functor_common_init_memory_needs_recalculating)
-        {
-          if(needs_recalculating==NULL)
-          {
-            needs_recalculating = new bool[n];
-            std::fill(needs_recalculating, needs_recalculating+n, true);
-          }
-        }
-      }
-      if(already_printed==NULL)
-      {
-        #pragma omp critical(module_functor_common_init_memory_already_printed)
-        {
-          if(already_printed==NULL)
-          {
-            already_printed = new bool[n];
-            std::fill(already_printed, already_printed+n, false);
-          }
-        }
-      }
-      if(already_printed_timing==NULL)
-      {
-        #pragma omp critical(module_functor_common_init_memory_already_printed_timing)
-        {
-          if(already_printed_timing==NULL)
-          {
-            already_printed_timing = new bool[n];
-            std::fill(already_printed_timing, already_printed_timing+n, false);
-          }
+          if(states==NULL) states = Utils::new_cache_aligned<thread_state>(n);
         }
       }
     }
@@ -1541,20 +1525,19 @@ namespace Gambit
     /// Do pre-calculate timing things
     void module_functor_common::startTiming(int thread_num)
     {
-      start[thread_num] = std::chrono::system_clock::now();
+      states[thread_num].start = std::chrono::steady_clock::now();
     }
 
     /// Do post-calculate timing things
     void module_functor_common::finishTiming(int thread_num)
     {
-      end[thread_num] = std::chrono::system_clock::now();
-      std::chrono::duration<double> runtime = end[thread_num] - start[thread_num];
-      #pragma omp critical(module_functor_common_finishTiming)
-      {
-        runtime_average = runtime_average*(1-fadeRate) + fadeRate*runtime.count();
-        pInvalidation = pInvalidation*(1-fadeRate) + fadeRate*FUNCTORS_BASE_INVALIDATION_RATE;
-      }
-      needs_recalculating[thread_num] = false;
+      thread_state& s = states[thread_num];
+      s.end = std::chrono::steady_clock::now();
+      std::chrono::duration<double> runtime = s.end - s.start;
+      s.runtime_average = s.runtime_average*(1-fadeRate) + fadeRate*runtime.count();
+      s.pInvalidation = s.pInvalidation*(1-fadeRate) + fadeRate*FUNCTORS_BASE_INVALIDATION_RATE;
+      s.ncalls++;
+      states[thread_num].needs_recalculating = false;
     }
 
   /// Class methods for actual module functors for TYPE=void.
@@ -1593,10 +1576,10 @@ namespace Gambit
         backend_error().raise(LOCAL_INFO, ss.str());
       }
       boost::io::ios_flags_saver ifs(cout);        // Don't allow module functions to change the output precision of cout
-      int thread_num = omp_get_thread_num();
+      int thread_num = (iRunNested ? omp_get_thread_num() : 0); // Functors that cannot run nested only have one slot, whichever thread runs them.
       fill_activeModelFlags();                     // If activeModels hasn't been populated yet, make sure it is.
       init_memory();                               // Init memory if this is the first run through.
-      if (needs_recalculating[thread_num])
+      if (states[thread_num].needs_recalculating)
       {
         entering_multithreaded_region();
 
@@ -1609,7 +1592,7 @@ namespace Gambit
         catch (invalid_point_exception& e)
         {
           if (not point_exception_raised) acknowledgeInvalidation(e);
-          if (omp_get_level()==0)                  // If not in an OpenMP parallel block, throw onwards
+          if (Utils::omp_module_level()==0)                  // If not in an OpenMP parallel block, throw onwards
           {
             this->finishTiming(thread_num);
             leaving_multithreaded_region();
@@ -1645,14 +1628,14 @@ namespace Gambit
     /// Function for adding a new parameter to the map inside the ModelParameters object
     void model_functor::addParameter(str parname)
     {
-      myValue->_definePar(parname);
+      myValue[0].value._definePar(parname);
     }
 
     /// Function for handing over parameter identities to another model_functor
     void model_functor::donateParameters(model_functor &receiver)
     {
-      for(std::map<std::string,double>::const_iterator it = myValue->begin();
-          it != myValue->end();
+      for(std::map<std::string,double>::const_iterator it = myValue[0].value.begin();
+          it != myValue[0].value.end();
           it++)
       {
         receiver.addParameter(it->first);
@@ -1678,7 +1661,7 @@ namespace Gambit
     /// ModelParameters objects)
     ModelParameters* primary_model_functor::getcontentsPtr()
     {
-      return myValue;
+      return &myValue[0].value;
     }
 
     /// @}
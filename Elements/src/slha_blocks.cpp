@@ -0,0 +1,196 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Numeric, read-only view of an SLHAea object.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#include <cstdlib>
+#include <cerrno>
+#include <sstream>
+
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+
+#include "gambit/Elements/slha_blocks.hpp"
+#include "gambit/Utils/standalone_error_handlers.hpp"
+
+namespace Gambit
+{
+
+  namespace
+  {
+    /// Parse a whole field as an integer
+    bool parse_int(const str& field, int& result)
+    {
+      if (field.empty()) return false;
+      char* end;
+      errno = 0;
+      const long value = std::strtol(field.c_str(), &end, 10);
+      if (*end != '\0' or errno != 0 or value != int(value)) return false;
+      result = int(value);
+      return true;
+    }
+
+    /// Parse a whole field as a double (accepting Fortran-style exponents)
+    bool parse_double(const str& field, double& result)
+    {
+      if (field.empty()) return false;
+      str f(field);
+      for (auto& c : f) if (c == 'd' or c == 'D') c = 'e';
+      char* end;
+      result = std::strtod(f.c_str(), &end);
+      return *end == '\0';
+    }
+  }
+
+  /// The scale given in the block definition
+  double SLHAblocks::Block::scale() const
+  {
+    if (not _has_scale) utils_error().raise(LOCAL_INFO, "SLHA block "+_name+" has no scale.");
+    return _scale;
+  }
+
+  /// Does the block contain a value with the given indices?
+  bool SLHAblocks::Block::has(const std::vector<int>& indices) const
+  {
+    switch (indices.size())
+    {
+      case 0: return has();
+      case 1: return has(indices[0]);
+      case 2: return has(indices[0], indices[1]);
+      default: return _more.find(indices) != _more.end();
+    }
+  }
+
+  /// Retrieve a value, raising an error if it is missing
+  /// @{
+  double SLHAblocks::Block::get() const
+  {
+    if (not _has_value) missing("");
+    return _value;
+  }
+
+  double SLHAblocks::Block::get(int i) const
+  {
+    auto it = _one.find(i);
+    if (it != _one.end()) return it->second;
+    missing(std::to_string(i));
+    return 0.0;
+  }
+
+  double SLHAblocks::Block::get(int i, int j) const
+  {
+    auto it = _two.find(key(i,j));
+    if (it != _two.end()) return it->second;
+    missing(std::to_string(i)+","+std::to_string(j));
+    return 0.0;
+  }
+
+  double SLHAblocks::Block::get(const std::vector<int>& indices) const
+  {
+    switch (indices.size())
+    {
+      case 0: return get();
+      case 1: return get(indices[0]);
+      case 2: return get(indices[0], indices[1]);
+    }
+    auto it = _more.find(indices);
+    if (it != _more.end()) return it->second;
+    std::ostringstream msg;
+    for (size_t k = 0; k < indices.size(); k++) msg << (k == 0 ? "" : ",") << indices[k];
+    missing(msg.str());
+    return 0.0;
+  }
+  /// @}
+
+  /// Raise an error for a missing entry
+  void SLHAblocks::Block::missing(const str& indices) const
+  {
+    utils_error().raise(LOCAL_INFO, "No numeric entry ("+indices+") in SLHA block "+_name+".");
+  }
+
+  /// Empty set of blocks
+  SLHAblocks::SLHAblocks() : _data(new data) {}
+
+  /// Parse all blocks of an SLHAea object
+  SLHAblocks::SLHAblocks(SLHAstruct slha) : _data(new data)
+  {
+    _data->slha = std::move(slha);
+    for (const SLHAea::Block& block : _data->slha)
+    {
+      auto def = block.find_block_def();
+      if (def == block.end() or not boost::iequals(def->front(), "BLOCK")) continue;
+
+      Block b;
+      b._name = boost::to_upper_copy(block.name());
+      if (_data->blocks.count(b._name) != 0) continue;
+
+      // Scale, from "BLOCK NAME Q= scale"
+      const size_t def_size = def->data_size();
+      for (size_t k = 2; k + 1 < def_size; k++)
+      {
+        if (boost::iequals((*def)[k], "Q=")) b._has_scale = parse_double((*def)[k+1], b._scale);
+      }
+
+      // Data lines: integer indices followed by a single numerical value
+      for (const SLHAea::Line& line : block)
+      {
+        if (not line.is_data_line()) continue;
+        const size_t n = line.data_size();
+        double value;
+        if (n == 0 or not parse_double(line[n-1], value)) continue;
+        std::vector<int> indices(n-1);
+        bool numeric = true;
+        for (size_t k = 0; k+1 < n and numeric; k++) numeric = parse_int(line[k], indices[k]);
+        if (not numeric) continue;
+        switch (indices.size())
+        {
+          case 0: if (not b._has_value) { b._has_value = true; b._value = value; } break;
+          case 1: b._one.insert(std::make_pair(indices[0], value)); break;
+          case 2: b._two.insert(std::make_pair(Block::key(indices[0], indices[1]), value)); break;
+          default: b._more.insert(std::make_pair(indices, value));
+        }
+      }
+
+      _data->blocks.insert(std::make_pair(b._name, std::move(b)));
+    }
+  }
+
+  /// Retrieve a block, or NULL if it does not exist
+  const SLHAblocks::Block* SLHAblocks::find(const str& block) const
+  {
+    auto it = _data->blocks.find(block);
+    if (it == _data->blocks.end())
+    {
+      // Block names are case-insensitive; only convert if the name as given is not found.
+      it = _data->blocks.find(boost::to_upper_copy(block));
+      if (it == _data->blocks.end()) return NULL;
+    }
+    return &(it->second);
+  }
+
+  /// Retrieve a block, raising an error if it does not exist
+  const SLHAblocks::Block& SLHAblocks::operator[](const str& block) const
+  {
+    const Block* b = find(block);
+    if (b != NULL) return *b;
+    utils_error().raise(LOCAL_INFO, "No block "+block+" in SLHA object.");
+    static const Block empty;
+    return empty;
+  }
+
+  /// The full SLHA text, rendered on first call and then kept
+  const str& SLHAblocks::text() const
+  {
+    data& d = *_data;
+    std::call_once(d.rendered, [&d]{ d.text = d.slha.str(); });
+    return d.text;
+  }
+
+}
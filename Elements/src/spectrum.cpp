@@ -35,6 +35,7 @@
 ///  *********************************************
 
 #include "gambit/Elements/spectrum.hpp"
+#include "gambit/Elements/subspectrum_overlay.hpp"
 #include "gambit/Models/SimpleSpectra/SMSimpleSpec.hpp" // For auto-creation of simple SM low-energy SubSpectrum
 #include "gambit/Utils/standalone_error_handlers.hpp"
 #include "gambit/Utils/file_lock.hpp"
@@ -52,6 +53,15 @@ namespace Gambit
      if(not initialised) utils_error().raise(LOCAL_INFO,"Access or deepcopy of empty Spectrum object attempted!");
    }
 
+   /// Prepare an owned SubSpectrum for modification. If it is shared with a copy, put it in an
+   /// overlay (or clone it, if it is already an overlay), so that the shared object is only ever
+   /// read. An unshared SubSpectrum is modified in place.
+   SubSpectrum* Spectrum::make_mutable(std::shared_ptr<SubSpectrum>& spec)
+   {
+     if(spec.use_count() > 1) spec = std::shared_ptr<SubSpectrum>(SubSpectrumOverlay::create(spec));
+     return spec.get();
+   }
+
    /// Swap resources of two Spectrum objects
    /// Note: Not a member function! This is an external function which is a friend of the Spectrum class.
    void swap(Spectrum& first, Spectrum& second)
@@ -113,11 +123,11 @@ namespace Gambit
      , initialised(true)
    { check_mass_cuts(); }
 
-   /// Copy constructor, clones SubSpectrum objects.
+   /// Copy constructor, shares owned SubSpectrum objects and clones wrapped ones.
    /// Make a non-const copy in order to use e.g. RunBothToScale function.
    Spectrum::Spectrum(const Spectrum& other)
-     : LE_new(other.clone_LE())
-     , HE_new(other.clone_HE())
+     : LE_new(other.LE_new ? other.LE_new : std::shared_ptr<SubSpectrum>(other.clone_LE()))
+     , HE_new(other.HE_new ? other.HE_new : std::shared_ptr<SubSpectrum>(other.clone_HE()))
      , LE(LE_new.get())
      , HE(HE_new.get())
      , SMINPUTS(other.SMINPUTS)
@@ -152,8 +162,8 @@ namespace Gambit
    /// Only possible with non-const object
    void Spectrum::RunBothToScale(double scale)
    {
-     LE->RunToScale(scale);
-     HE->RunToScale(scale);
+     get_LE().RunToScale(scale);
+     get_HE().RunToScale(scale);
    }
 
    /// Helper function for checking if a particle or ratio has been requested as an absolute value
@@ -221,8 +231,8 @@ namespace Gambit
    /// Standard getters
    /// Return references to internal data members. Make sure original Spectrum object doesn't
    /// get destroyed before you finish using these or you will cause a segfault.
-   SubSpectrum& Spectrum::get_LE() {check_init(); return *LE;}
-   SubSpectrum& Spectrum::get_HE() {check_init(); return *HE;}
+   SubSpectrum& Spectrum::get_LE() {check_init(); if(LE_new) LE = make_mutable(LE_new); return *LE;}
+   SubSpectrum& Spectrum::get_HE() {check_init(); if(HE_new) HE = make_mutable(HE_new); return *HE;}
    SMInputs&    Spectrum::get_SMInputs() {check_init(); return SMINPUTS;}
    // const versions
    const SubSpectrum& Spectrum::get_LE()       const {check_init(); return *LE;}
@@ -25,6 +25,8 @@
 
 #include <fstream>
 #include <string>
+#include <atomic>
+#include <mutex>
 
 #include "gambit/Elements/subspectrum.hpp"
 #include "gambit/Elements/mssm_slhahelp.hpp"
@@ -73,6 +75,91 @@ namespace Gambit
       return tmp;
    }
 
+   /// Get a new, unique value for override_layout
+   unsigned long SubSpectrum::new_override_layout()
+   {
+      static std::atomic<unsigned long> last_layout(0);
+      return ++last_layout;
+   }
+
+   /// Get the override_layout that results from adding the override described by key to
+   /// layout. The same additions in the same order always give the same layout, so that
+   /// handles can be reused with other SubSpectrum objects of the same type.
+   unsigned long SubSpectrum::next_override_layout(const unsigned long layout, const str& key)
+   {
+      static std::map<std::pair<unsigned long,str>,unsigned long> layouts;
+      static std::mutex layouts_mutex;
+      std::lock_guard<std::mutex> lock(layouts_mutex);
+      unsigned long& next = layouts[std::make_pair(layout,key)];
+      if(next == 0) next = new_override_layout();
+      return next;
+   }
+
+   /// Set the override value in the slot given by slots[key], adding a new slot if needed
+   template<class Key>
+   void SubSpectrum::store_override_slot(std::map<Key,int>& slots, const Key& key, const double value, const str& description)
+   {
+      typename std::map<Key,int>::const_iterator it = slots.find(key);
+      if(it != slots.end())
+      {
+         override_values[it->second] = value;
+      }
+      else
+      {
+         slots[key] = override_values.size();
+         override_values.push_back(value);
+         // The new override may hide parameters that existing handles point to
+         override_layout = next_override_layout(override_layout, description);
+      }
+   }
+
+   /// @{ Store override values, with no, one or two indices
+
+   void SubSpectrum::store_override(const Par::Tags partype, const str& name, const double value)
+   {
+      store_override_slot(override_maps.at(partype).m0, name, value,
+                          Par::toString.at(partype)+" "+name);
+   }
+
+   void SubSpectrum::store_override(const Par::Tags partype, const str& name, const int i, const double value)
+   {
+      store_override_slot(override_maps.at(partype).m1[name], i, value,
+                          Par::toString.at(partype)+" "+name+" "+std::to_string(i));
+   }
+
+   void SubSpectrum::store_override(const Par::Tags partype, const str& name, const int i, const int j, const double value)
+   {
+      store_override_slot(override_maps.at(partype).m2[name][i], j, value,
+                          Par::toString.at(partype)+" "+name+" "+std::to_string(i)+" "+std::to_string(j));
+   }
+
+   /// @}
+
+   /// @{ Default handle functions; these just store the request, so that
+   ///    get(handle) repeats the string search.
+
+   SpecParHandle SubSpectrum::get_handle(const Par::Tags partype, const str& name,
+                                         const SpecOverrideOptions check_overrides,
+                                         const SafeBool check_antiparticle) const
+   {
+      return SpecParHandle(partype, name, 0, 0, 0, check_overrides, static_cast<bool>(check_antiparticle), 0, -1, SpecAccessor());
+   }
+
+   SpecParHandle SubSpectrum::get_handle(const Par::Tags partype, const str& name, const int i,
+                                         const SpecOverrideOptions check_overrides,
+                                         const SafeBool check_antiparticle) const
+   {
+      return SpecParHandle(partype, name, 1, i, 0, check_overrides, static_cast<bool>(check_antiparticle), 0, -1, SpecAccessor());
+   }
+
+   SpecParHandle SubSpectrum::get_handle(const Par::Tags partype, const str& name, const int i, const int j,
+                                         const SpecOverrideOptions check_overrides) const
+   {
+      return SpecParHandle(partype, name, 2, i, j, check_overrides, false, 0, -1, SpecAccessor());
+   }
+
+   /// @}
+
    /// @{ PDB getter/checker overloads
 
    /* Input PDG code plus context integer as separate arguments */
@@ -226,7 +313,7 @@ namespace Gambit
       #endif
       if( has(partype,name,use_overrides,SafeBool(false)) )
       {
-         override_maps.at(partype).m0[name] = value;
+         store_override(partype, name, value);
          done = true;
          #ifdef CHECK_WHERE_FOUND
          std::cout << "Found in zero index override map; override added" << std::endl;
@@ -241,7 +328,7 @@ namespace Gambit
          std::pair<str, int> p = Models::ParticleDB().short_name_pair(name);
          if( has(partype,p.first,p.second,SafeBool(false)) )
          {
-            override_maps.at(partype).m1[p.first][p.second] = value;
+            store_override(partype, p.first, p.second, value);
             done = true;
             #ifdef CHECK_WHERE_FOUND
             std::cout << "Found in one index override map with short name '"<<p.first<<","<<p.second<<"'; override added"<< std::endl;
@@ -256,7 +343,7 @@ namespace Gambit
          {
            if(allow_new)
            {
-              override_maps.at(partype).m0[name] = value;
+              store_override(partype, name, value);
               done = true;
               #ifdef CHECK_WHERE_FOUND
               std::cout << "Decoupling allowed: added value to one index override map"<< std::endl;
@@ -291,7 +378,7 @@ namespace Gambit
               #endif
               if( has(partype,antiname,use_overrides,SafeBool(false)) )
               {
-                 override_maps.at(partype).m0[antiname] = value;
+                 store_override(partype, antiname, value);
                  done = true;
                  #ifdef CHECK_WHERE_FOUND
                  std::cout << "Found entry under antiparticle name '"<<antiname<<"' in zero index override map. Override added."<< std::endl;
@@ -305,7 +392,7 @@ namespace Gambit
                  std::pair<str, int> p = Models::ParticleDB().short_name_pair(antiname);
                  if( has(partype,p.first,p.second,use_overrides,SafeBool(false)) )
                  {
-                    override_maps.at(partype).m1[p.first][p.second] = value;
+                    store_override(partype, p.first, p.second, value);
                     done = true;
                     #ifdef CHECK_WHERE_FOUND
                     std::cout << "Found entry under short antiparticle name + index in one index override map. Override added."<< std::endl;
@@ -315,7 +402,7 @@ namespace Gambit
               // No maching antiparticle entry; check if we are allowed to add new values
               else if(allow_new)
               {
-                 override_maps.at(partype).m0[name] = value;
+                 store_override(partype, name, value);
                  done = true;
                  #ifdef CHECK_WHERE_FOUND
                  std::cout << "No antiparticle match found, but 'allow_new'="<<allow_new<<", so adding entry to zero index override map." << std::endl;
@@ -326,7 +413,7 @@ namespace Gambit
            {
               if(allow_new)
               {
-                 override_maps.at(partype).m0[name] = value;
+                 store_override(partype, name, value);
                  done = true;
                  #ifdef CHECK_WHERE_FOUND
                  std::cout << "Antiparticle doesn't exist, but 'allow_new'="<<allow_new<<", so adding entry to zero index override map." << std::endl;
@@ -376,7 +463,7 @@ namespace Gambit
 
       if( has(partype,name,i,use_overrides,SafeBool(false)) ) // Don't match anti-particle; will check that if other matching fails
       {
-         override_maps.at(partype).m1[name][i] = value;
+         store_override(partype, name, i, value);
          done = true;
       }
       else if( Models::ParticleDB().has_particle(std::make_pair(name, i)) )
@@ -384,7 +471,7 @@ namespace Gambit
          str longname = Models::ParticleDB().long_name(name,i);
          if( has(partype,longname,use_overrides,SafeBool(false)) )
          {
-            override_maps.at(partype).m0[longname] = value;
+            store_override(partype, longname, value);
             done = true;
          }
       }
@@ -396,7 +483,7 @@ namespace Gambit
          {
            if(allow_new)
            {
-              override_maps.at(partype).m1[name][i] = value;
+              store_override(partype, name, i, value);
               done = true;
            }
            else
@@ -417,7 +504,7 @@ namespace Gambit
               // Repeat the logic above
               if( has(partype,antiname,i,use_overrides,SafeBool(false)) ) // Don't match anti-particle; will check that if other matching fails
               {
-                 override_maps.at(partype).m1[antiname][i] = value;
+                 store_override(partype, antiname, i, value);
                  done = true;
               }
               else if( Models::ParticleDB().has_particle(std::make_pair(antiname, i)) )
@@ -425,14 +512,14 @@ namespace Gambit
                  str longname = Models::ParticleDB().long_name(antiname,i);
                  if( has(partype,longname,use_overrides,SafeBool(false)) )
                  {
-                    override_maps.at(partype).m0[longname] = value;
+                    store_override(partype, longname, value);
                     done = true;
                  }
               }
               // No matching antiparticle; see if we are allowed to just add the value
               else if(allow_new)
               {
-                 override_maps.at(partype).m1[name][i] = value;
+                 store_override(partype, name, i, value);
                  done = true;
               }
            }
@@ -440,7 +527,7 @@ namespace Gambit
            {
               if(allow_new)
               {
-                 override_maps.at(partype).m1[name][i] = value;
+                 store_override(partype, name, i, value);
                  done = true;
               }
               else
@@ -478,7 +565,7 @@ namespace Gambit
         errmsg << "If you intended to add this value to the spectrum without overriding anything, please call this function with the optional 'allow_new' boolean parameter set to 'false'. It can then be later retrieved using the normal getters with the same name used here." << std::endl;
         utils_error().forced_throw(LOCAL_INFO,errmsg.str());
       }
-      override_maps.at(partype).m2[name][i][j] = value;
+      store_override(partype, name, i, j, value);
    }
 
    /// PDB overloads of set_override functions
@@ -0,0 +1,195 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  SubSpectrum wrapper that shares another
+///  (parent) SubSpectrum and keeps any overrides
+///  added to it to itself.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#include "gambit/Elements/subspectrum_overlay.hpp"
+
+namespace Gambit
+{
+
+   /// Construct an overlay on parent, starting with the same overrides as the parent.
+   /// Copying the parent's overrides (rather than searching them in the parent) means that
+   /// all overrides are searched before any model getters, exactly as if the parent had
+   /// been cloned and the new overrides added to the clone.
+   SubSpectrumOverlay::SubSpectrumOverlay(const std::shared_ptr<SubSpectrum>& parent_in)
+     : parent(parent_in)
+   {
+      override_maps = parent->override_maps;
+      override_values = parent->override_values;
+      // Handles from overlays on the same type of parent, with the same overrides, are interchangeable.
+      override_layout = next_override_layout(parent->override_layout, "SubSpectrumOverlay");
+   }
+
+   /// Create an overlay on spec
+   std::unique_ptr<SubSpectrum> SubSpectrumOverlay::create(const std::shared_ptr<SubSpectrum>& spec)
+   {
+      if(is_overlay(*spec)) return spec->clone();
+      return std::unique_ptr<SubSpectrum>(new SubSpectrumOverlay(spec));
+   }
+
+   /// Is spec an overlay?
+   bool SubSpectrumOverlay::is_overlay(const SubSpectrum& spec)
+   {
+      return dynamic_cast<const SubSpectrumOverlay*>(&spec) != NULL;
+   }
+
+   /// Parent, cloned first if it is shared with another object
+   SubSpectrum& SubSpectrumOverlay::mutable_parent()
+   {
+      if(parent.use_count() > 1) parent = std::shared_ptr<SubSpectrum>(parent->clone());
+      return *parent;
+   }
+
+   /// Are there any overrides of the given type?
+   bool SubSpectrumOverlay::has_overrides(const Par::Tags partype) const
+   {
+      const OverrideMaps& o = override_maps.at(partype);
+      return not (o.m0.empty() and o.m1.empty() and o.m2.empty());
+   }
+
+   /// @{ Modify the parent, cloning it first if it is shared
+
+   void SubSpectrumOverlay::RunToScaleOverride(double scale) { mutable_parent().RunToScaleOverride(scale); }
+
+   void SubSpectrumOverlay::SetScale(double scale) { mutable_parent().SetScale(scale); }
+
+   void SubSpectrumOverlay::set(const Par::Tags partype, const double value, const str& name, const SafeBool check_antiparticle)
+   {
+      mutable_parent().set(partype, value, name, check_antiparticle);
+   }
+
+   void SubSpectrumOverlay::set(const Par::Tags partype, const double value, const str& name, const int i, const SafeBool check_antiparticle)
+   {
+      mutable_parent().set(partype, value, name, i, check_antiparticle);
+   }
+
+   void SubSpectrumOverlay::set(const Par::Tags partype, const double value, const str& name, const int i, const int j)
+   {
+      mutable_parent().set(partype, value, name, i, j);
+   }
+
+   /// @}
+
+   /// @{ Getters and checkers
+   ///    The overlay holds all the overrides, so the parent is only ever asked for model values.
+
+   bool SubSpectrumOverlay::has(const Par::Tags partype, const str& name, const SpecOverrideOptions check_overrides, const SafeBool check_antiparticle) const
+   {
+      if(not (check_overrides == ignore_overrides) and has_overrides(partype) and
+         Base::has(partype, name, overrides_only, check_antiparticle)) return true;
+      return not (check_overrides == overrides_only) and parent->has(partype, name, ignore_overrides, check_antiparticle);
+   }
+
+   double SubSpectrumOverlay::get(const Par::Tags partype, const str& name, const SpecOverrideOptions check_overrides, const SafeBool check_antiparticle) const
+   {
+      if(check_overrides == overrides_only or
+         (check_overrides == use_overrides and has_overrides(partype) and Base::has(partype, name, overrides_only, check_antiparticle)))
+      {
+        return Base::get(partype, name, overrides_only, check_antiparticle);
+      }
+      return parent->get(partype, name, ignore_overrides, check_antiparticle);
+   }
+
+   bool SubSpectrumOverlay::has(const Par::Tags partype, const str& name, const int i, const SpecOverrideOptions check_overrides, const SafeBool check_antiparticle) const
+   {
+      if(not (check_overrides == ignore_overrides) and has_overrides(partype) and
+         Base::has(partype, name, i, overrides_only, check_antiparticle)) return true;
+      return not (check_overrides == overrides_only) and parent->has(partype, name, i, ignore_overrides, check_antiparticle);
+   }
+
+   double SubSpectrumOverlay::get(const Par::Tags partype, const str& name, const int i, const SpecOverrideOptions check_overrides, const SafeBool check_antiparticle) const
+   {
+      if(check_overrides == overrides_only or
+         (check_overrides == use_overrides and has_overrides(partype) and Base::has(partype, name, i, overrides_only, check_antiparticle)))
+      {
+        return Base::get(partype, name, i, overrides_only, check_antiparticle);
+      }
+      return parent->get(partype, name, i, ignore_overrides, check_antiparticle);
+   }
+
+   bool SubSpectrumOverlay::has(const Par::Tags partype, const str& name, const int i, const int j, const SpecOverrideOptions check_overrides) const
+   {
+      if(not (check_overrides == ignore_overrides) and has_overrides(partype) and
+         Base::has(partype, name, i, j, overrides_only)) return true;
+      return not (check_overrides == overrides_only) and parent->has(partype, name, i, j, ignore_overrides);
+   }
+
+   double SubSpectrumOverlay::get(const Par::Tags partype, const str& name, const int i, const int j, const SpecOverrideOptions check_overrides) const
+   {
+      if(check_overrides == overrides_only or
+         (check_overrides == use_overrides and has_overrides(partype) and Base::has(partype, name, i, j, overrides_only)))
+      {
+        return Base::get(partype, name, i, j, overrides_only);
+      }
+      return parent->get(partype, name, i, j, ignore_overrides);
+   }
+
+   /// @}
+
+   /// @{ Handles
+   ///    Overrides are resolved by the overlay itself; anything else with a handle from the parent.
+
+   SpecParHandle SubSpectrumOverlay::parent_handle(const SpecParHandle& h, const Par::Tags partype, const str& name,
+    const int nindices, const int i, const int j, const SpecOverrideOptions check_overrides, const bool check_antiparticle) const
+   {
+      SpecAccessor accessor = [h](const SubSpectrum& s) -> double { return static_cast<const SubSpectrumOverlay&>(s).parent->get(h); };
+      return SpecParHandle(partype, name, nindices, i, j, check_overrides, check_antiparticle, override_layout, -1, accessor);
+   }
+
+   SpecParHandle SubSpectrumOverlay::get_handle(const Par::Tags partype, const str& name, const SpecOverrideOptions check_overrides, const SafeBool check_antiparticle) const
+   {
+      if(check_overrides == overrides_only or
+         (check_overrides == use_overrides and has_overrides(partype) and Base::has(partype, name, overrides_only, check_antiparticle)))
+      {
+        return Base::get_handle(partype, name, check_overrides, check_antiparticle);
+      }
+      return parent_handle(parent->get_handle(partype, name, ignore_overrides, check_antiparticle),
+                           partype, name, 0, 0, 0, check_overrides, static_cast<bool>(check_antiparticle));
+   }
+
+   SpecParHandle SubSpectrumOverlay::get_handle(const Par::Tags partype, const str& name, const int i, const SpecOverrideOptions check_overrides, const SafeBool check_antiparticle) const
+   {
+      if(check_overrides == overrides_only or
+         (check_overrides == use_overrides and has_overrides(partype) and Base::has(partype, name, i, overrides_only, check_antiparticle)))
+      {
+        return Base::get_handle(partype, name, i, check_overrides, check_antiparticle);
+      }
+      return parent_handle(parent->get_handle(partype, name, i, ignore_overrides, check_antiparticle),
+                           partype, name, 1, i, 0, check_overrides, static_cast<bool>(check_antiparticle));
+   }
+
+   SpecParHandle SubSpectrumOverlay::get_handle(const Par::Tags partype, const str& name, const int i, const int j, const SpecOverrideOptions check_overrides) const
+   {
+      if(check_overrides == overrides_only or
+         (check_overrides == use_overrides and has_overrides(partype) and Base::has(partype, name, i, j, overrides_only)))
+      {
+        return Base::get_handle(partype, name, i, j, check_overrides);
+      }
+      return parent_handle(parent->get_handle(partype, name, i, j, ignore_overrides),
+                           partype, name, 2, i, j, check_overrides, false);
+   }
+
+   /// @}
+
+   /// Add spectrum information to an SLHAea object, as written by the parent but with the values of this object
+   void SubSpectrumOverlay::add_to_SLHAea(int slha_version, SLHAstruct& slha) const
+   {
+      parent->add_to_SLHAea_from(slha_version, slha, *this);
+   }
+
+   void SubSpectrumOverlay::add_to_SLHAea_from(int slha_version, SLHAstruct& slha, const SubSpectrum& values) const
+   {
+      parent->add_to_SLHAea_from(slha_version, slha, values);
+   }
+
+}
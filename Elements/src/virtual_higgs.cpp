@@ -21,9 +21,10 @@
 ///
 ///  *********************************************
 
-#include <map>
 #include <vector>
 #include <sstream>
+#include <algorithm>
+#include <unordered_map>
 
 #include "gambit/Elements/virtual_higgs.hpp"
 #include "gambit/Utils/ascii_table_reader.hpp"
@@ -32,91 +33,174 @@
 namespace Gambit
 {
 
-  /// Higgs branching ratios and total width Gamma [GeV], as function of mass [GeV] (90 - 300 GeV)
-  double virtual_SMHiggs_widths(str channel, double mh)
+  namespace
+  {
+    /// Names of the channels, in the order of SMHiggsChannel::Channel (and of the table columns)
+    const std::vector<str> channel_names = initVector<std::string>("bb", "tautau", "mumu", "ss", "cc",
+     "tt", "gg", "gammagamma", "Zgamma", "WW", "ZZ", "Gamma");
+
+    /// Channels that are not given in the multi-TeV supplement (taken to be zero there)
+    const SMHiggsChannel::Channel non_highmass_channels[] =
+     {SMHiggsChannel::ss, SMHiggsChannel::gg, SMHiggsChannel::bb, SMHiggsChannel::mumu};
+  }
+
+  /// Interpolate n columns (first, first+stride, ...) at mass mh, writing them to result
+  void virtual_SMHiggs_width_table::segment::interpolate(double mh, int first, int n, int stride, double* result) const
+  {
+    // Index of the first grid point above mh (or the last grid point), as in daFunk::FunkInterp.
+    const size_t imax = mass.size() - 1;
+    const size_t i = std::upper_bound(mass.begin(), mass.begin() + imax, mh) - mass.begin();
+    const double t = (mh - mass[i-1]) / (mass[i] - mass[i-1]);
+    const double* y0 = &values[(i-1)*ncols + first];
+    const double* y1 = &values[i*ncols + first];
+    for (int k = 0; k < n; k++) result[k] = y0[k*stride] + t*(y1[k*stride] - y0[k*stride]);
+  }
+
+  /// Read in the tables
+  virtual_SMHiggs_width_table::virtual_SMHiggs_width_table()
   {
     // Paths to files containing virtual Higgs width tables.
     const str virtualH_tabfile = GAMBIT_DIR "/Elements/data/Higgs_decay_1307.1347.dat";
     const str virtualH_highmass = GAMBIT_DIR "/Elements/data/Higgs_decay_multiTeV_supplement.dat";
     const str virtualH_lowmass = GAMBIT_DIR "/Elements/data/Higgs_decay_lowmass_supplement.dat";
 
-    // Initialise, reading in the data tables and setting up the interpolators.
-    static ASCIItableReader table(virtualH_tabfile);
-    static ASCIItableReader table_highmass(virtualH_highmass);
-    static ASCIItableReader table_lowmass(virtualH_lowmass);
-    static std::map<std::string, daFunk::Funk> f_vs_mass;
-    static std::map<std::string, daFunk::Funk> f_vs_mass_highmass;
-    static std::map<std::string, daFunk::Funk> f_vs_mass_lowmass;
-    static bool initialised = false;
-    static double minmass, midmass_low, midmass_high, maxmass;
-    const static std::vector<str> non_highmass_channels = initVector<std::string>("ss","gg","bb","mumu");
-    const static std::vector<str> colnames = initVector<std::string>("mass",
-     "bb", "bb+", "bb-", "tautau", "tautau+", "tautau-", "mumu", "mumu+", "mumu-",
-     "ss", "ss+", "ss-", "cc", "cc+", "cc-", "tt", "tt+", "tt-", "gg", "gg+", "gg-",
-     "gammagamma", "gammagamma+", "gammagamma-", "Zgamma", "Zgamma+", "Zgamma-",
-     "WW", "WW+", "WW-", "ZZ", "ZZ+", "ZZ-", "Gamma", "Gamma+", "Gamma-");
-    const static std::vector<str> colnames_extended = initVector<std::string>("mass",
-     "bb", "tautau", "mumu", "ss", "cc", "tt", "gg", "gammagamma", "Zgamma",
-     "WW", "ZZ", "Gamma");
-    if (not initialised)
+    // Read each table, and store its columns (after the mass) row by row.
+    auto read = [](const str& filename, int ncols, segment& s)
     {
-      table.setcolnames(colnames);
-      for (auto it = colnames.begin(); it != colnames.end(); it++)
-      {
-        f_vs_mass[*it] = daFunk::interp("mass", table["mass"], table[*it]);
-      }
-      table_highmass.setcolnames(colnames_extended);
-      table_lowmass.setcolnames(colnames_extended);
-      for (auto it = colnames_extended.begin(); it != colnames_extended.end(); it++)
+      ASCIItableReader table(filename);
+      if (table.getncol() != ncols + 1)
+        utils_error().raise(LOCAL_INFO, "Unexpected number of columns in SM higgs table "+filename);
+      s.ncols = ncols;
+      s.mass = table[0];
+      s.values.resize(s.mass.size()*ncols);
+      for (int j = 0; j < ncols; j++)
       {
-        f_vs_mass_highmass[*it] = daFunk::interp("mass", table_highmass["mass"], table_highmass[*it]);
-        f_vs_mass_lowmass[*it] = daFunk::interp("mass", table_lowmass["mass"], table_lowmass[*it]);
+        const std::vector<double>& column = table[j+1];
+        for (size_t i = 0; i < s.mass.size(); i++) s.values[i*ncols+j] = column[i];
       }
-      minmass = table_lowmass["mass"][0];
-      midmass_low = table["mass"][0];
-      midmass_high = table_highmass["mass"][0];
-      maxmass = table_highmass["mass"][table_highmass.getnrow()-1];
-      if (table_lowmass["mass"][table_lowmass.getnrow()-1] != midmass_low)
-        utils_error().raise(LOCAL_INFO, "low-mass and intermediate SM higgs tables do not meet cleanly.");
-      if (table["mass"][table.getnrow()-1] != midmass_high)
-        utils_error().raise(LOCAL_INFO, "intermediate and high-mass SM higgs tables do not meet cleanly.");
-      initialised = true;
-    }
+      if (s.mass.size() < 2 or not std::is_sorted(s.mass.begin(), s.mass.end()))
+        utils_error().raise(LOCAL_INFO, "Masses in SM higgs table "+filename+" are not in ascending order.");
+    };
+    read(virtualH_lowmass, SMHiggsChannel::n_channels, low);
+    read(virtualH_tabfile, 3*SMHiggsChannel::n_channels, mid);
+    read(virtualH_highmass, SMHiggsChannel::n_channels, high);
+
+    if (low.mass.back() != mid.mass.front())
+      utils_error().raise(LOCAL_INFO, "low-mass and intermediate SM higgs tables do not meet cleanly.");
+    if (mid.mass.back() != high.mass.front())
+      utils_error().raise(LOCAL_INFO, "intermediate and high-mass SM higgs tables do not meet cleanly.");
+  }
+
+  /// Retrieve the table (thread-safe; reads the data files on first call)
+  const virtual_SMHiggs_width_table& virtual_SMHiggs_width_table::get()
+  {
+    static const virtual_SMHiggs_width_table table;
+    return table;
+  }
 
-    // Exit if the requested channel is unknown.
-    if (std::find(colnames.begin(), colnames.end(), channel) == colnames.end())
+  /// Check that mh is covered by the tables
+  void virtual_SMHiggs_width_table::check_mass(double mh) const
+  {
+    if (mh < min_mass() or mh > max_mass())
     {
       std::stringstream msg;
-      msg << "Unknown Higgs decay channel: " << channel << ".  Recognised channel codes are:";
-      for (auto it = colnames.begin(); it != colnames.end(); it++) if (*it != "mass") msg << endl << "  " << *it;
+      msg << "Requested Higgs virtuality is " << mh << "; allowed range is " << min_mass() << "--" << max_mass() << " GeV!";
       utils_error().raise(LOCAL_INFO, msg.str());
     }
+  }
 
-    // Exit if the requested mass is out of range.
-    if (mh < minmass or mh > maxmass)
+  /// Branching ratios and total width for all channels at mass mh
+  virtual_SMHiggs_width_table::channel_array virtual_SMHiggs_width_table::widths(double mh) const
+  {
+    check_mass(mh);
+    channel_array result;
+    if (mh <= low.mass.back())
     {
-      std::stringstream msg;
-      msg << "Requested Higgs virtuality is " << mh << "; allowed range is " << minmass << "--" << maxmass << " GeV!";
-      utils_error().raise(LOCAL_INFO, msg.str());
+      low.interpolate(mh, 0, SMHiggsChannel::n_channels, 1, result.data());
+    }
+    else if (mh <= mid.mass.back())
+    {
+      mid.interpolate(mh, 0, SMHiggsChannel::n_channels, 3, result.data());
     }
+    else
+    {
+      high.interpolate(mh, 0, SMHiggsChannel::n_channels, 1, result.data());
+      for (auto c : non_highmass_channels) result[c] = 0.;
+    }
+    return result;
+  }
 
-    // Retrieve the interpolated result.
+  /// Branching ratio or total width for a single channel at mass mh
+  double virtual_SMHiggs_width_table::width(SMHiggsChannel::Channel channel, double mh) const
+  {
+    check_mass(mh);
     double f;
-    if (mh <= midmass_low)
+    if (mh <= low.mass.back())
     {
-      f = f_vs_mass_lowmass[channel]->bind("mass")->eval(mh);
+      low.interpolate(mh, channel, 1, 1, &f);
     }
-    else if (mh >= midmass_low and mh <= midmass_high)
+    else if (mh <= mid.mass.back())
     {
-      f = f_vs_mass[channel]->bind("mass")->eval(mh);
+      mid.interpolate(mh, 3*channel, 1, 3, &f);
     }
     else
     {
-      if (std::find(non_highmass_channels.begin(), non_highmass_channels.end(), channel) != non_highmass_channels.end()) return 0.;
-      f = f_vs_mass_highmass[channel]->bind("mass")->eval(mh);
+      if (std::find(std::begin(non_highmass_channels), std::end(non_highmass_channels), channel)
+          != std::end(non_highmass_channels)) return 0.;
+      high.interpolate(mh, channel, 1, 1, &f);
     }
     return f;
+  }
 
+  /// Upper or lower uncertainties on all channels at mass mh (only tabulated from 80 GeV to 1 TeV)
+  virtual_SMHiggs_width_table::channel_array virtual_SMHiggs_width_table::uncertainties(double mh, bool upper) const
+  {
+    if (mh < mid.mass.front() or mh > mid.mass.back())
+    {
+      std::stringstream msg;
+      msg << "Uncertainties on SM Higgs widths are only tabulated for " << mid.mass.front() << "--"
+          << mid.mass.back() << " GeV; requested Higgs virtuality is " << mh << " GeV.";
+      utils_error().raise(LOCAL_INFO, msg.str());
+    }
+    channel_array result;
+    mid.interpolate(mh, upper ? 1 : 2, SMHiggsChannel::n_channels, 3, result.data());
+    return result;
+  }
+
+  /// Value of a column of the table by name ("bb", "bb+", "bb-", ..., "Gamma", "Gamma+", "Gamma-")
+  double virtual_SMHiggs_width_table::value(const str& column, double mh) const
+  {
+    const char last = column.empty() ? '\0' : column.back();
+    if (last != '+' and last != '-') return width(channel(column), mh);
+    const SMHiggsChannel::Channel c = channel(column.substr(0, column.size()-1));
+    return uncertainties(mh, last == '+')[c];
+  }
+
+  /// Convert a channel name into its code
+  SMHiggsChannel::Channel virtual_SMHiggs_width_table::channel(const str& name)
+  {
+    static const std::unordered_map<str, SMHiggsChannel::Channel> codes = []
+    {
+      std::unordered_map<str, SMHiggsChannel::Channel> result;
+      for (int i = 0; i < SMHiggsChannel::n_channels; i++) result[channel_names[i]] = SMHiggsChannel::Channel(i);
+      return result;
+    }();
+    auto it = codes.find(name);
+    if (it == codes.end())
+    {
+      std::stringstream msg;
+      msg << "Unknown Higgs decay channel: " << name << ".  Recognised channel codes are:";
+      for (auto jt = channel_names.begin(); jt != channel_names.end(); jt++)
+        msg << endl << "  " << *jt << endl << "  " << *jt << "+" << endl << "  " << *jt << "-";
+      utils_error().raise(LOCAL_INFO, msg.str());
+    }
+    return it->second;
+  }
+
+  /// Higgs branching ratios and total width Gamma [GeV], as function of mass [GeV] (90 - 300 GeV)
+  double virtual_SMHiggs_widths(str channel, double mh)
+  {
+    return virtual_SMHiggs_width_table::get().value(channel, mh);
   }
 
 }
@@ -35,6 +35,7 @@ std::string infile("FlavBit/data/example.slha");
 
 QUICK_FUNCTION(FlavBit, unimproved_MSSM_spectrum, NEW_CAPABILITY, createSpectrum, Spectrum, (MSSM30atQ,MSSM30atMGUT))
 QUICK_FUNCTION(FlavBit, MSSM_spectrum, NEW_CAPABILITY, relabelSpectrum, Spectrum, (MSSM30atQ,MSSM30atMGUT), (unimproved_MSSM_spectrum, Spectrum))
+QUICK_FUNCTION(FlavBit, MSSM_SLHA2_blocks, NEW_CAPABILITY, getSLHAblocks, SLHAblocks, (MSSM30atQ,MSSM30atMGUT), (MSSM_spectrum, Spectrum))
 QUICK_FUNCTION(FlavBit, Z_decay_rates, NEW_CAPABILITY, GammaZ, DecayTable::Entry)
 QUICK_FUNCTION(FlavBit, W_plus_decay_rates, NEW_CAPABILITY, GammaW, DecayTable::Entry)
 
@@ -55,6 +56,14 @@ namespace Gambit
       outSpec = *Pipes::relabelSpectrum::Dep::unimproved_MSSM_spectrum;
     }
 
+    /// Convert it into numerical SLHA2 blocks, as SpecBit does
+    void getSLHAblocks(SLHAblocks& result)
+    {
+      SLHAstruct slha = Pipes::getSLHAblocks::Dep::MSSM_spectrum->getSLHAea(2);
+      SLHAea_add(slha,"MODSEL",1, 0, "General MSSM", false);
+      result = SLHAblocks(std::move(slha));
+    }
+
     /// W decays -- only need the total width for SuperIso
     void GammaW(DecayTable::Entry& result)
     {
@@ -108,10 +117,12 @@ int main(int argc, char** argv)
     // Notify all module functions that care of the model being scanned.
     createSpectrum.notifyOfModel("MSSM30atQ");
     relabelSpectrum.notifyOfModel("MSSM30atQ");
+    getSLHAblocks.notifyOfModel("MSSM30atQ");
     SI_fill.notifyOfModel("MSSM30atQ");
 
     // Arrange the spectrum chain
     relabelSpectrum.resolveDependency(&createSpectrum);
+    getSLHAblocks.resolveDependency(&relabelSpectrum);
 
     // Set up the deltaMB_LL likelihood
     // Have to resolve dependencies by hand
@@ -142,9 +153,11 @@ int main(int argc, char** argv)
     //   - BEreq slha_adjust
     //   - BEreq mb_1S
     //   - MSSM_spectrum (or SM_spectrum)
+    //   - MSSM_SLHA2_blocks
     //   - W_plus_decay_rates
     //   - Z_decay_rates
     SI_fill.resolveDependency(&relabelSpectrum);
+    SI_fill.resolveDependency(&getSLHAblocks);
     SI_fill.resolveDependency(&GammaZ);
     SI_fill.resolveDependency(&GammaW);
     SI_fill.resolveBackendReq(&Backends::SuperIso_3_6::Functown::Init_param);
@@ -312,6 +325,7 @@ int main(int argc, char** argv)
     // Initialise the spectra
     createSpectrum.reset_and_calculate();
     relabelSpectrum.reset_and_calculate();
+    getSLHAblocks.reset_and_calculate();
 
     // Initialise the backends
     SuperIso_3_6_init.reset_and_calculate();
@@ -81,17 +81,16 @@ namespace Gambit
       using namespace Pipes::SI_fill;
       using namespace std;
 
-      SLHAstruct spectrum;
-      // Obtain SLHAea object from spectrum
+      SLHAblocks spectrum;
+      // Obtain numerical SLHA blocks from spectrum
       if (ModelInUse("WC"))
       {
-        spectrum = Dep::SM_spectrum->getSLHAea(2);
+        spectrum = SLHAblocks(Dep::SM_spectrum->getSLHAea(2));
       }
       else if (ModelInUse("MSSM63atMGUT") or ModelInUse("MSSM63atQ"))
       {
-        spectrum = Dep::MSSM_spectrum->getSLHAea(2);
-        // Add the MODSEL block if it is not provided by the spectrum object.
-        SLHAea_add(spectrum,"MODSEL",1, 0, "General MSSM", false);
+        // Shared with other modules; already includes a MODSEL block.
+        spectrum = *Dep::MSSM_SLHA2_blocks;
       }
       else
       {
@@ -102,195 +101,195 @@ namespace Gambit
 
       int ie,je;
 
-      if (!spectrum["MODSEL"].empty())
+      if (spectrum.has_block("MODSEL"))
       {
-        if (spectrum["MODSEL"][1].is_data_line()) result.model=SLHAea::to<int>(spectrum["MODSEL"][1][1]);
-        if (spectrum["MODSEL"][3].is_data_line()) result.NMSSM=SLHAea::to<int>(spectrum["MODSEL"][3][1]);
-        if (spectrum["MODSEL"][4].is_data_line()) result.RV=SLHAea::to<int>(spectrum["MODSEL"][4][1]);
-        if (spectrum["MODSEL"][5].is_data_line()) result.CPV=SLHAea::to<int>(spectrum["MODSEL"][5][1]);
-        if (spectrum["MODSEL"][6].is_data_line()) result.FV=SLHAea::to<int>(spectrum["MODSEL"][6][1]);
-        if (spectrum["MODSEL"][12].is_data_line()) result.Q=SLHAea::to<double>(spectrum["MODSEL"][12][1]);
+        if (spectrum.has("MODSEL",1)) result.model=int(spectrum.get("MODSEL",1));
+        if (spectrum.has("MODSEL",3)) result.NMSSM=int(spectrum.get("MODSEL",3));
+        if (spectrum.has("MODSEL",4)) result.RV=int(spectrum.get("MODSEL",4));
+        if (spectrum.has("MODSEL",5)) result.CPV=int(spectrum.get("MODSEL",5));
+        if (spectrum.has("MODSEL",6)) result.FV=int(spectrum.get("MODSEL",6));
+        if (spectrum.has("MODSEL",12)) result.Q=spectrum.get("MODSEL",12);
       }
 
       if (result.NMSSM != 0) result.model=result.NMSSM;
       if (result.RV != 0) result.model=-2;
       if (result.CPV != 0) result.model=-2;
 
-      if (!spectrum["SMINPUTS"].empty())
+      if (spectrum.has_block("SMINPUTS"))
       {
-        if (spectrum["SMINPUTS"][1].is_data_line()) result.inv_alpha_em=SLHAea::to<double>(spectrum["SMINPUTS"][1][1]);
-        if (spectrum["SMINPUTS"][2].is_data_line()) result.Gfermi=SLHAea::to<double>(spectrum["SMINPUTS"][2][1]);
-        if (spectrum["SMINPUTS"][3].is_data_line()) result.alphas_MZ=SLHAea::to<double>(spectrum["SMINPUTS"][3][1]);
-        if (spectrum["SMINPUTS"][4].is_data_line()) result.mass_Z=SLHAea::to<double>(spectrum["SMINPUTS"][4][1]);
-        if (spectrum["SMINPUTS"][5].is_data_line()) result.mass_b=SLHAea::to<double>(spectrum["SMINPUTS"][5][1]);
-        if (spectrum["SMINPUTS"][6].is_data_line()) result.mass_top_pole=SLHAea::to<double>(spectrum["SMINPUTS"][6][1]);
-        if (spectrum["SMINPUTS"][7].is_data_line()) result.mass_tau=SLHAea::to<double>(spectrum["SMINPUTS"][7][1]);
-        if (spectrum["SMINPUTS"][8].is_data_line()) result.mass_nutau2=SLHAea::to<double>(spectrum["SMINPUTS"][8][1]);
-        if (spectrum["SMINPUTS"][11].is_data_line()) result.mass_e2=SLHAea::to<double>(spectrum["SMINPUTS"][11][1]);
-        if (spectrum["SMINPUTS"][12].is_data_line()) result.mass_nue2=SLHAea::to<double>(spectrum["SMINPUTS"][12][1]);
-        if (spectrum["SMINPUTS"][13].is_data_line()) result.mass_mu2=SLHAea::to<double>(spectrum["SMINPUTS"][13][1]);
-        if (spectrum["SMINPUTS"][14].is_data_line()) result.mass_numu2=SLHAea::to<double>(spectrum["SMINPUTS"][14][1]);
-        if (spectrum["SMINPUTS"][21].is_data_line()) result.mass_d2=SLHAea::to<double>(spectrum["SMINPUTS"][21][1]);
-        if (spectrum["SMINPUTS"][22].is_data_line()) result.mass_u2=SLHAea::to<double>(spectrum["SMINPUTS"][22][1]);
-        if (spectrum["SMINPUTS"][23].is_data_line()) result.mass_s2=SLHAea::to<double>(spectrum["SMINPUTS"][23][1]);
-        if (spectrum["SMINPUTS"][24].is_data_line()) result.mass_c2=SLHAea::to<double>(spectrum["SMINPUTS"][24][1]);
+        if (spectrum.has("SMINPUTS",1)) result.inv_alpha_em=spectrum.get("SMINPUTS",1);
+        if (spectrum.has("SMINPUTS",2)) result.Gfermi=spectrum.get("SMINPUTS",2);
+        if (spectrum.has("SMINPUTS",3)) result.alphas_MZ=spectrum.get("SMINPUTS",3);
+        if (spectrum.has("SMINPUTS",4)) result.mass_Z=spectrum.get("SMINPUTS",4);
+        if (spectrum.has("SMINPUTS",5)) result.mass_b=spectrum.get("SMINPUTS",5);
+        if (spectrum.has("SMINPUTS",6)) result.mass_top_pole=spectrum.get("SMINPUTS",6);
+        if (spectrum.has("SMINPUTS",7)) result.mass_tau=spectrum.get("SMINPUTS",7);
+        if (spectrum.has("SMINPUTS",8)) result.mass_nutau2=spectrum.get("SMINPUTS",8);
+        if (spectrum.has("SMINPUTS",11)) result.mass_e2=spectrum.get("SMINPUTS",11);
+        if (spectrum.has("SMINPUTS",12)) result.mass_nue2=spectrum.get("SMINPUTS",12);
+        if (spectrum.has("SMINPUTS",13)) result.mass_mu2=spectrum.get("SMINPUTS",13);
+        if (spectrum.has("SMINPUTS",14)) result.mass_numu2=spectrum.get("SMINPUTS",14);
+        if (spectrum.has("SMINPUTS",21)) result.mass_d2=spectrum.get("SMINPUTS",21);
+        if (spectrum.has("SMINPUTS",22)) result.mass_u2=spectrum.get("SMINPUTS",22);
+        if (spectrum.has("SMINPUTS",23)) result.mass_s2=spectrum.get("SMINPUTS",23);
+        if (spectrum.has("SMINPUTS",24)) result.mass_c2=spectrum.get("SMINPUTS",24);
       }
 
-      if (!spectrum["VCKMIN"].empty())
+      if (spectrum.has_block("VCKMIN"))
       {
-        if (spectrum["VCKMIN"][1].is_data_line()) result.CKM_lambda=SLHAea::to<double>(spectrum["VCKMIN"][1][1]);
-        if (spectrum["VCKMIN"][2].is_data_line()) result.CKM_A=SLHAea::to<double>(spectrum["VCKMIN"][2][1]);
-        if (spectrum["VCKMIN"][3].is_data_line()) result.CKM_rhobar=SLHAea::to<double>(spectrum["VCKMIN"][3][1]);
-        if (spectrum["VCKMIN"][4].is_data_line()) result.CKM_etabar=SLHAea::to<double>(spectrum["VCKMIN"][4][1]);
+        if (spectrum.has("VCKMIN",1)) result.CKM_lambda=spectrum.get("VCKMIN",1);
+        if (spectrum.has("VCKMIN",2)) result.CKM_A=spectrum.get("VCKMIN",2);
+        if (spectrum.has("VCKMIN",3)) result.CKM_rhobar=spectrum.get("VCKMIN",3);
+        if (spectrum.has("VCKMIN",4)) result.CKM_etabar=spectrum.get("VCKMIN",4);
       }
 
-      if (!spectrum["UPMNSIN"].empty())
+      if (spectrum.has_block("UPMNSIN"))
       {
-        if (spectrum["UPMNSIN"][1].is_data_line()) result.PMNS_theta12=SLHAea::to<double>(spectrum["UPMNSIN"][1][1]);
-        if (spectrum["UPMNSIN"][2].is_data_line()) result.PMNS_theta23=SLHAea::to<double>(spectrum["UPMNSIN"][2][1]);
-        if (spectrum["UPMNSIN"][3].is_data_line()) result.PMNS_theta13=SLHAea::to<double>(spectrum["UPMNSIN"][3][1]);
-        if (spectrum["UPMNSIN"][4].is_data_line()) result.PMNS_delta13=SLHAea::to<double>(spectrum["UPMNSIN"][4][1]);
-        if (spectrum["UPMNSIN"][5].is_data_line()) result.PMNS_alpha1=SLHAea::to<double>(spectrum["UPMNSIN"][5][1]);
-        if (spectrum["UPMNSIN"][6].is_data_line()) result.PMNS_alpha2=SLHAea::to<double>(spectrum["UPMNSIN"][6][1]);
+        if (spectrum.has("UPMNSIN",1)) result.PMNS_theta12=spectrum.get("UPMNSIN",1);
+        if (spectrum.has("UPMNSIN",2)) result.PMNS_theta23=spectrum.get("UPMNSIN",2);
+        if (spectrum.has("UPMNSIN",3)) result.PMNS_theta13=spectrum.get("UPMNSIN",3);
+        if (spectrum.has("UPMNSIN",4)) result.PMNS_delta13=spectrum.get("UPMNSIN",4);
+        if (spectrum.has("UPMNSIN",5)) result.PMNS_alpha1=spectrum.get("UPMNSIN",5);
+        if (spectrum.has("UPMNSIN",6)) result.PMNS_alpha2=spectrum.get("UPMNSIN",6);
       }
 
-      if (!spectrum["MINPAR"].empty())
+      if (spectrum.has_block("MINPAR"))
       {
         switch(result.model)
         {
           case 1:
           {
-            if (spectrum["MINPAR"][1].is_data_line()) result.m0=SLHAea::to<double>(spectrum["MINPAR"][1][1]);
-            if (spectrum["MINPAR"][2].is_data_line()) result.m12=SLHAea::to<double>(spectrum["MINPAR"][2][1]);
-            if (spectrum["MINPAR"][3].is_data_line()) result.tan_beta=SLHAea::to<double>(spectrum["MINPAR"][3][1]);
-            if (spectrum["MINPAR"][4].is_data_line()) result.sign_mu=SLHAea::to<double>(spectrum["MINPAR"][4][1]);
-            if (spectrum["MINPAR"][5].is_data_line()) result.A0=SLHAea::to<double>(spectrum["MINPAR"][5][1]);
+            if (spectrum.has("MINPAR",1)) result.m0=spectrum.get("MINPAR",1);
+            if (spectrum.has("MINPAR",2)) result.m12=spectrum.get("MINPAR",2);
+            if (spectrum.has("MINPAR",3)) result.tan_beta=spectrum.get("MINPAR",3);
+            if (spectrum.has("MINPAR",4)) result.sign_mu=spectrum.get("MINPAR",4);
+            if (spectrum.has("MINPAR",5)) result.A0=spectrum.get("MINPAR",5);
           }
           case 2:
           {
-            if (spectrum["MINPAR"][1].is_data_line()) result.Lambda=SLHAea::to<double>(spectrum["MINPAR"][1][1]);
-            if (spectrum["MINPAR"][2].is_data_line()) result.Mmess=SLHAea::to<double>(spectrum["MINPAR"][2][1]);
-            if (spectrum["MINPAR"][3].is_data_line()) result.tan_beta=SLHAea::to<double>(spectrum["MINPAR"][3][1]);
-            if (spectrum["MINPAR"][4].is_data_line()) result.sign_mu=SLHAea::to<double>(spectrum["MINPAR"][4][1]);
-            if (spectrum["MINPAR"][5].is_data_line()) result.N5=SLHAea::to<double>(spectrum["MINPAR"][5][1]);
-            if (spectrum["MINPAR"][6].is_data_line()) result.cgrav=SLHAea::to<double>(spectrum["MINPAR"][6][1]);
+            if (spectrum.has("MINPAR",1)) result.Lambda=spectrum.get("MINPAR",1);
+            if (spectrum.has("MINPAR",2)) result.Mmess=spectrum.get("MINPAR",2);
+            if (spectrum.has("MINPAR",3)) result.tan_beta=spectrum.get("MINPAR",3);
+            if (spectrum.has("MINPAR",4)) result.sign_mu=spectrum.get("MINPAR",4);
+            if (spectrum.has("MINPAR",5)) result.N5=spectrum.get("MINPAR",5);
+            if (spectrum.has("MINPAR",6)) result.cgrav=spectrum.get("MINPAR",6);
           }
           case 3:
           {
-            if (spectrum["MINPAR"][1].is_data_line()) result.m32=SLHAea::to<double>(spectrum["MINPAR"][1][1]);
-            if (spectrum["MINPAR"][2].is_data_line()) result.m0=SLHAea::to<double>(spectrum["MINPAR"][2][1]);
-            if (spectrum["MINPAR"][3].is_data_line()) result.tan_beta=SLHAea::to<double>(spectrum["MINPAR"][3][1]);
-            if (spectrum["MINPAR"][4].is_data_line()) result.sign_mu=SLHAea::to<double>(spectrum["MINPAR"][4][1]);
+            if (spectrum.has("MINPAR",1)) result.m32=spectrum.get("MINPAR",1);
+            if (spectrum.has("MINPAR",2)) result.m0=spectrum.get("MINPAR",2);
+            if (spectrum.has("MINPAR",3)) result.tan_beta=spectrum.get("MINPAR",3);
+            if (spectrum.has("MINPAR",4)) result.sign_mu=spectrum.get("MINPAR",4);
           }
           default:
           {
-            if (spectrum["MINPAR"][3].is_data_line()) result.tan_beta=SLHAea::to<double>(spectrum["MINPAR"][3][1]);
+            if (spectrum.has("MINPAR",3)) result.tan_beta=spectrum.get("MINPAR",3);
           }
         }
       }
 
-      if (!spectrum["EXTPAR"].empty())
+      if (spectrum.has_block("EXTPAR"))
       {
-        if (spectrum["EXTPAR"][0].is_data_line()) result.Min=SLHAea::to<double>(spectrum["EXTPAR"][0][1]);
-        if (spectrum["EXTPAR"][1].is_data_line()) result.M1_Min=SLHAea::to<double>(spectrum["EXTPAR"][1][1]);
-        if (spectrum["EXTPAR"][2].is_data_line()) result.M2_Min=SLHAea::to<double>(spectrum["EXTPAR"][2][1]);
-        if (spectrum["EXTPAR"][3].is_data_line()) result.M3_Min=SLHAea::to<double>(spectrum["EXTPAR"][3][1]);
-        if (spectrum["EXTPAR"][11].is_data_line()) result.At_Min=SLHAea::to<double>(spectrum["EXTPAR"][11][1]);
-        if (spectrum["EXTPAR"][12].is_data_line()) result.Ab_Min=SLHAea::to<double>(spectrum["EXTPAR"][12][1]);
-        if (spectrum["EXTPAR"][13].is_data_line()) result.Atau_Min=SLHAea::to<double>(spectrum["EXTPAR"][13][1]);
-        if (spectrum["EXTPAR"][21].is_data_line()) result.M2H1_Min=SLHAea::to<double>(spectrum["EXTPAR"][21][1]);
-        if (spectrum["EXTPAR"][22].is_data_line()) result.M2H2_Min=SLHAea::to<double>(spectrum["EXTPAR"][22][1]);
-        if (spectrum["EXTPAR"][23].is_data_line()) result.mu_Min=SLHAea::to<double>(spectrum["EXTPAR"][23][1]);
-        if (spectrum["EXTPAR"][24].is_data_line()) result.M2A_Min=SLHAea::to<double>(spectrum["EXTPAR"][24][1]);
-        if (spectrum["EXTPAR"][25].is_data_line()) result.tb_Min=SLHAea::to<double>(spectrum["EXTPAR"][25][1]);
-        if (spectrum["EXTPAR"][26].is_data_line()) result.mA_Min=SLHAea::to<double>(spectrum["EXTPAR"][26][1]);
-        if (spectrum["EXTPAR"][31].is_data_line()) result.MeL_Min=SLHAea::to<double>(spectrum["EXTPAR"][31][1]);
-        if (spectrum["EXTPAR"][32].is_data_line()) result.MmuL_Min=SLHAea::to<double>(spectrum["EXTPAR"][32][1]);
-        if (spectrum["EXTPAR"][33].is_data_line()) result.MtauL_Min=SLHAea::to<double>(spectrum["EXTPAR"][33][1]);
-        if (spectrum["EXTPAR"][34].is_data_line()) result.MeR_Min=SLHAea::to<double>(spectrum["EXTPAR"][34][1]);
-        if (spectrum["EXTPAR"][35].is_data_line()) result.MmuR_Min=SLHAea::to<double>(spectrum["EXTPAR"][35][1]);
-        if (spectrum["EXTPAR"][36].is_data_line()) result.MtauR_Min=SLHAea::to<double>(spectrum["EXTPAR"][36][1]);
-        if (spectrum["EXTPAR"][41].is_data_line()) result.MqL1_Min=SLHAea::to<double>(spectrum["EXTPAR"][41][1]);
-        if (spectrum["EXTPAR"][42].is_data_line()) result.MqL2_Min=SLHAea::to<double>(spectrum["EXTPAR"][42][1]);
-        if (spectrum["EXTPAR"][43].is_data_line()) result.MqL3_Min=SLHAea::to<double>(spectrum["EXTPAR"][43][1]);
-        if (spectrum["EXTPAR"][44].is_data_line()) result.MuR_Min=SLHAea::to<double>(spectrum["EXTPAR"][44][1]);
-        if (spectrum["EXTPAR"][45].is_data_line()) result.McR_Min=SLHAea::to<double>(spectrum["EXTPAR"][45][1]);
-        if (spectrum["EXTPAR"][46].is_data_line()) result.MtR_Min=SLHAea::to<double>(spectrum["EXTPAR"][46][1]);
-        if (spectrum["EXTPAR"][47].is_data_line()) result.MdR_Min=SLHAea::to<double>(spectrum["EXTPAR"][47][1]);
-        if (spectrum["EXTPAR"][48].is_data_line()) result.MsR_Min=SLHAea::to<double>(spectrum["EXTPAR"][48][1]);
-        if (spectrum["EXTPAR"][49].is_data_line()) result.MbR_Min=SLHAea::to<double>(spectrum["EXTPAR"][49][1]);
-        if (spectrum["EXTPAR"][51].is_data_line()) result.N51=SLHAea::to<double>(spectrum["EXTPAR"][51][1]);
-        if (spectrum["EXTPAR"][52].is_data_line()) result.N52=SLHAea::to<double>(spectrum["EXTPAR"][52][1]);
-        if (spectrum["EXTPAR"][53].is_data_line()) result.N53=SLHAea::to<double>(spectrum["EXTPAR"][53][1]);
-        if (spectrum["EXTPAR"][61].is_data_line()) result.lambdaNMSSM_Min=SLHAea::to<double>(spectrum["EXTPAR"][61][1]);
-        if (spectrum["EXTPAR"][62].is_data_line()) result.kappaNMSSM_Min=SLHAea::to<double>(spectrum["EXTPAR"][62][1]);
-        if (spectrum["EXTPAR"][63].is_data_line()) result.AlambdaNMSSM_Min=SLHAea::to<double>(spectrum["EXTPAR"][63][1]);
-        if (spectrum["EXTPAR"][64].is_data_line()) result.AkappaNMSSM_Min=SLHAea::to<double>(spectrum["EXTPAR"][64][1]);
-        if (spectrum["EXTPAR"][65].is_data_line()) result.lambdaSNMSSM_Min=SLHAea::to<double>(spectrum["EXTPAR"][65][1]);
-        if (spectrum["EXTPAR"][66].is_data_line()) result.xiFNMSSM_Min=SLHAea::to<double>(spectrum["EXTPAR"][66][1]);
-        if (spectrum["EXTPAR"][67].is_data_line()) result.xiSNMSSM_Min=SLHAea::to<double>(spectrum["EXTPAR"][67][1]);
-        if (spectrum["EXTPAR"][68].is_data_line()) result.mupNMSSM_Min=SLHAea::to<double>(spectrum["EXTPAR"][68][1]);
-        if (spectrum["EXTPAR"][69].is_data_line()) result.mSp2NMSSM_Min=SLHAea::to<double>(spectrum["EXTPAR"][69][1]);
-        if (spectrum["EXTPAR"][70].is_data_line()) result.mS2NMSSM_Min=SLHAea::to<double>(spectrum["EXTPAR"][70][1]);
+        if (spectrum.has("EXTPAR",0)) result.Min=spectrum.get("EXTPAR",0);
+        if (spectrum.has("EXTPAR",1)) result.M1_Min=spectrum.get("EXTPAR",1);
+        if (spectrum.has("EXTPAR",2)) result.M2_Min=spectrum.get("EXTPAR",2);
+        if (spectrum.has("EXTPAR",3)) result.M3_Min=spectrum.get("EXTPAR",3);
+        if (spectrum.has("EXTPAR",11)) result.At_Min=spectrum.get("EXTPAR",11);
+        if (spectrum.has("EXTPAR",12)) result.Ab_Min=spectrum.get("EXTPAR",12);
+        if (spectrum.has("EXTPAR",13)) result.Atau_Min=spectrum.get("EXTPAR",13);
+        if (spectrum.has("EXTPAR",21)) result.M2H1_Min=spectrum.get("EXTPAR",21);
+        if (spectrum.has("EXTPAR",22)) result.M2H2_Min=spectrum.get("EXTPAR",22);
+        if (spectrum.has("EXTPAR",23)) result.mu_Min=spectrum.get("EXTPAR",23);
+        if (spectrum.has("EXTPAR",24)) result.M2A_Min=spectrum.get("EXTPAR",24);
+        if (spectrum.has("EXTPAR",25)) result.tb_Min=spectrum.get("EXTPAR",25);
+        if (spectrum.has("EXTPAR",26)) result.mA_Min=spectrum.get("EXTPAR",26);
+        if (spectrum.has("EXTPAR",31)) result.MeL_Min=spectrum.get("EXTPAR",31);
+        if (spectrum.has("EXTPAR",32)) result.MmuL_Min=spectrum.get("EXTPAR",32);
+        if (spectrum.has("EXTPAR",33)) result.MtauL_Min=spectrum.get("EXTPAR",33);
+        if (spectrum.has("EXTPAR",34)) result.MeR_Min=spectrum.get("EXTPAR",34);
+        if (spectrum.has("EXTPAR",35)) result.MmuR_Min=spectrum.get("EXTPAR",35);
+        if (spectrum.has("EXTPAR",36)) result.MtauR_Min=spectrum.get("EXTPAR",36);
+        if (spectrum.has("EXTPAR",41)) result.MqL1_Min=spectrum.get("EXTPAR",41);
+        if (spectrum.has("EXTPAR",42)) result.MqL2_Min=spectrum.get("EXTPAR",42);
+        if (spectrum.has("EXTPAR",43)) result.MqL3_Min=spectrum.get("EXTPAR",43);
+        if (spectrum.has("EXTPAR",44)) result.MuR_Min=spectrum.get("EXTPAR",44);
+        if (spectrum.has("EXTPAR",45)) result.McR_Min=spectrum.get("EXTPAR",45);
+        if (spectrum.has("EXTPAR",46)) result.MtR_Min=spectrum.get("EXTPAR",46);
+        if (spectrum.has("EXTPAR",47)) result.MdR_Min=spectrum.get("EXTPAR",47);
+        if (spectrum.has("EXTPAR",48)) result.MsR_Min=spectrum.get("EXTPAR",48);
+        if (spectrum.has("EXTPAR",49)) result.MbR_Min=spectrum.get("EXTPAR",49);
+        if (spectrum.has("EXTPAR",51)) result.N51=spectrum.get("EXTPAR",51);
+        if (spectrum.has("EXTPAR",52)) result.N52=spectrum.get("EXTPAR",52);
+        if (spectrum.has("EXTPAR",53)) result.N53=spectrum.get("EXTPAR",53);
+        if (spectrum.has("EXTPAR",61)) result.lambdaNMSSM_Min=spectrum.get("EXTPAR",61);
+        if (spectrum.has("EXTPAR",62)) result.kappaNMSSM_Min=spectrum.get("EXTPAR",62);
+        if (spectrum.has("EXTPAR",63)) result.AlambdaNMSSM_Min=spectrum.get("EXTPAR",63);
+        if (spectrum.has("EXTPAR",64)) result.AkappaNMSSM_Min=spectrum.get("EXTPAR",64);
+        if (spectrum.has("EXTPAR",65)) result.lambdaSNMSSM_Min=spectrum.get("EXTPAR",65);
+        if (spectrum.has("EXTPAR",66)) result.xiFNMSSM_Min=spectrum.get("EXTPAR",66);
+        if (spectrum.has("EXTPAR",67)) result.xiSNMSSM_Min=spectrum.get("EXTPAR",67);
+        if (spectrum.has("EXTPAR",68)) result.mupNMSSM_Min=spectrum.get("EXTPAR",68);
+        if (spectrum.has("EXTPAR",69)) result.mSp2NMSSM_Min=spectrum.get("EXTPAR",69);
+        if (spectrum.has("EXTPAR",70)) result.mS2NMSSM_Min=spectrum.get("EXTPAR",70);
       }
 
-      if (!spectrum["MASS"].empty())
+      if (spectrum.has_block("MASS"))
       {
-        if (spectrum["MASS"][1].is_data_line()) result.mass_d=SLHAea::to<double>(spectrum["MASS"][1][1]);
-        if (spectrum["MASS"][2].is_data_line()) result.mass_u=SLHAea::to<double>(spectrum["MASS"][2][1]);
-        if (spectrum["MASS"][3].is_data_line()) result.mass_s=SLHAea::to<double>(spectrum["MASS"][3][1]);
-        if (spectrum["MASS"][4].is_data_line()) result.mass_c=SLHAea::to<double>(spectrum["MASS"][4][1]);
-        if (spectrum["MASS"][6].is_data_line()) result.mass_t=SLHAea::to<double>(spectrum["MASS"][6][1]);
-        if (spectrum["MASS"][11].is_data_line()) result.mass_e=SLHAea::to<double>(spectrum["MASS"][11][1]);
-        if (spectrum["MASS"][12].is_data_line()) result.mass_nue=SLHAea::to<double>(spectrum["MASS"][12][1]);
-        if (spectrum["MASS"][13].is_data_line()) result.mass_mu=SLHAea::to<double>(spectrum["MASS"][13][1]);
-        if (spectrum["MASS"][14].is_data_line()) result.mass_num=SLHAea::to<double>(spectrum["MASS"][14][1]);
-        if (spectrum["MASS"][15].is_data_line()) result.mass_tau=result.mass_tau_pole=SLHAea::to<double>(spectrum["MASS"][15][1]);
-        if (spectrum["MASS"][16].is_data_line()) result.mass_nut=SLHAea::to<double>(spectrum["MASS"][16][1]);
-        if (spectrum["MASS"][21].is_data_line()) result.mass_gluon=SLHAea::to<double>(spectrum["MASS"][21][1]);
-        if (spectrum["MASS"][22].is_data_line()) result.mass_photon=SLHAea::to<double>(spectrum["MASS"][22][1]);
-        if (spectrum["MASS"][23].is_data_line()) result.mass_Z0=SLHAea::to<double>(spectrum["MASS"][23][1]);
-        if (spectrum["MASS"][24].is_data_line()) result.mass_W=SLHAea::to<double>(spectrum["MASS"][24][1]);
-        if (spectrum["MASS"][25].is_data_line()) result.mass_h0=SLHAea::to<double>(spectrum["MASS"][25][1]);
-        if (spectrum["MASS"][35].is_data_line()) result.mass_H0=SLHAea::to<double>(spectrum["MASS"][35][1]);
-        if (spectrum["MASS"][36].is_data_line()) result.mass_A0=SLHAea::to<double>(spectrum["MASS"][36][1]);
-        if (spectrum["MASS"][37].is_data_line()) result.mass_H=SLHAea::to<double>(spectrum["MASS"][37][1]);
-        if (spectrum["MASS"][39].is_data_line()) result.mass_graviton=SLHAea::to<double>(spectrum["MASS"][39][1]);
-        if (spectrum["MASS"][45].is_data_line()) result.mass_H03=SLHAea::to<double>(spectrum["MASS"][45][1]);
-        if (spectrum["MASS"][46].is_data_line()) result.mass_A02=SLHAea::to<double>(spectrum["MASS"][46][1]);
-        if (spectrum["MASS"][1000001].is_data_line()) result.mass_dnl=SLHAea::to<double>(spectrum["MASS"][1000001][1]);
-        if (spectrum["MASS"][1000002].is_data_line()) result.mass_upl=SLHAea::to<double>(spectrum["MASS"][1000002][1]);
-        if (spectrum["MASS"][1000003].is_data_line()) result.mass_stl=SLHAea::to<double>(spectrum["MASS"][1000003][1]);
-        if (spectrum["MASS"][1000004].is_data_line()) result.mass_chl=SLHAea::to<double>(spectrum["MASS"][1000004][1]);
-        if (spectrum["MASS"][1000005].is_data_line()) result.mass_b1=SLHAea::to<double>(spectrum["MASS"][1000005][1]);
-        if (spectrum["MASS"][1000006].is_data_line()) result.mass_t1=SLHAea::to<double>(spectrum["MASS"][1000006][1]);
-        if (spectrum["MASS"][1000011].is_data_line()) result.mass_el=SLHAea::to<double>(spectrum["MASS"][1000011][1]);
-        if (spectrum["MASS"][1000012].is_data_line()) result.mass_nuel=SLHAea::to<double>(spectrum["MASS"][1000012][1]);
-        if (spectrum["MASS"][1000013].is_data_line()) result.mass_mul=SLHAea::to<double>(spectrum["MASS"][1000013][1]);
-        if (spectrum["MASS"][1000014].is_data_line()) result.mass_numl=SLHAea::to<double>(spectrum["MASS"][1000014][1]);
-        if (spectrum["MASS"][1000015].is_data_line()) result.mass_tau1=SLHAea::to<double>(spectrum["MASS"][1000015][1]);
-        if (spectrum["MASS"][1000016].is_data_line()) result.mass_nutl=SLHAea::to<double>(spectrum["MASS"][1000016][1]);
-        if (spectrum["MASS"][1000021].is_data_line()) result.mass_gluino=SLHAea::to<double>(spectrum["MASS"][1000021][1]);
-        if (spectrum["MASS"][1000022].is_data_line()) result.mass_neut[1]=SLHAea::to<double>(spectrum["MASS"][1000022][1]);
-        if (spectrum["MASS"][1000023].is_data_line()) result.mass_neut[2]=SLHAea::to<double>(spectrum["MASS"][1000023][1]);
-        if (spectrum["MASS"][1000024].is_data_line()) result.mass_cha1=SLHAea::to<double>(spectrum["MASS"][1000024][1]);
-        if (spectrum["MASS"][1000025].is_data_line()) result.mass_neut[3]=SLHAea::to<double>(spectrum["MASS"][1000025][1]);
-        if (spectrum["MASS"][1000035].is_data_line()) result.mass_neut[4]=SLHAea::to<double>(spectrum["MASS"][1000035][1]);
-        if (spectrum["MASS"][1000037].is_data_line()) result.mass_cha2=SLHAea::to<double>(spectrum["MASS"][1000037][1]);
-        if (spectrum["MASS"][1000039].is_data_line()) result.mass_gravitino=SLHAea::to<double>(spectrum["MASS"][1000039][1]);
-        if (spectrum["MASS"][1000045].is_data_line()) result.mass_neut[5]=SLHAea::to<double>(spectrum["MASS"][1000045][1]);
-        if (spectrum["MASS"][2000001].is_data_line()) result.mass_dnr=SLHAea::to<double>(spectrum["MASS"][2000001][1]);
-        if (spectrum["MASS"][2000002].is_data_line()) result.mass_upr=SLHAea::to<double>(spectrum["MASS"][2000002][1]);
-        if (spectrum["MASS"][2000003].is_data_line()) result.mass_str=SLHAea::to<double>(spectrum["MASS"][2000003][1]);
-        if (spectrum["MASS"][2000004].is_data_line()) result.mass_chr=SLHAea::to<double>(spectrum["MASS"][2000004][1]);
-        if (spectrum["MASS"][2000005].is_data_line()) result.mass_b2=SLHAea::to<double>(spectrum["MASS"][2000005][1]);
-        if (spectrum["MASS"][2000006].is_data_line()) result.mass_t2=SLHAea::to<double>(spectrum["MASS"][2000006][1]);
-        if (spectrum["MASS"][2000011].is_data_line()) result.mass_er=SLHAea::to<double>(spectrum["MASS"][2000011][1]);
-        if (spectrum["MASS"][2000012].is_data_line()) result.mass_nuer=SLHAea::to<double>(spectrum["MASS"][2000012][1]);
-        if (spectrum["MASS"][2000013].is_data_line()) result.mass_mur=SLHAea::to<double>(spectrum["MASS"][2000013][1]);
-        if (spectrum["MASS"][2000014].is_data_line()) result.mass_numr=SLHAea::to<double>(spectrum["MASS"][2000014][1]);
-        if (spectrum["MASS"][2000015].is_data_line()) result.mass_tau2=SLHAea::to<double>(spectrum["MASS"][2000015][1]);
-        if (spectrum["MASS"][2000016].is_data_line()) result.mass_nutr=SLHAea::to<double>(spectrum["MASS"][2000016][1]);
+        if (spectrum.has("MASS",1)) result.mass_d=spectrum.get("MASS",1);
+        if (spectrum.has("MASS",2)) result.mass_u=spectrum.get("MASS",2);
+        if (spectrum.has("MASS",3)) result.mass_s=spectrum.get("MASS",3);
+        if (spectrum.has("MASS",4)) result.mass_c=spectrum.get("MASS",4);
+        if (spectrum.has("MASS",6)) result.mass_t=spectrum.get("MASS",6);
+        if (spectrum.has("MASS",11)) result.mass_e=spectrum.get("MASS",11);
+        if (spectrum.has("MASS",12)) result.mass_nue=spectrum.get("MASS",12);
+        if (spectrum.has("MASS",13)) result.mass_mu=spectrum.get("MASS",13);
+        if (spectrum.has("MASS",14)) result.mass_num=spectrum.get("MASS",14);
+        if (spectrum.has("MASS",15)) result.mass_tau=result.mass_tau_pole=spectrum.get("MASS",15);
+        if (spectrum.has("MASS",16)) result.mass_nut=spectrum.get("MASS",16);
+        if (spectrum.has("MASS",21)) result.mass_gluon=spectrum.get("MASS",21);
+        if (spectrum.has("MASS",22)) result.mass_photon=spectrum.get("MASS",22);
+        if (spectrum.has("MASS",23)) result.mass_Z0=spectrum.get("MASS",23);
+        if (spectrum.has("MASS",24)) result.mass_W=spectrum.get("MASS",24);
+        if (spectrum.has("MASS",25)) result.mass_h0=spectrum.get("MASS",25);
+        if (spectrum.has("MASS",35)) result.mass_H0=spectrum.get("MASS",35);
+        if (spectrum.has("MASS",36)) result.mass_A0=spectrum.get("MASS",36);
+        if (spectrum.has("MASS",37)) result.mass_H=spectrum.get("MASS",37);
+        if (spectrum.has("MASS",39)) result.mass_graviton=spectrum.get("MASS",39);
+        if (spectrum.has("MASS",45)) result.mass_H03=spectrum.get("MASS",45);
+        if (spectrum.has("MASS",46)) result.mass_A02=spectrum.get("MASS",46);
+        if (spectrum.has("MASS",1000001)) result.mass_dnl=spectrum.get("MASS",1000001);
+        if (spectrum.has("MASS",1000002)) result.mass_upl=spectrum.get("MASS",1000002);
+        if (spectrum.has("MASS",1000003)) result.mass_stl=spectrum.get("MASS",1000003);
+        if (spectrum.has("MASS",1000004)) result.mass_chl=spectrum.get("MASS",1000004);
+        if (spectrum.has("MASS",1000005)) result.mass_b1=spectrum.get("MASS",1000005);
+        if (spectrum.has("MASS",1000006)) result.mass_t1=spectrum.get("MASS",1000006);
+        if (spectrum.has("MASS",1000011)) result.mass_el=spectrum.get("MASS",1000011);
+        if (spectrum.has("MASS",1000012)) result.mass_nuel=spectrum.get("MASS",1000012);
+        if (spectrum.has("MASS",1000013)) result.mass_mul=spectrum.get("MASS",1000013);
+        if (spectrum.has("MASS",1000014)) result.mass_numl=spectrum.get("MASS",1000014);
+        if (spectrum.has("MASS",1000015)) result.mass_tau1=spectrum.get("MASS",1000015);
+        if (spectrum.has("MASS",1000016)) result.mass_nutl=spectrum.get("MASS",1000016);
+        if (spectrum.has("MASS",1000021)) result.mass_gluino=spectrum.get("MASS",1000021);
+        if (spectrum.has("MASS",1000022)) result.mass_neut[1]=spectrum.get("MASS",1000022);
+        if (spectrum.has("MASS",1000023)) result.mass_neut[2]=spectrum.get("MASS",1000023);
+        if (spectrum.has("MASS",1000024)) result.mass_cha1=spectrum.get("MASS",1000024);
+        if (spectrum.has("MASS",1000025)) result.mass_neut[3]=spectrum.get("MASS",1000025);
+        if (spectrum.has("MASS",1000035)) result.mass_neut[4]=spectrum.get("MASS",1000035);
+        if (spectrum.has("MASS",1000037)) result.mass_cha2=spectrum.get("MASS",1000037);
+        if (spectrum.has("MASS",1000039)) result.mass_gravitino=spectrum.get("MASS",1000039);
+        if (spectrum.has("MASS",1000045)) result.mass_neut[5]=spectrum.get("MASS",1000045);
+        if (spectrum.has("MASS",2000001)) result.mass_dnr=spectrum.get("MASS",2000001);
+        if (spectrum.has("MASS",2000002)) result.mass_upr=spectrum.get("MASS",2000002);
+        if (spectrum.has("MASS",2000003)) result.mass_str=spectrum.get("MASS",2000003);
+        if (spectrum.has("MASS",2000004)) result.mass_chr=spectrum.get("MASS",2000004);
+        if (spectrum.has("MASS",2000005)) result.mass_b2=spectrum.get("MASS",2000005);
+        if (spectrum.has("MASS",2000006)) result.mass_t2=spectrum.get("MASS",2000006);
+        if (spectrum.has("MASS",2000011)) result.mass_er=spectrum.get("MASS",2000011);
+        if (spectrum.has("MASS",2000012)) result.mass_nuer=spectrum.get("MASS",2000012);
+        if (spectrum.has("MASS",2000013)) result.mass_mur=spectrum.get("MASS",2000013);
+        if (spectrum.has("MASS",2000014)) result.mass_numr=spectrum.get("MASS",2000014);
+        if (spectrum.has("MASS",2000015)) result.mass_tau2=spectrum.get("MASS",2000015);
+        if (spectrum.has("MASS",2000016)) result.mass_nutr=spectrum.get("MASS",2000016);
       }
 
       // The following blocks will only appear for SUSY models so let's not waste time checking them if we're not scanning one of those.
@@ -299,142 +298,142 @@ namespace Gambit
         // The scale doesn't come through in MODSEL with all spectrum generators
         result.Q = Dep::MSSM_spectrum->get_HE().GetScale();
 
-        if (!spectrum["ALPHA"].empty()) if (spectrum["ALPHA"].back().is_data_line()) result.alpha=SLHAea::to<double>(spectrum["ALPHA"].back().at(0));
-
-        if (!spectrum["STOPMIX"].empty()) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
-         if (spectrum["STOPMIX"][max(ie,je)].is_data_line()) result.stop_mix[ie][je]=SLHAea::to<double>(spectrum["STOPMIX"].at(ie,je)[2]);
-        if (!spectrum["SBOTMIX"].empty()) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
-         if (spectrum["SBOTMIX"][max(ie,je)].is_data_line()) result.sbot_mix[ie][je]=SLHAea::to<double>(spectrum["SBOTMIX"].at(ie,je)[2]);
-        if (!spectrum["STAUMIX"].empty()) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
-         if (spectrum["STAUMIX"][max(ie,je)].is_data_line()) result.stau_mix[ie][je]=SLHAea::to<double>(spectrum["STAUMIX"].at(ie,je)[2]);
-        if (!spectrum["NMIX"].empty()) for (ie=1;ie<=4;ie++) for (je=1;je<=4;je++)
-         if (spectrum["NMIX"][max(ie,je)].is_data_line()) result.neut_mix[ie][je]=SLHAea::to<double>(spectrum["NMIX"].at(ie,je)[2]);
-        if (!spectrum["NMNMIX"].empty()) for (ie=1;ie<=5;ie++) for (je=1;je<=5;je++)
-         if (spectrum["NMNMIX"][max(ie,je)].is_data_line()) result.neut_mix[ie][je]=SLHAea::to<double>(spectrum["NMNMIX"].at(ie,je)[2]);
-        if (!spectrum["UMIX"].empty()) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
-         if (spectrum["UMIX"][max(ie,je)].is_data_line()) result.charg_Umix[ie][je]=SLHAea::to<double>(spectrum["UMIX"].at(ie,je)[2]);
-        if (!spectrum["VMIX"].empty()) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
-         if (spectrum["VMIX"][max(ie,je)].is_data_line()) result.charg_Vmix[ie][je]=SLHAea::to<double>(spectrum["VMIX"].at(ie,je)[2]);
-
-        if (!spectrum["GAUGE"].empty())
+        if (spectrum.has_block("ALPHA")) if (spectrum["ALPHA"].has()) result.alpha=spectrum["ALPHA"].get();
+
+        if (spectrum.has_block("STOPMIX")) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
+         if (spectrum.has("STOPMIX",ie,je)) result.stop_mix[ie][je]=spectrum.get("STOPMIX",ie,je);
+        if (spectrum.has_block("SBOTMIX")) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
+         if (spectrum.has("SBOTMIX",ie,je)) result.sbot_mix[ie][je]=spectrum.get("SBOTMIX",ie,je);
+        if (spectrum.has_block("STAUMIX")) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
+         if (spectrum.has("STAUMIX",ie,je)) result.stau_mix[ie][je]=spectrum.get("STAUMIX",ie,je);
+        if (spectrum.has_block("NMIX")) for (ie=1;ie<=4;ie++) for (je=1;je<=4;je++)
+         if (spectrum.has("NMIX",ie,je)) result.neut_mix[ie][je]=spectrum.get("NMIX",ie,je);
+        if (spectrum.has_block("NMNMIX")) for (ie=1;ie<=5;ie++) for (je=1;je<=5;je++)
+         if (spectrum.has("NMNMIX",ie,je)) result.neut_mix[ie][je]=spectrum.get("NMNMIX",ie,je);
+        if (spectrum.has_block("UMIX")) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
+         if (spectrum.has("UMIX",ie,je)) result.charg_Umix[ie][je]=spectrum.get("UMIX",ie,je);
+        if (spectrum.has_block("VMIX")) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
+         if (spectrum.has("VMIX",ie,je)) result.charg_Vmix[ie][je]=spectrum.get("VMIX",ie,je);
+
+        if (spectrum.has_block("GAUGE"))
         {
-          if (spectrum["GAUGE"][1].is_data_line()) result.gp_Q=SLHAea::to<double>(spectrum["GAUGE"][1][1]);
-          if (spectrum["GAUGE"][2].is_data_line()) result.g2_Q=SLHAea::to<double>(spectrum["GAUGE"][2][1]);
-          if (spectrum["GAUGE"][3].is_data_line()) result.g3_Q=SLHAea::to<double>(spectrum["GAUGE"][3][1]);
+          if (spectrum.has("GAUGE",1)) result.gp_Q=spectrum.get("GAUGE",1);
+          if (spectrum.has("GAUGE",2)) result.g2_Q=spectrum.get("GAUGE",2);
+          if (spectrum.has("GAUGE",3)) result.g3_Q=spectrum.get("GAUGE",3);
         }
 
-        if (!spectrum["YU"].empty()) for (ie=1;ie<=3;ie++) if (spectrum["YU"][ie].is_data_line()) result.yut[ie]=SLHAea::to<double>(spectrum["YU"].at(ie,ie)[2]);
-        if (!spectrum["YD"].empty()) for (ie=1;ie<=3;ie++) if (spectrum["YD"][ie].is_data_line()) result.yub[ie]=SLHAea::to<double>(spectrum["YD"].at(ie,ie)[2]);
-        if (!spectrum["YE"].empty()) for (ie=1;ie<=3;ie++) if (spectrum["YE"][ie].is_data_line()) result.yutau[ie]=SLHAea::to<double>(spectrum["YE"].at(ie,ie)[2]);
+        if (spectrum.has_block("YU")) for (ie=1;ie<=3;ie++) if (spectrum.has("YU",ie,ie)) result.yut[ie]=spectrum.get("YU",ie,ie);
+        if (spectrum.has_block("YD")) for (ie=1;ie<=3;ie++) if (spectrum.has("YD",ie,ie)) result.yub[ie]=spectrum.get("YD",ie,ie);
+        if (spectrum.has_block("YE")) for (ie=1;ie<=3;ie++) if (spectrum.has("YE",ie,ie)) result.yutau[ie]=spectrum.get("YE",ie,ie);
 
-        if (!spectrum["HMIX"].empty())
+        if (spectrum.has_block("HMIX"))
         {
-          if (spectrum["HMIX"][1].is_data_line()) result.mu_Q=SLHAea::to<double>(spectrum["HMIX"][1][1]);
-          if (spectrum["HMIX"][2].is_data_line()) result.tanb_GUT=SLHAea::to<double>(spectrum["HMIX"][2][1]);
-          if (spectrum["HMIX"][3].is_data_line()) result.Higgs_VEV=SLHAea::to<double>(spectrum["HMIX"][3][1]);
-          if (spectrum["HMIX"][4].is_data_line()) result.mA2_Q=SLHAea::to<double>(spectrum["HMIX"][4][1]);
+          if (spectrum.has("HMIX",1)) result.mu_Q=spectrum.get("HMIX",1);
+          if (spectrum.has("HMIX",2)) result.tanb_GUT=spectrum.get("HMIX",2);
+          if (spectrum.has("HMIX",3)) result.Higgs_VEV=spectrum.get("HMIX",3);
+          if (spectrum.has("HMIX",4)) result.mA2_Q=spectrum.get("HMIX",4);
         }
 
-        if (!spectrum["NMHMIX"].empty()) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
-         if (spectrum["NMHMIX"][max(ie,je)].is_data_line()) result.H0_mix[ie][je]=SLHAea::to<double>(spectrum["NMHMIX"].at(ie,je)[2]);
+        if (spectrum.has_block("NMHMIX")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (spectrum.has("NMHMIX",ie,je)) result.H0_mix[ie][je]=spectrum.get("NMHMIX",ie,je);
 
-        if (!spectrum["NMAMIX"].empty()) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
-         if (spectrum["NMAMIX"][max(ie,je)].is_data_line()) result.A0_mix[ie][je]=SLHAea::to<double>(spectrum["NMAMIX"].at(ie,je)[2]);
+        if (spectrum.has_block("NMAMIX")) for (ie=1;ie<=2;ie++) for (je=1;je<=2;je++)
+         if (spectrum.has("NMAMIX",ie,je)) result.A0_mix[ie][je]=spectrum.get("NMAMIX",ie,je);
 
-        if (!spectrum["MSOFT"].empty())
+        if (spectrum.has_block("MSOFT"))
         {
-          if (!spectrum["MSOFT"].front().empty()) result.MSOFT_Q=SLHAea::to<double>(spectrum["MSOFT"].front().at(3));
-          if (spectrum["MSOFT"][1].is_data_line()) result.M1_Q=SLHAea::to<double>(spectrum["MSOFT"][1][1]);
-          if (spectrum["MSOFT"][2].is_data_line()) result.M2_Q=SLHAea::to<double>(spectrum["MSOFT"][2][1]);
-          if (spectrum["MSOFT"][3].is_data_line()) result.M3_Q=SLHAea::to<double>(spectrum["MSOFT"][3][1]);
-          if (spectrum["MSOFT"][21].is_data_line()) result.M2H1_Q=SLHAea::to<double>(spectrum["MSOFT"][21][1]);
-          if (spectrum["MSOFT"][22].is_data_line()) result.M2H2_Q=SLHAea::to<double>(spectrum["MSOFT"][22][1]);
-          if (spectrum["MSOFT"][31].is_data_line()) result.MeL_Q=SLHAea::to<double>(spectrum["MSOFT"][31][1]);
-          if (spectrum["MSOFT"][32].is_data_line()) result.MmuL_Q=SLHAea::to<double>(spectrum["MSOFT"][32][1]);
-          if (spectrum["MSOFT"][33].is_data_line()) result.MtauL_Q=SLHAea::to<double>(spectrum["MSOFT"][33][1]);
-          if (spectrum["MSOFT"][34].is_data_line()) result.MeR_Q=SLHAea::to<double>(spectrum["MSOFT"][34][1]);
-          if (spectrum["MSOFT"][35].is_data_line()) result.MmuR_Q=SLHAea::to<double>(spectrum["MSOFT"][35][1]);
-          if (spectrum["MSOFT"][36].is_data_line()) result.MtauR_Q=SLHAea::to<double>(spectrum["MSOFT"][36][1]);
-          if (spectrum["MSOFT"][41].is_data_line()) result.MqL1_Q=SLHAea::to<double>(spectrum["MSOFT"][41][1]);
-          if (spectrum["MSOFT"][42].is_data_line()) result.MqL2_Q=SLHAea::to<double>(spectrum["MSOFT"][42][1]);
-          if (spectrum["MSOFT"][43].is_data_line()) result.MqL3_Q=SLHAea::to<double>(spectrum["MSOFT"][43][1]);
-          if (spectrum["MSOFT"][44].is_data_line()) result.MuR_Q=SLHAea::to<double>(spectrum["MSOFT"][44][1]);
-          if (spectrum["MSOFT"][45].is_data_line()) result.McR_Q=SLHAea::to<double>(spectrum["MSOFT"][45][1]);
-          if (spectrum["MSOFT"][46].is_data_line()) result.MtR_Q=SLHAea::to<double>(spectrum["MSOFT"][46][1]);
-          if (spectrum["MSOFT"][47].is_data_line()) result.MdR_Q=SLHAea::to<double>(spectrum["MSOFT"][47][1]);
-          if (spectrum["MSOFT"][48].is_data_line()) result.MsR_Q=SLHAea::to<double>(spectrum["MSOFT"][48][1]);
-          if (spectrum["MSOFT"][49].is_data_line()) result.MbR_Q=SLHAea::to<double>(spectrum["MSOFT"][49][1]);
+          if (spectrum["MSOFT"].has_scale()) result.MSOFT_Q=spectrum["MSOFT"].scale();
+          if (spectrum.has("MSOFT",1)) result.M1_Q=spectrum.get("MSOFT",1);
+          if (spectrum.has("MSOFT",2)) result.M2_Q=spectrum.get("MSOFT",2);
+          if (spectrum.has("MSOFT",3)) result.M3_Q=spectrum.get("MSOFT",3);
+          if (spectrum.has("MSOFT",21)) result.M2H1_Q=spectrum.get("MSOFT",21);
+          if (spectrum.has("MSOFT",22)) result.M2H2_Q=spectrum.get("MSOFT",22);
+          if (spectrum.has("MSOFT",31)) result.MeL_Q=spectrum.get("MSOFT",31);
+          if (spectrum.has("MSOFT",32)) result.MmuL_Q=spectrum.get("MSOFT",32);
+          if (spectrum.has("MSOFT",33)) result.MtauL_Q=spectrum.get("MSOFT",33);
+          if (spectrum.has("MSOFT",34)) result.MeR_Q=spectrum.get("MSOFT",34);
+          if (spectrum.has("MSOFT",35)) result.MmuR_Q=spectrum.get("MSOFT",35);
+          if (spectrum.has("MSOFT",36)) result.MtauR_Q=spectrum.get("MSOFT",36);
+          if (spectrum.has("MSOFT",41)) result.MqL1_Q=spectrum.get("MSOFT",41);
+          if (spectrum.has("MSOFT",42)) result.MqL2_Q=spectrum.get("MSOFT",42);
+          if (spectrum.has("MSOFT",43)) result.MqL3_Q=spectrum.get("MSOFT",43);
+          if (spectrum.has("MSOFT",44)) result.MuR_Q=spectrum.get("MSOFT",44);
+          if (spectrum.has("MSOFT",45)) result.McR_Q=spectrum.get("MSOFT",45);
+          if (spectrum.has("MSOFT",46)) result.MtR_Q=spectrum.get("MSOFT",46);
+          if (spectrum.has("MSOFT",47)) result.MdR_Q=spectrum.get("MSOFT",47);
+          if (spectrum.has("MSOFT",48)) result.MsR_Q=spectrum.get("MSOFT",48);
+          if (spectrum.has("MSOFT",49)) result.MbR_Q=spectrum.get("MSOFT",49);
         }
 
-        if (!spectrum["AU"].empty())
+        if (spectrum.has_block("AU"))
         {
-          if (spectrum["AU"][1].is_data_line()) result.A_u=SLHAea::to<double>(spectrum["AU"].at(1,1)[2]);
-          if (spectrum["AU"][2].is_data_line()) result.A_c=SLHAea::to<double>(spectrum["AU"].at(2,2)[2]);
-          if (spectrum["AU"][3].is_data_line()) result.A_t=SLHAea::to<double>(spectrum["AU"].at(3,3)[2]);
+          if (spectrum.has("AU",1,1)) result.A_u=spectrum.get("AU",1,1);
+          if (spectrum.has("AU",2,2)) result.A_c=spectrum.get("AU",2,2);
+          if (spectrum.has("AU",3,3)) result.A_t=spectrum.get("AU",3,3);
         }
 
-        if (!spectrum["AD"].empty())
+        if (spectrum.has_block("AD"))
         {
-          if (spectrum["AD"][1].is_data_line()) result.A_d=SLHAea::to<double>(spectrum["AD"].at(1,1)[2]);
-          if (spectrum["AD"][2].is_data_line()) result.A_s=SLHAea::to<double>(spectrum["AD"].at(2,2)[2]);
-          if (spectrum["AD"][3].is_data_line()) result.A_b=SLHAea::to<double>(spectrum["AD"].at(3,3)[2]);
+          if (spectrum.has("AD",1,1)) result.A_d=spectrum.get("AD",1,1);
+          if (spectrum.has("AD",2,2)) result.A_s=spectrum.get("AD",2,2);
+          if (spectrum.has("AD",3,3)) result.A_b=spectrum.get("AD",3,3);
         }
 
-        if (!spectrum["AE"].empty())
+        if (spectrum.has_block("AE"))
         {
-          if (spectrum["AE"][1].is_data_line()) result.A_e=SLHAea::to<double>(spectrum["AE"].at(1,1)[2]);
-          if (spectrum["AE"][2].is_data_line()) result.A_mu=SLHAea::to<double>(spectrum["AE"].at(2,2)[2]);
-          if (spectrum["AE"][3].is_data_line()) result.A_tau=SLHAea::to<double>(spectrum["AE"].at(3,3)[2]);
+          if (spectrum.has("AE",1,1)) result.A_e=spectrum.get("AE",1,1);
+          if (spectrum.has("AE",2,2)) result.A_mu=spectrum.get("AE",2,2);
+          if (spectrum.has("AE",3,3)) result.A_tau=spectrum.get("AE",3,3);
         }
 
-        if (!spectrum["NMSSMRUN"].empty())
+        if (spectrum.has_block("NMSSMRUN"))
         {
-          if (spectrum["NMSSMRUN"][1].is_data_line()) result.lambdaNMSSM=SLHAea::to<double>(spectrum["NMSSMRUN"][1][1]);
-          if (spectrum["NMSSMRUN"][2].is_data_line()) result.kappaNMSSM=SLHAea::to<double>(spectrum["NMSSMRUN"][2][1]);
-          if (spectrum["NMSSMRUN"][3].is_data_line()) result.AlambdaNMSSM=SLHAea::to<double>(spectrum["NMSSMRUN"][3][1]);
-          if (spectrum["NMSSMRUN"][4].is_data_line()) result.AkappaNMSSM=SLHAea::to<double>(spectrum["NMSSMRUN"][4][1]);
-          if (spectrum["NMSSMRUN"][5].is_data_line()) result.lambdaSNMSSM=SLHAea::to<double>(spectrum["NMSSMRUN"][5][1]);
-          if (spectrum["NMSSMRUN"][6].is_data_line()) result.xiFNMSSM=SLHAea::to<double>(spectrum["NMSSMRUN"][6][1]);
-          if (spectrum["NMSSMRUN"][7].is_data_line()) result.xiSNMSSM=SLHAea::to<double>(spectrum["NMSSMRUN"][7][1]);
-          if (spectrum["NMSSMRUN"][8].is_data_line()) result.mupNMSSM=SLHAea::to<double>(spectrum["NMSSMRUN"][8][1]);
-          if (spectrum["NMSSMRUN"][9].is_data_line()) result.mSp2NMSSM=SLHAea::to<double>(spectrum["NMSSMRUN"][9][1]);
-          if (spectrum["NMSSMRUN"][10].is_data_line()) result.mS2NMSSM=SLHAea::to<double>(spectrum["NMSSMRUN"][10][1]);
+          if (spectrum.has("NMSSMRUN",1)) result.lambdaNMSSM=spectrum.get("NMSSMRUN",1);
+          if (spectrum.has("NMSSMRUN",2)) result.kappaNMSSM=spectrum.get("NMSSMRUN",2);
+          if (spectrum.has("NMSSMRUN",3)) result.AlambdaNMSSM=spectrum.get("NMSSMRUN",3);
+          if (spectrum.has("NMSSMRUN",4)) result.AkappaNMSSM=spectrum.get("NMSSMRUN",4);
+          if (spectrum.has("NMSSMRUN",5)) result.lambdaSNMSSM=spectrum.get("NMSSMRUN",5);
+          if (spectrum.has("NMSSMRUN",6)) result.xiFNMSSM=spectrum.get("NMSSMRUN",6);
+          if (spectrum.has("NMSSMRUN",7)) result.xiSNMSSM=spectrum.get("NMSSMRUN",7);
+          if (spectrum.has("NMSSMRUN",8)) result.mupNMSSM=spectrum.get("NMSSMRUN",8);
+          if (spectrum.has("NMSSMRUN",9)) result.mSp2NMSSM=spectrum.get("NMSSMRUN",9);
+          if (spectrum.has("NMSSMRUN",10)) result.mS2NMSSM=spectrum.get("NMSSMRUN",10);
         }
 
-        if (!spectrum["USQMIX"].empty()) for (ie=1;ie<=6;ie++) for (je=1;je<=6;je++)
-         if (spectrum["USQMIX"][max(ie,je)].is_data_line()) result.sU_mix[ie][je]=SLHAea::to<double>(spectrum["USQMIX"].at(ie,je)[2]);
-        if (!spectrum["DSQMIX"].empty()) for (ie=1;ie<=6;ie++) for (je=1;je<=6;je++)
-         if (spectrum["DSQMIX"][max(ie,je)].is_data_line()) result.sD_mix[ie][je]=SLHAea::to<double>(spectrum["DSQMIX"].at(ie,je)[2]);
-        if (!spectrum["SELMIX"].empty()) for (ie=1;ie<=6;ie++) for (je=1;je<=6;je++)
-         if (spectrum["SELMIX"][max(ie,je)].is_data_line()) result.sE_mix[ie][je]=SLHAea::to<double>(spectrum["SELMIX"].at(ie,je)[2]);
-        if (!spectrum["SNUMIX"].empty()) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
-         if (spectrum["SNUMIX"][max(ie,je)].is_data_line()) result.sNU_mix[ie][je]=SLHAea::to<double>(spectrum["SNUMIX"].at(ie,je)[2]);
-
-        if (!spectrum["MSQ2"].empty()) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
-         if (spectrum["MSQ2"][max(ie,je)].is_data_line()) result.sCKM_msq2[ie][je]=SLHAea::to<double>(spectrum["MSQ2"].at(ie,je)[2]);
-        if (!spectrum["MSL2"].empty()) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
-         if (spectrum["MSL2"][max(ie,je)].is_data_line()) result.sCKM_msl2[ie][je]=SLHAea::to<double>(spectrum["MSL2"].at(ie,je)[2]);
-        if (!spectrum["MSD2"].empty()) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
-         if (spectrum["MSD2"][max(ie,je)].is_data_line()) result.sCKM_msd2[ie][je]=SLHAea::to<double>(spectrum["MSD2"].at(ie,je)[2]);
-        if (!spectrum["MSU2"].empty()) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
-         if (spectrum["MSU2"][max(ie,je)].is_data_line()) result.sCKM_msu2[ie][je]=SLHAea::to<double>(spectrum["MSU2"].at(ie,je)[2]);
-        if (!spectrum["MSE2"].empty()) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
-         if (spectrum["MSE2"][max(ie,je)].is_data_line()) result.sCKM_mse2[ie][je]=SLHAea::to<double>(spectrum["MSE2"].at(ie,je)[2]);
-
-        if (!spectrum["IMVCKM"].empty()) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
-         if (spectrum["IMVCKM"][max(ie,je)].is_data_line()) result.IMCKM[ie][je]=SLHAea::to<double>(spectrum["IMVCKM"].at(ie,je)[2]);
-        if (!spectrum["IMVCKM"].empty()) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
-         if (spectrum["IMVCKM"][max(ie,je)].is_data_line()) result.IMCKM[ie][je]=SLHAea::to<double>(spectrum["IMVCKM"].at(ie,je)[2]);
-
-        if (!spectrum["UPMNS"].empty()) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
-         if (spectrum["UPMNS"][max(ie,je)].is_data_line()) result.PMNS_U[ie][je]=SLHAea::to<double>(spectrum["UPMNS"].at(ie,je)[2]);
-
-        if (!spectrum["TU"].empty()) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
-         if (spectrum["TU"][max(ie,je)].is_data_line()) result.TU[ie][je]=SLHAea::to<double>(spectrum["TU"].at(ie,je)[2]);
-        if (!spectrum["TD"].empty()) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
-         if (spectrum["TD"][max(ie,je)].is_data_line()) result.TD[ie][je]=SLHAea::to<double>(spectrum["TD"].at(ie,je)[2]);
-        if (!spectrum["TE"].empty()) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
-         if (spectrum["TE"][max(ie,je)].is_data_line()) result.TE[ie][je]=SLHAea::to<double>(spectrum["TE"].at(ie,je)[2]);
+        if (spectrum.has_block("USQMIX")) for (ie=1;ie<=6;ie++) for (je=1;je<=6;je++)
+         if (spectrum.has("USQMIX",ie,je)) result.sU_mix[ie][je]=spectrum.get("USQMIX",ie,je);
+        if (spectrum.has_block("DSQMIX")) for (ie=1;ie<=6;ie++) for (je=1;je<=6;je++)
+         if (spectrum.has("DSQMIX",ie,je)) result.sD_mix[ie][je]=spectrum.get("DSQMIX",ie,je);
+        if (spectrum.has_block("SELMIX")) for (ie=1;ie<=6;ie++) for (je=1;je<=6;je++)
+         if (spectrum.has("SELMIX",ie,je)) result.sE_mix[ie][je]=spectrum.get("SELMIX",ie,je);
+        if (spectrum.has_block("SNUMIX")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (spectrum.has("SNUMIX",ie,je)) result.sNU_mix[ie][je]=spectrum.get("SNUMIX",ie,je);
+
+        if (spectrum.has_block("MSQ2")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (spectrum.has("MSQ2",ie,je)) result.sCKM_msq2[ie][je]=spectrum.get("MSQ2",ie,je);
+        if (spectrum.has_block("MSL2")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (spectrum.has("MSL2",ie,je)) result.sCKM_msl2[ie][je]=spectrum.get("MSL2",ie,je);
+        if (spectrum.has_block("MSD2")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (spectrum.has("MSD2",ie,je)) result.sCKM_msd2[ie][je]=spectrum.get("MSD2",ie,je);
+        if (spectrum.has_block("MSU2")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (spectrum.has("MSU2",ie,je)) result.sCKM_msu2[ie][je]=spectrum.get("MSU2",ie,je);
+        if (spectrum.has_block("MSE2")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (spectrum.has("MSE2",ie,je)) result.sCKM_mse2[ie][je]=spectrum.get("MSE2",ie,je);
+
+        if (spectrum.has_block("IMVCKM")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (spectrum.has("IMVCKM",ie,je)) result.IMCKM[ie][je]=spectrum.get("IMVCKM",ie,je);
+        if (spectrum.has_block("IMVCKM")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (spectrum.has("IMVCKM",ie,je)) result.IMCKM[ie][je]=spectrum.get("IMVCKM",ie,je);
+
+        if (spectrum.has_block("UPMNS")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (spectrum.has("UPMNS",ie,je)) result.PMNS_U[ie][je]=spectrum.get("UPMNS",ie,je);
+
+        if (spectrum.has_block("TU")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (spectrum.has("TU",ie,je)) result.TU[ie][je]=spectrum.get("TU",ie,je);
+        if (spectrum.has_block("TD")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (spectrum.has("TD",ie,je)) result.TD[ie][je]=spectrum.get("TD",ie,je);
+        if (spectrum.has_block("TE")) for (ie=1;ie<=3;ie++) for (je=1;je<=3;je++)
+         if (spectrum.has("TE",ie,je)) result.TE[ie][je]=spectrum.get("TE",ie,je);
       }
 
       else if (ModelInUse("WC"))
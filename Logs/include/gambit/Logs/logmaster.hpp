@@ -137,6 +137,9 @@ namespace Gambit
         /// Choose whether "Debug" tagged log messages will be ignored (i.e. not logged)
         void set_log_debug_messages(bool flag) {log_debug_messages=flag;}
 
+        /// Check whether "Debug" tagged log messages will actually be logged (lets callers skip building them)
+        bool logging_debug_messages() {return log_debug_messages and not silenced;}
+
         /// @}
 
       private:
@@ -135,6 +135,7 @@ namespace Gambit
             virtual int get_index_offset() const;
             //virtual SLHAstruct getSLHAea(int) const; // Using SubSpectrum bass class version
             virtual void add_to_SLHAea(int, SLHAea::Coll&) const;
+            virtual void add_to_SLHAea_from(int, SLHAea::Coll&, const SubSpectrum&) const;
             virtual const std::map<int, int>& PDG_translator() const;
 
             /// Map fillers
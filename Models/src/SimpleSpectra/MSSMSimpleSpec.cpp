@@ -410,12 +410,18 @@ namespace Gambit
 
       /// Add SLHAea object to another
       void MSSMSimpleSpec::add_to_SLHAea(int slha_version, SLHAea::Coll& slha) const
+      {
+        add_to_SLHAea_from(slha_version, slha, *this);
+      }
+
+      /// Add SLHAea object to another, taking the values from a SubSpectrum wrapping this one
+      void MSSMSimpleSpec::add_to_SLHAea_from(int slha_version, SLHAea::Coll& slha, const SubSpectrum& values) const
       {
         // Add SPINFO data if not already present
         SLHAea_add_GAMBIT_SPINFO(slha);
 
         // All MSSM blocks
-        slhahelp::add_MSSM_spectrum_to_SLHAea(*this, slha, slha_version);
+        slhahelp::add_MSSM_spectrum_to_SLHAea(values, slha, slha_version);
       }
 
       /// Retrieve the PDG translation map
@@ -473,7 +473,7 @@ namespace Gambit
     void make_MSSM_precision_spectrum_none(Spectrum& improved_spec /*(result)*/)
     {
       using namespace Pipes::make_MSSM_precision_spectrum_none;
-      improved_spec = *Dep::unimproved_MSSM_spectrum; // Does copy
+      improved_spec = *Dep::unimproved_MSSM_spectrum; // Shallow copy; overrides go into overlays on the shared SubSpectra
       improved_spec.drop_SLHAs_if_requested(runOptions, "GAMBIT_spectrum");
     }
 
@@ -481,7 +481,7 @@ namespace Gambit
     void make_MSSM_precision_spectrum_W(Spectrum& improved_spec /*(result)*/)
     {
       using namespace Pipes::make_MSSM_precision_spectrum_W;
-      improved_spec = *Dep::unimproved_MSSM_spectrum; // Does copy
+      improved_spec = *Dep::unimproved_MSSM_spectrum; // Shallow copy; overrides go into overlays on the shared SubSpectra
       static bool allow_fallback = runOptions->getValueOrDef<bool>(false, "allow_fallback_to_unimproved_masses");
       update_W_masses(improved_spec.get_HE(), improved_spec.get_LE(), *Dep::prec_mw, allow_fallback);
       improved_spec.drop_SLHAs_if_requested(runOptions, "GAMBIT_spectrum");
@@ -491,7 +491,7 @@ namespace Gambit
     void make_MSSM_precision_spectrum_H(Spectrum& improved_spec /*(result)*/)
     {
       using namespace Pipes::make_MSSM_precision_spectrum_H;
-      improved_spec = *Dep::unimproved_MSSM_spectrum; // Does copy
+      improved_spec = *Dep::unimproved_MSSM_spectrum; // Shallow copy; overrides go into overlays on the shared SubSpectra
       SubSpectrum& HE = improved_spec.get_HE();
       static bool allow_fallback = runOptions->getValueOrDef<bool>(false, "allow_fallback_to_unimproved_masses");
 
@@ -529,7 +529,7 @@ namespace Gambit
     void make_MSSM_precision_spectrum_H_W(Spectrum& improved_spec /*(result)*/)
     {
       using namespace Pipes::make_MSSM_precision_spectrum_H_W;
-      improved_spec = *Dep::unimproved_MSSM_spectrum; // Does copy
+      improved_spec = *Dep::unimproved_MSSM_spectrum; // Shallow copy; overrides go into overlays on the shared SubSpectra
       SubSpectrum& HE = improved_spec.get_HE();
       SubSpectrum& LE = improved_spec.get_LE();
       static bool allow_fallback = runOptions->getValueOrDef<bool>(false, "allow_fallback_to_unimproved_masses");
@@ -571,7 +571,7 @@ namespace Gambit
     void make_MSSM_precision_spectrum_4H_W(Spectrum& improved_spec /*(result)*/)
     {
       using namespace Pipes::make_MSSM_precision_spectrum_4H_W;
-      improved_spec = *Dep::unimproved_MSSM_spectrum; // Does copy
+      improved_spec = *Dep::unimproved_MSSM_spectrum; // Shallow copy; overrides go into overlays on the shared SubSpectra
       SubSpectrum& HE = improved_spec.get_HE();
       SubSpectrum& LE = improved_spec.get_LE();
       static bool allow_fallback = runOptions->getValueOrDef<bool>(false, "allow_fallback_to_unimproved_masses");
@@ -0,0 +1,86 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Standalone driver for the HDF5 combine
+///  routines, for combining the temporary
+///  per-rank output of a GAMBIT run by hand.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <exception>
+
+#include "gambit/Printers/printers/hdf5printer/hdf5_combine_tools.hpp"
+#include "gambit/Printers/printers/hdf5printer/hdf5tools.hpp"
+#include "gambit/Utils/util_functions.hpp"
+#include "gambit/Utils/static_members.hpp"
+
+void usage()
+{
+  std::cout << "\n  Usage: hdf5_combine <output file> <group> <number of temp files> [options]\n\n"
+            << "  Combines the temporary files <output file>_temp_0 ... <output file>_temp_<N-1> produced\n"
+            << "  by the HDF5 printer into <output file>_temp_combined.\n"
+            << "  --resume              also merge in an existing <output file>_temp_combined\n"
+            << "  --delete_tmp          delete the temporary files once they have been combined\n"
+            << "  --compression <name>  compress the output datasets: none (default), gzip or lz4\n"
+            << "  --level <n>           compression level for gzip (0-9, default 4)\n"
+            << "  --chunk_length <n>    entries per chunk of the compressed datasets (default 10000)\n" << std::endl;
+  exit(EXIT_FAILURE);
+}
+
+int main(int argc, char* argv[])
+{
+  bool resume = false, delete_tmp = false;
+  std::string compression = "none";
+  unsigned int level = 4;
+  unsigned long chunk_length = 10000;
+  std::vector<std::string> args;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string arg(argv[i]);
+    if (arg == "--resume") resume = true;
+    else if (arg == "--delete_tmp") delete_tmp = true;
+    else if (arg == "--compression" and i+1 < argc) compression = argv[++i];
+    else if (arg == "--level" and i+1 < argc) level = std::atoi(argv[++i]);
+    else if (arg == "--chunk_length" and i+1 < argc) chunk_length = std::atol(argv[++i]);
+    else if (arg == "--help" or arg == "-h") usage();
+    else args.push_back(arg);
+  }
+  if (args.size() != 3) usage();
+
+  const std::string finalfile = args[0];
+  const std::string group = args[1];
+  const int num = std::atoi(args[2].c_str());
+  if (num <= 0) usage();
+
+  const std::string tmp_comb_file = finalfile + "_temp_combined";
+  if (resume and not Gambit::Utils::file_exists(tmp_comb_file))
+  {
+    std::cout << "No previous combined output '" << tmp_comb_file << "' found; combining temp files only." << std::endl;
+    resume = false;
+  }
+
+  try
+  {
+    hid_t cparms = -1;
+    if (compression != "none") cparms = Gambit::Printers::HDF5::createDatasetPropList(chunk_length, compression, level, true);
+    Gambit::Printers::HDF5::combine_hdf5_files(tmp_comb_file, finalfile, group, num, resume, delete_tmp, cparms);
+    if (cparms >= 0) H5Pclose(cparms);
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "HDF5 combine failed: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Combined output written to " << tmp_comb_file << std::endl;
+  return EXIT_SUCCESS;
+}
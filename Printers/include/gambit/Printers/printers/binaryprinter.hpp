@@ -0,0 +1,176 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Binary printer class declaration
+///
+///  Writes the same table as the asciiPrinter,
+///  but as fixed-width little-endian records:
+///  one 8-byte double per column, followed by
+///  one validity byte per column (padded to a
+///  multiple of 8 bytes). A YAML schema sidecar
+///  gives the name and byte offsets of every
+///  column, so the output can be memory-mapped
+///  directly, e.g. in Python with
+///  numpy.memmap(file, dtype=...).
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+
+#ifndef __binary_printer_hpp__
+#define __binary_printer_hpp__
+
+// Standard libraries
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+#include <fstream>
+
+// Gambit
+#include "gambit/Printers/baseprinter.hpp"
+#include "gambit/Printers/printers/binarytypes.hpp"
+#include "gambit/Utils/yaml_options.hpp"
+
+// MPI bindings
+#include "gambit/Utils/mpiwrapper.hpp"
+#include "gambit/Utils/new_mpi_datatypes.hpp"
+
+// BOOST_PP
+#include <boost/preprocessor/seq/for_each_i.hpp>
+
+// Code!
+namespace Gambit
+{
+  namespace Printers
+  {
+
+    class binaryPrinter : public BasePrinter
+    {
+      public:
+        /// Constructor (for construction via inifile options)
+        binaryPrinter(const Options&, BasePrinter* const primary = NULL);
+
+        /// Tasks common to the various constructors
+        void common_constructor(const Options&);
+
+        /// Destructor
+        // Overload the base class virtual destructor
+        ~binaryPrinter();
+
+        /// Virtual function overloads:
+        ///@{
+
+        // Initialisation function
+        // Run by dependency resolver, which supplies the functors with a vector of VertexIDs whose requiresPrinting flags are set to true.
+        void initialise(const std::vector<int>&);
+        void reset(bool force=false);
+        void finalise(bool abnormal=false);
+
+        ///@}
+
+        /// Binaryprinter-specific functions
+
+        // Clear buffer
+        void erase_buffer();
+
+        // add results to printer buffer
+        void addtobuffer(const std::vector<double>&, const std::vector<std::string>&, const int, const int, const int);
+
+        // write the printer buffer to file
+        void dump_buffer(bool force=false);
+
+        // retrieve the name of the main output file (used by auxilliary printers to match the names)
+        std::string get_output_filename();
+
+        // retrieve the bufferlength (used by auxilliary printers to match the primary printer)
+        int get_bufferlength();
+
+        ///@{ Print functions
+        using BasePrinter::_print; // Tell compiler we are using some of the base class overloads of this on purpose.
+        #define DECLARE_PRINT(r,data,i,elem) void _print(elem const&, const std::string&, const int, const uint, const ulong);
+        BOOST_PP_SEQ_FOR_EACH_I(DECLARE_PRINT, , BINARY_TYPES)
+        #ifndef SCANNER_STANDALONE
+          BOOST_PP_SEQ_FOR_EACH_I(DECLARE_PRINT, , BINARY_MODULE_BACKEND_TYPES)
+        #endif
+        #undef DECLARE_PRINT
+        ///@}
+
+        /// Helper print functions
+        // Used to reduce repetition in definitions of virtual function overloads
+        // (useful since there is no automatic type conversion possible)
+        template<class T>
+        void template_print(T const&, const std::string&, const int, const uint, const ulong);
+        template<class T>
+        void template_print_vec(std::vector<T> const&, const std::string&, const int, const uint, const ulong);
+
+      private:
+        /// Data for a single model point; one vector of doubles per vertexID
+        struct Record
+        {
+          std::map<int, std::vector<double>> data;
+          bool readyToPrint = false;
+        };
+
+        /// Write the schema file describing the record layout
+        void write_schema();
+
+        /// Output file
+        std::string output_file;
+
+        /// Schema file (describes the layout of the records in the output file)
+        std::string schema_file;
+
+        /// Main output file stream (kept open between buffer dumps)
+        std::ofstream my_fstream;
+
+        /// Number of records to store in buffer before writing
+        unsigned int bufferlength;
+
+        /// Label for printer, mostly for more helpful error messages
+        std::string printer_name;
+
+        /// MPI rank
+        #ifdef WITH_MPI
+        // Gambit MPI communicator context for use within the printer system
+        GMPI::Comm myComm;
+        uint myRealRank;
+        uint mpiSize;
+        #endif
+
+        /// Buffer of output to be written
+        // Key is <int rank, int pointID>; value is a Record (for a single model point)
+        std::map<std::pair<int,int>,Record> buffer;
+
+        /// Recording of which model point each process is working on
+        PPIDpair lastPointID;
+
+        /// Number of columns occupied by each vertexID. As for the asciiPrinter, this is
+        /// fixed at the first buffer dump; functors may print fewer entries afterwards, but not more.
+        std::map<int,int> lineindexrecord;
+
+        /// Total number of columns, and size in bytes of one record
+        std::size_t ncolumns = 0;
+        std::size_t record_size = 0;
+
+        /// Column labels for each vertexID, for the schema file
+        std::map<int,std::vector<std::string>> label_record;
+        bool schema_written = false;
+
+        /// Scratch space for encoding a buffer's worth of records
+        std::vector<char> block;
+
+    };
+
+    // Register printer so it can be constructed via inifile instructions
+    // First argument is string label for inifile access, second is class from which to construct printer
+    LOAD_PRINTER(binary, binaryPrinter)
+
+  } // end namespace Printers
+} // end namespace Gambit
+
+#endif //ifndef __binary_printer_hpp__
@@ -0,0 +1,120 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Binary printer retriever class declaration.
+///  This is a class accompanying the binaryPrinter
+///  which takes care of *reading* from output
+///  created by the binaryPrinter. The data file
+///  is memory-mapped, so access to any point is
+///  constant-time.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#include "gambit/Printers/baseprinter.hpp"
+#include "gambit/Printers/printers/binarytypes.hpp"
+#include <boost/preprocessor/seq/for_each_i.hpp>
+
+#ifndef __binary_reader_hpp__
+#define __binary_reader_hpp__
+
+namespace Gambit
+{
+  namespace Printers
+  {
+
+     /// Derived EntryGetterInterface class for accessing binaryPrinter output points
+     class binaryReader : public BaseReader
+     {
+       public:
+         binaryReader(const Options& options);
+         ~binaryReader();
+
+         /// @{ Base class virtual interface functions
+         virtual void reset(); // Reset 'read head' position to first entry
+         virtual ulong get_dataset_length(); // Get length of input dataset
+         virtual PPIDpair get_next_point(); // Get next rank/ptID pair in data file
+         virtual PPIDpair get_current_point(); // Get current rank/ptID pair in data file
+         virtual ulong    get_current_index(); // Get a linear index which corresponds to the current rank/ptID pair in the iterative sense
+         virtual bool eoi(); // Check if 'current point' is past the end of the data file (and thus invalid!)
+         /// Get type information for a data entry, i.e. defines the C++ type which this should be
+         /// retrieved as, not what it is necessarily literally stored as in the output.
+         /// For binaryPrinter, everything is currently a double.
+         virtual std::size_t get_type(const std::string&) { return getTypeID<double>(); }
+         virtual std::set<std::string> get_all_labels(); // Get all output column labels
+         /// @}
+
+         ///@{ Retrieval functions
+         using BaseReader::_retrieve; // Tell compiler we are using some of the base class overloads of this on purpose.
+         #define DECLARE_RETRIEVE(r,data,i,elem) bool _retrieve(elem&, const std::string&, const uint, const ulong);
+         BOOST_PP_SEQ_FOR_EACH_I(DECLARE_RETRIEVE, , BINARY_TYPES)
+         #ifndef SCANNER_STANDALONE
+           BOOST_PP_SEQ_FOR_EACH_I(DECLARE_RETRIEVE, , BINARY_MODULE_BACKEND_TYPES)
+         #endif
+         #undef DECLARE_RETRIEVE
+         ///@}
+
+       private:
+         /// Byte offsets of a column's value and validity flag within a record
+         struct Column
+         {
+           std::size_t offset;
+           std::size_t valid_offset;
+         };
+
+         const std::string dataFile_name;
+         const std::string schemaFile_name;
+         std::map<std::string,Column> column_map; // Map from column names to record offsets
+         std::size_t record_size;
+         Column      col_rank;
+         Column      col_ptID;
+
+         /// Memory-mapped contents of the data file
+         const char* data;
+         std::size_t data_size;
+
+         ulong       dataset_length;
+         ulong       current_index; // Number of points visited; the current point is in row current_index-1
+         PPIDpair    current_point;
+
+         /// Row of each point, built on first random access
+         std::map<PPIDpair,ulong> row_lookup;
+
+         /// Read the column layout from a schema file
+         void read_schema(const std::string& schema_filename);
+
+         /// Look up a column by name, with error checking
+         const Column& get_column(const std::string& label) const;
+
+         /// Get the value of a column in some row; returns false if it is marked invalid
+         bool get_entry(const ulong row, const Column& col, double& out) const;
+
+         /// Get the point stored in some row (nullpoint if its ID entries are invalid)
+         PPIDpair get_point(const ulong row) const;
+
+         /// Find the row containing a given rank/pointID pair
+         ulong find_row(const PPIDpair& point);
+
+         /// Retrieve any simple numeric type, by conversion from the stored double
+         template<class T>
+         bool retrieve_numeric(T& out, const std::string& label, const uint rank, const ulong pointID)
+         {
+           double value;
+           bool is_valid = get_entry(find_row(PPIDpair(pointID,rank)), get_column(label), value);
+           out = is_valid ? static_cast<T>(value) : T();
+           return is_valid;
+         }
+
+     };
+
+    // Register reader so it can be constructed via inifile instructions
+    // First argument is string label for inifile access, second is class from which to construct printer
+    LOAD_READER(binary, binaryReader)
+  }
+}
+
+#endif
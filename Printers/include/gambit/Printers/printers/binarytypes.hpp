@@ -0,0 +1,61 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Sequence of all types printable by the
+///  binary printer, and the byte encoding
+///  shared by the binary printer and reader.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#ifndef __BINARYTYPES__
+#define __BINARYTYPES__
+
+#include <cstring>
+#include <cstdint>
+
+#include "gambit/ScannerBit/printable_types.hpp"
+
+#define BINARY_TYPES                        \
+  SCANNER_PRINTABLE_TYPES                   \
+  (triplet<double>)                         \
+
+#define BINARY_MODULE_BACKEND_TYPES         \
+  (DM_nucleon_couplings)                    \
+  (Flav_KstarMuMu_obs)                      \
+
+namespace Gambit
+{
+  namespace Printers
+  {
+    /// Version of the binary output format, recorded in the schema file
+    static const int BINARY_FORMAT_VERSION = 1;
+
+    namespace Binary
+    {
+      /// Write a double as 8 little-endian bytes, whatever the host byte order
+      inline void encode(const double x, char* out)
+      {
+        uint64_t u;
+        std::memcpy(&u, &x, sizeof(u));
+        for(int i=0; i<8; i++) out[i] = char((u >> (8*i)) & 0xff);
+      }
+
+      /// Read a double from 8 little-endian bytes
+      inline double decode(const char* in)
+      {
+        uint64_t u = 0;
+        for(int i=0; i<8; i++) u |= uint64_t((unsigned char)in[i]) << (8*i);
+        double x;
+        std::memcpy(&x, &u, sizeof(x));
+        return x;
+      }
+    }
+  }
+}
+
+#endif
@@ -21,6 +21,7 @@
 // Standard libraries
 #include <map>
 #include <vector>
+#include <memory>
 #include <algorithm>
 #include <sstream>
 #include <iostream>
@@ -35,6 +36,7 @@
 #include "gambit/Printers/printers/hdf5printer/hdf5tools.hpp"
 #include "gambit/Printers/printers/hdf5printer/VertexBufferNumeric1D_HDF5.hpp"
 #include "gambit/Printers/printers/hdf5printer/DataSetInterfaceScalar.hpp"
+#include "gambit/Printers/printers/hdf5printer/hdf5_async_writer.hpp"
 #include "gambit/Utils/yaml_options.hpp"
 #include "gambit/Utils/cats.hpp"
 #include "gambit/Logs/logger.hpp"
@@ -132,6 +134,13 @@ namespace Gambit
 
 
     /// The main printer class for output to HDF5 format
+    ///
+    /// Each MPI process writes its own temporary file (<file>_temp_<rank>), and the files are combined
+    /// into the final output at the end of the run, and on resume.  There is no mode in which all
+    /// processes write collectively into one shared file: that would need an MPI-enabled HDF5 build
+    /// (H5_HAVE_PARALLEL), and parallel HDF5 requires every dataset to be created and extended
+    /// collectively by all processes, whereas this printer creates and grows its datasets lazily and
+    /// independently on each process, from the asynchronous writer thread.
     class HDF5Printer : public BasePrinter
     {
       public:
@@ -183,6 +192,12 @@ namespace Gambit
         /// (should correspond to the number of "appends" each active buffer has received)
         unsigned long get_sync_pos() const { return sync_pos; }
 
+        /// Retrieve the creation settings (chunking, compression) for new datasets
+        hid_t get_dataset_cparms() { return primary_printer->dataset_cparms; }
+
+        /// Retrieve the background writer for sync buffers (NULL if writing directly)
+        HDF5AsyncWriter* get_async_writer() { return primary_printer->async_writer.get(); }
+
      private:
 
         /// Buffer manager objects
@@ -343,6 +358,15 @@ namespace Gambit
         /// Flag to disable combination of hdf5 output (user will have to run the combination routines manually)
         bool disable_combine_routines = false;
 
+        /// Dataset creation property list (chunk length and compression filters)
+        /// for all datasets written by this printer, including the combined output.
+        /// Left at -1 (default layout) unless 'chunk_length' or 'compression' is set.
+        hid_t dataset_cparms = -1;
+
+        /// Background thread which writes out full sync buffers while the scan carries on
+        /// (only if 'async_write' is set; owned by the primary printer)
+        std::unique_ptr<HDF5AsyncWriter> async_writer;
+
         /// Map containing pointers to all VertexBuffers contained in this printer
         // Note: Each buffer contains a bool to indicate whether it has done an "append" for the point "lastPointID"
         BaseBufferMap all_my_buffers;
@@ -508,6 +532,9 @@ namespace Gambit
           std::cout<<"...is silenced? "<<silence<<std::endl;
         #endif
 
+        // Creating datasets means calling HDF5, which the background writer must not be doing
+        if(printer->get_async_writer()!=NULL) printer->get_async_writer()->wait();
+
         // Create the new buffer object
         hid_t loc(-1);
         if(synchronised)
@@ -527,10 +554,12 @@ namespace Gambit
                                       , silence
                                       , false /*printer->get_resume() -- In this new version of the HDF5Printer we write temporary files and then combine them at the end of the scan, so each individual buffer no longer needs to be in 'resume' mode, it can just start anew and be combined with the old data later on */
                                       , access /* r/w mode. Buffers can now be used for reading also. */
+                                      , printer->get_dataset_cparms()
                                       );
 
         // Get the new (possibly silenced) buffer back out of the map
         it = local_buffers.find(key);
+        it->second.set_async_writer(printer->get_async_writer());
 
         // Add a pointer to the new buffer to the full list as well
         if(not silence) printer->insert_buffer( key, it->second );
@@ -32,6 +32,7 @@
 // Gambit
 #include "gambit/Utils/standalone_error_handlers.hpp"
 #include "gambit/Logs/logger.hpp"
+#include "gambit/Printers/printers/hdf5printer/hdf5_async_writer.hpp"
 
 namespace Gambit {
 
@@ -120,11 +121,13 @@ namespace Gambit {
 
          /// Constructors
          DataSetInterfaceBase();
-         DataSetInterfaceBase(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK], const bool resume, const char access);
+         DataSetInterfaceBase(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK], const bool resume, const char access, const hid_t cparms_template=-1);
          virtual ~DataSetInterfaceBase();
 
          /// Create a (chunked) dataset
-         hid_t createDataSet(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK]);
+         /// Chunk length and filters are copied from cparms_template, if supplied
+         /// (see HDF5::createDatasetPropList); otherwise chunks are CHUNKLENGTH long and uncompressed.
+         hid_t createDataSet(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK], const hid_t cparms_template=-1);
 
          /// Open an existing dataset
          hid_t openDataSet(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK]);
@@ -157,7 +160,7 @@ namespace Gambit {
       {}
 
       template<class T, std::size_t RR, std::size_t CL>
-      DataSetInterfaceBase<T,RR,CL>::DataSetInterfaceBase(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK], const bool r, const char a)
+      DataSetInterfaceBase<T,RR,CL>::DataSetInterfaceBase(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK], const bool r, const char a, const hid_t cparms_template)
         : mylocation_id(location_id)
         , myname(name)
         , record_dims() /* doh have to copy array element by element */
@@ -172,7 +175,7 @@ namespace Gambit {
         }
         else
         {
-           dset_id = createDataSet(location_id,name,rdims);
+           dset_id = createDataSet(location_id,name,rdims,cparms_template);
         }
         if(dset_id<0)
         {
@@ -221,7 +224,7 @@ namespace Gambit {
 
       /// Create a (chunked) dataset
       template<class T, std::size_t RECORDRANK, std::size_t CHUNKLENGTH>
-      hid_t DataSetInterfaceBase<T,RECORDRANK,CHUNKLENGTH>::createDataSet(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK])
+      hid_t DataSetInterfaceBase<T,RECORDRANK,CHUNKLENGTH>::createDataSet(hid_t location_id, const std::string& name, const std::size_t rdims[DSETRANK], const hid_t cparms_template)
       {
          // I'd like to declare rdims as rdims[RECORDRANK], but apparantly zero length arrays are not allowed,
          // so this would not compile in the RECORDRANK=0 case, which I need. Irritating.
@@ -254,7 +257,19 @@ namespace Gambit {
          // Object containing dataset creation parameters
          //H5::DSetCreatPropList cparms;
          //cparms.setChunk(DSETRANK, chunkdims);
-         hid_t cparms_id = H5Pcreate(H5P_DATASET_CREATE);
+         hid_t cparms_id;
+         if(cparms_template<0)
+         {
+            cparms_id = H5Pcreate(H5P_DATASET_CREATE);
+         }
+         else
+         {
+            // Start from the supplied settings (filters etc.), taking the chunk length
+            // along the record index from them too.
+            cparms_id = H5Pcopy(cparms_template);
+            hsize_t template_chunk[1];
+            if(cparms_id>=0 and H5Pget_chunk(cparms_id, 1, template_chunk)>0) chunkdims[0] = template_chunk[0];
+         }
          if(cparms_id<0)
          {
             std::ostringstream errmsg;
@@ -288,6 +303,8 @@ namespace Gambit {
                errmsg << "Error creating dataset (with name: \""<<myname<<"\") in HDF5 file. Dataset with same name may already exist";
                printer_error().raise(LOCAL_INFO, errmsg.str());
          }
+         H5Pclose(cparms_id);
+         H5Sclose(dspace_id);
          return output_dset_id;
       }
 
@@ -399,10 +416,9 @@ namespace Gambit {
             herr_t status = H5Dset_extent( this->get_dset_id(), this->dsetdims());
             if(status<0)
             {
-               std::cout<<this->get_dset_id()<<std::endl;
                std::ostringstream errmsg;
-               errmsg << "Failed to extend dataset (with name: \""<<myname<<"\") from length "<<current_length<<" to length "<<newlength<<"!";
-               printer_error().raise(LOCAL_INFO, errmsg.str());
+               errmsg << "Failed to extend dataset (with name: \""<<myname<<"\", id "<<this->get_dset_id()<<") from length "<<current_length<<" to length "<<newlength<<"!";
+               raise_write_error(LOCAL_INFO, errmsg.str());
             }
          }
       }
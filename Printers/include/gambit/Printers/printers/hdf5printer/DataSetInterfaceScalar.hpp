@@ -53,7 +53,7 @@ namespace Gambit {
         public: 
           /// Constructors
           DataSetInterfaceScalar(); 
-          DataSetInterfaceScalar(hid_t location_id, const std::string& name, const bool resume, const char access); 
+          DataSetInterfaceScalar(hid_t location_id, const std::string& name, const bool resume, const char access, const hid_t cparms_template=-1);
  
           /// Select a hyperslab chunk in the hosted dataset
           std::pair<hid_t,hid_t> select_chunk(std::size_t offset, std::size_t length) const;
@@ -93,8 +93,8 @@ namespace Gambit {
       {}
 
       template<class T, std::size_t CL>
-      DataSetInterfaceScalar<T,CL>::DataSetInterfaceScalar(hid_t location_id, const std::string& name, const bool resume, const char access) 
-        : DataSetInterfaceBase<T,0,CL>(location_id, name, empty_rdims, resume, access)
+      DataSetInterfaceScalar<T,CL>::DataSetInterfaceScalar(hid_t location_id, const std::string& name, const bool resume, const char access, const hid_t cparms_template)
+        : DataSetInterfaceBase<T,0,CL>(location_id, name, empty_rdims, resume, access, cparms_template)
       {}
 
       template<class T, std::size_t CHUNKLENGTH>
@@ -119,7 +119,7 @@ namespace Gambit {
          {
             std::ostringstream errmsg;
             errmsg << "Error writing new chunk to dataset (with name: \""<<this->get_myname()<<"\") in HDF5 file. H5Dwrite failed." << std::endl;
-            printer_error().raise(LOCAL_INFO, errmsg.str());
+            raise_write_error(LOCAL_INFO, errmsg.str());
          }
          #ifdef HDF5_DEBUG
          std::cout<<"Chunk written to dataset \""<<this->get_myname()<<"\"! Incrementing chunk offset:"
@@ -323,7 +323,7 @@ namespace Gambit {
             errmsg << "  offset = " << offset << std::endl;
             errmsg << "  offset+length = " << length << std::endl;
             errmsg << "  dset_length() = "<< this->dset_length() << std::endl;
-            printer_error().raise(LOCAL_INFO, errmsg.str());
+            raise_write_error(LOCAL_INFO, errmsg.str());
          }
 
          // Select a hyperslab.
@@ -333,7 +333,7 @@ namespace Gambit {
          {
             std::ostringstream errmsg;
             errmsg << "Error selecting chunk from dataset (with name: \""<<this->get_myname()<<"\") in HDF5 file. H5Dget_space failed." << std::endl;
-            printer_error().raise(LOCAL_INFO, errmsg.str());
+            raise_write_error(LOCAL_INFO, errmsg.str());
          }
 
          hsize_t offsets[DSETRANK];
@@ -350,7 +350,7 @@ namespace Gambit {
          {
             std::ostringstream errmsg;
             errmsg << "Error selecting chunk from dataset (with name: \""<<this->get_myname()<<"\", offset="<<offset<<", length="<<selection_dims[0]<<") in HDF5 file. H5Sselect_hyperslab failed." << std::endl;
-            printer_error().raise(LOCAL_INFO, errmsg.str());
+            raise_write_error(LOCAL_INFO, errmsg.str());
          }
 
          // Define memory space
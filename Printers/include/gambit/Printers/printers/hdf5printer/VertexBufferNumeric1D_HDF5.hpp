@@ -24,6 +24,8 @@
 
 #include <cstddef>
 #include <sstream>
+#include <memory>
+#include <algorithm>
 
 // HDF5 C bindings
 #include <hdf5.h> 
@@ -31,6 +33,7 @@
 // Gambit
 #include "gambit/Printers/VertexBufferNumeric1D.hpp"
 #include "gambit/Printers/printers/hdf5printer/DataSetInterfaceScalar.hpp"
+#include "gambit/Printers/printers/hdf5printer/hdf5_async_writer.hpp"
 #include "gambit/Utils/standalone_error_handlers.hpp"
 #include "gambit/Logs/logger.hpp"
 
@@ -71,6 +74,14 @@ namespace Gambit {
            /// size as the sync buffers.
            unsigned long target_sync_pos = 0;
 
+           /// Background writer to which full sync buffers are handed off (NULL
+           /// to write them directly). While it has jobs queued, only the writer
+           /// may touch the HDF5 datasets, so nextemptyslab is then tracked here.
+           HDF5AsyncWriter* async_writer = NULL;
+
+           /// Wait until any writes handed off to the background writer are done
+           void wait_for_writer() { if(async_writer!=NULL) async_writer->wait(); }
+
          public:
            /// Constructors
            VertexBufferNumeric1D_HDF5();
@@ -98,6 +109,7 @@ namespace Gambit {
              , const bool silence
              , const bool resume
              , const char access
+             , const hid_t cparms_template=-1 // Creation settings for new datasets (chunking, compression)
              );
      
            /// Destructor
@@ -129,10 +141,15 @@ namespace Gambit {
            /// Attempt to write any postponed RA_write attempts to disk
            void attempt_postponed_RA_write_to_disk(const std::map<PPIDpair, ulong>& PPID_to_dsetindex);
 
+           /// Hand full sync buffers to a background writer thread instead of
+           /// writing them directly
+           void set_async_writer(HDF5AsyncWriter* writer) { async_writer = writer; }
+
            /// Update the variables needed to tracks the currently target dset slot
            /// (really just updates the nextemptyslab variable)
            virtual void update_dset_head_pos()
            {
+              wait_for_writer();
               if(this->myRank==0 or not this->MPI_mode()) // Only the master process has access to this information, unless we are in non-MPI mode
               {
                 if(dsetvalid().get_nextemptyslab() != dsetdata().get_nextemptyslab())
@@ -244,6 +261,7 @@ namespace Gambit {
         , const bool silence
         , const bool resume
         , char access
+        , const hid_t cparms_template
         )
         : VertexBufferNumeric1D<T,CHUNKLENGTH>(
             name
@@ -274,7 +292,7 @@ namespace Gambit {
           {
              logger()<<LogTags::printers<<"Creating new dataset '"<<name<<"_isvalid'...";
           }
-          _dsetvalid = DataSetInterfaceScalar<bool,CHUNKLENGTH>(location_id, name+"_isvalid", resume, this->access_mode());
+          _dsetvalid = DataSetInterfaceScalar<bool,CHUNKLENGTH>(location_id, name+"_isvalid", resume, this->access_mode(), cparms_template);
 
           if(resume) 
           { 
@@ -284,7 +302,7 @@ namespace Gambit {
           {
              logger()<<std::endl<<LogTags::printers<<"Creating new dataset '"<<name<<"'...";
           }
-          _dsetdata  = DataSetInterfaceScalar<T,CHUNKLENGTH>(location_id, name, resume, this->access_mode());
+          _dsetdata  = DataSetInterfaceScalar<T,CHUNKLENGTH>(location_id, name, resume, this->access_mode(), cparms_template);
 
           logger()<<EOM; // Leave this to calling function
         }
@@ -319,7 +337,7 @@ namespace Gambit {
 
       }
     
-      /// @{ Safe dataset getters
+      /// @{ Safe dataset getters (also called from background write jobs)
       template<class T, std::size_t L>
       DataSetInterfaceScalar<bool,L>& VertexBufferNumeric1D_HDF5<T,L>::dsetvalid()
       {
@@ -328,7 +346,7 @@ namespace Gambit {
         {
             std::ostringstream errmsg;
             errmsg << "rank "<<this->myRank<<": Error! VertexBuffer (HDF5 type) in non-master process tried to access dsetvalid! This doesn't exist except on the master process (buffer is "<<this->get_label()<<")";
-            printer_error().raise(LOCAL_INFO, errmsg.str()); 
+            raise_write_error(LOCAL_INFO, errmsg.str()); 
         }
         #endif 
         return _dsetvalid;
@@ -342,7 +360,7 @@ namespace Gambit {
         {
             std::ostringstream errmsg;
             errmsg << "rank "<<this->myRank<<"Error! VertexBuffer (HDF5 type) in non-master process tried to access dsetdata! This doesn't exist except on the master process (buffer is "<<this->get_label()<<")";
-            printer_error().raise(LOCAL_INFO, errmsg.str()); 
+            raise_write_error(LOCAL_INFO, errmsg.str()); 
         }
         #endif 
         return _dsetdata;
@@ -357,13 +375,32 @@ namespace Gambit {
            // Check if buffer is empty, and whether we really want to write an
            // empty buffer to disk.
            if( not this->sync_buffer_is_empty() or
-               this->dset_head_pos() >= dsetvalid().dset_length()
+               this->dset_head_pos() >= (async_writer!=NULL ? nextemptyslab : dsetvalid().dset_length())
              ) // Should only have to check one of the datasets... perhaps add error checking for this.
            {
-             dsetvalid().writenewchunk(this->buffer_valid); 
-             dsetdata().writenewchunk(this->buffer_entries);
-             // Update the head tracking variables to reflect the new dset chunk
-             update_dset_head_pos();
+             if(async_writer!=NULL)
+             {
+               // Sync datasets are exactly nextemptyslab long, so we can move the head
+               // ourselves and leave the writing to the background thread. It gets its
+               // own copy of the buffer, since ours is about to be cleared and refilled.
+               struct Chunk { bool valid[L]; T entries[L]; };
+               std::shared_ptr<Chunk> chunk(new Chunk);
+               std::copy(this->buffer_valid, this->buffer_valid+L, chunk->valid);
+               std::copy(this->buffer_entries, this->buffer_entries+L, chunk->entries);
+               async_writer->submit([this,chunk]()
+               {
+                 dsetvalid().writenewchunk(chunk->valid);
+                 dsetdata().writenewchunk(chunk->entries);
+               });
+               nextemptyslab += L;
+             }
+             else
+             {
+               dsetvalid().writenewchunk(this->buffer_valid); 
+               dsetdata().writenewchunk(this->buffer_entries);
+               // Update the head tracking variables to reflect the new dset chunk
+               update_dset_head_pos();
+             }
            }
          }
          else {
@@ -378,6 +415,7 @@ namespace Gambit {
       void VertexBufferNumeric1D_HDF5<T,CHUNKLENGTH>::write_external_to_disk(const T (&values)[CHUNKLENGTH], const bool (&isvalid)[CHUNKLENGTH])
       {
          if(not this->is_silenced()) {
+           wait_for_writer();
            dsetvalid().writenewchunk(isvalid); 
            dsetdata().writenewchunk(values);
            // Update sync information to reflect the presence of the new chunk
@@ -405,6 +443,8 @@ namespace Gambit {
 
          if(this->myRank==0 or not this->MPI_mode()) // Can only touch datasets on master process (unless we are in non-MPI mode)
          {
+            wait_for_writer();
+
             /// Invalidate the contents of the linked datasets
             /// This can be done by simply resetting the all validity bools to "false"
             dsetvalid().zero();
@@ -413,6 +453,9 @@ namespace Gambit {
             // Point the write head (or "cursor") back at the beginning of the output datasets.
             dsetvalid().reset_nextemptyslab();
             dsetdata().reset_nextemptyslab();
+
+            // Nothing else moves the head back when writes go via the background writer
+            if(async_writer!=NULL) update_dset_head_pos();
          }
       }
 
@@ -500,6 +543,7 @@ namespace Gambit {
 
         if(not this->is_silenced()) 
          {
+            wait_for_writer();
             dsetvalid().extend_dset(target_sync_pos);
             dsetdata().extend_dset(target_sync_pos);
 
@@ -587,7 +631,8 @@ namespace Gambit {
          if(not this->is_silenced()) 
          {
             // Make sure the correct dset_head_pos() is known
-            update_dset_head_pos();
+            // (the background writer, if any, leaves it up to date already)
+            if(async_writer==NULL) update_dset_head_pos();
 
             // Update the variable which tracks the current sync position.
             // (do this regardless of whether this is a sync buffer or not)
@@ -665,6 +710,7 @@ namespace Gambit {
       template<class T, std::size_t L>
       ulong VertexBufferNumeric1D_HDF5<T,L>::get_dataset_length()
       {
+         wait_for_writer();
          if(dsetvalid().dset_length() != dsetdata().dset_length())
          {
             std::ostringstream errmsg;
@@ -678,6 +724,7 @@ namespace Gambit {
       template<class T, std::size_t L>
       void VertexBufferNumeric1D_HDF5<T,L>::finalise()
       {
+         wait_for_writer();
          dsetdata().closeDataSet();
          dsetvalid().closeDataSet();
       }
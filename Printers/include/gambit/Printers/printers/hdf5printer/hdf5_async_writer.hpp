@@ -0,0 +1,109 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Background writer thread for the HDF5
+///  printer. Full sync buffers are handed to
+///  this thread as write jobs, so that the
+///  scan does not have to wait for HDF5 to
+///  finish writing them.
+///
+///  The HDF5 library is generally not built
+///  thread-safe, so the thread that owns the
+///  writer must call wait() before making any
+///  HDF5 call of its own.  Neither is the
+///  logger, so errors in write jobs are only
+///  recorded on the writer thread, and raised
+///  on the owning thread by submit() or wait().
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#ifndef __hdf5_async_writer_hpp__
+#define __hdf5_async_writer_hpp__
+
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <string>
+#include <cstddef>
+
+namespace Gambit
+{
+  namespace Printers
+  {
+
+    /// Runs queued HDF5 write jobs, in order, on a dedicated thread
+    class HDF5AsyncWriter
+    {
+      public:
+        /// Start the writer thread. Once max_queued jobs are waiting,
+        /// submit() blocks until the writer has caught up.
+        HDF5AsyncWriter(const std::size_t max_queued);
+
+        /// Finishes any queued jobs and stops the thread
+        ~HDF5AsyncWriter();
+
+        /// Queue a job for the writer thread (blocks if the queue is full).
+        /// Raises the error of an earlier failed job, if any.
+        void submit(const std::function<void()>& job);
+
+        /// Block until all queued jobs have been done. Raises the error of
+        /// the first failed job, if any.
+        void wait();
+
+        /// Block until all queued jobs have been done or one has failed,
+        /// without raising any error (for use in destructors)
+        void drain();
+
+        /// Is the calling thread the writer thread of any HDF5AsyncWriter?
+        static bool on_writer_thread();
+
+        /// Finish all queued jobs and join the writer thread.
+        /// Nothing may be submitted afterwards.
+        void stop();
+
+        /// Number of times submit() had to wait for the writer to catch up
+        unsigned long get_n_stalls() const { return n_stalls; }
+
+      private:
+        /// Main loop of the writer thread
+        void run();
+
+        /// Raise the error of a failed job (call with mtx locked)
+        void raise_error();
+
+        std::deque<std::function<void()>> jobs;
+        const std::size_t max_queued;
+        bool busy = false;
+        bool stopping = false;
+        unsigned long n_stalls = 0;
+
+        /// First error in a job; no more jobs are run after it. Errors raised with
+        /// raise_write_error are kept as origin and message, anything else as is.
+        bool failed = false;
+        std::string error_origin;
+        std::string error_message;
+        std::exception_ptr error;
+
+        std::mutex mtx;
+        std::condition_variable job_ready; // signalled when a job is queued, or on stop
+        std::condition_variable job_done;  // signalled when a job finishes
+
+        std::thread worker;
+    };
+
+    /// Raise a printer error from code that may run on the writer thread. There, the error
+    /// is thrown without being logged, and raised properly by the next submit() or wait().
+    void raise_write_error(const std::string& origin, const std::string& message);
+
+  }
+}
+
+#endif
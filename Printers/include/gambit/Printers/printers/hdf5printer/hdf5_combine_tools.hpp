@@ -22,6 +22,7 @@
 
 #include <vector>
 #include <sstream>
+#include <algorithm>
 #include <unordered_set>
 #include <unordered_map> 
 #include <hdf5.h>
@@ -44,6 +45,92 @@ namespace Gambit
             template <class U, typename... T>
             void Enter_HDF5(hid_t dataset, T&... params);
 
+            /// Number of elements moved per read/write while combining; bounds the memory used
+            /// by the combine routines independently of the size of the scan.
+            static const hsize_t COMBINE_CHUNK = 65536;
+
+            /// Read or write `count` elements of a 1D dataset, starting at element `offset`.
+            template <typename U>
+            inline void transfer_slab(hid_t dataset, hsize_t offset, hsize_t count, U *buffer, bool write)
+            {
+                hid_t space = H5Dget_space(dataset);
+                hid_t memspace = H5Screate_simple(1, &count, NULL);
+                herr_t status = -1;
+                if (space >= 0 and memspace >= 0 and H5Sselect_hyperslab(space, H5S_SELECT_SET, &offset, NULL, &count, NULL) >= 0)
+                {
+                    if (write)
+                        status = H5Dwrite(dataset, get_hdf5_data_type<U>::type(), memspace, space, H5P_DEFAULT, (void *)buffer);
+                    else
+                        status = H5Dread(dataset, get_hdf5_data_type<U>::type(), memspace, space, H5P_DEFAULT, (void *)buffer);
+                }
+                if (memspace >= 0) H5Sclose(memspace);
+                if (space >= 0) H5Sclose(space);
+                if (status < 0)
+                {
+                    std::ostringstream errmsg;
+                    errmsg << "Error combining HDF5 output! Failed to " << (write ? "write" : "read") << " elements " << offset
+                           << " to " << offset + count << " of dataset '" << getName(dataset) << "'.";
+                    printer_error().raise(LOCAL_INFO, errmsg.str());
+                }
+            }
+
+            /// Copy `length` elements from one 1D dataset to another, one chunk at a time.
+            template <typename U>
+            inline void copy_slabs(hid_t src, hsize_t src_offset, hid_t dst, hsize_t dst_offset, hsize_t length, std::vector<U> &buffer)
+            {
+                for (hsize_t done = 0; done < length; done += COMBINE_CHUNK)
+                {
+                    hsize_t count = std::min(length - done, COMBINE_CHUNK);
+                    buffer.resize(count);
+                    transfer_slab(src, src_offset + done, count, &buffer[0], false);
+                    transfer_slab(dst, dst_offset + done, count, &buffer[0], true);
+                }
+            }
+
+            /// Write buffer[i] to element coords[i] of a 1D dataset, for every entry of coords.
+            template <typename U>
+            inline void write_points(hid_t dataset, const std::vector<hsize_t> &coords, const U *buffer)
+            {
+                if (coords.empty()) return;
+                hsize_t count = coords.size();
+                hid_t space = H5Dget_space(dataset);
+                hid_t memspace = H5Screate_simple(1, &count, NULL);
+                herr_t status = -1;
+                if (space >= 0 and memspace >= 0 and H5Sselect_elements(space, H5S_SELECT_SET, count, &coords[0]) >= 0)
+                {
+                    status = H5Dwrite(dataset, get_hdf5_data_type<U>::type(), memspace, space, H5P_DEFAULT, (void *)buffer);
+                }
+                if (memspace >= 0) H5Sclose(memspace);
+                if (space >= 0) H5Sclose(space);
+                if (status < 0)
+                {
+                    std::ostringstream errmsg;
+                    errmsg << "Error combining HDF5 output! Failed to write " << count << " scattered elements to dataset '" << getName(dataset) << "'.";
+                    printer_error().raise(LOCAL_INFO, errmsg.str());
+                }
+            }
+
+            /// Length of a 1D "isvalid" dataset once any trailing invalid entries are dropped.
+            /// The dataset is scanned backwards one chunk at a time.
+            inline hsize_t trailing_valid_length(hid_t dataset)
+            {
+                hid_t space = H5Dget_space(dataset);
+                hsize_t size = H5Sget_simple_extent_npoints(space);
+                H5Sclose(space);
+                std::vector<int> valids;
+                while (size > 0)
+                {
+                    hsize_t count = std::min(size, COMBINE_CHUNK);
+                    valids.resize(count);
+                    transfer_slab(dataset, size - count, count, &valids[0], false);
+                    for (auto it = valids.rbegin(), end = valids.rend(); it != end; ++it, --size)
+                    {
+                        if (*it) return size;
+                    }
+                }
+                return 0;
+            }
+
             struct read_hdf5
             {
                 template <typename U, typename T>
@@ -61,18 +148,23 @@ namespace Gambit
             struct copy_hdf5
             {
                 template <typename U>
-                static void run(U, hid_t &dataset_out, std::vector<hid_t> &datasets, unsigned long long &size_tot, std::vector<unsigned long long> &sizes, hid_t &old_dataset)
+                static void run(U, hid_t &dataset_out, std::vector<hid_t> &datasets, std::vector<unsigned long long> &sizes, hid_t &old_dataset)
                 {
-                    std::vector<U> data(size_tot);
-                    unsigned long long j = 0;
-                    
+                    // Stream each input into its place in the output, one chunk at a time, so that
+                    // memory use does not grow with the size of the run.
+                    hid_t out_space = H5Dget_space(dataset_out);
+                    hsize_t size_out = H5Sget_simple_extent_npoints(out_space);
+                    H5Sclose(out_space);
+
+                    std::vector<U> buffer;
+                    hsize_t j = 0;
+
                     if (old_dataset >= 0)
                     {
                         hid_t space = H5Dget_space(old_dataset);
                         hsize_t dim_t = H5Sget_simple_extent_npoints(space);
                         H5Sclose(space);
-                        data.resize(dim_t + size_tot);
-                        H5Dread(old_dataset, get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&data[0]);
+                        copy_slabs(old_dataset, 0, dataset_out, 0, std::min(dim_t, size_out), buffer);
                         j = dim_t;
                     }
                     
@@ -81,9 +173,6 @@ namespace Gambit
                         hsize_t dim_t;
                         if(datasets[i] >= 0)
                         {
-                           // Read the dataset in to buffer
-                           H5Dread(datasets[i], get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&data[j]);
-                           
                            hid_t space = H5Dget_space(datasets[i]);
                            dim_t = H5Sget_simple_extent_npoints(space);
                            H5Sclose(space);
@@ -97,8 +186,10 @@ namespace Gambit
                         // Check size consistency
                         if (dim_t >= sizes[i])
                         {
-                            // Data had expected size, no problem
-                            // NOTE: Why can dim_t be larger than expected? Possible padding at end or something?
+                            // Data had expected size, no problem. Anything past sizes[i] is
+                            // trailing invalid padding and is not copied.
+                            if (j < size_out)
+                                copy_slabs(datasets[i], 0, dataset_out, j, std::min<hsize_t>(sizes[i], size_out - j), buffer);
                             j += sizes[i];
                         }
                         else if(dim_t==0)
@@ -115,8 +206,6 @@ namespace Gambit
                             printer_error().raise(LOCAL_INFO, errmsg.str());
                         }
                     }
-                    
-                    H5Dwrite( dataset_out, get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&data[0]);
                 }
             };
 
@@ -125,31 +214,9 @@ namespace Gambit
                 template <typename U>
                 static void run (U, hid_t &dataset_out, hid_t &dataset2_out, std::vector<hid_t> &datasets, std::vector<hid_t> &datasets2, const unsigned long long size, const std::unordered_map<PPIDpair, unsigned long long, PPIDHash, PPIDEqual>& RA_write_hash, const std::vector<std::vector <unsigned long long> > &pointid, const std::vector<std::vector <unsigned long long> > &rank, const std::vector<unsigned long long> &aux_sizes, hid_t &/*old_dataset*/, hid_t &/*old_dataset2*/)
                 {
-                    std::vector<U> output(size, 0);
-                    std::vector<int> valids(size, 0);
-
-                    // Should no longer need the old datasets, they should have already been copied during "copy_hdf5"
-                    // if (old_dataset >= 0 && old_dataset2 >= 0)
-                    // {
-                    //     hid_t space  = HDF5::getSpace(old_dataset);
-                    //     hid_t space2 = HDF5::getSpace(old_dataset2);
-                    //     hsize_t old_size  = H5Sget_simple_extent_npoints(space);
-                    //     hsize_t old_size2 = H5Sget_simple_extent_npoints(space2);
-                    //     HDF5::closeSpace(space);
-                    //     HDF5::closeSpace(space2);
-                    //     if(old_size > size or old_size2 > size)
-                    //     {
-                    //        std::ostringstream errmsg;
-                    //        errmsg << "Error copying old dataset into buffer! The old dataset has a larger size than has been allocated for new data! (old_size="<<old_size<<", old_size2="<<old_size2<<", new_size="<<size<<")";
-                    //        printer_error().raise(LOCAL_INFO, errmsg.str());
-                    //     }
-                    //     H5Dread(old_dataset,  get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&output[0]);
-                    //     H5Dread(old_dataset2, get_hdf5_data_type<int>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&valids[0]);
-                    // }
-
-                    // Instead we just need to read in the recently-copied primary points and replace
-                    // entries as needed (TODO: would use much less memory if we just write individual replacements
-                    // straight to disk)
+                    // The old datasets are not needed here; they have already been copied during "copy_hdf5".
+                    // The RA points are read from the temp files one chunk at a time, and written
+                    // straight into the recently-copied primary datasets as scattered replacements.
                     if (dataset_out >= 0 && dataset2_out >= 0)
                     {
                         hid_t space  = HDF5::getSpace(dataset_out);
@@ -161,16 +228,14 @@ namespace Gambit
                         if(out_size > size or out_size2 > size)
                         {
                            std::ostringstream errmsg;
-                           errmsg << "Error copying dataset into buffer for RA replacements! The dataset has a larger size than has been allocated for new data! (out_size="<<out_size<<", out_size2="<<out_size2<<", expected_size="<<size<<")";
+                           errmsg << "Error preparing dataset for RA replacements! The dataset is larger than has been allocated for new data! (out_size="<<out_size<<", out_size2="<<out_size2<<", expected_size="<<size<<")";
                            printer_error().raise(LOCAL_INFO, errmsg.str());
                         }
-                        H5Dread(dataset_out,  get_hdf5_data_type<U>::type(),   H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&output[0]);
-                        H5Dread(dataset2_out, get_hdf5_data_type<int>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&valids[0]);
                     }
                     else
                     {
                         std::ostringstream errmsg;
-                        errmsg << "Error copying datasets into buffer for RA replacements! Could not open datasets (were they created properly during 'copy_hdf5' operation?).";
+                        errmsg << "Error preparing datasets for RA replacements! Could not open datasets (were they created properly during 'copy_hdf5' operation?).";
                         printer_error().raise(LOCAL_INFO, errmsg.str());
                     } 
 
@@ -188,6 +253,24 @@ namespace Gambit
                     DSET_SIZE_CHECK(pointid)
                     DSET_SIZE_CHECK(rank)
                     #undef DSET_SIZE_CHECK
+
+                    // Chunk buffers for reading, and pending replacements (target index -> value).
+                    // A target written more than once keeps the last value, as it would in order.
+                    std::vector<U> data;
+                    std::vector<int> valid;
+                    std::vector<hsize_t> targets;
+                    std::vector<U> values;
+                    std::unordered_map<hsize_t, std::size_t> pending;
+
+                    auto flush = [&]()
+                    {
+                        write_points(dataset_out, targets, values.data());
+                        std::vector<int> ones(targets.size(), 1);
+                        write_points(dataset2_out, targets, ones.data());
+                        targets.clear();
+                        values.clear();
+                        pending.clear();
+                    };
  
                     // Additional iterators to be iterated in sync with dataset iteration
                     // We are actually only copying over one 'parameter' in this function,
@@ -217,10 +300,7 @@ namespace Gambit
                        {
                           hid_t space = H5Dget_space(*it);
                           hssize_t dim_t = H5Sget_simple_extent_npoints(space);
-                          std::vector<U> data(dim_t);
-                          std::vector<bool> valid;
-                          Enter_HDF5<read_hdf5> (*itv, valid);
-                          H5Dread(*it, get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&data[0]);
+                          H5Sclose(space);
                           
                           if((unsigned long long)dim_t < *st)
                           {
@@ -229,30 +309,22 @@ namespace Gambit
                               printer_error().raise(LOCAL_INFO, errmsg.str());
                           }
 
-                          for (int i = 0, end = *st; i < end; i++)
+                          for (hsize_t offset = 0; offset < *st; offset += COMBINE_CHUNK)
                           {
-                              if (valid[i])
+                              hsize_t count = std::min<hsize_t>(*st - offset, COMBINE_CHUNK);
+                              data.resize(count);
+                              valid.resize(count);
+                              transfer_slab(*it, offset, count, &data[0], false);
+                              transfer_slab(*itv, offset, count, &valid[0], false);
+
+                              for (hsize_t k = 0; k < count; k++)
                               {
+                                  if (not valid[k]) continue;
+                                  hsize_t i = offset + k;
+
                                   // Look up target for write in hash map
                                   std::unordered_map<PPIDpair, unsigned long long, PPIDHash, PPIDEqual>::const_iterator ihash = RA_write_hash.find(PPIDpair((*pt)[i],(*ra)[i]));
-                                  if(ihash != RA_write_hash.end())
-                                  {
-                                      // found hash key, copy data
-                                      unsigned long long temp = ihash->second;
-                                      if(temp > size)
-                                      {
-                                          std::ostringstream errmsg;
-                                          errmsg << "Error copying random access parameter. The hash entry for "
-                                          << "pt number " << (*pt)[i] << " of rank " << (*ra)[i]  
-                                          << " targets the point outside the size of the output dataset ("<<temp<<" > "<<size<<")." 
-                                          << "This indicates"
-                                          << " a bug in the hash generation, please report it."; 
-                                          printer_error().raise(LOCAL_INFO, errmsg.str());
-                                      }
-                                      output[temp] = data[i];
-                                      valids[temp] = 1;
-                                  }
-                                  else
+                                  if(ihash == RA_write_hash.end())
                                   {
                                      std::ostringstream errmsg;
                                      errmsg << "Error copying random access parameter. Could not find "
@@ -260,13 +332,38 @@ namespace Gambit
                                      << " in the output dataset (hash entry was not found).";
                                      printer_error().raise(LOCAL_INFO, errmsg.str());
                                   }
+
+                                  // found hash key, queue the replacement
+                                  unsigned long long temp = ihash->second;
+                                  if(temp >= size)
+                                  {
+                                      std::ostringstream errmsg;
+                                      errmsg << "Error copying random access parameter. The hash entry for "
+                                      << "pt number " << (*pt)[i] << " of rank " << (*ra)[i]  
+                                      << " targets the point outside the size of the output dataset ("<<temp<<" >= "<<size<<")." 
+                                      << "This indicates"
+                                      << " a bug in the hash generation, please report it."; 
+                                      printer_error().raise(LOCAL_INFO, errmsg.str());
+                                  }
+
+                                  auto queued = pending.find(temp);
+                                  if (queued != pending.end())
+                                  {
+                                      values[queued->second] = data[k];
+                                  }
+                                  else
+                                  {
+                                      pending.emplace(temp, targets.size());
+                                      targets.push_back(temp);
+                                      values.push_back(data[k]);
+                                      if (targets.size() >= COMBINE_CHUNK) flush();
+                                  }
                               }
                           }
                        } // end if
                     }
                     
-                    H5Dwrite( dataset_out, get_hdf5_data_type<U>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&output[0]);
-                    H5Dwrite( dataset2_out, get_hdf5_data_type<int>::type(), H5S_ALL, H5S_ALL, H5P_DEFAULT, (void *)&valids[0]);
+                    flush();
                 }
             };
 
@@ -371,21 +468,20 @@ namespace Gambit
                 std::vector<unsigned long long> cum_sizes;
                 std::vector<unsigned long long> sizes;
                 unsigned long long size_tot;
-                unsigned long long size_tot_l;
                 std::string root_file_name;
-                unsigned long long pt_min;
+                hid_t cparms; // Creation settings for output datasets (chunking, compression); -1 for contiguous
                 
             public:
-                hdf5_stuff(const std::string &file_name, const std::string &group_name, int num);
+                hdf5_stuff(const std::string &file_name, const std::string &group_name, int num, hid_t cparms = -1);
                 ~hdf5_stuff(); // close files on destruction                
-                void Enter_Aux_Paramters(const std::string &file, bool resume = false);
+                void Enter_Aux_Paramters(const std::string &file, bool resume = false, bool delete_tmp = true);
             };
 
-            inline void combine_hdf5_files(const std::string file_output, const std::string &file, const std::string &group, int num, bool resume)
+            inline void combine_hdf5_files(const std::string file_output, const std::string &file, const std::string &group, int num, bool resume, bool delete_tmp = true, hid_t cparms = -1)
             {
-                hdf5_stuff stuff(file, group, num);
+                hdf5_stuff stuff(file, group, num, cparms);
                 
-                stuff.Enter_Aux_Paramters(file_output, resume);
+                stuff.Enter_Aux_Paramters(file_output, resume, delete_tmp);
             }
   
             // Helper function to compute target point hash for RA combination
@@ -160,6 +160,13 @@ namespace Gambit
          /// Get name of dataset
          std::string getName(hid_t dset_id);
 
+         /// Create a dataset creation property list for chunked 1D datasets, with optional
+         /// compression. 'filter' is "none", "gzip" (deflate, level 0-9) or "lz4" (needs the
+         /// HDF5 LZ4 filter plugin to be installed, both for writing and for reading back).
+         /// Byte shuffling before compression usually helps a lot for numeric columns.
+         /// Release with H5Pclose when no longer needed.
+         hid_t createDatasetPropList(hsize_t chunklength, const std::string& filter, unsigned int level, bool shuffle);
+
          /// @}
 
       }
@@ -0,0 +1,348 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Binary printer class member function definitions
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+
+// Standard libraries
+#include <map>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <ios>
+#include <sstream>
+#include <fstream>
+
+// Gambit
+#include "gambit/Printers/printers/binaryprinter.hpp"
+#include "gambit/Utils/standalone_error_handlers.hpp"
+#include "gambit/Utils/stream_overloads.hpp"
+#include "gambit/Utils/util_functions.hpp"
+
+// MPI bindings
+#include "gambit/Utils/mpiwrapper.hpp"
+
+// Code!
+namespace Gambit
+{
+
+  namespace Printers
+  {
+
+    /// Open binary file stream with error checking
+    void open_binary_output_file(std::ofstream& output, const std::string& filename, std::ios_base::openmode mode)
+    {
+      output.open(filename, std::ofstream::out | std::ofstream::binary | mode);
+      if( output.fail() | output.bad() )
+      {
+         std::ostringstream ss;
+         ss << "IO error while opening file for writing! Tried to open ofstream to file \""<<filename<<"\", but encountered error bit in the created ostream.";
+         printer_error().raise(LOCAL_INFO, ss.str());
+      }
+    }
+
+    // Common constructor tasks
+    void binaryPrinter::common_constructor(const Options& options)
+    {
+      if( this->is_auxilliary_printer() ) // check if this is an auxilliary printer
+      {
+         // Get stream name from printermanager
+         printer_name = options.getValue<std::string>("name");
+
+         // Get primary printer (need to cast from BasePrinter type to binaryPrinter)
+         binaryPrinter* primary = dynamic_cast<binaryPrinter*>(this->get_primary_printer());
+
+         // Name files based on the primary printer filenames
+         std::ostringstream f;
+         f << primary->get_output_filename() << "_" << printer_name;
+         output_file = Utils::ensure_path_exists(options.getValueOrDef<std::string>(f.str(),"output_file"));
+
+         // Match the buffer length to the primary printer, or use a user-supplied option
+         bufferlength = options.getValueOrDef<uint>(primary->get_bufferlength(),"buffer_length");
+      }
+      else
+      {
+         printer_name = "Primary";
+
+         std::ostringstream f;
+         if(options.hasKey("output_path"))
+         {
+           f << options.getValue<std::string>("output_path") << "/";
+         }
+         else
+         {
+           f << options.getValue<std::string>("default_output_path") << "/";
+         }
+         f << options.getValue<std::string>("output_file");
+         output_file = Utils::ensure_path_exists(f.str());
+
+         bufferlength = options.getValueOrDef<uint>(1000,"buffer_length");
+      }
+
+      #ifdef WITH_MPI
+      myRealRank = myComm.Get_rank();
+      this->setRank(myRealRank);
+      mpiSize = myComm.Get_size();
+
+      // Append mpi rank to file names to avoid collisions between processes
+      std::ostringstream fout;
+      fout << output_file <<"_"<<myRealRank;
+      output_file = fout.str();
+      #endif
+
+      // Name schema file to match output file
+      schema_file = output_file + "_schema.yaml";
+
+      // Erase contents of output_file if it already exists, and keep it open for appending
+      open_binary_output_file(my_fstream, output_file, std::ofstream::trunc);
+    }
+
+    // Constructor
+    binaryPrinter::binaryPrinter(const Options& options, BasePrinter* const primary)
+      : BasePrinter(primary,options.getValueOrDef<bool>(false,"auxilliary"))
+      , output_file("")
+      , schema_file("")
+      , bufferlength(1000)
+      , printer_name("")
+     #ifdef WITH_MPI
+      , myComm() // attaches to MPI_COMM_WORLD, beware collisions with e.g. scanning algorithms.
+      , mpiSize(1)
+     #endif
+      , lastPointID(nullpoint)
+    {
+      common_constructor(options);
+    }
+
+    /// Destructor
+    binaryPrinter::~binaryPrinter()
+    {
+      if(my_fstream.is_open()) my_fstream.close();
+    }
+
+    /// Initialisation function
+    void binaryPrinter::initialise(const std::vector<int>& /*printmevec*/)
+    {
+      // Nothing to be done
+    }
+
+    /// Do final buffer dumps
+    void binaryPrinter::finalise(bool /*abnormal*/)
+    {
+      dump_buffer(true);
+      // Make sure a schema exists even if nothing was ever printed
+      if(not schema_written) write_schema();
+      my_fstream.close();
+    }
+
+    /// Delete contents of output file (to be replaced/updated) and erase everything in the buffer
+    void binaryPrinter::reset(bool)
+    {
+      my_fstream.close();
+      open_binary_output_file(my_fstream, output_file, std::ofstream::trunc);
+      erase_buffer();
+      lastPointID = nullpoint;
+    }
+
+    /// Clear buffer
+    void binaryPrinter::erase_buffer()
+    {
+      buffer.clear();
+    }
+
+    // getters for internal variables
+    std::string binaryPrinter::get_output_filename() { return output_file; }
+    int         binaryPrinter::get_bufferlength()    { return bufferlength; }
+
+    // add results to printer buffer
+    void binaryPrinter::addtobuffer(const std::vector<double>& functor_data, const std::vector<std::string>& functor_labels, const int vID, const int rank, const int pointID)
+    {
+      // Key for accessing buffer
+      std::pair<int,int> bkey = std::make_pair(rank,pointID);
+      PPIDpair ppid(pointID,rank);
+
+      if(lastPointID == nullpoint)
+      {
+        // No previous point; add current point
+        lastPointID = ppid;
+      }
+      else if(lastPointID != ppid)
+      {
+        // Moving to new point; set previous point data as "ready to print".
+        std::pair<int,int> prevbkey = std::make_pair(lastPointID.rank,lastPointID.pointID);
+        auto prev = buffer.find(prevbkey);
+        if(prev==buffer.end())
+        {
+           std::ostringstream err;
+           err << "Tried to move binaryPrinter buffer to new point '" << ppid << "', however the *previous* point '"
+               << lastPointID << "' could not be found in the buffer (we need to set it as 'finished'). This is a bug "
+               << "in the binaryPrinter; please report it. (functor label: " << functor_labels << ")";
+           printer_error().raise(LOCAL_INFO, err.str());
+        }
+        prev->second.readyToPrint = true;
+        lastPointID = ppid;
+
+        // Check whether it is time to dump the (completed) buffer points to disk
+        if(buffer.size()>=bufferlength) dump_buffer();
+      }
+
+      Record& record = buffer[bkey];
+      if(record.readyToPrint)
+      {
+         std::ostringstream err;
+         err << "Error! Attempted to write to \"old\" model point buffer in binaryPrinter (slot (rank,pointID): "
+             << rank <<", "<< pointID << "; functor label: "<< functor_labels << "). Records should not be written "
+             << "to again once the printer has moved on from them. This is a bug; please report it.";
+         printer_error().raise(LOCAL_INFO, err.str());
+      }
+      record.data[vID] = functor_data;
+
+      if ( label_record.find(vID)==label_record.end() or functor_labels.size()>label_record.at(vID).size() )
+      {
+         // Keep the longest label list seen for each vertex
+         label_record[vID] = functor_labels;
+      }
+    }
+
+    /// Write the schema file describing the record layout
+    void binaryPrinter::write_schema()
+    {
+      YAML::Emitter out;
+      out << YAML::BeginMap;
+      out << YAML::Key << "format"      << YAML::Value << "gambit_binary";
+      out << YAML::Key << "version"     << YAML::Value << BINARY_FORMAT_VERSION;
+      out << YAML::Key << "byte_order"  << YAML::Value << "little";
+      out << YAML::Key << "data_file"   << YAML::Value << Utils::base_name(output_file);
+      out << YAML::Key << "record_size" << YAML::Value << record_size;
+      out << YAML::Key << "columns"     << YAML::Value << YAML::BeginSeq;
+      std::size_t column_index = 0;
+      for (std::map<int,int>::iterator it = lineindexrecord.begin(); it != lineindexrecord.end(); it++)
+      {
+        const std::vector<std::string>& labels = label_record.at(it->first);
+        for (int i=0; i<it->second; i++)
+        {
+          out << YAML::Flow << YAML::BeginMap;
+          out << YAML::Key << "name"         << YAML::Value << YAML::DoubleQuoted << labels.at(i);
+          out << YAML::Key << "type"         << YAML::Value << "f8";
+          out << YAML::Key << "offset"       << YAML::Value << 8*column_index;
+          out << YAML::Key << "valid_offset" << YAML::Value << 8*ncolumns + column_index;
+          out << YAML::EndMap;
+          column_index++;
+        }
+      }
+      out << YAML::EndSeq;
+      out << YAML::EndMap;
+
+      std::ofstream schema_fstream;
+      open_binary_output_file(schema_fstream, schema_file, std::ofstream::trunc);
+      schema_fstream << out.c_str() << std::endl;
+      schema_fstream.close();
+      schema_written = true;
+    }
+
+    // write the printer buffer to file
+    void binaryPrinter::dump_buffer(bool force)
+    {
+      //  force=true -- dumps all records regardless if they are "readyToPrint"
+
+      // Work out the number of columns used by each vertexID
+      std::map<int,int> newlineindexrecord(lineindexrecord);
+      for (auto bufentry = buffer.begin(); bufentry != buffer.end(); ++bufentry)
+      {
+        for (auto item = bufentry->second.data.begin(); item != bufentry->second.data.end(); ++item)
+        {
+          int& len = newlineindexrecord[item->first];
+          len = std::max(len, (int)item->second.size());
+        }
+      }
+
+      // The record layout is fixed by the first buffer dump
+      if (lineindexrecord.size()==0)
+      {
+        lineindexrecord = newlineindexrecord;
+        ncolumns = 0;
+        for (auto it = lineindexrecord.begin(); it != lineindexrecord.end(); ++it) ncolumns += it->second;
+        // One double and one validity byte per column, padded to keep the doubles aligned
+        record_size = 8*ncolumns + 8*((ncolumns+7)/8);
+      }
+      else if (lineindexrecord!=newlineindexrecord)
+      {
+        std::ostringstream errmsg;
+        errmsg << "Error! Output format has changed since last buffer dump! The binaryPrinter cannot handle this! "
+               << "Details:" << std::endl;
+        for (auto it = newlineindexrecord.begin(); it != newlineindexrecord.end(); ++it)
+        {
+          if(lineindexrecord.find(it->first)==lineindexrecord.end())
+          {
+            errmsg << "   vID="<<it->first<<" (label="<<label_record.at(it->first)<<") did not print during filling of the first buffer." << std::endl;
+          }
+          else if(it->second > lineindexrecord.at(it->first))
+          {
+            errmsg << "   vID="<<it->first<<" (label="<<label_record.at(it->first)<<") printed "<<it->second
+                   << " entries, but only "<<lineindexrecord.at(it->first)<<" were seen during filling of the first buffer." << std::endl;
+          }
+        }
+        printer_error().raise(LOCAL_INFO,errmsg.str());
+      }
+
+      if (not schema_written and ncolumns!=0) write_schema();
+
+      // Encode all finished records, then write them out in one go
+      block.clear();
+      for (auto bufentry = buffer.begin(); bufentry != buffer.end(); /* Will increment in loop */ )
+      {
+        Record& record = bufentry->second;
+        if(force or record.readyToPrint)
+        {
+          const std::size_t start = block.size();
+          block.resize(start + record_size, 0);
+          char* values = &block[start];
+          char* valid  = values + 8*ncolumns;
+          std::size_t column = 0;
+          for (auto it = lineindexrecord.begin(); it != lineindexrecord.end(); ++it)
+          {
+            auto itdata = record.data.find(it->first);
+            const std::size_t n = (itdata==record.data.end()) ? 0 : itdata->second.size();
+            for (int j=0; j<it->second; j++, column++)
+            {
+              if((std::size_t)j<n)
+              {
+                Binary::encode(itdata->second[j], values + 8*column);
+                valid[column] = 1;
+              }
+              else
+              {
+                // No result for this entry (e.g. the point was abandoned midway)
+                Binary::encode(std::numeric_limits<double>::quiet_NaN(), values + 8*column);
+              }
+            }
+          }
+          buffer.erase(bufentry++);
+        }
+        else
+        {
+          ++bufentry;
+        }
+      }
+
+      if(not block.empty())
+      {
+        my_fstream.write(block.data(), block.size());
+        my_fstream.flush();
+        if(my_fstream.fail())
+        {
+          std::ostringstream errmsg;
+          errmsg << "IO error while writing binaryPrinter output to file \""<<output_file<<"\"!";
+          printer_error().raise(LOCAL_INFO, errmsg.str());
+        }
+      }
+    }
+
+  } // end namespace printers
+} // end namespace Gambit
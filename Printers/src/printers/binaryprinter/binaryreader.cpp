@@ -0,0 +1,254 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Binary printer retriever class definitions.
+///  This is a class accompanying the binaryPrinter
+///  which takes care of *reading* from output
+///  created by the binaryPrinter.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "gambit/Printers/printers/binaryreader.hpp"
+#include "gambit/Utils/util_functions.hpp"
+#include "gambit/Logs/logger.hpp"
+
+namespace Gambit {
+  namespace Printers {
+
+    /// @{ General members of 'binaryReader'
+
+    /// Constructor
+    binaryReader::binaryReader(const Options& options)
+      : dataFile_name( options.getValue<std::string>("data_filename") )
+      , schemaFile_name( options.getValueOrDef<std::string>(dataFile_name+"_schema.yaml", "schema_filename") )
+      , column_map()
+      , record_size(0)
+      , col_rank()
+      , col_ptID()
+      , data(NULL)
+      , data_size(0)
+      , dataset_length(0)
+      , current_index(0)
+      , current_point(nullpoint)
+      , row_lookup()
+    {
+      logger() << LogTags::info << "binaryReader: Constructing 'binaryReader' for performing retrieval from previous output. File to be accessed is:"<<std::endl;
+      logger() << "  data file:   " << dataFile_name << std::endl;
+      logger() << "  schema file: " << schemaFile_name << std::endl;
+      logger() << EOM;
+
+      read_schema(schemaFile_name);
+      col_rank = get_column("MPIrank");
+      col_ptID = get_column("pointID");
+
+      /// Map the data file into memory
+      int fd = open(dataFile_name.c_str(), O_RDONLY);
+      struct stat st;
+      if(fd<0 or fstat(fd, &st)!=0)
+      {
+        std::ostringstream err;
+        err << "Error! binaryReader failed to open 'data' file '"<<dataFile_name<<"' for reading past scan output. OS message was: "<<strerror(errno);
+        if(fd>=0) close(fd);
+        printer_error().raise(LOCAL_INFO,err.str());
+      }
+      data_size = st.st_size;
+      if(data_size < record_size)
+      {
+        close(fd);
+        std::ostringstream err;
+        err << "Error! binaryReader found no complete records in input file '"<<dataFile_name<<"' (file seems to be empty?). Please check the path specified in the YAML config file for this run." << std::endl;
+        printer_error().raise(LOCAL_INFO,err.str());
+      }
+      void* map = mmap(NULL, data_size, PROT_READ, MAP_SHARED, fd, 0);
+      close(fd); // The mapping stays valid after the descriptor is closed
+      if(map==MAP_FAILED)
+      {
+        std::ostringstream err;
+        err << "Error! binaryReader failed to memory-map 'data' file '"<<dataFile_name<<"'. OS message was: "<<strerror(errno);
+        printer_error().raise(LOCAL_INFO,err.str());
+      }
+      data = static_cast<const char*>(map);
+
+      dataset_length = data_size / record_size;
+      if(data_size % record_size != 0)
+      {
+        // Most likely the scan was killed partway through a write; the complete records are fine
+        logger() << LogTags::warn << "binaryReader: data file '"<<dataFile_name<<"' ends with an incomplete record, which will be ignored." << EOM;
+      }
+    }
+
+    /// Destructor
+    binaryReader::~binaryReader()
+    {
+      if(data!=NULL) munmap(const_cast<char*>(data), data_size);
+    }
+
+    /// Get total length of dataset
+    ulong binaryReader::get_dataset_length()
+    {
+      return dataset_length;
+    }
+
+    // Get a linear index which corresponds to the current rank/ptID pair in the iterative sense
+    ulong binaryReader::get_current_index()
+    {
+      return current_index;
+    }
+
+    /// Reset read head position to zero
+    void binaryReader::reset()
+    {
+      current_index = 0;
+      current_point = nullpoint;
+    }
+
+    // Get current rank/ptID pair in data file
+    PPIDpair binaryReader::get_current_point()
+    {
+      return current_point;
+    }
+
+    /// Get next rank/ptID pair
+    PPIDpair binaryReader::get_next_point()
+    {
+      if(eoi())
+      {
+        std::ostringstream err;
+        err << "Error! binaryReader attempted to iterate past the end of the wrapped output file ("<<dataFile_name<<")! When iterating through output please check for the end-of-iteration via 'eoi()' before calling 'get_next_point()'.";
+        printer_error().raise(LOCAL_INFO,err.str());
+      }
+      ++current_index;
+      // Check eoi() before using the point! Points whose IDs were not recorded come back as nullpoint.
+      current_point = eoi() ? nullpoint : get_point(current_index-1);
+      return current_point;
+    }
+
+    /// Check for end of input
+    bool binaryReader::eoi()
+    {
+      return current_index > dataset_length;
+    }
+
+    /// Read the column layout from a schema file
+    void binaryReader::read_schema(const std::string& schema_filename)
+    {
+      YAML::Node schema;
+      try
+      {
+        schema = YAML::LoadFile(schema_filename);
+      }
+      catch(YAML::Exception& e)
+      {
+        std::ostringstream err;
+        err << "Error! binaryReader failed to read 'schema' file '"<<schema_filename<<"'. yaml-cpp message was: "<<e.what();
+        printer_error().raise(LOCAL_INFO,err.str());
+      }
+
+      if(not schema["format"] or schema["format"].as<std::string>()!="gambit_binary" or
+         not schema["version"] or schema["version"].as<int>()>BINARY_FORMAT_VERSION)
+      {
+        std::ostringstream err;
+        err << "Error! '"<<schema_filename<<"' is not a schema file for binaryPrinter output that this version of GAMBIT can read.";
+        printer_error().raise(LOCAL_INFO,err.str());
+      }
+
+      record_size = schema["record_size"].as<std::size_t>();
+      const YAML::Node columns = schema["columns"];
+      for(YAML::const_iterator it = columns.begin(); it != columns.end(); ++it)
+      {
+        Column col;
+        col.offset       = (*it)["offset"].as<std::size_t>();
+        col.valid_offset = (*it)["valid_offset"].as<std::size_t>();
+        if((*it)["type"].as<std::string>()!="f8" or col.offset+8>record_size or col.valid_offset>=record_size)
+        {
+          std::ostringstream err;
+          err << "Error! Invalid entry for column '"<<(*it)["name"].as<std::string>()<<"' in binaryPrinter schema file '"<<schema_filename<<"'.";
+          printer_error().raise(LOCAL_INFO,err.str());
+        }
+        column_map[(*it)["name"].as<std::string>()] = col;
+      }
+    }
+
+    /// Look up a column by name, with error checking
+    const binaryReader::Column& binaryReader::get_column(const std::string& label) const
+    {
+      auto it = column_map.find(label);
+      if(it==column_map.end())
+      {
+        std::ostringstream err;
+        err << "Error! binaryReader could not retrieve requested output entry '"<<label<<"'. This label does not match any column described in the schema file '"<<schemaFile_name<<"'.";
+        printer_error().raise(LOCAL_INFO,err.str());
+      }
+      return it->second;
+    }
+
+    /// Get the value of a column in some row; returns false if it is marked invalid
+    bool binaryReader::get_entry(const ulong row, const Column& col, double& out) const
+    {
+      const char* record = data + row*record_size;
+      out = Binary::decode(record + col.offset);
+      return record[col.valid_offset]!=0;
+    }
+
+    /// Get the point stored in some row (nullpoint if its ID entries are invalid)
+    PPIDpair binaryReader::get_point(const ulong row) const
+    {
+      double rank, ptID;
+      if(get_entry(row, col_rank, rank) and get_entry(row, col_ptID, ptID))
+      {
+        return PPIDpair((ulong)(ptID+0.5), (uint)(rank+0.5));
+      }
+      return nullpoint;
+    }
+
+    /// Find the row containing a given rank/pointID pair
+    ulong binaryReader::find_row(const PPIDpair& point)
+    {
+      // Usually this is the point we are iterating over
+      if(not eoi() and current_index!=0 and point==current_point) return current_index-1;
+
+      // Otherwise index the whole file once; this is cheap since only two columns are touched
+      if(row_lookup.empty())
+      {
+        for(ulong row=0; row<dataset_length; ++row)
+        {
+          PPIDpair p = get_point(row);
+          if(p!=nullpoint) row_lookup[p] = row;
+        }
+      }
+      auto it = row_lookup.find(point);
+      if(it==row_lookup.end())
+      {
+        std::ostringstream err;
+        err << "Error! binaryReader could not find the requested MPIrank/pointID pair "<<point<<" in the data file '"<<dataFile_name<<"'! Please ensure that this point exists in the data file (e.g. by iterating through the full point list using 'get_next_point()')";
+        printer_error().raise(LOCAL_INFO,err.str());
+      }
+      return it->second;
+    }
+
+    /// Get all output column labels
+    std::set<std::string> binaryReader::get_all_labels()
+    {
+       std::set<std::string> out;
+       for(auto it = column_map.begin(); it!=column_map.end(); ++it)
+       {
+         out.insert(it->first);
+       }
+       return out;
+    }
+    /// @}
+
+  }
+}
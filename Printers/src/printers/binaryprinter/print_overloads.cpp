@@ -0,0 +1,140 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Binary printer print function overloads.
+///  Add a new overload of the _print function
+///  in this file if you want to be able to print
+///  a new type.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#include "gambit/Printers/printers/binaryprinter.hpp"
+
+namespace Gambit
+{
+
+  namespace Printers
+  {
+
+    /// @{ PRINT FUNCTIONS
+    /// Everything is stored as doubles, as for the asciiPrinter.
+
+    /// Template for print functions of "simple" types
+    template<class T>
+    void binaryPrinter::template_print(T const& value, const std::string& label, const int IDcode, const uint thread, const ulong pointID)
+    {
+      std::vector<double> vdvalue(1,value);
+      std::vector<std::string> labels(1,label);
+      addtobuffer(vdvalue,labels,IDcode,thread,pointID);
+    }
+
+    /// Template for print functions of vectors of "simple" types
+    template<class T>
+    void binaryPrinter::template_print_vec(std::vector<T> const& value, const std::string& label, const int IDcode, const uint thread, const ulong pointID)
+    {
+      std::vector<std::string> labels;
+      std::vector<double> d_values;
+      labels.reserve(value.size());
+      d_values.reserve(value.size());
+      for(unsigned int i=0;i<value.size();i++)
+      {
+        std::stringstream ss;
+        ss<<label<<"["<<i<<"]";
+        labels.push_back(ss.str());
+        d_values.push_back(value.at(i)); // Convert to double
+      }
+      addtobuffer(d_values,labels,IDcode,thread,pointID);
+    }
+
+    /// Macros to add all the simple print functions that just use the above templates
+    #define BSIMPLEPRINT(r,data,elem) \
+      void binaryPrinter::_print(elem const& value, const std::string& label, \
+                           const int IDcode, const uint rank, \
+                           const ulong pointID) \
+      { \
+        template_print(value,label,IDcode,rank,pointID); \
+      }
+    #define BSIMPLEPRINT_VEC(r,data,elem) \
+      void binaryPrinter::_print(elem const& value, const std::string& label, \
+                           const int IDcode, const uint rank, \
+                           const ulong pointID) \
+      { \
+        template_print_vec(value,label,IDcode,rank,pointID); \
+      }
+
+    #define ADD_BINARY_SIMPLE_PRINTS(TYPES) BOOST_PP_SEQ_FOR_EACH(BSIMPLEPRINT, _, TYPES)
+    #define ADD_BINARY_VECTOR_PRINTS(TYPES) BOOST_PP_SEQ_FOR_EACH(BSIMPLEPRINT_VEC, _, TYPES)
+    ADD_BINARY_SIMPLE_PRINTS(SCANNER_SIMPLE_TYPES)
+    ADD_BINARY_VECTOR_PRINTS(SCANNER_VECTOR_TYPES)
+
+    void binaryPrinter::_print(map_str_dbl const& value, const std::string& label, const int IDcode, const uint thread, const ulong pointID)
+    {
+      std::vector<std::string> names;
+      std::vector<double> vdvalue;
+      names.reserve(value.size());
+      vdvalue.reserve(value.size());
+      for (map_str_dbl::const_iterator it = value.begin(); it != value.end(); it++)
+      {
+        std::stringstream ss;
+        ss<<label<<"::"<<it->first;
+        names.push_back( ss.str() );
+        vdvalue.push_back( it->second );
+      }
+      addtobuffer(vdvalue,names,IDcode,thread,pointID);
+    }
+
+    void binaryPrinter::_print(ModelParameters const& value, const std::string& label, const int vID, const unsigned int mpirank, const unsigned long pointID)
+    {
+      std::map<std::string, double> parameter_map = value.getValues();
+      _print(parameter_map, label, vID, mpirank, pointID);
+    }
+
+    void binaryPrinter::_print(triplet<double> const& value, const std::string& label, const int vID, const unsigned int mpirank, const unsigned long pointID)
+    {
+      std::map<std::string, double> m;
+      m["central"] = value.central;
+      m["lower"] = value.lower;
+      m["upper"] = value.upper;
+      _print(m, label, vID, mpirank, pointID);
+    }
+
+    #ifndef SCANNER_STANDALONE // All the types inside BINARY_MODULE_BACKEND_TYPES need to go inside this def guard.
+
+      void binaryPrinter::_print(DM_nucleon_couplings const& value, const std::string& label, const int vID, const unsigned int mpirank, const unsigned long pointID)
+      {
+        std::map<std::string, double> m;
+        m["Gp_SI"] = value.gps;
+        m["Gn_SI"] = value.gns;
+        m["Gp_SD"] = value.gpa;
+        m["Gn_SD"] = value.gna;
+        _print(m, label, vID, mpirank, pointID);
+      }
+
+      void binaryPrinter::_print(Flav_KstarMuMu_obs const& value, const std::string& label, const int vID, const unsigned int mpirank, const unsigned long pointID)
+      {
+        std::map<std::string, double> m;
+        std::ostringstream bins;
+        bins << value.q2_min << "_" << value.q2_max;
+        m["BR_"+bins.str()] = value.BR;
+        m["AFB_"+bins.str()] = value.AFB;
+        m["FL_"+bins.str()] = value.FL;
+        m["S3_"+bins.str()] = value.S3;
+        m["S4_"+bins.str()] = value.S4;
+        m["S5_"+bins.str()] = value.S5;
+        m["S7_"+bins.str()] = value.S7;
+        m["S8_"+bins.str()] = value.S8;
+        m["S9_"+bins.str()] = value.S9;
+        _print(m, label, vID, mpirank, pointID);
+      }
+
+    #endif
+
+    /// @}
+
+  }
+}
@@ -0,0 +1,146 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Binary reader retrieve function overloads.
+///  Add a new overload of the _retrieve function
+///  in this file if you want to be able to read
+///  a new type during postprocessing.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#include "gambit/Printers/printers/binaryreader.hpp"
+#include "gambit/Utils/stream_overloads.hpp"
+
+namespace Gambit
+{
+
+  namespace Printers
+  {
+
+    /// @{ Retrieval functions
+
+    /// Everything is stored as a double, so the simple numeric types are just converted
+    #define BSIMPLERETRIEVE(r,data,elem) \
+      bool binaryReader::_retrieve(elem& out, const std::string& label, const uint rank, const ulong pointID) \
+      { \
+        return retrieve_numeric(out,label,rank,pointID); \
+      }
+    BOOST_PP_SEQ_FOR_EACH(BSIMPLERETRIEVE, _, SCANNER_SIMPLE_TYPES)
+    #undef BSIMPLERETRIEVE
+
+    /// Gets ALL the ModelParameters matching a certain model name, as for the asciiReader.
+    /// So say the labels for two parameters are:
+    ///
+    ///#NormalDist_parameters @NormalDist::primary_parameters::mu
+    ///#NormalDist_parameters @NormalDist::primary_parameters::sigma
+    ///
+    /// Then to get a ModelParameters object containing "mu" and "sigma" you should enter
+    /// 'NormalDist' as the label.
+    bool binaryReader::_retrieve(ModelParameters& out, const std::string& modelname, const uint rank, const ulong pointID)
+    {
+      bool is_valid = true;
+      const ulong row = find_row(PPIDpair(pointID,rank));
+
+      /// Work out all the output labels that correspond to the input modelname
+      bool found_at_least_one(false);
+      for(const std::pair<std::string,Column>& kv : column_map)
+      {
+        std::string param_name; // *output* of parsing function, parameter name
+        std::string label_root; // *output* of parsing function, label minus parameter name
+        if(parse_label_for_ModelParameters(kv.first, modelname, param_name, label_root))
+        {
+          // Add the found parameter name to the ModelParameters object
+          out._definePar(param_name);
+          if(found_at_least_one)
+          {
+            if(out.getOutputName()!=label_root)
+            {
+               std::ostringstream err;
+               err << "Error! binaryReader could not retrieve ModelParameters matching the model name '"<<modelname
+                   <<"' in the binary file '"<<dataFile_name<<"' (while calling 'retrieve'). Candidate parameters WERE "
+                   <<"found, however their labels indicate the presence of an inconsistency or ambiguity in the output. "
+                   <<"The parameter "<<param_name<<" was found under the label root\n"<<label_root
+                   <<"\nwhich does not match the root expected based upon previous parameter retrievals for this model, which was\n  "
+                   <<out.getOutputName()<<"\nThis may indicate that multiple sets of model parameters are present in the "
+                   <<"output file for the same model! This is not allowed, please report this bug against whatever master "
+                   <<"YAML file (or external code?) produced the output file you are trying to read.";
+              printer_error().raise(LOCAL_INFO,err.str());
+            }
+          }
+          else
+          {
+            out.setOutputName(label_root);
+          }
+
+          // Get the corresponding value out of the data file
+          double value;
+          found_at_least_one = true;
+          if(get_entry(row, kv.second, value))
+          {
+             out.setValue(param_name, value);
+          }
+          else
+          {
+             // If one parameter value is 'invalid' then we cannot reconstruct
+             // the ModelParameters object, so we mark the whole thing invalid.
+             out.setValue(param_name, 0);
+             is_valid = false;
+          }
+        }
+      }
+
+      if(not found_at_least_one)
+      {
+         std::ostringstream err;
+         err << "Error! binaryReader failed to find any ModelParameters matching the model name '"<<modelname
+             <<"' in the schema file '"<<schemaFile_name<<"' (while calling 'retrieve'). Please check that model name and schema file name are correct.";
+         printer_error().raise(LOCAL_INFO,err.str());
+      }
+      return is_valid;
+    }
+
+    bool binaryReader::_retrieve(std::vector<bool>& /*out*/,const std::string& /*label*/, const uint /*rank*/, const ulong /*pointID*/)
+    { printer_error().raise(LOCAL_INFO,"NOT YET IMPLEMENTED"); return false; }
+    bool binaryReader::_retrieve(std::vector<int>& /*out*/,const std::string& /*label*/, const uint /*rank*/, const ulong /*pointID*/)
+    { printer_error().raise(LOCAL_INFO,"NOT YET IMPLEMENTED"); return false; }
+    bool binaryReader::_retrieve(std::vector<unsigned int>& /*out*/,const std::string& /*label*/, const uint /*rank*/, const ulong /*pointID*/)
+    { printer_error().raise(LOCAL_INFO,"NOT YET IMPLEMENTED"); return false; }
+    bool binaryReader::_retrieve(std::vector<short>& /*out*/,const std::string& /*label*/, const uint /*rank*/, const ulong /*pointID*/)
+    { printer_error().raise(LOCAL_INFO,"NOT YET IMPLEMENTED"); return false; }
+    bool binaryReader::_retrieve(std::vector<unsigned short>& /*out*/,const std::string& /*label*/, const uint /*rank*/, const ulong /*pointID*/)
+    { printer_error().raise(LOCAL_INFO,"NOT YET IMPLEMENTED"); return false; }
+    bool binaryReader::_retrieve(std::vector<long>& /*out*/,const std::string& /*label*/, const uint /*rank*/, const ulong /*pointID*/)
+    { printer_error().raise(LOCAL_INFO,"NOT YET IMPLEMENTED"); return false; }
+    bool binaryReader::_retrieve(std::vector<unsigned long>& /*out*/,const std::string& /*label*/, const uint /*rank*/, const ulong /*pointID*/)
+    { printer_error().raise(LOCAL_INFO,"NOT YET IMPLEMENTED"); return false; }
+    bool binaryReader::_retrieve(std::vector<long long>& /*out*/,const std::string& /*label*/, const uint /*rank*/, const ulong /*pointID*/)
+    { printer_error().raise(LOCAL_INFO,"NOT YET IMPLEMENTED"); return false; }
+    bool binaryReader::_retrieve(std::vector<unsigned long long>& /*out*/,const std::string& /*label*/, const uint /*rank*/, const ulong /*pointID*/)
+    { printer_error().raise(LOCAL_INFO,"NOT YET IMPLEMENTED"); return false; }
+    bool binaryReader::_retrieve(std::vector<float>& /*out*/,const std::string& /*label*/, const uint /*rank*/, const ulong /*pointID*/)
+    { printer_error().raise(LOCAL_INFO,"NOT YET IMPLEMENTED"); return false; }
+    bool binaryReader::_retrieve(std::vector<double>& /*out*/,const std::string& /*label*/, const uint /*rank*/, const ulong /*pointID*/)
+    { printer_error().raise(LOCAL_INFO,"NOT YET IMPLEMENTED"); return false; }
+    bool binaryReader::_retrieve(map_str_dbl& /*out*/, const std::string& /*label*/, const uint /*rank*/, const ulong /*pointID*/)
+    { printer_error().raise(LOCAL_INFO,"NOT YET IMPLEMENTED"); return false; }
+    bool binaryReader::_retrieve(triplet<double>& /*out*/,const std::string& /*label*/, const uint /*rank*/, const ulong /*pointID*/)
+    { printer_error().raise(LOCAL_INFO,"NOT YET IMPLEMENTED"); return false; }
+
+    #ifndef SCANNER_STANDALONE // All the types inside BINARY_MODULE_BACKEND_TYPES need to go inside this def guard.
+
+      bool binaryReader::_retrieve(DM_nucleon_couplings& /*out*/, const std::string& /*label*/, const uint /*rank*/, const ulong /*pointID*/)
+      { printer_error().raise(LOCAL_INFO,"NOT YET IMPLEMENTED"); return false; }
+      bool binaryReader::_retrieve(Flav_KstarMuMu_obs& /*out*/, const std::string& /*label*/, const uint /*rank*/, const ulong /*pointID*/)
+      { printer_error().raise(LOCAL_INFO,"NOT YET IMPLEMENTED"); return false; }
+
+    #endif
+
+    /// @}
+
+  }
+}
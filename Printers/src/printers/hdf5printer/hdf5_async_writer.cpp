@@ -0,0 +1,150 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Background writer thread for the HDF5
+///  printer; member function definitions.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#include "gambit/Printers/printers/hdf5printer/hdf5_async_writer.hpp"
+#include "gambit/Utils/standalone_error_handlers.hpp"
+
+namespace Gambit
+{
+  namespace Printers
+  {
+
+    namespace
+    {
+      /// Set on the writer threads only
+      thread_local bool is_writer_thread = false;
+
+      /// Error thrown (unlogged) by raise_write_error on a writer thread
+      struct write_error
+      {
+        std::string origin;
+        std::string message;
+      };
+    }
+
+    HDF5AsyncWriter::HDF5AsyncWriter(const std::size_t max_queued)
+      : jobs()
+      , max_queued(max_queued==0 ? 1 : max_queued)
+      , worker(&HDF5AsyncWriter::run, this)
+    {}
+
+    HDF5AsyncWriter::~HDF5AsyncWriter()
+    {
+      // Must not throw from here; any job error should already have been
+      // picked up by an earlier wait().
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+      }
+      job_ready.notify_all();
+      if(worker.joinable()) worker.join();
+    }
+
+    void HDF5AsyncWriter::submit(const std::function<void()>& job)
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      if(failed) raise_error();
+      if(jobs.size() >= max_queued)
+      {
+        // Writer has fallen behind; hold the scan back until it catches up
+        n_stalls++;
+        job_done.wait(lock, [this]{ return jobs.size() < max_queued or failed; });
+        if(failed) raise_error();
+      }
+      jobs.push_back(job);
+      lock.unlock();
+      job_ready.notify_one();
+    }
+
+    void HDF5AsyncWriter::wait()
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      job_done.wait(lock, [this]{ return (jobs.empty() and not busy) or failed; });
+      if(failed) raise_error();
+    }
+
+    void HDF5AsyncWriter::drain()
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      job_done.wait(lock, [this]{ return (jobs.empty() and not busy) or failed; });
+    }
+
+    void HDF5AsyncWriter::stop()
+    {
+      wait();
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+      }
+      job_ready.notify_all();
+      if(worker.joinable()) worker.join();
+    }
+
+    bool HDF5AsyncWriter::on_writer_thread() { return is_writer_thread; }
+
+    void HDF5AsyncWriter::raise_error()
+    {
+      if(error) std::rethrow_exception(error);
+      printer_error().raise(error_origin, "Background HDF5 write failed: " + error_message);
+    }
+
+    void HDF5AsyncWriter::run()
+    {
+      is_writer_thread = true;
+      std::unique_lock<std::mutex> lock(mtx);
+      while(true)
+      {
+        job_ready.wait(lock, [this]{ return not jobs.empty() or stopping; });
+        // Queue is always drained before stopping
+        if(jobs.empty()) break;
+
+        std::function<void()> job = jobs.front();
+        jobs.pop_front();
+        busy = true;
+        lock.unlock();
+        try
+        {
+          job();
+          lock.lock();
+        }
+        catch(const write_error& e)
+        {
+          lock.lock();
+          failed = true;
+          error_origin = e.origin;
+          error_message = e.message;
+        }
+        catch(...)
+        {
+          lock.lock();
+          failed = true;
+          error = std::current_exception();
+        }
+        busy = false;
+        job_done.notify_all();
+        if(failed)
+        {
+          jobs.clear();
+          break;
+        }
+      }
+    }
+
+    void raise_write_error(const std::string& origin, const std::string& message)
+    {
+      if(HDF5AsyncWriter::on_writer_thread()) throw write_error{origin, message};
+      printer_error().raise(origin, message);
+    }
+
+  }
+}
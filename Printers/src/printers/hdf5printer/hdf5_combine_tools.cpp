@@ -134,12 +134,32 @@ namespace Gambit
                 return return_val;
             }
             
-            inline void setup_hdf5_points(hid_t new_group, hid_t type, hid_t type2, unsigned long long size_tot, hid_t &dataset_out, hid_t &dataset2_out, hid_t &dataspace, hid_t &dataspace2, const std::string &name)
+            inline void setup_hdf5_points(hid_t new_group, hid_t type, hid_t type2, unsigned long long size_tot, hid_t &dataset_out, hid_t &dataset2_out, hid_t &dataspace, hid_t &dataspace2, const std::string &name, hid_t cparms)
             {
                 #ifdef COMBINE_DEBUG
                 std::cerr << "  Creating dataset '"<<name<<"'" << std::endl;
                 #endif
 
+                // Chunked (and possibly compressed) layout if requested. The output datasets
+                // have a fixed size, so chunks may not be longer than the dataset itself.
+                hid_t dcpl = H5P_DEFAULT;
+                if(cparms >= 0 and size_tot > 0)
+                {
+                  dcpl = H5Pcopy(cparms);
+                  hsize_t chunk[1];
+                  if(dcpl < 0 or H5Pget_chunk(dcpl, 1, chunk) < 0)
+                  {
+                    std::ostringstream errmsg;
+                    errmsg<<"Failed to set up HDF5 points for copying. Could not read chunking settings for dataset ("<<name<<").";
+                    printer_error().raise(LOCAL_INFO, errmsg.str());
+                  }
+                  if(chunk[0] > size_tot)
+                  {
+                    chunk[0] = size_tot;
+                    H5Pset_chunk(dcpl, 1, chunk);
+                  }
+                }
+
                 hsize_t dimsf[1];
                 dimsf[0] = size_tot;
                 dataspace = H5Screate_simple(1, dimsf, NULL); 
@@ -149,7 +169,7 @@ namespace Gambit
                   errmsg<<"Failed to set up HDF5 points for copying. H5Screate_simple failed for dataset ("<<name<<")."; 
                   printer_error().raise(LOCAL_INFO, errmsg.str());
                 }
-                dataset_out = H5Dcreate2(new_group, name.c_str(), type, dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+                dataset_out = H5Dcreate2(new_group, name.c_str(), type, dataspace, H5P_DEFAULT, dcpl, H5P_DEFAULT);
                 if(dataset_out < 0)
                 {
                   std::ostringstream errmsg;
@@ -163,7 +183,7 @@ namespace Gambit
                   errmsg<<"Failed to set up HDF5 points for copying. H5Screate_simple failed for dataset ("<<name<<"_isvalid).";
                   printer_error().raise(LOCAL_INFO, errmsg.str());
                 }
-                dataset2_out = H5Dcreate2(new_group, (name + "_isvalid").c_str(), type2, dataspace2, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+                dataset2_out = H5Dcreate2(new_group, (name + "_isvalid").c_str(), type2, dataspace2, H5P_DEFAULT, dcpl, H5P_DEFAULT);
                 if(dataset2_out < 0)
                 {
                   std::ostringstream errmsg;
@@ -175,6 +195,7 @@ namespace Gambit
                 // Could therefore get rid of dataset_out arguments, but won't bother right now.
                 HDF5::closeDataset(dataset_out);
                 HDF5::closeDataset(dataset2_out);
+                if(dcpl != H5P_DEFAULT) H5Pclose(dcpl);
             }
                 
             inline std::vector<std::string> getGroups(std::string groups)
@@ -195,12 +216,13 @@ namespace Gambit
                 return ret;
             }
                 
-            hdf5_stuff::hdf5_stuff(const std::string &file_name, const std::string &group_name, int num) 
+            hdf5_stuff::hdf5_stuff(const std::string &file_name, const std::string &group_name, int num, hid_t cparms)
               : group_name(group_name)
               , cum_sizes(num, 0)
               , sizes(num, 0)
               , size_tot(0)
               , root_file_name(file_name)
+              , cparms(cparms)
             {
                 //std::vector<bool> temp;
                 //herr_t status;
@@ -282,10 +304,6 @@ namespace Gambit
                     {
                        // Probably the sync group is empty for this file, just skip it
                        size = 0;
-                       if (i == num - 1) // Do we need this here?
-                       {
-                           size_tot_l = size_tot + size; // Last?
-                       }
                     } 
                     else if(dataset<0 or dataset2<0)
                     {
@@ -302,16 +320,6 @@ namespace Gambit
                        size           = H5Sget_simple_extent_npoints(dataspace); // Use variable declared outside the if block
                        hssize_t size2 = H5Sget_simple_extent_npoints(dataspace2);
                        
-                       std::vector<bool> valids;
-                       Enter_HDF5<read_hdf5>(dataset2, valids);
-                       
-                       if (i == 0)
-                       {
-                           std::vector<unsigned long long> pt_id;
-                           Enter_HDF5<read_hdf5>(dataset2, pt_id);
-                           pt_min = pt_id[0];
-                       }
-                       
                        if (size != size2)
                        {
                            std::ostringstream errmsg;
@@ -319,18 +327,8 @@ namespace Gambit
                            printer_error().raise(LOCAL_INFO, errmsg.str());
                        }
                        
-                       if (i == num - 1)
-                       {
-                           size_tot_l = size_tot + size; // Last?
-                       }
-                       
-                       for (auto it = valids.end()-1; size > 0; --it)
-                       {
-                           if (*it)
-                               break;
-                           else
-                               --size;
-                       }
+                       // Drop any trailing invalid points
+                       size = trailing_valid_length(dataset2);
 
                        H5Sclose(dataspace);
                        H5Sclose(dataspace2);
@@ -355,7 +353,7 @@ namespace Gambit
                 }
             } 
             
-            void hdf5_stuff::Enter_Aux_Paramters(const std::string &file, bool resume)
+            void hdf5_stuff::Enter_Aux_Paramters(const std::string &file, bool resume, bool delete_tmp)
             {
                 std::vector<std::vector<unsigned long long>> ranks, ptids;
                 std::vector<unsigned long long> aux_sizes;
@@ -481,10 +479,6 @@ namespace Gambit
                        hssize_t size = H5Sget_simple_extent_npoints(dataspace);
                        hssize_t size2 = H5Sget_simple_extent_npoints(dataspace2);
                        
-                       
-                       std::vector<bool> valids;
-                       Enter_HDF5<read_hdf5>(dataset3, valids);
-                       
                        if (size != size2)
                        {
                            std::ostringstream errmsg;
@@ -492,16 +486,11 @@ namespace Gambit
                            printer_error().raise(LOCAL_INFO, errmsg.str());
                        }
                        
-                       for (auto it = valids.end()-1; size > 0; --it)
-                       {
-                           if (*it)
-                               break;
-                           else
-                               --size;
-                       }
-                       aux_sizes.push_back(size);
+                       // Drop any trailing invalid points
+                       aux_sizes.push_back(trailing_valid_length(dataset3));
                        
                        H5Sclose(dataspace);
+                       H5Sclose(dataspace2);
                        HDF5::closeDataset(dataset);
                        HDF5::closeDataset(dataset2);
                        HDF5::closeDataset(dataset3);
@@ -577,15 +566,15 @@ namespace Gambit
                     }
                     
                     // Create datasets
-                    setup_hdf5_points(new_group, type, type2, size_tot, dataset_out, dataset2_out, dataspace, dataspace2, *it);
+                    setup_hdf5_points(new_group, type, type2, size_tot, dataset_out, dataset2_out, dataspace, dataspace2, *it, cparms);
                     //std::cout<<"(theoretically) created dataset '"<<*it<<"' in file:group "<<file<<":"<<group_name<<std::endl;
  
                     // Reopen dataset for writing
                     dataset_out   = HDF5::openDataset(new_group, *it);
                     dataset2_out  = HDF5::openDataset(new_group, (*it)+"_isvalid");
                     std::cout << "Copying parameter "<<*it<<std::endl; // debug
-                    Enter_HDF5<copy_hdf5>(dataset_out, datasets, size_tot_l, sizes, old_dataset);
-                    Enter_HDF5<copy_hdf5>(dataset2_out, datasets2, size_tot_l, sizes, old_dataset2);
+                    Enter_HDF5<copy_hdf5>(dataset_out, datasets, sizes, old_dataset);
+                    Enter_HDF5<copy_hdf5>(dataset2_out, datasets2, sizes, old_dataset2);
                     
                     for (int i = 0, end = datasets.size(); i < end; i++)
                     {
@@ -604,9 +593,7 @@ namespace Gambit
                 // and their targets in the output dataset. That means we need to read through
                 // the output dataset and read in all the pointID/MPI pairs.
                 // We only need to do this once and create a big hash table to use while copying.
-                // It would be better to do all the copying in chunks, and then we would also
-                // only need chunks of this hash table at a time, but Greg didn't write this
-                // code with chunked writing in mind. TODO: Should modify the code to do this.
+                // The table only holds the RA points; the datasets themselves are copied in chunks.
 
                 // We already know all the RA rank/ptID pairs, so just need to scan the output
                 // datasets for the matching pairs, and record their indices.
@@ -701,7 +688,7 @@ namespace Gambit
                              }
                           }
                           // Create new dataset
-                          setup_hdf5_points(new_group, type, type2, size_tot, dataset_out, dataset2_out, dataspace, dataspace2, *it); 
+                          setup_hdf5_points(new_group, type, type2, size_tot, dataset_out, dataset2_out, dataspace, dataspace2, *it, cparms); 
                        }
                        // Reopen output datasets for copying
                        dataset_out  = HDF5::openDataset(new_group, *it);
@@ -731,7 +718,7 @@ namespace Gambit
                     std::system(("rm -f " + file + ".temp.bak").c_str());
                 }
                 
-                for (int i = 0, end = files.size(); i < end; i++)
+                if (delete_tmp) for (int i = 0, end = files.size(); i < end; i++)
                 {
                     std::stringstream ss;
                     ss << i;
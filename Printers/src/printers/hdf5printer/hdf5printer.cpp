@@ -559,6 +559,23 @@ namespace Gambit
         // HDF5 group (virtual "folder") inside output file in which to store datasets
         group = options.getValueOrDef<std::string>("/","group");
 
+        // Chunking and compression of the output datasets. Longer chunks compress better
+        // (the default chunk holds just one buffer), and should preferably be a multiple of
+        // the buffer length, so that each buffer flush lands inside a single chunk.
+        // Unless either is set, the datasets keep their default layout (and the combined
+        // output stays contiguous, which is fastest to read).
+        if(options.hasKey("chunk_length") or options.hasKey("compression"))
+        {
+          const hsize_t chunk_length = options.getValueOrDef<unsigned long>(BUFFERLENGTH,"chunk_length");
+          const std::string compression = options.getValueOrDef<std::string>("none","compression");
+          const unsigned int compression_level = options.getValueOrDef<unsigned int>(4,"compression_level");
+          const bool shuffle = options.getValueOrDef<bool>(true,"shuffle");
+          dataset_cparms = HDF5::createDatasetPropList(chunk_length, compression, compression_level, shuffle);
+          logger() << LogTags::printers << LogTags::info << "HDF5Printer datasets will use chunks of "<<chunk_length<<" entries, compression: "<<compression;
+          if(compression!="none") logger() << " (level "<<compression_level<<", shuffle "<<(shuffle ? "on" : "off")<<")";
+          logger() << EOM;
+        }
+
         // Delete final target file (or group) if one with same name already exists? (and if we are restarting the run)
         // This is just for convenience during testing; by default datasets will simply be replaced in/added to
         // existing target HDF5 files. This lets one combine data from many scans into one file if desired.
@@ -765,6 +782,18 @@ namespace Gambit
         location_id = group_id;
         RA_location_id = RA_group_id;
 
+        // Optionally write full sync buffers from a background thread, so that the scan
+        // does not stall on disk I/O. At most 'async_write_queue' buffer writes can be
+        // waiting at once; beyond that the scan waits for the writer to catch up.
+        // Nothing else in this process should use HDF5 while the scan runs (e.g. the
+        // postprocessor reading HDF5 input), unless HDF5 was built thread-safe.
+        if(options.getValueOrDef<bool>(false,"async_write"))
+        {
+          const std::size_t queue_length = options.getValueOrDef<unsigned long>(1000,"async_write_queue");
+          async_writer.reset(new HDF5AsyncWriter(queue_length));
+          logger() << LogTags::printers << LogTags::info << "HDF5Printer will write buffers from a background thread (up to "<<queue_length<<" buffer writes queued)" << EOM;
+        }
+
       }
       else
       {
@@ -967,6 +996,13 @@ namespace Gambit
     HDF5Printer::~HDF5Printer()
     {
       DBUG( std::cout << "Destructing HDF5Printer object (with name=\""<<printer_name<<"\")..." << std::endl; )
+      // Queued background writes refer to the buffers of this printer, so let the writer
+      // finish with them (or give up on an error, which can't be raised from here) before
+      // any buffers are destroyed.  Auxiliary printers are destroyed before the primary one.
+      if(is_primary_printer) async_writer.reset();
+      else if(get_async_writer()!=NULL) get_async_writer()->drain();
+      // Release the dataset creation property list (only the primary printer makes one)
+      if(dataset_cparms >= 0) H5Pclose(dataset_cparms);
     }
 
     /// Perform final cleanup and write tasks
@@ -982,6 +1018,11 @@ namespace Gambit
         synchronise_buffers();
         logger() << LogTags::printers << "Print buffers synchronised; flushing them to disk" << EOM;
         flush();
+        if(async_writer)
+        {
+          async_writer->wait();
+          logger() << LogTags::printers << "Background writer finished; the scan waited for it "<<async_writer->get_n_stalls()<<" time(s) because its queue was full ("<<printer_name<<")" << EOM;
+        }
         logger() << LogTags::printers << "Final buffer flush done ("<<printer_name<<")"<<EOM;
 
         // close HDF5 datasets, groups, and file
@@ -1209,7 +1250,13 @@ namespace Gambit
       // exists, and it will crash if it doesn't. So we need to first check if such a file exists.
       bool combined_file_exists = Utils::file_exists(tmp_comb_file); // We already check this externally; pass in as flag?
       std::cout<<"combined_file_exists? "<<combined_file_exists<<std::endl;
-      HDF5::combine_hdf5_files(tmp_comb_file, finalfile, group, num, combined_file_exists);
+      std::chrono::time_point<std::chrono::system_clock> start(std::chrono::system_clock::now());
+      HDF5::combine_hdf5_files(tmp_comb_file, finalfile, group, num, combined_file_exists, true, dataset_cparms);
+      std::chrono::duration<double> time_taken = std::chrono::system_clock::now() - start;
+
+      // Report how much space the output takes, e.g. to judge the compression settings
+      std::ifstream combined(tmp_comb_file, std::ios::binary | std::ios::ate);
+      logger() << LogTags::printers << LogTags::info << "Combined HDF5 output ("<<tmp_comb_file<<") is "<<combined.tellg()<<" bytes; combination took "<<time_taken.count()<<" seconds." << EOM;
 
       // This is just left the same as the combine_output_py version!
       if(finalcombine)
@@ -1470,12 +1517,29 @@ namespace Gambit
       }
 
       // Tell the HDF5 library to flush everything to disk
-      herr_t err = H5Fflush(file_id, H5F_SCOPE_GLOBAL);
-      if(err<0)
+      const hid_t file = file_id;
+      const unsigned int rank = myRank;
+      const std::string name = printer_name;
+      auto flush_file = [file,rank,name]()
       {
-        std::ostringstream errmsg;
-        errmsg << "Error in HDF5Printer while trying to empty all synchronised buffers. Buffers were emptied to the HDF5 backend (seemingly) successfully, however H5Fflush returned an error value ("<<err<<"). That is, an error occurred while the HDF5 system attempted to flush its internally buffered data to disk. (Note: rank="<<myRank<<", printer_name="<<printer_name<<")";
-        printer_error().raise(LOCAL_INFO, errmsg.str());
+        herr_t err = H5Fflush(file, H5F_SCOPE_GLOBAL);
+        if(err<0)
+        {
+          std::ostringstream errmsg;
+          errmsg << "Error in HDF5Printer while trying to empty all synchronised buffers. Buffers were emptied to the HDF5 backend (seemingly) successfully, however H5Fflush returned an error value ("<<err<<"). That is, an error occurred while the HDF5 system attempted to flush its internally buffered data to disk. (Note: rank="<<rank<<", printer_name="<<name<<")";
+          raise_write_error(LOCAL_INFO, errmsg.str());
+        }
+      };
+      HDF5AsyncWriter* writer = get_async_writer();
+      if(writer==NULL)
+      {
+        flush_file();
+      }
+      else if(N_were_full!=0)
+      {
+        // Queue the flush behind the buffer writes just handed to the writer
+        // (when nothing was written there is nothing new to flush)
+        writer->submit(flush_file);
       }
     }
 
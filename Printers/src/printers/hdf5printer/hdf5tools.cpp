@@ -417,6 +417,58 @@ namespace Gambit {
           return n;
       }
 
+      /// Create a dataset creation property list for chunked (and optionally compressed) 1D datasets
+      hid_t createDatasetPropList(hsize_t chunklength, const std::string& filter, unsigned int level, bool shuffle)
+      {
+          // Registered HDF5 filter ID for LZ4 (https://portal.hdfgroup.org/display/support/Filters)
+          static const H5Z_filter_t H5Z_FILTER_LZ4 = 32004;
+
+          hid_t cparms_id = H5Pcreate(H5P_DATASET_CREATE);
+          if(cparms_id<0 or chunklength==0 or H5Pset_chunk(cparms_id, 1, &chunklength)<0)
+          {
+            std::ostringstream errmsg;
+            errmsg << "Failed to set up HDF5 dataset creation properties with chunk length "<<chunklength<<".";
+            printer_error().raise(LOCAL_INFO, errmsg.str());
+          }
+
+          herr_t status = 0;
+          if(filter=="none")
+          {
+            return cparms_id;
+          }
+          else if(filter=="gzip")
+          {
+            if(not H5Zfilter_avail(H5Z_FILTER_DEFLATE))
+            {
+              printer_error().raise(LOCAL_INFO, "HDF5 compression filter 'gzip' was requested, but this HDF5 library was built without it.");
+            }
+            if(shuffle) status = H5Pset_shuffle(cparms_id);
+            if(status>=0) status = H5Pset_deflate(cparms_id, level);
+          }
+          else if(filter=="lz4")
+          {
+            if(not H5Zfilter_avail(H5Z_FILTER_LZ4))
+            {
+              printer_error().raise(LOCAL_INFO, "HDF5 compression filter 'lz4' was requested, but the LZ4 filter plugin could not be found. Please install it (e.g. from the hdf5plugin or HDF5 filter plugin packages) and point HDF5_PLUGIN_PATH to it, or use 'gzip' instead.");
+            }
+            if(shuffle) status = H5Pset_shuffle(cparms_id);
+            if(status>=0) status = H5Pset_filter(cparms_id, H5Z_FILTER_LZ4, H5Z_FLAG_MANDATORY, 0, NULL);
+          }
+          else
+          {
+            std::ostringstream errmsg;
+            errmsg << "Unrecognised HDF5 compression filter '"<<filter<<"'! Valid choices are 'none', 'gzip' and 'lz4'.";
+            printer_error().raise(LOCAL_INFO, errmsg.str());
+          }
+          if(status<0)
+          {
+            std::ostringstream errmsg;
+            errmsg << "Failed to set up HDF5 compression filter '"<<filter<<"'. See stderr output for more details.";
+            printer_error().raise(LOCAL_INFO, errmsg.str());
+          }
+          return cparms_id;
+      }
+
       /// @}
     }
  
@@ -22,6 +22,7 @@
 #ifndef __BASE_PRIORS_HPP__
 #define __BASE_PRIORS_HPP__
 
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -43,6 +44,12 @@ namespace Gambit
         protected:
             std::vector<std::string> param_names;
 
+            /// Positions of param_names in the dense physical parameter vector (set by compileLayout)
+            std::vector<unsigned int> param_index;
+
+            /// Scratch map used by the default (string-keyed) implementation of transformDense
+            mutable std::unordered_map<std::string, double> dense_scratch;
+
         public:
             BasePrior() : param_size(0), param_names(0) {}
 
@@ -56,6 +63,30 @@ namespace Gambit
 
             virtual double operator()(const std::vector<double> &) const {return 0.0;}
 
+            /// Resolve, once, the positions of this prior's parameters in the dense physical parameter
+            /// vector.  Names not yet present in the layout are appended to it.
+            virtual void compileLayout(std::unordered_map<std::string, unsigned int> &layout)
+            {
+                param_index.clear();
+                for (auto it = param_names.begin(), end = param_names.end(); it != end; ++it)
+                {
+                    unsigned int next = layout.size();
+                    param_index.push_back(layout.emplace(*it, next).first->second);
+                }
+            }
+
+            /// Transformation from the unit hypercube directly into the dense physical parameter vector
+            /// compiled by compileLayout.  The default goes via the string-keyed transform; priors on
+            /// the hot path override it to write straight into their slots.
+            virtual void transformDense(const std::vector<double> &unitPars, double *physPars) const
+            {
+                transform(unitPars, dense_scratch);
+                for (unsigned int i = 0, end = param_index.size(); i < end; i++)
+                {
+                    physPars[param_index[i]] = dense_scratch[param_names[i]];
+                }
+            }
+
             inline unsigned int size() const {return param_size;}
 
             inline void setSize(const unsigned int size) {param_size = size;}
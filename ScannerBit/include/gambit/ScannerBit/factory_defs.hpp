@@ -114,6 +114,14 @@ namespace Gambit
             virtual ret main(const args&...) = 0;
             virtual ~Function_Base(){}
 
+            /// Dense parameter path (see like_ptr).  A function that can take its physical parameters
+            /// as a flat array overrides these: compileParameterLayout is called once with the name of
+            /// each array entry and returns true if the layout could be bound, after which setParameters
+            /// is called with the transformed parameters before each evaluation.  By default the
+            /// string-keyed map passed to main is used instead.
+            virtual bool compileParameterLayout(const std::vector<std::string> &) {return false;}
+            virtual void setParameters(const std::vector<double> &) {}
+
             ret operator () (const args&... params)
             {
                 Gambit::Scanner::Plugins::plugin_info.set_calculating(true);
@@ -305,16 +313,54 @@ namespace Gambit
             typedef scan_ptr<double (std::unordered_map<std::string, double> &)> s_ptr;
             std::unordered_map<std::string, double> map;
 
+            /// Dense physical parameter vector, laid out once by dense_layout()
+            std::vector<double> phys;
+            /// State of the dense layout: 0 = not yet compiled, 1 = in use, -1 = unsupported (use the map)
+            int layout_state;
+
+            /// Compile the dense parameter layout on first use, and say whether it can be used.
+            bool dense_layout()
+            {
+                if (layout_state == 0)
+                {
+                    Priors::BasePrior &prior = (*this)->getPrior();
+                    std::vector<std::string> names = prior.getParameters();
+                    std::unordered_map<std::string, unsigned int> layout;
+                    for (unsigned int i = 0, end = names.size(); i < end; i++)
+                    {
+                        layout.emplace(names[i], i);
+                    }
+                    prior.compileLayout(layout);
+
+                    std::vector<std::string> keys(layout.size());
+                    for (auto it = layout.begin(), end = layout.end(); it != end; ++it)
+                    {
+                        keys[it->second] = it->first;
+                    }
+                    phys.assign(keys.size(), 0.0);
+                    layout_state = (not keys.empty() and (*this)->compileParameterLayout(keys)) ? 1 : -1;
+                }
+                return layout_state > 0;
+            }
+
         public:
-            like_ptr(){}
-            like_ptr(const like_ptr &in) : s_ptr (in){}
+            like_ptr() : layout_state(0) {}
+            like_ptr(const like_ptr &in) : s_ptr (in), layout_state(0) {}
             //like_ptr(like_ptr &&in) : s_ptr (std::move(in)) {}
-            like_ptr(void *in) : s_ptr(in) {}
+            like_ptr(void *in) : s_ptr(in), layout_state(0) {}
 
             double operator()(const std::vector<double> &vec)
             {
                 int rank = (*this)->getRank();
-                (*this)->getPrior().transform(vec, map);
+                if (dense_layout())
+                {
+                    (*this)->getPrior().transformDense(vec, &phys[0]);
+                    (*this)->setParameters(phys);
+                }
+                else
+                {
+                    (*this)->getPrior().transform(vec, map);
+                }
                 double ret_val = (*this)->operator()(map);
                 unsigned long long int id = Gambit::Printers::get_point_id();
                 (*this)->getPrinter().print(ret_val, (*this)->getPurpose(), rank, id);
@@ -340,6 +386,26 @@ namespace Gambit
                 // Return the value of the function, offset by any offset set
                 return ret_val + (*this)->getPurposeOffset();
             }
+
+            /// Evaluate a batch of points, one unit-cube vector per point, and return their
+            /// log-likelihoods in the same order.  Points are evaluated one after the other,
+            /// exactly as if operator() had been called on each in turn, so point IDs and
+            /// printer output are unchanged; plugins that generate whole populations should
+            /// call this so that the evaluation strategy can be changed in one place.  If an
+            /// early shutdown is triggered part way through, the remaining points are skipped
+            /// and fewer values than points are returned.
+            std::vector<double> operator()(const std::vector<std::vector<double>> &vecs)
+            {
+                std::vector<double> ret_vals;
+                ret_vals.reserve(vecs.size());
+                for (auto it = vecs.begin(), end = vecs.end(); it != end; ++it)
+                {
+                    ret_vals.push_back((*this)(*it));
+                    if (Gambit::Scanner::Plugins::plugin_info.early_shutdown_in_progress())
+                        break;
+                }
+                return ret_vals;
+            }
         };
 
         /// Pure Base class of a plugin Factory function.
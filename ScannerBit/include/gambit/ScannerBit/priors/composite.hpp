@@ -50,6 +50,8 @@ namespace Gambit
             // References to component prior objects
             std::vector<BasePrior*> my_subpriors;
             std::vector<std::string> shown_param_names;
+            // Scratch unit-cube slice handed to each component prior by transformDense
+            mutable std::vector<double> unitSlice;
                 
         public:
         
@@ -72,6 +74,29 @@ namespace Gambit
                     (*it)->transform(subUnit, outputMap);
                 }
             }
+
+            // Resolve the dense layout of this prior and all of its components
+            void compileLayout(std::unordered_map<std::string, unsigned int> &layout)
+            {
+                BasePrior::compileLayout(layout);
+                for (auto it = my_subpriors.begin(), end = my_subpriors.end(); it != end; it++)
+                {
+                    (*it)->compileLayout(layout);
+                }
+            }
+
+            // Transformation from unit hypercube straight into the dense parameter vector
+            void transformDense(const std::vector<double> &unitPars, double *physPars) const
+            {
+                std::vector<double>::const_iterator unit_it = unitPars.begin(), unit_next;
+                for (auto it = my_subpriors.begin(), end = my_subpriors.end(); it != end; it++)
+                {
+                    unit_next = unit_it + (*it)->size();
+                    unitSlice.assign(unit_it, unit_next);
+                    unit_it = unit_next;
+                    (*it)->transformDense(unitSlice, physPars);
+                }
+            }
             
             //~CompositePrior() noexcept
             ~CompositePrior()
@@ -84,6 +84,16 @@ namespace Gambit
 
                 iter = (iter + 1)%value.size();
             }
+
+            void transformDense(const std::vector<double> &, double *output) const
+            {
+                for (auto it = param_index.begin(), end = param_index.end(); it != end; it++)
+                {
+                    output[*it] = value[iter];
+                }
+
+                iter = (iter + 1)%value.size();
+            }
         };
 
         //if the parameter shares multiple different parameters
@@ -91,6 +101,7 @@ namespace Gambit
         {
         private:
             std::string name;
+            unsigned int name_index;
             std::vector<double> scale, shift;
 
         public:
@@ -153,6 +164,23 @@ namespace Gambit
                     outputMap[*it] = (*it1)*value + *it2;
                 }
             }
+
+            void compileLayout(std::unordered_map<std::string, unsigned int> &layout)
+            {
+                BasePrior::compileLayout(layout);
+                unsigned int next = layout.size();
+                name_index = layout.emplace(name, next).first->second;
+            }
+
+            void transformDense(const std::vector<double> &, double *output) const
+            {
+                double value = output[name_index];
+
+                for (unsigned int i = 0, end = std::min(param_index.size(), scale.size()); i < end; i++)
+                {
+                    output[param_index[i]] = scale[i]*value + shift[i];
+                }
+            }
         };
 
         LOAD_PRIOR(fixed_value, FixedPrior)
@@ -211,6 +211,11 @@ namespace Gambit
                 output[myparameter] = (T::inv(unitpars[0]*(upper-lower) + lower)-shift_out)/scale_out;
             }
 
+            void transformDense(const std::vector<double> &unitpars, double *output) const
+            {
+                output[param_index[0]] = (T::inv(unitpars[0]*(upper-lower) + lower)-shift_out)/scale_out;
+            }
+
             double operator()(const std::vector<double> &vec) const {return T::prior(vec[0]*scale+shift)*scale;}
         };
 
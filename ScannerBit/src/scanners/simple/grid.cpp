@@ -19,6 +19,7 @@
 #endif
 
 #include <vector>
+#include <algorithm>
 #include <string>
 #include <cmath>
 #include <iostream>
@@ -62,10 +63,13 @@ scanner_plugin(grid, version(1, 0, 0))
 
         like_ptr LogLike;
         LogLike = get_purpose(get_inifile_value<std::string>("like"));
-        std::vector<double> vec(ma, 0.0);
+        unsigned int batch = std::max(get_inifile_value<int>("batch_size", 1), 1);
+        std::vector<std::vector<double>> pts;
+        pts.reserve(batch);
 
         for (int i = rank, end = NTot; i < end; i+=numtasks)
         {
+            std::vector<double> vec(ma, 0.0);
             int n = i;
             for (int j = 0; j < ma; j++)
             {
@@ -77,7 +81,13 @@ scanner_plugin(grid, version(1, 0, 0))
                 n /= N[j];
             }
 
-            LogLike(vec);
+            pts.push_back(std::move(vec));
+            if (pts.size() == batch or i + numtasks >= end)
+            {
+                if (LogLike(pts).size() < pts.size())
+                    break;
+                pts.clear();
+            }
         }
 
         return 0;
@@ -19,6 +19,7 @@
 #endif
 
 #include <vector>
+#include <algorithm>
 #include <string>
 #include <iostream>
 
@@ -28,13 +29,14 @@
 scanner_plugin(random, version(1, 0, 0))
 {
     like_ptr LogLike;
-    int num, dim, numtasks, rank;
+    int num, dim, numtasks, rank, batch;
     
     plugin_constructor
     {
         LogLike = get_purpose(get_inifile_value<std::string>("like"));
         num = get_inifile_value<int>("point_number", 10);
         dim = get_dimension();
+        batch = std::max(get_inifile_value<int>("batch_size", 1), 1);
         
 #ifdef WITH_MPI
         MPI_Comm_size(MPI_COMM_WORLD, &numtasks);
@@ -47,19 +49,24 @@ scanner_plugin(random, version(1, 0, 0))
     
     int plugin_main ()
     {
-        std::vector<double> a(dim);
+        std::vector<std::vector<double>> pts;
 
         std::cout << "Entering random sampler." << "\n\tnumber of points to calculate:  " << num << std::endl;
         
-        for (int k = 0; k < num; k++)
+        for (int k = 0; k < num; k += batch)
         {
-            for (int i = rank; i < dim; i+=numtasks)
+            pts.assign(std::min(batch, num - k), std::vector<double>(dim));
+            for (auto &a : pts)
             {
-                a[i] = Gambit::Random::draw();
+                for (int i = rank; i < dim; i+=numtasks)
+                {
+                    a[i] = Gambit::Random::draw();
+                }
             }
-            LogLike(a);
+            if (LogLike(pts).size() < pts.size())
+                break;
             
-            if (k%1000 == 0)
+            if (k/1000 != (k + int(pts.size()) - 1)/1000 or k%1000 == 0)
                 std::cout << "points:  " << k << " / " << num << std::endl;
         }
         
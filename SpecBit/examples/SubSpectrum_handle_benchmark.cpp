@@ -0,0 +1,56 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Benchmark of SubSpectrum parameter access.
+///  Reads an MSSM spectrum from an SLHA2 file
+///  into an MSSMSimpleSpec (the SLHAea-backed
+///  spectrum wrapper), then runs
+///  BenchmarkMssmParHandles on it, timing
+///  retrieval of the MSSM parameters by string
+///  name against retrieval through resolved
+///  handles (SpecParHandle), and checking that
+///  both give the same values.  Off-diagonal
+///  Yukawa couplings that SLHA2 allows a file to
+///  omit are filled in as zero first.
+///
+///  Usage: SubSpectrum_handle_benchmark [slha file] [repetitions]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author The GAMBIT Collaboration
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <iostream>
+
+#include "gambit/Elements/slhaea_helpers.hpp"
+#include "gambit/Models/SimpleSpectra/MSSMSimpleSpec.hpp"
+#include "gambit/SpecBit/SpecBit_externaltests.hpp"
+#include "gambit/cmake/cmake_variables.hpp"
+
+using namespace Gambit;
+
+int main(int argc, char* argv[])
+{
+  const str filename = (argc > 1 ? argv[1] : GAMBIT_DIR "/DarkBit/data/benchmarks/stau_coannihilation.slha2");
+  const int nrep = (argc > 2 ? std::stoi(argv[2]) : 10000);
+
+  SLHAstruct slha = read_SLHA(filename);
+  for (const str block : {"YU", "YD", "YE"})
+  {
+    for (int i = 1; i <= 3; i++) for (int j = 1; j <= 3; j++) SLHAea_add(slha, block, i, j, 0., "");
+  }
+  const MSSMSimpleSpec mssm(slha);
+  std::cout << filename << std::endl;
+
+  if (not SpecBit::BenchmarkMssmParHandles(mssm, nrep))
+  {
+    std::cout << "Handle and string lookups gave different values." << std::endl;
+    return 1;
+  }
+  return 0;
+}
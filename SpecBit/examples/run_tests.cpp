@@ -39,6 +39,10 @@ int main(int argc, char* argv[])
       //return 1;
    }
    else std::cout << "TestMssmPoleGets passed."  << std::endl;
+   if(BenchmarkMssmParHandles(mssm)==false){
+      std::cout << "BenchmarkMssmParHandles fail." << std::endl;
+   }
+   else std::cout << "BenchmarkMssmParHandles passed."  << std::endl;
    //So now we have a mssm1 model object filled, as it will be
    //stored in Gambit after the spectrum generator has run
    // mssm.mass2_par_mapping(); //call mapping - this needs to be changed.
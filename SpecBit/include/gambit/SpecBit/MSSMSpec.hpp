@@ -80,6 +80,13 @@ namespace Gambit
       // Fill an SLHAea object with spectrum information
       template <class MI>
       void MSSMSpec<MI>::add_to_SLHAea(int slha_version, SLHAstruct& slha) const
+      {
+         add_to_SLHAea_from(slha_version, slha, *this);
+      }
+
+      // Fill an SLHAea object with spectrum information, taking the values from a SubSpectrum wrapping this one
+      template <class MI>
+      void MSSMSpec<MI>::add_to_SLHAea_from(int slha_version, SLHAstruct& slha, const SubSpectrum& values) const
       {
          std::ostringstream comment;
 
@@ -95,7 +102,7 @@ namespace Gambit
          }
  
          // All other MSSM blocks
-         slhahelp::add_MSSM_spectrum_to_SLHAea(*this, slha, slha_version);
+         slhahelp::add_MSSM_spectrum_to_SLHAea(values, slha, slha_version);
       }
 
       //inspired by softsusy's lsp method.
@@ -112,6 +112,7 @@ namespace Gambit
 
             // Fill an SLHAea object with spectrum information
             virtual void add_to_SLHAea(int slha_version, SLHAstruct& slha) const;
+            virtual void add_to_SLHAea_from(int slha_version, SLHAstruct& slha, const SubSpectrum& values) const;
 
             /// TODO: Need to implement this properly...
             /// Copy low energy spectrum information from another model object
@@ -78,6 +78,7 @@ namespace Gambit
 
             /// Add QEDQCD information to an SLHAea object
             virtual void add_to_SLHAea(int, SLHAstruct& slha) const;
+            virtual void add_to_SLHAea_from(int, SLHAstruct& slha, const SubSpectrum& values) const;
 
             /// RunningPars interface overrides
             virtual double GetScale() const;      /***/
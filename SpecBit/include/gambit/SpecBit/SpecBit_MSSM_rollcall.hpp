@@ -121,6 +121,16 @@
     #undef FUNCTION
   #undef CAPABILITY
 
+  #define CAPABILITY MSSM_SLHA2_blocks
+  START_CAPABILITY
+    // ==============================
+    // Convert an MSSM_spectrum into numerical SLHA2 blocks, once per point, for modules and backends that read SLHA
+    #define FUNCTION get_MSSM_spectrum_as_SLHAblocks
+    START_FUNCTION(SLHAblocks)
+    DEPENDENCY(MSSM_spectrum, Spectrum)
+    #undef FUNCTION
+  #undef CAPABILITY
+
   #define CAPABILITY unimproved_MSSM_spectrum
    // Same as above, but works with unimproved version of spectrum
     #define FUNCTION get_unimproved_MSSM_spectrum_as_map
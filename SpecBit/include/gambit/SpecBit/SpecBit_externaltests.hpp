@@ -24,6 +24,8 @@
 #ifndef __SpecBit_tests_hpp__
 #define __SpecBit_tests_hpp__
 
+#include <chrono>
+
 #include "gambit/SpecBit/MSSMSpec.hpp"
 #include "gambit/SpecBit/model_files_and_boxes.hpp"
 
@@ -819,6 +821,98 @@ namespace Gambit
 
     }
 
+    /// Micro-benchmark of the MSSM spectrum accessors, comparing retrieval by
+    /// string name with retrieval through handles (SpecParHandle).  Returns
+    /// false if the two give different values.
+    inline bool BenchmarkMssmParHandles(const SubSpectrum& spec, const int nrep = 1000)
+    {
+       struct Par1
+       {
+          Par::Tags tag; std::string name; int nindices; int imax;
+          Par1(Par::Tags t, std::string n, int ni, int im) : tag(t), name(n), nindices(ni), imax(im) {}
+       };
+       std::vector<Par1> pars;
+       pars.push_back(Par1(Par::mass2,         "mHu2",  0, 0));
+       pars.push_back(Par1(Par::mass2,         "mq2",   2, 3));
+       pars.push_back(Par1(Par::mass1,         "Mu",    0, 0));
+       pars.push_back(Par1(Par::mass1,         "TYu",   2, 3));
+       pars.push_back(Par1(Par::dimensionless, "Yu",    2, 3));
+       pars.push_back(Par1(Par::Pole_Mass,     "~g",    0, 0));
+       pars.push_back(Par1(Par::Pole_Mass,     "~u",    1, 6));
+       pars.push_back(Par1(Par::Pole_Mass,     "~d",    1, 6));
+       pars.push_back(Par1(Par::Pole_Mass,     "~chi0", 1, 4));
+       pars.push_back(Par1(Par::Pole_Mass,     "~chi-", 1, 2)); // via antiparticle
+       pars.push_back(Par1(Par::Pole_Mass,     "h0",    1, 2));
+       pars.push_back(Par1(Par::Pole_Mass,     "H+",    0, 0));
+       pars.push_back(Par1(Par::Pole_Mixing,   "~u",    2, 6));
+
+       // Expand into the full list of (parameter, indices) and get handles for them
+       typedef std::vector<std::pair<const Par1*,std::pair<int,int>>> CallList;
+       CallList calls;
+       std::vector<SpecParHandle> handles;
+       for(std::vector<Par1>::const_iterator it = pars.begin(); it != pars.end(); ++it)
+       {
+          for(int i = 1; i <= std::max(it->imax,1); i++)
+          for(int j = 1; j <= (it->nindices==2 ? it->imax : 1); j++)
+          {
+             calls.push_back(std::make_pair(&*it, std::make_pair(i,j)));
+             switch(it->nindices)
+             {
+                case 0: handles.push_back(spec.get_handle(it->tag, it->name)); break;
+                case 1: handles.push_back(spec.get_handle(it->tag, it->name, i)); break;
+                case 2: handles.push_back(spec.get_handle(it->tag, it->name, i, j)); break;
+             }
+          }
+       }
+
+       double sum_string = 0, sum_handle = 0;
+       bool pass = true;
+       auto t0 = std::chrono::steady_clock::now();
+       for(int n = 0; n < nrep; n++)
+       {
+          for(CallList::const_iterator it = calls.begin(); it != calls.end(); ++it)
+          {
+             const Par1& p = *it->first;
+             switch(p.nindices)
+             {
+                case 0: sum_string += spec.get(p.tag, p.name); break;
+                case 1: sum_string += spec.get(p.tag, p.name, it->second.first); break;
+                case 2: sum_string += spec.get(p.tag, p.name, it->second.first, it->second.second); break;
+             }
+          }
+       }
+       auto t1 = std::chrono::steady_clock::now();
+       for(int n = 0; n < nrep; n++)
+       {
+          for(std::vector<SpecParHandle>::const_iterator it = handles.begin(); it != handles.end(); ++it)
+             sum_handle += spec.get(*it);
+       }
+       auto t2 = std::chrono::steady_clock::now();
+
+       for(size_t k = 0; k < calls.size(); k++)
+       {
+          const Par1& p = *calls[k].first;
+          double expected = 0;
+          switch(p.nindices)
+          {
+             case 0: expected = spec.get(p.tag, p.name); break;
+             case 1: expected = spec.get(p.tag, p.name, calls[k].second.first); break;
+             case 2: expected = spec.get(p.tag, p.name, calls[k].second.first, calls[k].second.second); break;
+          }
+          if(spec.get(handles[k]) != expected)
+          {
+             pass = print_error(false, "get(handle)", p.name, spec.get(handles[k]), expected, calls[k].second.first, calls[k].second.second);
+          }
+       }
+
+       const double ncalls = double(nrep) * calls.size();
+       OUTPUT << "SubSpectrum accessor benchmark (" << calls.size() << " parameters, " << nrep << " repetitions):" << std::endl;
+       OUTPUT << "  string lookup: " << std::chrono::duration<double,std::nano>(t1-t0).count()/ncalls << " ns per call" << std::endl;
+       OUTPUT << "  handle:        " << std::chrono::duration<double,std::nano>(t2-t1).count()/ncalls << " ns per call" << std::endl;
+       OUTPUT << "  (checksums " << sum_string << ", " << sum_handle << ")" << std::endl;
+       return pass;
+    }
+
     template <class Model>
     void setup(Model& mssm)
     {
@@ -78,7 +78,13 @@ namespace Gambit
       ///     @}
 
       /// Add QED x QCD information to an SLHAea object
-      void QedQcdWrapper::add_to_SLHAea(int, SLHAstruct& slha) const
+      void QedQcdWrapper::add_to_SLHAea(int slha_version, SLHAstruct& slha) const
+      {
+        add_to_SLHAea_from(slha_version, slha, *this);
+      }
+
+      /// Add QED x QCD information to an SLHAea object, taking the values from a SubSpectrum wrapping this one
+      void QedQcdWrapper::add_to_SLHAea_from(int, SLHAstruct& slha, const SubSpectrum& values) const
       {
         // Here we assume that all SMINPUTS defined in SLHA2 are provided by the
         // SMINPUTS object, so we don't bother repeating them here.  We also assume
@@ -87,7 +93,7 @@ namespace Gambit
         // if we're helping make an SLHA1 or SLHA2 file.
 
         // Add the b pole mass
-        SLHAea_add_from_subspec(slha, LOCAL_INFO, *this, Par::Pole_Mass,"d_3","MASS",5,"# mb (pole)");
+        SLHAea_add_from_subspec(slha, LOCAL_INFO, values, Par::Pole_Mass,"d_3","MASS",5,"# mb (pole)");
       }
 
       /// Run masses and couplings to end_scale
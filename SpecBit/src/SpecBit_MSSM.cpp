@@ -546,6 +546,23 @@ namespace Gambit
       result = Pipes::get_MSSM_spectrum_as_SLHAea_SLHA2::Dep::unimproved_MSSM_spectrum->getSLHAea(2);
     }
 
+    /// Convert the spectrum contained in a Spectrum object into numerical SLHA2 blocks
+    void get_MSSM_spectrum_as_SLHAblocks(SLHAblocks &result)
+    {
+      SLHAstruct slha = Pipes::get_MSSM_spectrum_as_SLHAblocks::Dep::MSSM_spectrum->getSLHAea(2);
+      // Add the MODSEL block at the front if it is not provided by the spectrum object.
+      if (slha.find("MODSEL") == slha.end())
+      {
+        SLHAea::Block block("MODSEL");
+        block.push_back("BLOCK MODSEL              # Model selection");
+        SLHAea::Line line;
+        line << 1 << 0 << "# General MSSM";
+        block.push_back(line);
+        slha.push_front(block);
+      }
+      result = SLHAblocks(std::move(slha));
+    }
+
     /// Get an MSSMSpectrum object from an SLHA file
     /// Wraps it up in MSSMSimpleSpec; i.e. no RGE running possible.
     /// This is mainly for testing against benchmark points, but may be a useful last
@@ -0,0 +1,143 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Benchmark of the per-thread result slots and
+///  flags of nested module functors.  Mimics an
+///  OpenMP loop manager (e.g. the ColliderBit
+///  event loop or the DarkBit cascade loop):
+///  every thread resets, recalculates and reads
+///  back a chain of nested functors in each
+///  iteration, each functor writing its result
+///  into the slot of the thread and reading its
+///  dependency through a safe_ptr.  Times the
+///  slots packed into plain arrays, as
+///  module_functor kept them before, against
+///  the slots padded to whole cache lines with
+///  Utils::cache_padded, as it keeps them now.
+///
+///  Usage: functor_slot_benchmark [iterations] [threads] [nested functors]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  \author The GAMBIT Collaboration
+///  \date 2026 Oct
+///
+///  *********************************************
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "gambit/Utils/cache_aligned.hpp"
+#include "gambit/Utils/util_types.hpp"
+
+using namespace Gambit;
+
+/// Per-thread storage of a nested functor, packed into plain arrays
+struct packed_slots
+{
+  double* value;
+  bool* needs_recalculating;
+  long long* iteration;
+  packed_slots(int n) : value(new double[n]()), needs_recalculating(new bool[n]()), iteration(new long long[n]()) {}
+  ~packed_slots() { delete [] value; delete [] needs_recalculating; delete [] iteration; }
+  double& result(int t) { return value[t]; }
+  bool& flag(int t) { return needs_recalculating[t]; }
+  long long& counter(int t) { return iteration[t]; }
+  safe_ptr<double> valuePtr() { return safe_ptr<double>(value); }
+};
+
+/// Per-thread storage of a nested functor, with the slot of each thread padded to whole cache lines
+struct padded_slots
+{
+  struct alignas(GAMBIT_CACHE_LINE_SIZE) thread_state { bool needs_recalculating = false; };
+  Utils::cache_padded<double>* value;
+  thread_state* states;
+  Utils::cache_padded<long long>* iteration;
+  int n;
+  padded_slots(int n_in)
+   : value(Utils::new_cache_aligned<Utils::cache_padded<double> >(n_in)),
+     states(Utils::new_cache_aligned<thread_state>(n_in)),
+     iteration(Utils::new_cache_aligned<Utils::cache_padded<long long> >(n_in)),
+     n(n_in)
+  {}
+  ~padded_slots()
+  {
+    Utils::delete_cache_aligned(value, n);
+    Utils::delete_cache_aligned(states, n);
+    Utils::delete_cache_aligned(iteration, n);
+  }
+  double& result(int t) { return value[t].value; }
+  bool& flag(int t) { return states[t].needs_recalculating; }
+  long long& counter(int t) { return iteration[t].value; }
+  safe_ptr<double> valuePtr() { return safe_ptr<double>(&value[0].value, sizeof(value[0])); }
+};
+
+/// Run the loop with the given slot layout; returns the time per iteration in nanoseconds
+template <typename SLOTS>
+double time_loop(long long niterations, int nthreads, int nfunctors, double& checksum)
+{
+  std::vector<std::unique_ptr<SLOTS> > functors;
+  std::vector<safe_ptr<double> > ptrs;
+  for (int k = 0; k < nfunctors; ++k)
+  {
+    functors.emplace_back(new SLOTS(nthreads));
+    ptrs.push_back(functors.back()->valuePtr());
+  }
+
+  double sum = 0;
+  const auto start = std::chrono::steady_clock::now();
+  #pragma omp parallel num_threads(nthreads) reduction(+:sum)
+  {
+    const int t = omp_get_thread_num();
+    #pragma omp for schedule(static)
+    for (long long i = 0; i < niterations; ++i)
+    {
+      // Reset the nested functors, as the loop manager does at the start of each iteration
+      for (int k = 0; k < nfunctors; ++k)
+      {
+        functors[k]->counter(t) = i;
+        functors[k]->flag(t) = true;
+      }
+      // Calculate each functor in turn, reading the result of the one before through its safe_ptr
+      for (int k = 0; k < nfunctors; ++k)
+      {
+        SLOTS& f = *functors[k];
+        if (f.flag(t))
+        {
+          f.result(t) = (k == 0 ? 1.0 : 0.5*ptrs[k-1][t]) + f.counter(t)%2;
+          f.flag(t) = false;
+        }
+      }
+      sum += ptrs.back()[t];
+    }
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  checksum = sum;
+  return std::chrono::duration<double, std::nano>(stop - start).count() / niterations;
+}
+
+int main(int argc, char* argv[])
+{
+  const long long niterations = (argc > 1 ? std::stoll(argv[1]) : 10000000);
+  const int nthreads = (argc > 2 ? std::stoi(argv[2]) : omp_get_max_threads());
+  const int nfunctors = (argc > 3 ? std::stoi(argv[3]) : 5);
+
+  std::cout << niterations << " iterations, " << nthreads << " threads, " << nfunctors << " nested functors" << std::endl;
+  double packed_sum, padded_sum;
+  const double packed = time_loop<packed_slots>(niterations, nthreads, nfunctors, packed_sum);
+  const double padded = time_loop<padded_slots>(niterations, nthreads, nfunctors, padded_sum);
+
+  std::cout << "  packed slots: " << packed << " ns per iteration" << std::endl;
+  std::cout << "  padded slots: " << padded << " ns per iteration" << std::endl;
+  if (packed_sum != padded_sum)
+  {
+    std::cout << "The two layouts gave different results." << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,102 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Benchmark of run-option lookups, with and
+///  without the Options cache.  Reads the
+///  options blocks from the ObsLikes and Rules
+///  sections of a GAMBIT yaml file, and times the
+///  lookups that module functions would make at
+///  each point of a scan.
+///
+///  Usage: options_benchmark [yaml file] [points]
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+#include "gambit/Utils/yaml_options.hpp"
+
+using namespace Gambit;
+
+typedef std::function<void(const Options&)> Lookup;
+
+/// Add the lookup that a module function would use for one entry of an options block
+void add_lookup(const str& key, const YAML::Node& value, std::vector<Lookup>& lookups)
+{
+  double d;
+  bool b;
+  if (value.IsScalar() and YAML::convert<double>::decode(value, d))
+    lookups.push_back([key](const Options& o) { o.getValueOrDef<double>(0., key); });
+  else if (value.IsScalar() and YAML::convert<bool>::decode(value, b))
+    lookups.push_back([key](const Options& o) { o.getValueOrDef<bool>(false, key); });
+  else if (value.IsScalar())
+    lookups.push_back([key](const Options& o) { o.getValueOrDef<str>("", key); });
+  else if (value.IsSequence() and value.size() > 0 and value[0].IsSequence())
+    lookups.push_back([key](const Options& o) { o.getValueOrDef<std::vector<std::vector<str> > >(std::vector<std::vector<str> >(), key); });
+  else if (value.IsSequence())
+    lookups.push_back([key](const Options& o) { o.getValueOrDef<std::vector<str> >(std::vector<str>(), key); });
+  else
+    lookups.push_back([key](const Options& o) { o.hasKey(key); });
+}
+
+/// Collect the options blocks of all entries of a yaml section
+void collect(const YAML::Node& section, std::vector<Options>& blocks, std::vector<std::vector<Lookup> >& lookups)
+{
+  for (YAML::const_iterator it = section.begin(); it != section.end(); ++it)
+  {
+    const YAML::Node options = (*it)["options"];
+    if (not options or not options.IsMap()) continue;
+    blocks.push_back(Options(options));
+    lookups.push_back(std::vector<Lookup>());
+    for (YAML::const_iterator jt = options.begin(); jt != options.end(); ++jt)
+      add_lookup(jt->first.as<str>(), jt->second, lookups.back());
+    // Most options that module functions ask for are not set in the yaml file, and fall back to their defaults
+    for (int i = 0; i < 5; ++i)
+    {
+      const str key = "unset_option_" + std::to_string(i);
+      lookups.back().push_back([key](const Options& o) { o.getValueOrDef<double>(1., key); });
+    }
+  }
+}
+
+/// Time all lookups for the given number of points; returns the time per point in microseconds
+double time_points(const std::vector<Options>& blocks, const std::vector<std::vector<Lookup> >& lookups, int npoints)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int n = 0; n < npoints; ++n)
+    for (size_t i = 0; i < blocks.size(); ++i)
+      for (auto it = lookups[i].begin(); it != lookups[i].end(); ++it) (*it)(blocks[i]);
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(stop - start).count() / npoints;
+}
+
+int main(int argc, char* argv[])
+{
+  const str filename = (argc > 1 ? argv[1] : "yaml_files/MSSM7.yaml");
+  const int npoints = (argc > 2 ? std::stoi(argv[2]) : 10000);
+
+  const YAML::Node root = YAML::LoadFile(filename);
+  std::vector<Options> blocks;
+  std::vector<std::vector<Lookup> > lookups;
+  collect(root["ObsLikes"], blocks, lookups);
+  collect(root["Rules"], blocks, lookups);
+
+  size_t nlookups = 0;
+  for (auto it = lookups.begin(); it != lookups.end(); ++it) nlookups += it->size();
+  std::cout << filename << ": " << blocks.size() << " options blocks, " << nlookups << " lookups per point" << std::endl;
+
+  const double uncached = time_points(blocks, lookups, npoints);
+  for (auto it = blocks.begin(); it != blocks.end(); ++it) it->freeze();
+  const double cached = time_points(blocks, lookups, npoints);
+
+  std::cout << "  uncached: " << uncached << " us per point (" << 1e3*uncached/nlookups << " ns per lookup)" << std::endl;
+  std::cout << "  frozen:   " << cached << " us per point (" << 1e3*cached/nlookups << " ns per lookup)" << std::endl;
+  return 0;
+}
@@ -0,0 +1,79 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Allocation of arrays that start on a cache
+///  line boundary, for per-thread storage that
+///  is written to from inside OpenMP loops.
+///  Types used here should be padded to a
+///  multiple of GAMBIT_CACHE_LINE_SIZE (e.g. with
+///  alignas) so that no two elements share a
+///  cache line.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#ifndef __cache_aligned_hpp__
+#define __cache_aligned_hpp__
+
+#include <new>
+#include <cstddef>
+#include <cstdlib>
+
+/// Size in bytes of a cache line (assumed, as for most x86 and ARM CPUs)
+#define GAMBIT_CACHE_LINE_SIZE 64
+
+namespace Gambit
+{
+
+  namespace Utils
+  {
+
+    /// Wrapper that pads a value out to a whole number of cache lines, so that neighbouring
+    /// elements of an array of these never share a line.
+    template <typename T>
+    struct alignas(alignof(T) > GAMBIT_CACHE_LINE_SIZE ? alignof(T) : GAMBIT_CACHE_LINE_SIZE) cache_padded
+    {
+      T value;
+    };
+
+    /// Allocate and default-construct an array of n objects starting on a cache line boundary.
+    /// Must be freed with delete_cache_aligned.
+    template <typename T>
+    T* new_cache_aligned(std::size_t n)
+    {
+      void* mem = NULL;
+      std::size_t align = (alignof(T) > GAMBIT_CACHE_LINE_SIZE ? alignof(T) : GAMBIT_CACHE_LINE_SIZE);
+      if (posix_memalign(&mem, align, n*sizeof(T)+(n==0)) != 0) throw std::bad_alloc();
+      T* array = static_cast<T*>(mem);
+      std::size_t i = 0;
+      try
+      {
+        for (; i < n; ++i) new (array+i) T();
+      }
+      catch (...)
+      {
+        while (i > 0) array[--i].~T();
+        free(mem);
+        throw;
+      }
+      return array;
+    }
+
+    /// Destroy and free an array of n objects allocated with new_cache_aligned.
+    template <typename T>
+    void delete_cache_aligned(T* array, std::size_t n)
+    {
+      if (array == NULL) return;
+      while (n > 0) array[--n].~T();
+      free(array);
+    }
+
+  }
+
+}
+
+#endif //#ifndef __cache_aligned_hpp__
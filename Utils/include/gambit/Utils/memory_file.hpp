@@ -0,0 +1,73 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Scratch files for handing text (e.g. an SLHA
+///  spectrum) to backends that will only read
+///  from a named file.  Where the platform
+///  allows it (Linux memfd), the file lives in
+///  memory and never touches the filesystem;
+///  otherwise it is written to disk under the
+///  given name.
+///
+///  Usage:
+///
+///   {
+///     Utils::MemoryFile slha("myfile.slha", contents);
+///     backend_reader(slha.get_filename());
+///   }
+///   /* The file disappears when 'slha' is destructed */
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#ifndef __memory_file_hpp__
+#define __memory_file_hpp__
+
+#include <string>
+
+namespace Gambit
+{
+   namespace Utils
+   {
+
+      /// Class to manage a (preferably memory-backed) scratch file.
+      /// The file is closed, and deleted if on disk, when this object is destructed.
+      class MemoryFile
+      {
+        private:
+          /// Name under which the contents can be opened
+          std::string my_fname;
+
+          /// C file descriptor for the file
+          int fd;
+
+          /// Bool to indicate that the file lives in memory rather than on disk
+          bool in_mem;
+
+          /// Not copyable
+          MemoryFile(const MemoryFile&);
+          MemoryFile& operator=(const MemoryFile&);
+
+        public:
+          /// Constructor. Creates the file and fills it with contents.
+          /// The name labels the memory file, or is the file name if it has to go to disk.
+          MemoryFile(const std::string& name, const std::string& contents);
+
+          /// Destructor
+          ~MemoryFile();
+
+          /// Getter for the name to open the file with
+          const std::string& get_filename() const;
+
+          /// Check whether the file lives in memory
+          bool in_memory() const;
+
+      }; // end class MemoryFile
+   }
+}
+
+#endif
@@ -88,6 +88,10 @@ namespace Gambit {
 
       /// Set single parameter value
       void setValue(std::string const &inkey,double const&value);
+
+      /// Get a pointer to the stored value of a named parameter, for repeated fast setting by index
+      /// (e.g. by the likelihood container). Remains valid as long as no parameters are (re)defined.
+      double* getValuePtr(std::string const &inkey);
   
       /// Set many parameter values using a map
       void setValues(std::map<std::string,double> const &params_map, bool missing_is_error = true);
@@ -184,6 +184,13 @@ namespace Gambit
     /// From: http://stackoverflow.com/a/2845275/1447953
     bool isInteger(const std::string&);
 
+    /// Get the OpenMP nesting level as seen from module functions, i.e. not counting any
+    /// parallel region opened by the Core to calculate several functors at once.
+    int omp_module_level();
+
+    /// Set the OpenMP nesting level at which the Core is calculating several functors at once (0 = none).
+    void set_omp_module_base_level(int);
+
   }
 
 }
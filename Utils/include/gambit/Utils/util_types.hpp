@@ -150,10 +150,12 @@ namespace Gambit
     public:
 
       /// Construct-o-safe_ptr
-      safe_ptr(TYPE* in_ptr = NULL) { ptr = in_ptr; }
+      /// If the array elements pointed to are spaced out (e.g. padded to cache lines), give the
+      /// distance in bytes between the starts of successive elements as the stride.
+      safe_ptr(TYPE* in_ptr = NULL, std::size_t in_stride = sizeof(TYPE)) { ptr = in_ptr; stride = in_stride; }
 
       /// Set pointer
-      virtual void set(TYPE* in_ptr) { ptr = in_ptr; }
+      virtual void set(TYPE* in_ptr) { ptr = in_ptr; stride = sizeof(TYPE); }
 
       /// Dereference pointer
       virtual const TYPE& operator*() const
@@ -166,7 +168,7 @@ namespace Gambit
       virtual const TYPE& operator[](int index) const
       {
         if (ptr == NULL) dieGracefully();
-        return *(ptr+index);
+        return element(index);
       }
 
       /// Access is allowed to const member functions only
@@ -181,6 +183,15 @@ namespace Gambit
       /// The actual underlying pointer, interpreted as a pointer to constant value
       const TYPE* ptr;
 
+      /// Distance in bytes between successive elements of the array pointed to
+      std::size_t stride;
+
+      /// Get an element of the array pointed to, taking the stride into account
+      const TYPE& element(int index) const
+      {
+        return *reinterpret_cast<const TYPE*>(reinterpret_cast<const char*>(ptr) + index*stride);
+      }
+
       /// Failure message invoked when the user tries to dereference a null safe_ptr
       static void dieGracefully()
       {
@@ -205,13 +216,13 @@ namespace Gambit
     public:
 
       /// Constructor
-      omp_safe_ptr(TYPE* in_ptr = NULL) : safe_ptr<TYPE>(in_ptr) {}
+      omp_safe_ptr(TYPE* in_ptr = NULL, std::size_t in_stride = sizeof(TYPE)) : safe_ptr<TYPE>(in_ptr, in_stride) {}
 
       /// Dereference pointer
       virtual const TYPE& operator*() const
       {
         if (this->ptr == NULL) safe_ptr<TYPE>::dieGracefully();
-        return *(this->ptr+omp_get_thread_num());
+        return this->element(omp_get_thread_num());
       }
 
   };
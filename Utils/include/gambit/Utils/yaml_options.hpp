@@ -32,6 +32,11 @@
 #include <vector>
 #include <sstream>
 #include <utility>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstring>
+#include <typeinfo>
 
 #include "gambit/Utils/util_types.hpp"
 #include "gambit/Utils/standalone_error_handlers.hpp"
@@ -57,17 +62,69 @@ namespace Gambit
       /// Move constructor
       Options(YAML::Node &&options) : options(std::move(options)) {}
 
+      /// Copying an Options object copies the options, but not the cache; the copy is not frozen.
+      /// YAML nodes are handles to shared data, so the options are cloned, so that setValue
+      /// on the copy cannot change the options (or invalidate the cache) of the original.
+      /// @{
+      Options(const Options &other) : options(clone(other.options)) {}
+      Options& operator=(const Options &other)
+      {
+        if (this != &other)
+        {
+          options = clone(other.options);
+          cache.reset();
+        }
+        return *this;
+      }
+      /// @}
+
+      /// Moving an Options object moves the options along with the cache.
+      /// @{
+      Options(Options &&) = default;
+      Options& operator=(Options &&) = default;
+      /// @}
+
+      /// Freeze the options. From now on, the results of getValue, getValueOrDef and
+      /// hasKey are cached by type and keys, so that repeated lookups (e.g. at every
+      /// point of a scan) do not need to traverse and parse the YAML node again.
+      /// Lookups of cached results take no lock, so they are cheap from any number of threads.
+      /// The options should not be changed through the YAML node after freezing;
+      /// setValue and assignment are fine (they clear the cache), but not while other
+      /// threads are looking options up.
+      void freeze()
+      {
+        if (not cache) cache.reset(new Cache);
+      }
+
+      /// Check whether the options have been frozen
+      bool frozen() const { return bool(cache); }
+
       /// Getters for key/value pairs (which is all the options node should contain)
       /// @{
       template <typename... args>
       bool hasKey(const args&... keys) const
       {
+        if (cache)
+        {
+          const std::size_t hash = cacheHash<KeyLookup>(keys...);
+          const Cache::Entry* entry = cachedEntry<KeyLookup>(hash, keys...);
+          if (entry) return entry->found;
+          const bool found = getVariadicNode(options, keys...);
+          storeEntry<KeyLookup>(hash, found, std::shared_ptr<const void>(), keys...);
+          return found;
+        }
         return getVariadicNode(options, keys...);
       }
 
       template<typename TYPE, typename... args>
       TYPE getValue(const args&... keys) const
       {
+        const std::size_t hash = (cache ? cacheHash<TYPE>(keys...) : 0);
+        if (cache)
+        {
+          const Cache::Entry* entry = cachedEntry<TYPE>(hash, keys...);
+          if (entry and entry->found) return *static_cast<const TYPE*>(entry->value.get());
+        }
         const YAML::Node node = getVariadicNode(options, keys...);
         TYPE result;
         if (not node)
@@ -82,6 +139,7 @@ namespace Gambit
           try
           {
             result = node.as<TYPE>();
+            if (cache) storeEntry<TYPE>(hash, true, std::make_shared<const TYPE>(result), keys...);
           }
           catch(YAML::Exception& e)
           {
@@ -100,17 +158,25 @@ namespace Gambit
       template<typename TYPE, typename... args>
       TYPE getValueOrDef(TYPE def, const args&... keys) const
       {
+        const std::size_t hash = (cache ? cacheHash<TYPE>(keys...) : 0);
+        if (cache)
+        {
+          const Cache::Entry* entry = cachedEntry<TYPE>(hash, keys...);
+          if (entry) return entry->found ? *static_cast<const TYPE*>(entry->value.get()) : def;
+        }
         const YAML::Node node = getVariadicNode(options, keys...);
         TYPE result;
         if (not node)
         {
           result = def;
+          if (cache) storeEntry<TYPE>(hash, false, std::shared_ptr<const void>(), keys...);
         }
         else
         {
           try
           {
             result = node.as<TYPE>();
+            if (cache) storeEntry<TYPE>(hash, true, std::make_shared<const TYPE>(result), keys...);
           }
           catch(YAML::Exception& e)
           {
@@ -134,6 +200,11 @@ namespace Gambit
       void setValue(const KEYTYPE &key, const VALTYPE &val)
       {
          options[key] = val;
+         if (cache)
+         {
+           std::lock_guard<std::mutex> lock(cache->mutex);
+           cache->clear();
+         }
          return;
       }
       /// @}
@@ -223,6 +294,115 @@ namespace Gambit
 
       YAML::Node options;
 
+      /// Deep copy of a YAML node (undefined nodes stay undefined)
+      static YAML::Node clone(const YAML::Node &node)
+      {
+        return node.IsDefined() ? YAML::Clone(node) : node;
+      }
+
+      /// Cache of looked-up values, used once the options are frozen.
+      /// Entries are only ever added (until the cache is cleared), so lookups walk the
+      /// bucket lists without locking; the mutex only serialises the additions.
+      struct Cache
+      {
+        /// Result of one lookup (value is a TYPE, if found)
+        struct Entry
+        {
+          const std::type_info* type;
+          std::vector<str> keys;
+          bool found;
+          std::shared_ptr<const void> value;
+          const Entry* next;
+        };
+        static const std::size_t n_buckets = 64;
+        std::atomic<const Entry*> buckets[n_buckets];
+        std::mutex mutex;
+
+        Cache() { for (std::size_t i = 0; i < n_buckets; ++i) buckets[i].store(NULL, std::memory_order_relaxed); }
+        ~Cache() { clear(); }
+
+        /// Delete all entries (not safe while other threads are looking entries up)
+        void clear()
+        {
+          for (std::size_t i = 0; i < n_buckets; ++i)
+          {
+            const Entry* entry = buckets[i].exchange(NULL);
+            while (entry != NULL)
+            {
+              const Entry* next = entry->next;
+              delete entry;
+              entry = next;
+            }
+          }
+        }
+      };
+      std::unique_ptr<Cache> cache;
+
+      /// Tag type for the cache entries of hasKey lookups
+      struct KeyLookup {};
+
+      /// @{ Hash a lookup of type TYPE with the given keys, without copying the keys
+      static std::size_t hashChars(std::size_t hash, const char* chars, std::size_t n)
+      {
+        for (std::size_t i = 0; i < n; ++i) hash = (hash ^ static_cast<unsigned char>(chars[i])) * 1099511628211ULL;
+        return hash;
+      }
+
+      static std::size_t hashKeys(std::size_t hash) { return hash; }
+
+      template<typename... args>
+      static std::size_t hashKeys(std::size_t hash, const str& key, const args&... keys)
+      {
+        return hashKeys(hashChars(hash, key.data(), key.size()) * 31, keys...);
+      }
+
+      template<typename... args>
+      static std::size_t hashKeys(std::size_t hash, const char* key, const args&... keys)
+      {
+        return hashKeys(hashChars(hash, key, std::strlen(key)) * 31, keys...);
+      }
+
+      template<typename TYPE, typename... args>
+      static std::size_t cacheHash(const args&... keys)
+      {
+        return hashKeys(typeid(TYPE).hash_code(), keys...);
+      }
+      /// @}
+
+      /// @{ Compare the keys of a cache entry with the given keys
+      static bool sameKeys(const std::vector<str>& entry_keys, std::size_t i) { return i == entry_keys.size(); }
+
+      template<typename KEY, typename... args>
+      static bool sameKeys(const std::vector<str>& entry_keys, std::size_t i, const KEY& key, const args&... keys)
+      {
+        return i < entry_keys.size() and entry_keys[i] == key and sameKeys(entry_keys, i+1, keys...);
+      }
+      /// @}
+
+      /// Retrieve the cached result of a lookup; NULL if it is not cached yet
+      template<typename TYPE, typename... args>
+      const Cache::Entry* cachedEntry(std::size_t hash, const args&... keys) const
+      {
+        for (const Cache::Entry* entry = cache->buckets[hash % Cache::n_buckets].load(std::memory_order_acquire);
+             entry != NULL; entry = entry->next)
+        {
+          if (*entry->type == typeid(TYPE) and sameKeys(entry->keys, 0, keys...)) return entry;
+        }
+        return NULL;
+      }
+
+      /// Add the result of a lookup to the cache
+      template<typename TYPE, typename... args>
+      void storeEntry(std::size_t hash, bool found, std::shared_ptr<const void> value, const args&... keys) const
+      {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        // Another thread may have stored the same lookup in the meantime
+        if (cachedEntry<TYPE>(hash, keys...) != NULL) return;
+        std::atomic<const Cache::Entry*>& bucket = cache->buckets[hash % Cache::n_buckets];
+        const Cache::Entry* entry = new Cache::Entry{&typeid(TYPE), std::vector<str>{str(keys)...}, found, value, bucket.load(std::memory_order_relaxed)};
+        bucket.store(entry, std::memory_order_release);
+      }
+
   };
 
 }
@@ -23,6 +23,7 @@
 
 #include "gambit/Utils/mpiwrapper.hpp"
 #include "gambit/Utils/util_macros.hpp"
+#include "gambit/Utils/util_functions.hpp"
 #include "gambit/Utils/exceptions.hpp"
 #include "gambit/Utils/standalone_error_handlers.hpp"
 #include "gambit/Logs/logger.hpp"
@@ -261,7 +262,7 @@ namespace Gambit
     /// Throw the exception onward if running serially, abort if not.
     void exception::throw_iff_outside_parallel()
     {
-      if (omp_get_level()==0) // If not in an OpenMP parallel block, throw onwards
+      if (Utils::omp_module_level()==0) // If not in an OpenMP parallel block, throw onwards
       {
         throw(*this);
       }
@@ -420,7 +421,7 @@ namespace Gambit
     /// Raise the exception, i.e. throw it with a message.
     void invalid_point_exception::raise(const std::string& msg)
     {
-      if (omp_get_level()==0) // If not in an OpenMP parallel block, throw onwards
+      if (Utils::omp_module_level()==0) // If not in an OpenMP parallel block, throw onwards
       {
         #pragma omp critical (GAMBIT_exception)
         {
@@ -471,7 +472,7 @@ namespace Gambit
     /// Check whether a piped invalid point exception was requested, and throw if necessary.
     void Piped_invalid_point::check()
     {
-      if (omp_get_level()==0) // If not in an OpenMP parallel block, throw onwards
+      if (Utils::omp_module_level()==0) // If not in an OpenMP parallel block, throw onwards
       {    
         if (this->flag)
         {
@@ -542,7 +543,7 @@ namespace Gambit
     /// Check whether any exceptions were requested, and raise them.
     void Piped_exceptions::check(exception &excep)
     {
-      if (omp_get_level()==0) // If not in an OpenMP parallel block, throw onwards
+      if (Utils::omp_module_level()==0) // If not in an OpenMP parallel block, throw onwards
       {    
         if (this->flag)
         {
@@ -0,0 +1,111 @@
+//   GAMBIT: Global and Modular BSM Inference Tool
+//   *********************************************
+///  \file
+///
+///  Scratch files for handing text (e.g. an SLHA
+///  spectrum) to backends that will only read
+///  from a named file.
+///
+///  *********************************************
+///
+///  Authors (add name and date if you modify):
+///
+///  *********************************************
+
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+  #include <sys/syscall.h>
+  #include <sys/mman.h>
+  #ifndef MFD_CLOEXEC
+    #define MFD_CLOEXEC 0x0001U
+  #endif
+#endif
+
+#include "gambit/Utils/memory_file.hpp"
+#include "gambit/Utils/standalone_error_handlers.hpp"
+#include "gambit/Utils/local_info.hpp"
+#include "gambit/Logs/logger.hpp"
+
+namespace Gambit
+{
+   namespace Utils
+   {
+
+      /// @{ Members of MemoryFile class
+
+      /// Constructor
+      MemoryFile::MemoryFile(const std::string& name, const std::string& contents)
+       : fd(-1)
+       , in_mem(false)
+      {
+        #if defined(__linux__) && defined(SYS_memfd_create)
+          // Anonymous memory-backed file, which other code in this process can open by
+          // name through /proc.  Use the disk instead if either of these is unavailable.
+          // Close-on-exec, so that the descriptor is not inherited by any backend processes.
+          fd = syscall(SYS_memfd_create, name.c_str(), MFD_CLOEXEC);
+          if(fd>=0)
+          {
+            my_fname = "/proc/self/fd/" + std::to_string(fd);
+            if(access(my_fname.c_str(), R_OK)==0) in_mem = true;
+            else { close(fd); fd = -1; }
+          }
+        #endif
+
+        if(not in_mem)
+        {
+          my_fname = name;
+          fd = open(my_fname.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+          if(fd<0)
+          {
+            std::ostringstream msg;
+            msg << "Error creating file '"<<my_fname<<"'! Error was: "<< std::strerror(errno);
+            utils_error().raise(LOCAL_INFO,msg.str());
+          }
+        }
+
+        // Write the whole contents, allowing for partial writes
+        const char* buf = contents.data();
+        size_t left = contents.size();
+        while(left>0)
+        {
+          ssize_t n = write(fd, buf, left);
+          if(n<0)
+          {
+            if(errno==EINTR) continue;
+            std::ostringstream msg;
+            msg << "Error writing to file '"<<my_fname<<"'! Error was: "<< std::strerror(errno);
+            close(fd);
+            if(not in_mem) remove(my_fname.c_str());
+            fd = -1;
+            utils_error().raise(LOCAL_INFO,msg.str());
+          }
+          buf += n;
+          left -= n;
+        }
+      }
+
+      /// Destructor
+      MemoryFile::~MemoryFile()
+      {
+        if(fd>=0) close(fd);
+        if(not in_mem and fd>=0 and remove(my_fname.c_str())!=0)
+        {
+          // No exceptions from a destructor; just log it
+          logger() << LogTags::utils << LogTags::warn << "Unable to delete file " << my_fname << EOM;
+        }
+      }
+
+      /// Getter for the name to open the file with
+      const std::string& MemoryFile::get_filename() const { return my_fname; }
+
+      /// Check whether the file lives in memory
+      bool MemoryFile::in_memory() const { return in_mem; }
+
+      /// @}
+   }
+}
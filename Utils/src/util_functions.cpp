@@ -32,6 +32,7 @@
 #include <sys/stat.h>
 #include <dirent.h>
 #include <libgen.h>
+#include <omp.h>
 
 /// Gambit
 #include "gambit/Utils/util_functions.hpp"
@@ -352,6 +353,21 @@ namespace Gambit
       }
       return true;
     }     
+
+    /// OpenMP nesting level at which the Core is calculating several functors at once
+    static int omp_module_base_level = 0;
+
+    /// Get the OpenMP nesting level as seen from module functions
+    int omp_module_level()
+    {
+      return omp_get_level() - omp_module_base_level;
+    }
+
+    /// Set the OpenMP nesting level at which the Core is calculating several functors at once
+    void set_omp_module_base_level(int level)
+    {
+      omp_module_base_level = level;
+    }
    
     
   }
@@ -83,15 +83,51 @@ if(EXISTS "${PROJECT_SOURCE_DIR}/ScannerBit/")
 endif()
 
 # Add C++ hdf5 combine tool, if we have HDF5 libraries
-#if(HDF5_FOUND)
-#  if(EXISTS "${PROJECT_SOURCE_DIR}/Printers/")
-#    if(EXISTS "${PROJECT_SOURCE_DIR}/Elements/")
-#       add_gambit_executable(hdf5_combine ${HDF5_LIBRARIES}
-#                        SOURCES ${PROJECT_SOURCE_DIR}/Printers/examples/hdf5_combine_standalone.cpp
-#                                ${GAMBIT_BASIC_COMMON_OBJECTS}
-#       )
-#       set_target_properties(hdf5_combine PROPERTIES RUNTIME_OUTPUT_DIRECTORY "${PROJECT_SOURCE_DIR}/Printers/scripts")
-#    endif()
-#  endif()
-#endif()
+if(HDF5_FOUND)
+  if(EXISTS "${PROJECT_SOURCE_DIR}/Printers/")
+    add_gambit_executable(hdf5_combine "${HDF5_LIBRARIES}"
+                          SOURCES ${PROJECT_SOURCE_DIR}/Printers/examples/hdf5_combine_standalone.cpp
+                                  ${PROJECT_SOURCE_DIR}/Printers/src/printers/hdf5printer/hdf5_combine_tools.cpp
+                                  ${PROJECT_SOURCE_DIR}/Printers/src/printers/hdf5printer/hdf5tools.cpp
+                                  ${GAMBIT_BASIC_COMMON_OBJECTS}
+    )
+    set_target_properties(hdf5_combine PROPERTIES RUNTIME_OUTPUT_DIRECTORY "${PROJECT_SOURCE_DIR}/Printers/scripts")
+    add_dependencies(standalones hdf5_combine)
+  endif()
+endif()
+
+# Add the run-option lookup benchmark
+if(EXISTS "${PROJECT_SOURCE_DIR}/Utils/")
+  add_gambit_executable(options_benchmark ""
+                        SOURCES ${PROJECT_SOURCE_DIR}/Utils/examples/options_benchmark.cpp
+                                ${GAMBIT_BASIC_COMMON_OBJECTS}
+  )
+  add_dependencies(standalones options_benchmark)
+endif()
 
+# Add the benchmark of per-thread functor result slots
+if(EXISTS "${PROJECT_SOURCE_DIR}/Utils/")
+  add_gambit_executable(functor_slot_benchmark ""
+                        SOURCES ${PROJECT_SOURCE_DIR}/Utils/examples/functor_slot_benchmark.cpp
+                                ${GAMBIT_BASIC_COMMON_OBJECTS}
+  )
+  add_dependencies(standalones functor_slot_benchmark)
+endif()
+
+# Add the ObsLike execution plan benchmark
+if(EXISTS "${PROJECT_SOURCE_DIR}/Core/")
+  add_gambit_executable(ObsLike_plan_benchmark "${gambit_XTRA}"
+                        SOURCES ${PROJECT_SOURCE_DIR}/Core/examples/ObsLike_plan_benchmark.cpp
+                                ${GAMBIT_ALL_COMMON_OBJECTS}
+                                ${GAMBIT_BIT_OBJECTS}
+                                $<TARGET_OBJECTS:Core>
+                                $<TARGET_OBJECTS:Printers>
+  )
+  if (NOT EXCLUDE_FLEXIBLESUSY)
+    add_dependencies(ObsLike_plan_benchmark flexiblesusy)
+  endif()
+  if (NOT EXCLUDE_DELPHES)
+    add_dependencies(ObsLike_plan_benchmark delphes)
+  endif()
+  add_dependencies(standalones ObsLike_plan_benchmark)
+endif()